@@ -0,0 +1,470 @@
+/**
+ * @file bench_json.cpp
+ * @brief Parse de mensagens de feed: Json::parse (DOM) vs JsonDocument (arena).
+ *
+ * Mede ns/mensagem, throughput (GB/s) e alocações por mensagem (operator
+ * new global contado). O JsonDocument é reutilizado entre mensagens, como
+ * num callback onRawMessage. O estágio 1 (índice estrutural) é medido
+ * sozinho, em cada kernel disponível, a conversão de números (double e
+ * Decimal) é comparada com strtod e a extração de um depthUpdate por
+ * eventos (parseEvents), a de campos por caminho (JsonQuery) e o
+ * decode/encode de structs (GG_JSON_BIND) são comparados com DOM + busca.
+ * A serialização (JsonWriter) é comparada com a antiga, por iostream, e a
+ * busca no Json::Object (por texto e por Json::Key) com o
+ * std::unordered_map que ele substituiu.
+ */
+
+#include "gg_ws/json.hpp"
+#include "gg_ws/json_bind.hpp"
+#include "gg_ws/json_document.hpp"
+#include "gg_ws/json_query.hpp"
+#include "gg_ws/json_writer.hpp"
+#include "../src/internal/json_number.hpp"
+#include "../src/internal/json_structural.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <new>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace gg;
+
+static std::atomic<size_t> allocations{0};
+
+void* operator new(size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"    // new acima usa malloc
+#endif
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+
+namespace {
+
+constexpr int Iterations = 200000;
+
+struct Message {
+    const char* name;
+    std::string data;
+};
+
+std::string depthUpdate(int levels) {
+    std::string depth = R"({"e":"depthUpdate","E":1700000000123,"s":"BTCUSDT","U":157,"u":160,"b":[)";
+    for (int i = 0; i < levels; ++i) {
+        depth += (i ? "," : "") + std::string(R"([")") + std::to_string(67234 - i) + R"(.50","0.)" +
+                 std::to_string(100 + i * 7) + R"("])";
+    }
+    depth += R"(],"a":[)";
+    for (int i = 0; i < levels; ++i) {
+        depth += (i ? "," : "") + std::string(R"([")") + std::to_string(67235 + i) + R"(.10","1.)" +
+                 std::to_string(200 + i * 3) + R"("])";
+    }
+    depth += "]}";
+    return depth;
+}
+
+std::vector<Message> messages() {
+    return {
+        {"trade", R"({"e":"trade","E":1700000000123,"s":"BTCUSDT","t":12345,"p":"67234.50",)"
+                  R"("q":"0.00012","b":88,"a":50,"T":1700000000120,"m":true,"M":true})"},
+        {"depthUpdate (10x10)", depthUpdate(10)},
+        {"ticker", R"({"stream":"btcusdt@ticker","data":{"e":"24hrTicker","E":1700000000123,"s":"BTCUSDT",)"
+                   R"("p":"-120.50","P":"-0.178","w":"67500.12","c":"67234.50","Q":"0.012","o":"67355.00",)"
+                   R"("h":"68000.00","l":"66900.00","v":"12345.678","q":"832145678.90","O":1699913723123,)"
+                   R"("C":1700000123123,"F":100,"L":200,"n":101}})"},
+        {"depthUpdate (1000x1000)", depthUpdate(1000)},
+    };
+}
+
+template<typename Parse>
+void run(const char* label, const Message& message, Parse parse) {
+    // Mesmo volume de bytes para mensagens grandes
+    const int iterations = static_cast<int>(std::max<size_t>(100, Iterations * 200 / message.data.size()));
+    for (int i = 0; i < 1000; ++i) parse(message.data);   // Aquecimento
+
+    size_t before = allocations.load();
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        parse(message.data);
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    size_t allocs = allocations.load() - before;
+
+    double ns = std::chrono::duration<double, std::nano>(elapsed).count() / iterations;
+    double gbps = static_cast<double>(message.data.size()) / ns;
+    std::printf("  %-24s %-20s %10.1f ns/msg  %5.2f GB/s  %8.1f alocações/msg\n",
+                message.name, label, ns, gbps, static_cast<double>(allocs) / iterations);
+}
+
+// Números típicos de feed, medidos em lote (ns por número)
+void runNumbers() {
+    struct Sample {
+        const char* name;
+        std::vector<std::string> texts;
+    };
+    std::vector<Sample> samples = {
+        {"inteiro (ms)", {}}, {"2 casas", {}}, {"8 casas", {}}, {"17 casas", {}}, {"expoente", {}}
+    };
+    uint32_t seed = 1;
+    auto next = [&seed]() { seed = seed * 1103515245 + 12345; return seed >> 8; };
+    for (int i = 0; i < 1000; ++i) {
+        samples[0].texts.push_back(std::to_string(1700000000000ULL + next()));
+        samples[1].texts.push_back(std::to_string(60000 + next() % 10000) + "." + std::to_string(10 + next() % 90));
+        samples[2].texts.push_back("0.000" + std::to_string(10 + next() % 90000));
+        samples[3].texts.push_back("0." + std::to_string(1000000000 + next() % 1000000000) +
+                                   std::to_string(1000000 + next() % 9000000));
+        samples[4].texts.push_back(std::to_string(1 + next() % 9) + "." + std::to_string(next() % 1000) + "e-" +
+                                   std::to_string(next() % 300));
+    }
+
+    auto measure = [](const Sample& sample, auto convert) {
+        volatile double sink = 0;
+        auto start = std::chrono::steady_clock::now();
+        constexpr int Rounds = 200;
+        for (int r = 0; r < Rounds; ++r) {
+            for (const auto& text : sample.texts) sink = sink + convert(text);
+        }
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        return std::chrono::duration<double, std::nano>(elapsed).count() / (Rounds * sample.texts.size());
+    };
+
+    for (const auto& sample : samples) {
+        double fast = measure(sample, [](const std::string& text) {
+            // Caminho double de getNumber()
+            using Kind = internal::json::Number::Kind;
+            internal::json::Number number;
+            internal::json::parseNumber(text.data(), text.data() + text.size(), number);
+            switch (number.kind) {
+                case Kind::Int:     return static_cast<double>(number.i);
+                case Kind::UInt:    return static_cast<double>(number.u);
+                case Kind::Decimal: return Decimal(number.i, number.scale).toDouble();
+                default:            return number.d;
+            }
+        });
+        double decimal = measure(sample, [](const std::string& text) {
+            // Preço em ticks de 10^-8 sem ponto flutuante (expoente grande: nullopt)
+            auto value = Decimal::parse(text);
+            return value ? static_cast<double>(value->toTicks(8).value_or(0)) : 0.0;
+        });
+        double slow = measure(sample, [](const std::string& text) {
+            // Como o parser antigo: cópia terminada em '\0' + strtod
+            char local[64];
+            std::memcpy(local, text.data(), text.size());
+            local[text.size()] = '\0';
+            return std::strtod(local, nullptr);
+        });
+        std::printf("  %-14s double %6.1f ns   Decimal %6.1f ns   strtod %6.1f ns\n",
+                    sample.name, fast, decimal, slow);
+    }
+}
+
+// Níveis de um depthUpdate em ticks de 10^-8, extraídos por eventos
+struct Level {
+    int64_t price;
+    int64_t qty;
+};
+
+int64_t ticks(std::string_view text) {
+    auto value = Decimal::parse(text);
+    return value ? value->toTicks(8).value_or(0) : 0;
+}
+
+struct DepthHandler {
+    std::vector<Level>& bids;
+    std::vector<Level>& asks;
+    std::vector<Level>* side = nullptr;
+    int arrays = 0;
+    int field = 0;
+    Level level{};
+
+    void onKey(std::string_view key) {
+        if (arrays == 0) side = key == "b" ? &bids : key == "a" ? &asks : nullptr;
+    }
+    void onStartArray() {
+        ++arrays;
+        field = 0;
+    }
+    void onString(std::string_view text) {
+        if (!side || arrays != 2) return;
+        (field++ == 0 ? level.price : level.qty) = ticks(text);
+    }
+    void onEndArray() {
+        if (side && arrays == 2) side->push_back(level);
+        if (--arrays == 0) side = nullptr;
+    }
+};
+
+// Trade completo em struct (GG_JSON_BIND)
+struct Trade {
+    std::string_view e;
+    int64_t E = 0;
+    std::string_view s;
+    uint64_t t = 0;
+    Decimal p;
+    Decimal q;
+    int64_t b = 0;
+    int64_t a = 0;
+    int64_t T = 0;
+    bool m = false;
+    bool M = false;
+};
+GG_JSON_BIND(Trade, e, E, s, t, p, q, b, a, T, m, M)
+
+// Serialização anterior ao JsonWriter (ostringstream + setprecision(17)), como referência
+void iostreamStringify(std::ostringstream& out, const Json& json) {
+    switch (json.type()) {
+        case Json::Type::Null: out << "null"; break;
+        case Json::Type::Bool: out << (json.getBool() ? "true" : "false"); break;
+        case Json::Type::Number:
+            if (json.isDecimal()) {
+                out << json.getDecimal().toString();
+            } else if (json.isInteger()) {
+                out << json.getInt();
+            } else {
+                out << std::setprecision(17) << json.getNumber();
+            }
+            break;
+        case Json::Type::String: {
+            out << '"';
+            for (char c : json.getString()) {
+                if (c == '"' || c == '\\') out << '\\' << c;
+                else if (static_cast<unsigned char>(c) < 0x20) out << "\\u" << std::hex << std::setfill('0')
+                                                                  << std::setw(4) << static_cast<int>(c) << std::dec;
+                else out << c;
+            }
+            out << '"';
+            break;
+        }
+        case Json::Type::Array: {
+            out << '[';
+            bool first = true;
+            json.forEach([&](const Json& item) {
+                if (!first) out << ',';
+                first = false;
+                iostreamStringify(out, item);
+            });
+            out << ']';
+            break;
+        }
+        case Json::Type::Object: {
+            out << '{';
+            bool first = true;
+            json.forEachPair([&](std::string_view key, const Json& value) {
+                if (!first) out << ',';
+                first = false;
+                out << '"' << key << "\":";
+                iostreamStringify(out, value);
+            });
+            out << '}';
+            break;
+        }
+    }
+}
+
+} // anonymous namespace
+
+int main() {
+    using internal::json::StructuralIndex;
+    std::printf("=== Benchmark de Parse JSON ===\n\n");
+    volatile double sink = 0;
+
+    std::printf("Estágio 1 (índice estrutural, melhor kernel: %s):\n",
+                StructuralIndex::kernelName(StructuralIndex::bestKernel()));
+    StructuralIndex index;
+    for (const auto& message : messages()) {
+        for (auto kernel : {StructuralIndex::Kernel::Scalar, StructuralIndex::Kernel::Sse2,
+                            StructuralIndex::Kernel::Avx2}) {
+            if (static_cast<int>(kernel) > static_cast<int>(StructuralIndex::bestKernel())) continue;
+            char label[32];
+            std::snprintf(label, sizeof(label), "índice %s", StructuralIndex::kernelName(kernel));
+            run(label, message, [&](const std::string& data) {
+                index.build(data, kernel);
+                sink = sink + static_cast<double>(index.size());
+            });
+        }
+    }
+
+    std::printf("\nNúmeros (por número):\n");
+    runNumbers();
+
+    std::printf("\nExtração de depthUpdate (níveis em ticks):\n");
+    std::vector<Level> bids, asks;
+    bids.reserve(1000);
+    asks.reserve(1000);
+    for (const auto& message : messages()) {
+        if (message.data.find("depthUpdate") == std::string::npos) continue;
+        run("parseEvents", message, [&](const std::string& data) {
+            bids.clear();
+            asks.clear();
+            DepthHandler handler{bids, asks};
+            (void)Json::parseEvents(data, handler);
+            sink = sink + static_cast<double>(bids.size() + asks.size());
+        });
+        run("Json::parse + busca", message, [&](const std::string& data) {
+            bids.clear();
+            asks.clear();
+            auto json = Json::parse(data);
+            for (auto [key, side] : {std::pair{"b", &bids}, std::pair{"a", &asks}}) {
+                (*json)[key].forEach([side](const Json& level) {
+                    side->push_back({ticks(level[0].getString()), ticks(level[1].getString())});
+                });
+            }
+            sink = sink + static_cast<double>(bids.size() + asks.size());
+        });
+    }
+
+    JsonDocument doc;
+    std::printf("\nExtração de 3 campos (JsonQuery vs DOM):\n");
+    // Por mensagem: caminhos, objeto que os contém e as três chaves
+    struct Extraction {
+        const char* message;
+        JsonQuery query;
+        const char* parent;
+        const char* keys[3];
+    };
+    const Extraction extractions[] = {
+        {"trade", JsonQuery({"/p", "/q", "/T"}), nullptr, {"p", "q", "T"}},
+        {"ticker", JsonQuery({"/data/c", "/data/v", "/data/C"}), "data", {"c", "v", "C"}},
+        {"depthUpdate (1000x1000)", JsonQuery({"/E", "/U", "/u"}), nullptr, {"E", "U", "u"}},   // Para antes dos níveis
+    };
+    std::array<JsonField, 3> fields;
+    for (const auto& message : messages()) {
+        for (const auto& extraction : extractions) {
+            if (message.name != std::string_view(extraction.message)) continue;
+            const auto& keys = extraction.keys;
+            run("JsonQuery", message, [&](const std::string& data) {
+                extraction.query.extract(data, fields);
+                sink = sink + fields[0].getDecimal().toDouble() + fields[1].getDecimal().toDouble() +
+                       static_cast<double>(fields[2].getInt());
+            });
+            run("JsonDocument", message, [&](const std::string& data) {
+                doc.parse(data);
+                JsonValue root = extraction.parent ? doc[extraction.parent] : doc.root();
+                sink = sink + root[keys[0]].getDecimal().toDouble() + root[keys[1]].getDecimal().toDouble() +
+                       static_cast<double>(root[keys[2]].getInt());
+            });
+            run("Json::parse", message, [&](const std::string& data) {
+                auto json = Json::parse(data);
+                const Json& root = extraction.parent ? (*json)[extraction.parent] : *json;
+                sink = sink + root[keys[0]].getDecimal().toDouble() + root[keys[1]].getDecimal().toDouble() +
+                       static_cast<double>(root[keys[2]].getInt());
+            });
+        }
+    }
+
+    std::printf("\nStruct Trade (GG_JSON_BIND vs DOM):\n");
+    const Message tradeMessage = messages().front();
+    Trade trade;
+    run("decodeJson", tradeMessage, [&](const std::string& data) {
+        (void)decodeJson(data, trade);
+        sink = sink + trade.p.toDouble() + static_cast<double>(trade.T);
+    });
+    run("Json::parse + getters", tradeMessage, [&](const std::string& data) {
+        auto json = Json::parse(data);
+        const Json& root = *json;
+        trade = {root["e"].getString(), root["E"].getInt(), root["s"].getString(), root["t"].getUInt(),
+                 root["p"].getDecimal(), root["q"].getDecimal(), root["b"].getInt(), root["a"].getInt(),
+                 root["T"].getInt(), root["m"].getBool(), root["M"].getBool()};
+        sink = sink + trade.p.toDouble() + static_cast<double>(trade.T);
+    });
+    std::string encoded;
+    run("encodeJson", tradeMessage, [&](const std::string&) {
+        encoded.clear();
+        encodeJson(trade, encoded);
+        sink = sink + static_cast<double>(encoded.size());
+    });
+    run("Json + stringify", tradeMessage, [&](const std::string&) {
+        Json json = Json::object();
+        json["e"] = trade.e;
+        json["E"] = trade.E;
+        json["s"] = trade.s;
+        json["t"] = trade.t;
+        json["p"] = trade.p;
+        json["q"] = trade.q;
+        json["b"] = trade.b;
+        json["a"] = trade.a;
+        json["T"] = trade.T;
+        json["m"] = trade.m;
+        json["M"] = trade.M;
+        encoded = json.stringify();
+        sink = sink + static_cast<double>(encoded.size());
+    });
+
+    std::printf("\nSerialização (Json já montado):\n");
+    for (const auto& message : messages()) {
+        const Json json = *Json::parse(message.data);
+        run("iostream (referência)", message, [&](const std::string&) {
+            std::ostringstream out;
+            iostreamStringify(out, json);
+            sink = sink + static_cast<double>(out.str().size());
+        });
+        run("stringify()", message, [&](const std::string&) {
+            sink = sink + static_cast<double>(json.stringify().size());
+        });
+        run("stringify(out)", message, [&](const std::string&) {
+            encoded.clear();
+            json.stringify(encoded);
+            sink = sink + static_cast<double>(encoded.size());
+        });
+    }
+    run("JsonWriter (ordem)", tradeMessage, [&](const std::string&) {
+        encoded.clear();
+        JsonWriter writer(encoded);
+        writer.beginObject()
+              .field("symbol", trade.s)
+              .field("side", "BUY")
+              .field("type", "LIMIT")
+              .field("price", trade.p)
+              .field("quantity", trade.q)
+              .field("timestamp", trade.T)
+              .endObject();
+        sink = sink + static_cast<double>(writer.size());
+    });
+
+    std::printf("\nBusca de todas as chaves (get(Json::Key) vs get() vs std::unordered_map):\n");
+    for (const auto& message : messages()) {
+        if (message.data.find("depthUpdate") != std::string::npos) continue;
+        const Json parsed = *Json::parse(message.data);
+        const Json& object = parsed.contains("data") ? parsed["data"] : parsed;     // ticker: 18 chaves (índice)
+        std::vector<std::string> keys = object.keys();
+        std::vector<Json::Key> handles;
+        for (const auto& key : keys) handles.emplace_back(key);
+        // Layout anterior do Json::Object, como referência
+        std::unordered_map<std::string, Json> map;
+        object.forEachPair([&map](std::string_view key, const Json& value) { map.emplace(key, value); });
+        run("get(Json::Key)", message, [&](const std::string&) {
+            for (Json::Key key : handles) sink = sink + static_cast<double>(object.get(key).type());
+        });
+        run("get()", message, [&](const std::string&) {
+            for (const auto& key : keys) sink = sink + static_cast<double>(object.get(key).type());
+        });
+        run("unordered_map", message, [&](const std::string&) {
+            for (const auto& key : keys) sink = sink + static_cast<double>(map.find(key)->second.type());
+        });
+    }
+
+    std::printf("\nParse completo:\n");
+    for (const auto& message : messages()) {
+        run("Json::parse", message, [&](const std::string& data) {
+            auto json = Json::parse(data);
+            sink = sink + (*json)["E"].getNumber();
+        });
+        run("JsonDocument", message, [&](const std::string& data) {
+            doc.parse(data);
+            sink = sink + doc["E"].getNumber();
+        });
+    }
+    return 0;
+}
@@ -0,0 +1,137 @@
+/**
+ * @file bench_policies.cpp
+ * @brief Custo por mensagem de cada combinação de políticas (loopback TCP).
+ *
+ * O servidor local envia N frames de texto de uma vez; mede-se o tempo
+ * entre o primeiro byte disponível e a última mensagem entregue ao callback.
+ */
+
+#include "gg_ws/gg_ws.hpp"
+#include "../tests/local_server.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <thread>
+
+using namespace gg;
+
+namespace {
+
+constexpr int MessageCount = 200000;
+
+const std::string& burst() {
+    static const std::string data = [] {
+        std::string out;
+        for (int i = 0; i < MessageCount; ++i) {
+            out += test::Connection::encodeFrame(0x1,
+                R"({"e":"trade","E":1700000000123,"s":"BTCUSDT","t":)" + std::to_string(i) +
+                R"(,"p":"67234.50","q":"0.00012","m":true})");
+        }
+        return out;
+    }();
+    return data;
+}
+
+WebSocketConfig benchConfig(const test::LocalServer& server) {
+    WebSocketConfig config{.url = server.url()};
+    config.autoReconnect = false;
+    config.ping.mode = PingMode::Disabled;
+    return config;
+}
+
+void report(const char* name, std::chrono::steady_clock::duration elapsed, int received) {
+    double ns = std::chrono::duration<double, std::nano>(elapsed).count() / received;
+    std::printf("  %-44s %8.1f ns/msg  %6.2f M msg/s\n", name, ns, 1e3 / ns);
+}
+
+template<typename WS>
+void runThreaded(const char* name, bool useJson) {
+    test::LocalServer server([](test::Connection& conn) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        conn.sendRaw(burst());
+        conn.waitClose(10000);
+    });
+
+    WS ws(benchConfig(server));
+    std::atomic<int> received{0};
+    std::chrono::steady_clock::time_point first, last;
+
+    auto count = [&] {
+        int n = received.load(std::memory_order_relaxed) + 1;
+        if (n == 1) first = std::chrono::steady_clock::now();
+        if (n == MessageCount) last = std::chrono::steady_clock::now();
+        received.store(n, std::memory_order_release);
+    };
+    if constexpr (WS::policies::json) {
+        if (useJson) {
+            ws.onMessage([&](const Json&) { count(); });
+        } else {
+            ws.onRawMessage([&](std::string_view) { count(); });
+        }
+    } else {
+        ws.onRawMessage([&](std::string_view) { count(); });
+    }
+
+    if (!ws.connect()) {
+        std::printf("  %-44s falhou ao conectar\n", name);
+        return;
+    }
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(30);
+    while (received.load(std::memory_order_acquire) < MessageCount) {
+        if (std::chrono::steady_clock::now() > deadline || !ws.isConnected()) {
+            std::printf("  %-44s incompleto (%d/%d)\n", name, received.load(), MessageCount);
+            return;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    ws.disconnect();
+    report(name, last - first, MessageCount);
+}
+
+template<typename WS>
+void runPolled(const char* name) {
+    test::LocalServer server([](test::Connection& conn) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        conn.sendRaw(burst());
+        conn.waitClose(10000);
+    });
+
+    WS ws(benchConfig(server));
+    int received = 0;
+    std::chrono::steady_clock::time_point first;
+    ws.onRawMessage([&](std::string_view) {
+        if (received++ == 0) first = std::chrono::steady_clock::now();
+    });
+
+    if (!ws.connect()) {
+        std::printf("  %-44s falhou ao conectar\n", name);
+        return;
+    }
+    while (received < MessageCount) {
+        if (ws.poll(256, 10) == 0 && !ws.isConnected()) {
+            std::printf("  %-44s incompleto (%d/%d)\n", name, received, MessageCount);
+            return;
+        }
+    }
+    auto last = std::chrono::steady_clock::now();
+    ws.disconnect();
+    report(name, last - first, MessageCount);
+}
+
+} // anonymous namespace
+
+int main() {
+    std::printf("=== Benchmark de Políticas (%d mensagens, loopback) ===\n\n", MessageCount);
+    burst();
+
+    runThreaded<WebSocket>("WebSocket (default) + onMessage(Json)", true);
+    runThreaded<WebSocket>("WebSocket (default) + onRawMessage", false);
+    runThreaded<BasicWebSocket<policy::TcpTransport, policy::JsonOff, policy::HeartbeatOff,
+                               policy::MetricsOff>>("Tcp + JsonOff + HeartbeatOff + MetricsOff", false);
+    runPolled<BasicWebSocket<policy::TcpTransport, policy::ExternalDriven, policy::JsonOff,
+                             policy::HeartbeatOff, policy::MetricsOff>>("Tcp + ExternalDriven + JsonOff (poll)");
+
+    return 0;
+}
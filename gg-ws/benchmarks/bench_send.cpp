@@ -0,0 +1,105 @@
+/**
+ * @file bench_send.cpp
+ * @brief Latência de send() por thread com 1 a 16 threads enviando juntas.
+ *
+ * Todas as threads enviam pela mesma conexão (loopback TCP) enquanto o
+ * servidor local só drena o socket. Com o envio combinado, um escritor
+ * manda os frames de todas as threads numa escrita; frames/escrita mostra
+ * quanto foi combinado.
+ */
+
+#include "gg_ws/gg_ws.hpp"
+#include "../tests/local_server.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace gg;
+
+namespace {
+
+constexpr int SendsPerThread = 20000;
+constexpr int ThreadCounts[] = {1, 2, 4, 8, 16};
+
+using Sender = BasicWebSocket<policy::TcpTransport, policy::JsonOff, policy::HeartbeatOff>;
+
+const std::string& order() {
+    static const std::string data =
+        R"({"method":"order.place","params":{"symbol":"BTCUSDT","side":"BUY","type":"LIMIT",)"
+        R"("price":"67234.50","quantity":"0.001"},"id":1})";
+    return data;
+}
+
+double percentile(std::vector<int64_t>& samples, double p) {
+    size_t index = static_cast<size_t>(p * static_cast<double>(samples.size() - 1));
+    std::nth_element(samples.begin(), samples.begin() + static_cast<std::ptrdiff_t>(index), samples.end());
+    return static_cast<double>(samples[index]);
+}
+
+void run(int threadCount) {
+    test::LocalServer server([](test::Connection& conn) {
+        char buf[64 * 1024];
+        while (::recv(conn.fd(), buf, sizeof(buf), 0) > 0) {}
+    });
+
+    WebSocketConfig config{.url = server.url()};
+    config.autoReconnect = false;
+    Sender ws(config);
+    if (!ws.connect()) {
+        std::printf("  %2d threads: falhou ao conectar\n", threadCount);
+        return;
+    }
+
+    std::vector<std::vector<int64_t>> latencies(static_cast<size_t>(threadCount));
+    std::atomic<int> ready{0};
+    std::atomic<bool> go{false};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threadCount; ++t) {
+        threads.emplace_back([&, t]() {
+            auto& samples = latencies[static_cast<size_t>(t)];
+            samples.reserve(SendsPerThread);
+            ready++;
+            while (!go.load(std::memory_order_acquire)) {}
+            for (int i = 0; i < SendsPerThread; ++i) {
+                auto start = std::chrono::steady_clock::now();
+                ws.send(order());
+                samples.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - start).count());
+            }
+        });
+    }
+    while (ready.load() < threadCount) {}
+
+    auto start = std::chrono::steady_clock::now();
+    go.store(true, std::memory_order_release);
+    for (auto& t : threads) t.join();
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    WebSocketStats stats = ws.stats();
+    ws.disconnect();
+
+    std::vector<int64_t> all;
+    for (auto& samples : latencies) all.insert(all.end(), samples.begin(), samples.end());
+    const double total = static_cast<double>(all.size());
+    const double seconds = std::chrono::duration<double>(elapsed).count();
+    const double p50 = percentile(all, 0.50);
+    const double p99 = percentile(all, 0.99);
+    const double p999 = percentile(all, 0.999);
+    std::printf("  %2d threads  p50 %7.0f ns  p99 %8.0f ns  p99.9 %8.0f ns  %6.2f M msg/s  %5.2f frames/escrita\n",
+                threadCount, p50, p99, p999, total / seconds / 1e6,
+                static_cast<double>(stats.messagesSent) / static_cast<double>(std::max<uint64_t>(1, stats.sendWrites)));
+}
+
+} // anonymous namespace
+
+int main() {
+    std::printf("=== Benchmark de Envio Concorrente (%d envios/thread, loopback) ===\n\n", SendsPerThread);
+    for (int threads : ThreadCounts) {
+        run(threads);
+    }
+    return 0;
+}
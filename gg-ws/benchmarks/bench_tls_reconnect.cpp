@@ -0,0 +1,79 @@
+/**
+ * @file bench_tls_reconnect.cpp
+ * @brief Tempo de handshake TLS em reconexões: completo vs sessão retomada.
+ *
+ * Servidor wss:// local (certificado autoassinado EC P-256). O cliente
+ * conecta e desconecta N vezes; o tempo de TLS vem de EndpointTiming::tls.
+ * Sem retomada, todo handshake refaz certificado + key exchange; com
+ * retomada, só a primeira conexão paga o handshake completo.
+ */
+
+#include "gg_ws/gg_ws.hpp"
+#include "../tests/local_server.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+using namespace gg;
+
+namespace {
+
+constexpr int Reconnects = 200;
+
+using Client = BasicWebSocket<policy::TlsTransport, policy::JsonOff, policy::HeartbeatOff,
+                              policy::MetricsOff>;
+
+void run(const char* name, int maxVersion, bool resume) {
+    test::TlsIdentity identity(maxVersion);
+    test::LocalServer server(identity, [](test::Connection& conn) {
+        conn.waitClose(2000);
+    });
+
+    WebSocketConfig config{.url = server.url()};
+    config.autoReconnect = false;
+    config.tls.caFile = identity.caFile();
+    config.tls.resumeSessions = resume;
+    Client ws(config);
+
+    std::vector<int64_t> samples;
+    samples.reserve(Reconnects);
+    int resumed = 0;
+    ws.onEndpointRace([&](const std::vector<EndpointTiming>& timings) {
+        for (const auto& timing : timings) {
+            if (timing.outcome != EndpointOutcome::Winner) continue;
+            samples.push_back(timing.tls.count());
+            if (timing.tlsResumed) resumed++;
+        }
+    });
+
+    for (int i = 0; i < Reconnects; ++i) {
+        if (!ws.connect()) {
+            std::printf("  %-28s falhou ao conectar\n", name);
+            return;
+        }
+        ws.disconnect();
+    }
+    server.stop();
+
+    // Primeira conexão sempre é completa: fica fora da estatística
+    samples.erase(samples.begin());
+    double mean = 0;
+    for (int64_t us : samples) mean += static_cast<double>(us);
+    mean /= static_cast<double>(samples.size());
+    std::nth_element(samples.begin(), samples.begin() + static_cast<std::ptrdiff_t>(samples.size() / 2), samples.end());
+    std::printf("  %-28s média %7.1f us  p50 %5lld us  retomadas %d/%d\n",
+                name, mean, static_cast<long long>(samples[samples.size() / 2]), resumed, Reconnects - 1);
+}
+
+} // anonymous namespace
+
+int main() {
+    std::printf("=== Benchmark de Reconexão TLS (%d conexões, loopback) ===\n\n", Reconnects);
+    run("TLS 1.3 handshake completo", 0, false);
+    run("TLS 1.3 com retomada", 0, true);
+    run("TLS 1.2 handshake completo", TLS1_2_VERSION, false);
+    run("TLS 1.2 com retomada", TLS1_2_VERSION, true);
+    return 0;
+}
@@ -0,0 +1,204 @@
+/**
+ * @file bench_transport.cpp
+ * @brief Custo do stack do cliente por estágio, sem rede (MemoryTransport).
+ *
+ * Um MemoryPipe com Source preenche o buffer de recepção com frames já
+ * codificados, em ciclo: o tempo medido é só decoder + dispatch + o estágio
+ * escolhido (raw, router, JSON). Para comparação, o mesmo burst passa por
+ * Unix domain socket e loopback TCP.
+ */
+
+#include "gg_ws/gg_ws.hpp"
+#include "../tests/local_server.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <unistd.h>
+
+using namespace gg;
+
+namespace {
+
+constexpr int MemoryMessages = 5000000;
+constexpr int SocketMessages = 200000;
+constexpr int DistinctFrames = 1024;
+
+using MemoryRaw = BasicWebSocket<policy::MemoryTransport, policy::ExternalDriven, policy::JsonOff,
+                                 policy::HeartbeatOff, policy::MetricsOff>;
+using MemoryJson = BasicWebSocket<policy::MemoryTransport, policy::ExternalDriven,
+                                  policy::HeartbeatOff, policy::MetricsOff>;
+using MemoryThreaded = BasicWebSocket<policy::MemoryTransport, policy::JsonOff,
+                                      policy::HeartbeatOff, policy::MetricsOff>;
+using SocketRaw = BasicWebSocket<policy::TcpTransport, policy::ExternalDriven, policy::JsonOff,
+                                 policy::HeartbeatOff, policy::MetricsOff>;
+
+std::string tradeFrame(int i) {
+    const char* type = i % 4 == 3 ? "depthUpdate" : "trade";
+    return test::Connection::encodeFrame(0x1,
+        std::string(R"({"e":")") + type + R"(","E":1700000000123,"s":"BTCUSDT","t":)" +
+        std::to_string(i) + R"(,"p":"67234.50","q":"0.00012","m":true})");
+}
+
+// Bloco repetido pela Source (frames podem cruzar o fim de uma leitura)
+const std::string& cycle() {
+    static const std::string data = [] {
+        std::string out;
+        for (int i = 0; i < DistinctFrames; ++i) out += tradeFrame(i);
+        return out;
+    }();
+    return data;
+}
+
+const std::string& burst() {
+    static const std::string data = [] {
+        std::string out;
+        for (int i = 0; i < SocketMessages; ++i) out += tradeFrame(i);
+        return out;
+    }();
+    return data;
+}
+
+void report(const char* name, std::chrono::steady_clock::duration elapsed, int received) {
+    double ns = std::chrono::duration<double, std::nano>(elapsed).count() / received;
+    std::printf("  %-44s %8.1f ns/msg  %6.2f M msg/s\n", name, ns, 1e3 / ns);
+}
+
+std::shared_ptr<MemoryPipe> cyclingPipe(const char* name) {
+    auto pipe = MemoryPipe::create(name);
+    pipe->setSource([offset = size_t(0)](char* out, size_t capacity) mutable {
+        const std::string& data = cycle();
+        size_t n = 0;
+        while (n < capacity) {
+            size_t chunk = std::min(capacity - n, data.size() - offset);
+            std::memcpy(out + n, data.data() + offset, chunk);
+            n += chunk;
+            offset = (offset + chunk) % data.size();
+        }
+        return n;
+    });
+    return pipe;
+}
+
+WebSocketConfig memoryConfig(const char* name) {
+    WebSocketConfig config{.url = std::string("memory://") + name};
+    config.autoReconnect = false;
+    config.ping.mode = PingMode::Disabled;
+    return config;
+}
+
+// Estágio é instalado por `setup`; poll() até MemoryMessages entregues
+template<typename WS, typename Setup>
+void runMemory(const char* name, Setup setup) {
+    auto pipe = cyclingPipe("bench");
+    WS ws(memoryConfig("bench"));
+    int received = 0;
+    setup(ws, received);
+
+    if (!ws.connect()) {
+        std::printf("  %-44s falhou ao conectar\n", name);
+        return;
+    }
+    auto start = std::chrono::steady_clock::now();
+    while (received < MemoryMessages) {
+        ws.poll(static_cast<size_t>(MemoryMessages - received));
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    ws.disconnect();
+    report(name, elapsed, received);
+}
+
+void runMemoryThreaded(const char* name) {
+    auto pipe = cyclingPipe("bench_threaded");
+    MemoryThreaded ws(memoryConfig("bench_threaded"));
+    std::atomic<int> received{0};
+    std::chrono::steady_clock::time_point first, last;
+    ws.onRawMessage([&](std::string_view) {
+        int n = received.load(std::memory_order_relaxed) + 1;
+        if (n == 1) first = std::chrono::steady_clock::now();
+        if (n == MemoryMessages) last = std::chrono::steady_clock::now();
+        received.store(n, std::memory_order_release);
+    });
+
+    if (!ws.connect()) {
+        std::printf("  %-44s falhou ao conectar\n", name);
+        return;
+    }
+    while (received.load(std::memory_order_acquire) < MemoryMessages) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    ws.disconnect();
+    report(name, last - first, MemoryMessages);
+}
+
+// Mesmo burst por socket real (loopback TCP ou Unix), lido com poll()
+void runSocket(const char* name, const std::string& unixPath) {
+    auto session = [](test::Connection& conn) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        conn.sendRaw(burst());
+        conn.waitClose(10000);
+    };
+    std::unique_ptr<test::LocalServer> server = unixPath.empty()
+        ? std::make_unique<test::LocalServer>(session)
+        : std::make_unique<test::LocalServer>(unixPath, session);
+
+    WebSocketConfig config{.url = server->url()};
+    config.autoReconnect = false;
+    SocketRaw ws(config);
+    int received = 0;
+    std::chrono::steady_clock::time_point first;
+    ws.onRawMessage([&](std::string_view) {
+        if (received++ == 0) first = std::chrono::steady_clock::now();
+    });
+
+    if (!ws.connect()) {
+        std::printf("  %-44s falhou ao conectar\n", name);
+        return;
+    }
+    while (received < SocketMessages) {
+        if (ws.poll(256, 10) == 0 && !ws.isConnected()) {
+            std::printf("  %-44s incompleto (%d/%d)\n", name, received, SocketMessages);
+            return;
+        }
+    }
+    auto last = std::chrono::steady_clock::now();
+    ws.disconnect();
+    report(name, last - first, SocketMessages);
+}
+
+} // anonymous namespace
+
+int main() {
+    std::printf("=== Benchmark de Transporte ===\n\n");
+    cycle();
+    burst();
+
+    std::printf("MemoryTransport (%d mensagens, sem syscalls):\n", MemoryMessages);
+    runMemory<MemoryRaw>("decoder + dispatch (onRawMessage)", [](auto& ws, int& received) {
+        ws.onRawMessage([&received](std::string_view) { received++; });
+    });
+    runMemory<MemoryRaw>("decoder + dispatch (onMessageBatch)", [](auto& ws, int& received) {
+        ws.onMessageBatch([&received](const MessageBatch& batch) {
+            received += static_cast<int>(batch.size());
+        });
+    });
+    runMemory<MemoryRaw>("+ MessageRouter (\"e\")", [](auto& ws, int& received) {
+        MessageRouter router("e");
+        router.on("trade", [&received](std::string_view) { received++; })
+              .on("depthUpdate", [&received](std::string_view) { received++; });
+        ws.route(std::move(router));
+    });
+    runMemory<MemoryJson>("+ Json::parse (onMessage)", [](auto& ws, int& received) {
+        ws.onMessage([&received](const Json&) { received++; });
+    });
+    runMemoryThreaded("OwnThread (onRawMessage)");
+
+    std::printf("\nSockets (%d mensagens, ExternalDriven + onRawMessage):\n", SocketMessages);
+    runSocket("Unix domain socket", "/tmp/gg_ws_bench_" + std::to_string(::getpid()) + ".sock");
+    runSocket("Loopback TCP", "");
+
+    return 0;
+}
@@ -0,0 +1,66 @@
+/**
+ * @file bench_utf8.cpp
+ * @brief Benchmark do validador UTF-8 (GB/s) por implementação.
+ */
+
+#include "../src/internal/utf8_validator.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+using namespace gg;
+
+namespace {
+
+// Payload típico de market data (ASCII puro)
+std::string makeAsciiPayload(size_t size) {
+    const std::string msg =
+        R"({"e":"depthUpdate","E":1700000000123,"s":"BTCUSDT","U":157,"u":160,)"
+        R"("b":[["67234.50","0.00012"],["67234.40","1.25000"]],"a":[["67234.60","0.50000"]]})";
+    std::string out;
+    while (out.size() < size) out += msg;
+    out.resize(size);
+    return out;
+}
+
+// Texto com ~25% de caracteres multibyte
+std::string makeMixedPayload(size_t size) {
+    const std::string chunk = "preço ação 日本語 🚀 ok ";
+    std::string out;
+    while (out.size() + chunk.size() < size) out += chunk;
+    return out;
+}
+
+template<typename Fn>
+void run(const char* name, Fn fn, const std::string& data, int iterations) {
+    volatile bool sink = true;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        sink = sink & fn(data.data(), data.size());
+    }
+    auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    double gbps = (static_cast<double>(data.size()) * iterations) / elapsed / 1e9;
+    std::printf("  %-8s %8zu bytes  %7.2f GB/s  %s\n", name, data.size(), gbps, sink ? "" : "(inválido)");
+}
+
+void runAll(const char* label, const std::string& data, int iterations) {
+    std::printf("%s:\n", label);
+    run("scalar", internal::utf8ValidateScalar, data, iterations);
+#ifdef GG_WS_UTF8_X86
+    if (__builtin_cpu_supports("ssse3")) run("ssse3", internal::utf8ValidateSse, data, iterations);
+    if (__builtin_cpu_supports("avx2")) run("avx2", internal::utf8ValidateAvx2, data, iterations);
+#endif
+}
+
+} // anonymous namespace
+
+int main() {
+    std::printf("=== Benchmark UTF-8 ===\n\n");
+
+    runAll("Mensagem pequena ASCII", makeAsciiPayload(200), 2000000);
+    runAll("Snapshot ASCII", makeAsciiPayload(64 * 1024), 10000);
+    runAll("Texto multibyte", makeMixedPayload(64 * 1024), 10000);
+
+    return 0;
+}
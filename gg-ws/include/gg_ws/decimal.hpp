@@ -0,0 +1,80 @@
+#pragma once
+
+/**
+ * @file decimal.hpp
+ * @brief Decimal de ponto fixo para preços e quantidades (sem ponto flutuante).
+ *
+ * Decimal guarda mantissa × 10^-scale. "67234.50" vira {6723450, 2}: a
+ * conversão para ticks inteiros é exata e a serialização devolve o mesmo
+ * texto. Json::getDecimal() lê números e strings numéricas assim.
+ *
+ * Exemplo:
+ * @code
+ *   gg::Decimal price = msg["p"].getDecimal();       // "67234.50"
+ *   auto ticks = price.toTicks(2);                    // 6723450
+ *   if (!ticks) return;                               // Mais casas que o tick
+ * @endcode
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace gg {
+
+struct Decimal {
+    static constexpr uint8_t MaxScale = 18;
+
+    // Tamanho máximo de toChars(): sinal, 19 dígitos, ponto e "0." (ou
+    // "e-255" acima de MaxScale)
+    static constexpr size_t MaxChars = 25;
+
+    int64_t mantissa = 0;
+    uint8_t scale = 0;          // Casas decimais (0..MaxScale)
+
+    constexpr Decimal() noexcept = default;
+    constexpr Decimal(int64_t mantissa, uint8_t scale) noexcept : mantissa(mantissa), scale(scale) {}
+
+    /**
+     * @brief Lê um texto com a gramática de número JSON ("67234.50", "-1.5e-3").
+     * @return nullopt se inválido ou se não cabe em int64 com até MaxScale casas
+     */
+    [[nodiscard]] static std::optional<Decimal> parse(std::string_view text) noexcept;
+
+    /**
+     * @brief Decimal com os dígitos da menor representação que volta ao mesmo double.
+     * @return nullopt para NaN, infinito ou valor fora da faixa
+     */
+    [[nodiscard]] static std::optional<Decimal> fromDouble(double value) noexcept;
+
+    /**
+     * @brief double mais próximo (arredondamento correto).
+     */
+    [[nodiscard]] double toDouble() const noexcept;
+
+    /**
+     * @brief Valor em unidades de 10^-tickScale (ex: toTicks(2) de 67234.5 = 6723450).
+     * @return nullopt se perderia casas diferentes de zero ou estouraria int64
+     */
+    [[nodiscard]] std::optional<int64_t> toTicks(uint8_t tickScale) const noexcept;
+
+    /**
+     * @brief Escreve o texto ("67234.50", mantendo as casas) sem terminador.
+     *
+     * Escala acima de MaxScale (só construída à mão) sai com expoente,
+     * "1e-60", para caber em MaxChars.
+     * @param out Pelo menos MaxChars bytes
+     * @return Ponteiro após o último caractere
+     */
+    char* toChars(char* out) const noexcept;
+
+    [[nodiscard]] std::string toString() const;
+
+    // Igualdade numérica: {50, 1} == {5, 0}
+    [[nodiscard]] bool operator==(const Decimal& other) const noexcept;
+    [[nodiscard]] bool operator!=(const Decimal& other) const noexcept { return !(*this == other); }
+};
+
+} // namespace gg
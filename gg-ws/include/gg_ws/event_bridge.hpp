@@ -0,0 +1,289 @@
+#pragma once
+
+/**
+ * @file event_bridge.hpp
+ * @brief Publica mensagens recebidas num gg::EventBus (GG_Observer) sem cópias por assinante.
+ *
+ * Cada mensagem é copiada uma única vez, do buffer de recepção para um bloco
+ * de um pool, e vira um MessageHandle: copiar o handle só incrementa um
+ * contador atômico. O EventBus copia o evento para a fila de cada thread
+ * assinante; com MessageHandle, todas recebem o mesmo buffer (e o mesmo Json,
+ * se pré-parseado). O bloco volta ao pool quando o último handle morre, em
+ * qualquer thread.
+ *
+ * Exemplo:
+ * @code
+ *   gg::EventBus bus;
+ *   gg::EventBusBridge bridge(bus, {.parseJson = true});
+ *   bridge.attach(ws);      // Ocupa ws.onMessageBatch()
+ *
+ *   // Thread da estratégia
+ *   auto sub = bus.subscribe<gg::MessageHandle>([](const gg::MessageHandle& msg) {
+ *       if (const gg::Json* json = msg.json()) onTick(*json);
+ *   });
+ *   while (running) bus.poll();
+ * @endcode
+ *
+ * @note O bridge é um template sobre o bus (qualquer tipo com emit(const T&)):
+ *       gg_ws não depende do GG_Observer.
+ */
+
+#include "json.hpp"
+#include "types.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace gg {
+
+namespace bridge_detail {
+
+struct PoolCore;
+
+struct Block {
+    std::atomic<uint32_t> refs{0};
+    PoolCore* core = nullptr;
+    std::string payload;            // Capacidade preservada entre usos
+    std::optional<Json> json;
+    bool binary = false;
+};
+
+// Estado compartilhado entre o MessagePool e os blocos em uso: vive até o
+// pool e o último bloco emprestado morrerem
+struct PoolCore {
+    std::mutex mutex;
+    std::vector<Block*> idle;
+    size_t maxIdle;
+    std::atomic<size_t> refs{1};    // Dono + blocos emprestados
+
+    explicit PoolCore(size_t maxIdleBlocks) : maxIdle(maxIdleBlocks) {}
+
+    ~PoolCore() {
+        for (Block* block : idle) delete block;
+    }
+
+    void release() {
+        if (refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            delete this;
+        }
+    }
+
+    // Último handle morreu: limpa fora da thread de I/O e devolve
+    void recycle(Block* block) {
+        block->json.reset();
+        block->payload.clear();
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (idle.size() < maxIdle) {
+                idle.push_back(block);
+                block = nullptr;
+            }
+        }
+        delete block;
+        release();
+    }
+};
+
+} // namespace bridge_detail
+
+/**
+ * @brief Mensagem num bloco do pool, compartilhada por contagem de referências.
+ */
+class MessageHandle {
+public:
+    MessageHandle() noexcept = default;
+
+    ~MessageHandle() {
+        reset();
+    }
+
+    MessageHandle(const MessageHandle& other) noexcept : block_(other.block_) {
+        if (block_) block_->refs.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    MessageHandle& operator=(const MessageHandle& other) noexcept {
+        if (this != &other) {
+            MessageHandle copy(other);
+            std::swap(block_, copy.block_);
+        }
+        return *this;
+    }
+
+    MessageHandle(MessageHandle&& other) noexcept : block_(other.block_) {
+        other.block_ = nullptr;
+    }
+
+    MessageHandle& operator=(MessageHandle&& other) noexcept {
+        if (this != &other) {
+            reset();
+            block_ = other.block_;
+            other.block_ = nullptr;
+        }
+        return *this;
+    }
+
+    [[nodiscard]] std::string_view data() const noexcept {
+        return block_ ? std::string_view(block_->payload) : std::string_view{};
+    }
+
+    [[nodiscard]] bool binary() const noexcept { return block_ && block_->binary; }
+
+    /**
+     * @brief Json pré-parseado (BridgeOptions::parseJson).
+     * @return nullptr se não parseado, binário ou JSON inválido
+     */
+    [[nodiscard]] const Json* json() const noexcept {
+        return block_ && block_->json ? &*block_->json : nullptr;
+    }
+
+    /**
+     * @brief Handles vivos apontando para o mesmo bloco.
+     */
+    [[nodiscard]] size_t useCount() const noexcept {
+        return block_ ? block_->refs.load(std::memory_order_relaxed) : 0;
+    }
+
+    explicit operator bool() const noexcept { return block_ != nullptr; }
+
+    void reset() noexcept {
+        if (block_ && block_->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            block_->core->recycle(block_);
+        }
+        block_ = nullptr;
+    }
+
+private:
+    friend class MessagePool;
+
+    explicit MessageHandle(bridge_detail::Block* block) noexcept : block_(block) {}
+
+    bridge_detail::Block* block_ = nullptr;
+};
+
+/**
+ * @brief Pool de blocos para MessageHandle.
+ *
+ * acquire() é feito pelo produtor (thread de I/O); a devolução acontece na
+ * thread que soltar o último handle. Handles podem sobreviver ao pool.
+ */
+class MessagePool {
+public:
+    /**
+     * @param preallocate Blocos criados de início
+     * @param maxIdle Blocos ociosos retidos (o excedente é liberado)
+     */
+    explicit MessagePool(size_t preallocate = 256, size_t maxIdle = 4096)
+        : core_(new bridge_detail::PoolCore(maxIdle)) {
+        core_->idle.reserve(preallocate);
+        for (size_t i = 0; i < preallocate; ++i) {
+            core_->idle.push_back(new bridge_detail::Block());
+        }
+    }
+
+    ~MessagePool() {
+        core_->release();
+    }
+
+    MessagePool(const MessagePool&) = delete;
+    MessagePool& operator=(const MessagePool&) = delete;
+
+    /**
+     * @brief Copia a mensagem para um bloco do pool.
+     * @param parseJson Parseia uma vez aqui; assinantes compartilham o resultado
+     */
+    MessageHandle acquire(std::string_view data, bool binary, bool parseJson = false) {
+        bridge_detail::Block* block = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(core_->mutex);
+            if (!core_->idle.empty()) {
+                block = core_->idle.back();
+                core_->idle.pop_back();
+            }
+        }
+        if (!block) {
+            block = new bridge_detail::Block();
+        }
+
+        block->core = core_;
+        block->payload.assign(data.data(), data.size());
+        block->binary = binary;
+        if (parseJson && !binary) {
+            block->json = Json::parse(block->payload);
+        }
+        block->refs.store(1, std::memory_order_relaxed);
+        core_->refs.fetch_add(1, std::memory_order_relaxed);
+        return MessageHandle(block);
+    }
+
+    /**
+     * @brief Blocos ociosos prontos para reuso.
+     */
+    [[nodiscard]] size_t idle() const {
+        std::lock_guard<std::mutex> lock(core_->mutex);
+        return core_->idle.size();
+    }
+
+private:
+    bridge_detail::PoolCore* core_;
+};
+
+struct BridgeOptions {
+    bool parseJson{false};          // Json parseado uma vez, na thread de I/O
+    size_t preallocate{256};        // Blocos iniciais do pool
+    size_t maxIdle{4096};           // Blocos ociosos retidos
+};
+
+/**
+ * @brief Publica cada mensagem recebida como MessageHandle num bus.
+ * @tparam Bus Tipo com emit(const MessageHandle&) (ex: gg::EventBus)
+ */
+template<typename Bus>
+class EventBusBridge {
+public:
+    explicit EventBusBridge(Bus& bus, BridgeOptions options = {})
+        : bus_(bus), options_(options), pool_(options.preallocate, options.maxIdle) {}
+
+    EventBusBridge(const EventBusBridge&) = delete;
+    EventBusBridge& operator=(const EventBusBridge&) = delete;
+
+    /**
+     * @brief Liga o bridge ao cliente via onMessageBatch().
+     * @note O bridge precisa viver enquanto o cliente recebe
+     */
+    template<typename Client>
+    void attach(Client& ws) {
+        ws.onMessageBatch([this](const MessageBatch& batch) { publish(batch); });
+    }
+
+    void publish(const MessageBatch& batch) {
+        for (const MessageView& message : batch) {
+            publish(message.data, message.binary);
+        }
+    }
+
+    void publish(std::string_view data, bool binary = false) {
+        bus_.emit(pool_.acquire(data, binary, options_.parseJson));
+        published_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] uint64_t published() const noexcept {
+        return published_.load(std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] MessagePool& pool() noexcept { return pool_; }
+
+private:
+    Bus& bus_;
+    BridgeOptions options_;
+    MessagePool pool_;
+    std::atomic<uint64_t> published_{0};
+};
+
+} // namespace gg
@@ -6,7 +6,17 @@
  * 
  * Inclui automaticamente todos os componentes:
  * - types.hpp: Tipos, enums e configurações
+ * - decimal.hpp: Decimal de ponto fixo (preços e quantidades)
  * - json.hpp: Parser JSON minimalista
+ * - json_object.hpp: Json::Object (ordem de inserção, chaves internadas)
+ * - json_events.hpp: Parse por eventos (Json::parseEvents)
+ * - json_writer.hpp: Escrita de JSON em streaming (JsonWriter)
+ * - json_document.hpp: Documento JSON em arena (JsonDocument)
+ * - json_query.hpp: Extração de campos por caminho (JsonQuery)
+ * - json_bind.hpp: Decode/encode de structs (GG_JSON_BIND)
+ * - policies.hpp: Políticas de compilação (BasicWebSocket)
+ * - router.hpp: Roteamento de mensagens por conteúdo (MessageRouter)
+ * - memory_transport.hpp: Transporte em memória (MemoryPipe)
  * - websocket.hpp: Cliente WebSocket
  * 
  * Exemplo de uso:
@@ -47,5 +57,13 @@
  */
 
 #include "types.hpp"
+#include "decimal.hpp"
 #include "json.hpp"
+#include "json_writer.hpp"
+#include "json_document.hpp"
+#include "json_query.hpp"
+#include "json_bind.hpp"
+#include "policies.hpp"
+#include "router.hpp"
+#include "memory_transport.hpp"
 #include "websocket.hpp"
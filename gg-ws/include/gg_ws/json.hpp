@@ -1,5 +1,8 @@
 #pragma once
 
+#include "decimal.hpp"
+#include "json_object.hpp"
+
 #include <cstddef>
 #include <cstdint>
 #include <initializer_list>
@@ -7,7 +10,7 @@
 #include <optional>
 #include <string>
 #include <string_view>
-#include <unordered_map>
+#include <type_traits>
 #include <variant>
 #include <vector>
 
@@ -43,14 +46,17 @@ public:
     };
 
     using Array = std::vector<Json>;
-    using Object = std::unordered_map<std::string, Json>;
+    using Object = JsonObject;        // Ordem de inserção (json_object.hpp)
 
 private:
     Type type_ = Type::Null;
     std::variant<
         std::monostate,     // Null
         bool,               // Bool
-        double,             // Number
+        double,             // Number (com fração/expoente ou fora de 64 bits)
+        int64_t,            // Number inteiro exato
+        uint64_t,           // Number inteiro exato acima de INT64_MAX
+        Decimal,            // Number com fração, exato como no texto
         std::string,        // String
         Array,              // Array
         Object              // Object
@@ -66,9 +72,15 @@ public:
     Json() noexcept = default;
     Json(std::nullptr_t) noexcept : type_(Type::Null) {}
     Json(bool value) noexcept : type_(Type::Bool), value_(value) {}
-    Json(int value) noexcept : type_(Type::Number), value_(static_cast<double>(value)) {}
-    Json(int64_t value) noexcept : type_(Type::Number), value_(static_cast<double>(value)) {}
+    Json(int value) noexcept : type_(Type::Number), value_(static_cast<int64_t>(value)) {}
+    Json(int64_t value) noexcept : type_(Type::Number), value_(value) {}
+    Json(uint64_t value) noexcept : type_(Type::Number) {
+        // Forma canônica: uint64 só acima de INT64_MAX
+        if (value <= static_cast<uint64_t>(INT64_MAX)) value_ = static_cast<int64_t>(value);
+        else value_ = value;
+    }
     Json(double value) noexcept : type_(Type::Number), value_(value) {}
+    Json(Decimal value) noexcept : type_(Type::Number), value_(value) {}
     Json(const char* value) : type_(Type::String), value_(std::string(value)) {}
     Json(std::string value) noexcept : type_(Type::String), value_(std::move(value)) {}
     Json(std::string_view value) : type_(Type::String), value_(std::string(value)) {}
@@ -96,6 +108,31 @@ public:
      */
     [[nodiscard]] static bool isValid(std::string_view input) noexcept;
 
+    /**
+     * @brief Resultado de parseEvents (true se Ok).
+     */
+    struct EventResult {
+        enum class Status : uint8_t {
+            Ok,
+            Invalid,        // JSON inválido
+            Stopped         // Um callback retornou false
+        };
+        Status status = Status::Ok;
+        size_t offset = 0;  // Byte do token em que o parse parou (Ok: tamanho da entrada)
+
+        explicit operator bool() const noexcept { return status == Status::Ok; }
+    };
+
+    /**
+     * @brief Parse por eventos (SAX): chama os callbacks do handler, sem DOM e sem alocar.
+     *
+     * Callbacks e semântica em json_events.hpp (incluído por este header).
+     * @param handler Tipo com onKey/onString/onNumber/onStartObject/...; os
+     *        ausentes são ignorados (resolvido em compilação)
+     */
+    template<typename Handler>
+    [[nodiscard]] static EventResult parseEvents(std::string_view input, Handler&& handler) noexcept;
+
     // ============================================
     // Serialização
     // ============================================
@@ -106,6 +143,17 @@ public:
      * @return String JSON
      */
     [[nodiscard]] std::string stringify(bool pretty = false) const;
+
+    /**
+     * @brief Acrescenta o JSON a out (string reutilizável: sem alocar em regime).
+     */
+    void stringify(std::string& out, bool pretty = false) const;
+
+    /**
+     * @brief Escreve o JSON em buffer[0, capacity), sem alocar.
+     * @return Bytes escritos, ou 0 se não coube
+     */
+    [[nodiscard]] size_t stringify(char* buffer, size_t capacity, bool pretty = false) const noexcept;
     
     /**
      * @brief Converte o JSON para string (alias para stringify).
@@ -128,7 +176,35 @@ public:
     // ============================================
     [[nodiscard]] bool getBool(bool defaultValue = false) const noexcept;
     [[nodiscard]] double getNumber(double defaultValue = 0.0) const noexcept;
+
+    /**
+     * @brief Inteiro exato (ids, timestamps em ns): sem passar por double.
+     * @return Números com fração são truncados; fora da faixa retornam defaultValue
+     */
     [[nodiscard]] int64_t getInt(int64_t defaultValue = 0) const noexcept;
+    [[nodiscard]] uint64_t getUInt(uint64_t defaultValue = 0) const noexcept;
+
+    /**
+     * @brief Preço/quantidade exato, de um Number ou de uma string numérica ("67234.50").
+     *
+     * Números com fração lidos pelo parse() já são Decimal (sem passar por
+     * double); doubles construídos usam a menor representação que volta ao
+     * mesmo valor.
+     * @return defaultValue se não é número, a string não é numérica ou não cabe
+     */
+    [[nodiscard]] Decimal getDecimal(Decimal defaultValue = {}) const noexcept;
+
+    /**
+     * @brief true se o número foi lido/construído como inteiro exato.
+     */
+    [[nodiscard]] bool isInteger() const noexcept {
+        return std::holds_alternative<int64_t>(value_) || std::holds_alternative<uint64_t>(value_);
+    }
+
+    /**
+     * @brief true se o número é um Decimal (lido com fração ou construído com Decimal).
+     */
+    [[nodiscard]] bool isDecimal() const noexcept { return std::holds_alternative<Decimal>(value_); }
     [[nodiscard]] std::string_view getString(std::string_view defaultValue = "") const noexcept;
     
     /**
@@ -161,6 +237,29 @@ public:
     // ============================================
     // Acesso a Objects
     // ============================================
+
+    /**
+     * @brief Chave com o hash já calculado, para campos lidos a cada mensagem.
+     *
+     * @code
+     *   static constexpr gg::Json::Key Price{"p"};
+     *   auto price = msg[Price].getDecimal();      // Sem hash e sem alocação
+     * @endcode
+     *
+     * @note Guarda uma view: o texto deve viver mais que a Key (literais vivem).
+     */
+    class Key {
+    public:
+        constexpr explicit Key(std::string_view text) noexcept
+            : text_(text), hash_(detail::objectKeyHash(text)) {}
+
+        [[nodiscard]] constexpr std::string_view text() const noexcept { return text_; }
+        [[nodiscard]] constexpr uint64_t hash() const noexcept { return hash_; }
+
+    private:
+        std::string_view text_;
+        uint64_t hash_;
+    };
     
     /**
      * @brief Acesso por chave (apenas para objects).
@@ -169,16 +268,20 @@ public:
      */
     [[nodiscard]] const Json& operator[](std::string_view key) const noexcept;
     [[nodiscard]] Json& operator[](std::string_view key);
+    [[nodiscard]] const Json& operator[](Key key) const noexcept;
+    [[nodiscard]] Json& operator[](Key key);
     
     /**
      * @brief Acesso por chave (alias para operator[]).
      */
     [[nodiscard]] const Json& get(std::string_view key) const noexcept;
+    [[nodiscard]] const Json& get(Key key) const noexcept;
     
     /**
      * @brief Verifica se uma chave existe no object.
      */
     [[nodiscard]] bool contains(std::string_view key) const noexcept;
+    [[nodiscard]] bool contains(Key key) const noexcept;
     
     /**
      * @brief Retorna todas as chaves do object.
@@ -204,18 +307,14 @@ public:
     }
     
     /**
-     * @brief Itera sobre pares chave-valor de object.
-     * @param fn Função a ser chamada para cada par (key, value)
+     * @brief Itera sobre pares chave-valor de object, na ordem de inserção.
+     * @param fn Função a ser chamada para cada par (std::string_view key, const Json& value)
+     *
+     * Funções da assinatura antiga (const std::string& key) continuam
+     * aceitas: recebem uma cópia da chave, válida só durante a chamada.
      */
     template<typename Fn>
-    void forEachPair(Fn&& fn) const {
-        if (isObject()) {
-            const auto& obj = std::get<Object>(value_);
-            for (const auto& [key, value] : obj) {
-                fn(key, value);
-            }
-        }
-    }
+    void forEachPair(Fn&& fn) const;
 
     // ============================================
     // Modificação
@@ -254,4 +353,75 @@ public:
     [[nodiscard]] static Json object() { return Json(Object{}); }
 };
 
+/**
+ * @brief Membro de um Json::Object.
+ */
+class JsonObject::Member {
+public:
+    Member(detail::KeyHandle key, Json value) noexcept : value(std::move(value)), key_(std::move(key)) {}
+
+    [[nodiscard]] std::string_view key() const noexcept { return key_.view(); }
+
+    Json value;
+
+private:
+    friend class JsonObject;
+    detail::KeyHandle key_;
+};
+
+template<typename M>
+M& JsonObject::Iterator<M>::operator*() const noexcept {
+    return chunk_->members()[position_];
+}
+
+// Busca linear inline: é o caminho de Json::Key em objects pequenos
+inline const Json* JsonObject::find(std::string_view key, uint64_t hash) const noexcept {
+    if (index_) return findIndexed(key, hash);
+    for (const Chunk* chunk = first_; chunk; chunk = chunk->next) {
+        const Member* members = chunk->members();
+        for (uint32_t i = 0; i < chunk->size; ++i) {
+            if (members[i].key_.matches(key, hash)) return &members[i].value;
+        }
+    }
+    return nullptr;
+}
+
+inline Json* JsonObject::find(std::string_view key, uint64_t hash) noexcept {
+    return const_cast<Json*>(static_cast<const JsonObject&>(*this).find(key, hash));
+}
+
+inline const Json& Json::operator[](Key key) const noexcept {
+    const Object* object = std::get_if<Object>(&value_);
+    const Json* value = object ? object->find(key.text(), key.hash()) : nullptr;
+    return value ? *value : nullJson();
+}
+
+inline const Json& Json::get(Key key) const noexcept {
+    return (*this)[key];
+}
+
+inline bool Json::contains(Key key) const noexcept {
+    const Object* object = std::get_if<Object>(&value_);
+    return object && object->find(key.text(), key.hash()) != nullptr;
+}
+
+template<typename Fn>
+void Json::forEachPair(Fn&& fn) const {
+    if (!isObject()) return;
+    if constexpr (std::is_invocable_v<Fn&, std::string_view, const Json&>) {
+        for (const auto& member : std::get<Object>(value_)) {
+            fn(member.key(), member.value);
+        }
+    } else {
+        std::string key;
+        for (const auto& member : std::get<Object>(value_)) {
+            key.assign(member.key());
+            fn(key, member.value);
+        }
+    }
+}
+
 } // namespace gg
+
+// Implementação de Json::parseEvents (template)
+#include "json_events.hpp"
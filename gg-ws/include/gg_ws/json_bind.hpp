@@ -0,0 +1,411 @@
+#pragma once
+
+/**
+ * @file json_bind.hpp
+ * @brief Decode/encode de structs direto de/para JSON, sem DOM (GG_JSON_BIND).
+ *
+ * GG_JSON_BIND(Tipo, campos...) declara os membros que viram chaves JSON.
+ * decodeJson() lê os bytes direto para a struct pelo índice estrutural de
+ * Json::parse: cada chave é achada com um hash perfeito calculado em
+ * compilação e cada membro é convertido pelo seu tipo, sem nó
+ * intermediário. encodeJson() escreve a struct com JsonWriter, na ordem
+ * dos campos.
+ *
+ * Exemplo:
+ * @code
+ *   struct Trade {
+ *       gg::Decimal price;
+ *       gg::Decimal qty;
+ *       int64_t ts = 0;
+ *       std::string_view side;     // View da entrada
+ *   };
+ *   GG_JSON_BIND(Trade, price, qty, ts, side)
+ *
+ *   Trade trade;
+ *   if (gg::decodeJson(msg, trade)) { ... }
+ *   std::string out = gg::encodeJson(trade);
+ * @endcode
+ *
+ * Tipos de membro: bool, inteiros, double/float, Decimal, std::string,
+ * std::string_view, std::optional<T>, std::vector<T> e structs com
+ * GG_JSON_BIND. Números também são aceitos entre aspas ("67234.50"), como
+ * os feeds enviam preços. Inteiros exigem valor inteiro que caiba no tipo.
+ *
+ * @note GG_JSON_BIND vai no mesmo namespace do tipo (achado por ADL).
+ *       Chaves desconhecidas são validadas e puladas; membros sem chave na
+ *       mensagem ficam como estavam. std::string_view aponta para a
+ *       entrada e não aceita strings com escape. Só std::string e
+ *       std::vector alocam.
+ */
+
+#include "json.hpp"
+#include "json_writer.hpp"
+
+#include <array>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// ============================================
+// Macro de Binding
+// ============================================
+
+/**
+ * @brief Declara os membros de Type serializados como JSON (até 32, chave = nome do membro).
+ */
+#define GG_JSON_BIND(Type, ...)                                                          \
+    [[maybe_unused]] constexpr auto ggJsonFields(const Type*) noexcept {                 \
+        return std::make_tuple(GG_JSON_DETAIL_FOR_EACH(GG_JSON_DETAIL_FIELD, Type, __VA_ARGS__)); \
+    }
+
+#define GG_JSON_DETAIL_FIELD(Type, member) \
+    ::gg::detail::FieldBinding<Type, decltype(Type::member)>{#member, &Type::member}
+
+// Aplica m(T, campo) a cada campo, separado por vírgula
+#define GG_JSON_DETAIL_EXPAND(x) x
+#define GG_JSON_DETAIL_FE_1(m, T, a) m(T, a)
+#define GG_JSON_DETAIL_FE_2(m, T, a, ...) m(T, a), GG_JSON_DETAIL_EXPAND(GG_JSON_DETAIL_FE_1(m, T, __VA_ARGS__))
+#define GG_JSON_DETAIL_FE_3(m, T, a, ...) m(T, a), GG_JSON_DETAIL_EXPAND(GG_JSON_DETAIL_FE_2(m, T, __VA_ARGS__))
+#define GG_JSON_DETAIL_FE_4(m, T, a, ...) m(T, a), GG_JSON_DETAIL_EXPAND(GG_JSON_DETAIL_FE_3(m, T, __VA_ARGS__))
+#define GG_JSON_DETAIL_FE_5(m, T, a, ...) m(T, a), GG_JSON_DETAIL_EXPAND(GG_JSON_DETAIL_FE_4(m, T, __VA_ARGS__))
+#define GG_JSON_DETAIL_FE_6(m, T, a, ...) m(T, a), GG_JSON_DETAIL_EXPAND(GG_JSON_DETAIL_FE_5(m, T, __VA_ARGS__))
+#define GG_JSON_DETAIL_FE_7(m, T, a, ...) m(T, a), GG_JSON_DETAIL_EXPAND(GG_JSON_DETAIL_FE_6(m, T, __VA_ARGS__))
+#define GG_JSON_DETAIL_FE_8(m, T, a, ...) m(T, a), GG_JSON_DETAIL_EXPAND(GG_JSON_DETAIL_FE_7(m, T, __VA_ARGS__))
+#define GG_JSON_DETAIL_FE_9(m, T, a, ...) m(T, a), GG_JSON_DETAIL_EXPAND(GG_JSON_DETAIL_FE_8(m, T, __VA_ARGS__))
+#define GG_JSON_DETAIL_FE_10(m, T, a, ...) m(T, a), GG_JSON_DETAIL_EXPAND(GG_JSON_DETAIL_FE_9(m, T, __VA_ARGS__))
+#define GG_JSON_DETAIL_FE_11(m, T, a, ...) m(T, a), GG_JSON_DETAIL_EXPAND(GG_JSON_DETAIL_FE_10(m, T, __VA_ARGS__))
+#define GG_JSON_DETAIL_FE_12(m, T, a, ...) m(T, a), GG_JSON_DETAIL_EXPAND(GG_JSON_DETAIL_FE_11(m, T, __VA_ARGS__))
+#define GG_JSON_DETAIL_FE_13(m, T, a, ...) m(T, a), GG_JSON_DETAIL_EXPAND(GG_JSON_DETAIL_FE_12(m, T, __VA_ARGS__))
+#define GG_JSON_DETAIL_FE_14(m, T, a, ...) m(T, a), GG_JSON_DETAIL_EXPAND(GG_JSON_DETAIL_FE_13(m, T, __VA_ARGS__))
+#define GG_JSON_DETAIL_FE_15(m, T, a, ...) m(T, a), GG_JSON_DETAIL_EXPAND(GG_JSON_DETAIL_FE_14(m, T, __VA_ARGS__))
+#define GG_JSON_DETAIL_FE_16(m, T, a, ...) m(T, a), GG_JSON_DETAIL_EXPAND(GG_JSON_DETAIL_FE_15(m, T, __VA_ARGS__))
+#define GG_JSON_DETAIL_FE_17(m, T, a, ...) m(T, a), GG_JSON_DETAIL_EXPAND(GG_JSON_DETAIL_FE_16(m, T, __VA_ARGS__))
+#define GG_JSON_DETAIL_FE_18(m, T, a, ...) m(T, a), GG_JSON_DETAIL_EXPAND(GG_JSON_DETAIL_FE_17(m, T, __VA_ARGS__))
+#define GG_JSON_DETAIL_FE_19(m, T, a, ...) m(T, a), GG_JSON_DETAIL_EXPAND(GG_JSON_DETAIL_FE_18(m, T, __VA_ARGS__))
+#define GG_JSON_DETAIL_FE_20(m, T, a, ...) m(T, a), GG_JSON_DETAIL_EXPAND(GG_JSON_DETAIL_FE_19(m, T, __VA_ARGS__))
+#define GG_JSON_DETAIL_FE_21(m, T, a, ...) m(T, a), GG_JSON_DETAIL_EXPAND(GG_JSON_DETAIL_FE_20(m, T, __VA_ARGS__))
+#define GG_JSON_DETAIL_FE_22(m, T, a, ...) m(T, a), GG_JSON_DETAIL_EXPAND(GG_JSON_DETAIL_FE_21(m, T, __VA_ARGS__))
+#define GG_JSON_DETAIL_FE_23(m, T, a, ...) m(T, a), GG_JSON_DETAIL_EXPAND(GG_JSON_DETAIL_FE_22(m, T, __VA_ARGS__))
+#define GG_JSON_DETAIL_FE_24(m, T, a, ...) m(T, a), GG_JSON_DETAIL_EXPAND(GG_JSON_DETAIL_FE_23(m, T, __VA_ARGS__))
+#define GG_JSON_DETAIL_FE_25(m, T, a, ...) m(T, a), GG_JSON_DETAIL_EXPAND(GG_JSON_DETAIL_FE_24(m, T, __VA_ARGS__))
+#define GG_JSON_DETAIL_FE_26(m, T, a, ...) m(T, a), GG_JSON_DETAIL_EXPAND(GG_JSON_DETAIL_FE_25(m, T, __VA_ARGS__))
+#define GG_JSON_DETAIL_FE_27(m, T, a, ...) m(T, a), GG_JSON_DETAIL_EXPAND(GG_JSON_DETAIL_FE_26(m, T, __VA_ARGS__))
+#define GG_JSON_DETAIL_FE_28(m, T, a, ...) m(T, a), GG_JSON_DETAIL_EXPAND(GG_JSON_DETAIL_FE_27(m, T, __VA_ARGS__))
+#define GG_JSON_DETAIL_FE_29(m, T, a, ...) m(T, a), GG_JSON_DETAIL_EXPAND(GG_JSON_DETAIL_FE_28(m, T, __VA_ARGS__))
+#define GG_JSON_DETAIL_FE_30(m, T, a, ...) m(T, a), GG_JSON_DETAIL_EXPAND(GG_JSON_DETAIL_FE_29(m, T, __VA_ARGS__))
+#define GG_JSON_DETAIL_FE_31(m, T, a, ...) m(T, a), GG_JSON_DETAIL_EXPAND(GG_JSON_DETAIL_FE_30(m, T, __VA_ARGS__))
+#define GG_JSON_DETAIL_FE_32(m, T, a, ...) m(T, a), GG_JSON_DETAIL_EXPAND(GG_JSON_DETAIL_FE_31(m, T, __VA_ARGS__))
+#define GG_JSON_DETAIL_PICK(_1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, _17, _18, _19, _20, _21, _22, _23, _24, _25, _26, _27, _28, _29, _30, _31, _32, NAME, ...) NAME
+#define GG_JSON_DETAIL_FOR_EACH(m, T, ...) \
+    GG_JSON_DETAIL_EXPAND(GG_JSON_DETAIL_PICK(__VA_ARGS__, \
+        GG_JSON_DETAIL_FE_32, GG_JSON_DETAIL_FE_31, GG_JSON_DETAIL_FE_30, GG_JSON_DETAIL_FE_29, GG_JSON_DETAIL_FE_28, GG_JSON_DETAIL_FE_27, \
+        GG_JSON_DETAIL_FE_26, GG_JSON_DETAIL_FE_25, GG_JSON_DETAIL_FE_24, GG_JSON_DETAIL_FE_23, GG_JSON_DETAIL_FE_22, GG_JSON_DETAIL_FE_21, \
+        GG_JSON_DETAIL_FE_20, GG_JSON_DETAIL_FE_19, GG_JSON_DETAIL_FE_18, GG_JSON_DETAIL_FE_17, GG_JSON_DETAIL_FE_16, GG_JSON_DETAIL_FE_15, \
+        GG_JSON_DETAIL_FE_14, GG_JSON_DETAIL_FE_13, GG_JSON_DETAIL_FE_12, GG_JSON_DETAIL_FE_11, GG_JSON_DETAIL_FE_10, GG_JSON_DETAIL_FE_9, \
+        GG_JSON_DETAIL_FE_8, GG_JSON_DETAIL_FE_7, GG_JSON_DETAIL_FE_6, GG_JSON_DETAIL_FE_5, GG_JSON_DETAIL_FE_4, GG_JSON_DETAIL_FE_3, \
+        GG_JSON_DETAIL_FE_2, GG_JSON_DETAIL_FE_1)(m, T, __VA_ARGS__))
+
+namespace gg {
+
+namespace detail {
+
+// ============================================
+// Campos e hash perfeito das chaves
+// ============================================
+template<typename T, typename M>
+struct FieldBinding {
+    std::string_view name;
+    M T::* member;
+};
+
+// Chega por ADL na função declarada por GG_JSON_BIND
+template<typename T, typename = void>
+struct IsJsonBound : std::false_type {};
+template<typename T>
+struct IsJsonBound<T, std::void_t<decltype(ggJsonFields(static_cast<const T*>(nullptr)))>> : std::true_type {};
+
+template<typename T>
+struct IsOptional : std::false_type {};
+template<typename T>
+struct IsOptional<std::optional<T>> : std::true_type {};
+
+template<typename T>
+struct IsVector : std::false_type {};
+template<typename T, typename A>
+struct IsVector<std::vector<T, A>> : std::true_type {};
+
+template<typename T>
+inline constexpr bool AlwaysFalse = false;
+
+constexpr uint32_t keyHash(std::string_view key, uint32_t seed) noexcept {
+    uint32_t h = seed ^ (static_cast<uint32_t>(key.size()) * 0x9E3779B1u);
+    for (char c : key) h = (h ^ static_cast<uint8_t>(c)) * 0x01000193u;     // FNV-1a
+    return h ^ (h >> 15);
+}
+
+// Potência de 2 com folga de 4x: a busca da semente termina em poucas tentativas
+constexpr size_t keyTableSize(size_t count) noexcept {
+    size_t size = 4;
+    while (size < count * 4) size *= 2;
+    return size;
+}
+
+/**
+ * Hash perfeito das N chaves: a semente é procurada em compilação até
+ * cada chave cair num slot próprio. Na busca, um hash e uma comparação.
+ */
+template<size_t N>
+struct KeyTable {
+    static constexpr size_t Size = keyTableSize(N);
+    static constexpr uint8_t Empty = 0xFF;
+
+    std::array<std::string_view, N> names{};
+    std::array<uint8_t, Size> slots{};
+    uint32_t seed = 0;
+    bool perfect = false;
+
+    constexpr explicit KeyTable(const std::array<std::string_view, N>& keys) noexcept : names(keys) {
+        for (uint32_t candidate = 0; candidate < 100000 && !perfect; ++candidate) {
+            for (auto& slot : slots) slot = Empty;
+            perfect = true;
+            for (size_t i = 0; i < N && perfect; ++i) {
+                auto& slot = slots[keyHash(names[i], candidate) & (Size - 1)];
+                if (slot != Empty) perfect = false;
+                slot = static_cast<uint8_t>(i);
+            }
+            seed = candidate;
+        }
+    }
+
+    // Índice do campo ou -1
+    [[nodiscard]] constexpr int find(std::string_view key) const noexcept {
+        const uint8_t index = slots[keyHash(key, seed) & (Size - 1)];
+        return index != Empty && names[index] == key ? index : -1;
+    }
+};
+
+template<typename T>
+struct Binding;
+
+// ============================================
+// Decode
+// ============================================
+
+// Pula um valor inteiro, validando (chave desconhecida)
+inline bool skipValue(TokenReader& reader, int depth) noexcept {
+    struct Ignore {} ignore;
+    return EventParser<Ignore>(reader, ignore).value(depth);
+}
+
+template<typename M>
+bool readValue(TokenReader& reader, M& out, int depth) {
+    if constexpr (std::is_same_v<M, bool>) {
+        if (reader.peek() == 't') return out = true, reader.literal("true", 4);
+        if (reader.peek() == 'f') return out = false, reader.literal("false", 5);
+        return false;
+    } else if constexpr (std::is_arithmetic_v<M> || std::is_same_v<M, Decimal>) {
+        JsonNumber number;
+        if (!reader.numberOrString(number)) return false;
+        if constexpr (std::is_same_v<M, Decimal>) {
+            const Decimal missing(0, Decimal::MaxScale + 1);    // Escala impossível: não converteu
+            out = number.getDecimal(missing);
+            return out.scale <= Decimal::MaxScale;
+        } else if constexpr (std::is_floating_point_v<M>) {
+            out = static_cast<M>(number.getNumber());
+            return true;
+        } else {
+            if (!number.isInteger()) return false;
+            if (number.text()[0] == '-') {
+                // Negativo inteiro é sempre int64
+                const int64_t value = number.getInt();
+                if constexpr (std::is_unsigned_v<M>) return false;
+                if (value < static_cast<int64_t>(std::numeric_limits<M>::min())) return false;
+                out = static_cast<M>(value);
+            } else {
+                const uint64_t value = number.getUInt();
+                if (value > static_cast<uint64_t>(std::numeric_limits<M>::max())) return false;
+                out = static_cast<M>(value);
+            }
+            return true;
+        }
+    } else if constexpr (std::is_same_v<M, std::string> || std::is_same_v<M, std::string_view>) {
+        std::string_view text;
+        bool escaped;
+        if (reader.peek() != '"' || !reader.string(text, escaped)) return false;
+        if constexpr (std::is_same_v<M, std::string_view>) {
+            if (escaped) return false;      // Só a entrada vive além do decode
+        }
+        out = M(text);
+        return true;
+    } else if constexpr (IsOptional<M>::value) {
+        if (reader.peek() == 'n') {
+            out.reset();
+            return reader.literal("null", 4);
+        }
+        if (!out) out.emplace();
+        return readValue(reader, *out, depth);
+    } else if constexpr (IsVector<M>::value) {
+        if (depth >= TokenReader::MaxDepth || !reader.expect('[')) return false;
+        out.clear();
+        if (reader.expect(']')) return true;
+        for (;;) {
+            if (!readValue(reader, out.emplace_back(), depth + 1)) return false;
+            if (reader.expect(']')) return true;
+            if (!reader.expect(',')) return false;
+        }
+    } else if constexpr (IsJsonBound<M>::value) {
+        return depth < TokenReader::MaxDepth && Binding<M>::read(reader, out, depth + 1);
+    } else {
+        static_assert(AlwaysFalse<M>, "Tipo de membro sem conversão JSON (veja json_bind.hpp)");
+        return false;
+    }
+}
+
+// ============================================
+// Encode
+// ============================================
+template<typename M>
+void writeValue(JsonWriter& writer, const M& value) {
+    if constexpr (std::is_same_v<M, bool> || std::is_integral_v<M> || std::is_same_v<M, Decimal> ||
+                  std::is_same_v<M, std::string> || std::is_same_v<M, std::string_view>) {
+        writer.value(value);
+    } else if constexpr (std::is_floating_point_v<M>) {
+        writer.value(static_cast<double>(value));
+    } else if constexpr (IsOptional<M>::value) {
+        if (value) {
+            writeValue(writer, *value);
+        } else {
+            writer.null();
+        }
+    } else if constexpr (IsVector<M>::value) {
+        writer.beginArray();
+        for (const auto& item : value) writeValue(writer, item);
+        writer.endArray();
+    } else if constexpr (IsJsonBound<M>::value) {
+        Binding<M>::write(writer, value);
+    } else {
+        static_assert(AlwaysFalse<M>, "Tipo de membro sem conversão JSON (veja json_bind.hpp)");
+    }
+}
+
+// ============================================
+// Binding de uma struct
+// ============================================
+template<typename T>
+struct Binding {
+    static constexpr auto Fields = ggJsonFields(static_cast<const T*>(nullptr));
+    static constexpr size_t Count = std::tuple_size_v<decltype(Fields)>;
+
+    template<size_t... I>
+    static constexpr std::array<std::string_view, Count> names(std::index_sequence<I...>) noexcept {
+        return {std::get<I>(Fields).name...};
+    }
+    static constexpr KeyTable<Count> Keys{names(std::make_index_sequence<Count>())};
+    static_assert(Keys.perfect, "GG_JSON_BIND: chaves repetidas (ou sem hash perfeito)");
+
+    // Converte o membro I escolhido em tempo de execução (um ramo por campo)
+    template<size_t... I>
+    static bool readField(TokenReader& reader, T& out, int index, int depth, std::index_sequence<I...>) {
+        bool ok = false;
+        ((index == static_cast<int>(I) && (ok = readValue(reader, out.*(std::get<I>(Fields).member), depth), true)) ||
+         ...);
+        return ok;
+    }
+
+    static bool read(TokenReader& reader, T& out, int depth) {
+        if (!reader.expect('{')) return false;
+        if (reader.expect('}')) return true;
+        for (;;) {
+            // Chave deve ser string
+            std::string_view key;
+            if (reader.peek() != '"' || !reader.string(key) || !reader.expect(':')) return false;
+            const int index = Keys.find(key);
+            if (index < 0 ? !skipValue(reader, depth)
+                          : !readField(reader, out, index, depth, std::make_index_sequence<Count>())) {
+                return false;
+            }
+            if (reader.expect('}')) return true;
+            if (!reader.expect(',')) return false;
+        }
+    }
+
+    template<size_t... I>
+    static void writeFields(JsonWriter& writer, const T& value, std::index_sequence<I...>) {
+        (writeValue(writer.key(std::get<I>(Fields).name), value.*(std::get<I>(Fields).member)), ...);
+    }
+
+    static void write(JsonWriter& writer, const T& value) {
+        writer.beginObject();
+        writeFields(writer, value, std::make_index_sequence<Count>());
+        writer.endObject();
+    }
+};
+
+} // namespace detail
+
+// ============================================
+// API
+// ============================================
+
+/**
+ * @brief Lê input direto em out (struct com GG_JSON_BIND, vector, optional...).
+ * @return false se o JSON é inválido ou um valor não cabe no membro (out
+ *         pode ter ficado parcialmente preenchido); nunca lança exceção
+ */
+template<typename T>
+[[nodiscard]] bool decodeJson(std::string_view input, T& out) noexcept {
+    const uint32_t* begin;
+    const uint32_t* end;
+    if (!detail::indexEvents(input, begin, end)) return false;
+    detail::TokenReader reader(input, begin, end);
+    try {
+        return detail::readValue(reader, out, 0) && reader.done();
+    } catch (...) {
+        return false;       // Alocação de std::string/std::vector
+    }
+}
+
+/**
+ * @brief Acrescenta o JSON de value a out (campos na ordem de GG_JSON_BIND).
+ */
+template<typename T>
+void encodeJson(const T& value, std::string& out) {
+    JsonWriter writer(out);
+    detail::writeValue(writer, value);
+}
+
+template<typename T>
+[[nodiscard]] std::string encodeJson(const T& value) {
+    std::string out;
+    encodeJson(value, out);
+    return out;
+}
+
+/**
+ * @brief Escreve o JSON de value em buffer[0, capacity), sem alocar.
+ * @return Bytes escritos, ou 0 se não coube
+ */
+template<typename T>
+[[nodiscard]] size_t encodeJson(const T& value, char* buffer, size_t capacity) {
+    JsonWriter writer(buffer, capacity);
+    detail::writeValue(writer, value);
+    return writer.overflow() ? 0 : writer.size();
+}
+
+/**
+ * @brief Escreve value como valor do JsonWriter (dentro de um documento maior).
+ */
+template<typename T>
+void encodeJson(const T& value, JsonWriter& writer) {
+    detail::writeValue(writer, value);
+}
+
+} // namespace gg
@@ -0,0 +1,279 @@
+#pragma once
+
+/**
+ * @file json_document.hpp
+ * @brief Documento JSON em arena, reutilizável entre mensagens.
+ *
+ * JsonDocument faz o parse para nós compactos (16 bytes) alocados numa
+ * arena monotônica que pertence ao documento. Strings sem escape apontam
+ * para a entrada; as com escape são decodificadas na arena. Arrays e
+ * objects são vetores contíguos, na ordem do documento. parse() reaproveita
+ * a arena da mensagem anterior: em regime, não há alocação por mensagem.
+ *
+ * Exemplo:
+ * @code
+ *   gg::JsonDocument doc;
+ *   ws.onRawMessage([&doc](std::string_view msg) {
+ *       if (!doc.parse(msg)) return;
+ *       double price = doc["p"].getNumber();
+ *       std::string_view symbol = doc["s"].getString();
+ *   });
+ * @endcode
+ *
+ * @note Views (JsonValue, getString) valem até o próximo parse()/reset()
+ *       e, para strings sem escape, enquanto a entrada existir.
+ */
+
+#include "json.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+
+namespace gg {
+
+class JsonDocument;
+
+/**
+ * @brief Valor de um JsonDocument (view de um nó; cópia barata).
+ *
+ * Mesma semântica de acesso seguro de Json: tipo errado, índice fora do
+ * limite ou chave ausente retornam o default ou um valor nulo.
+ */
+class JsonValue {
+public:
+    struct Member;
+
+    // Representação de um Number (mesma regra de Json: inteiro exato quando cabe)
+    // Decimal: integer = mantissa, length = casas
+    enum class NumberKind : uint8_t { Double, Int, UInt, Decimal };
+
+    // Nó compacto: tipo, tamanho e payload (16 bytes)
+    struct Node {
+        Json::Type type;
+        NumberKind numberKind;          // Só para Number
+        uint32_t length;                // String: bytes; Array/Object: elementos
+        union {
+            bool boolean;
+            double number;
+            int64_t integer;
+            uint64_t uinteger;
+            const char* string;
+            const Node* elements;
+            const Member* members;
+        };
+    };
+
+    struct Member {
+        const char* key;
+        uint32_t keyLength;
+        Node value;
+    };
+
+    JsonValue() noexcept : node_(&nullNode()) {}
+    explicit JsonValue(const Node* node) noexcept : node_(node ? node : &nullNode()) {}
+
+    // ============================================
+    // Verificação de Tipo
+    // ============================================
+    [[nodiscard]] Json::Type type() const noexcept { return node_->type; }
+    [[nodiscard]] bool isNull() const noexcept { return node_->type == Json::Type::Null; }
+    [[nodiscard]] bool isBool() const noexcept { return node_->type == Json::Type::Bool; }
+    [[nodiscard]] bool isNumber() const noexcept { return node_->type == Json::Type::Number; }
+    [[nodiscard]] bool isString() const noexcept { return node_->type == Json::Type::String; }
+    [[nodiscard]] bool isArray() const noexcept { return node_->type == Json::Type::Array; }
+    [[nodiscard]] bool isObject() const noexcept { return node_->type == Json::Type::Object; }
+
+    // ============================================
+    // Getters Seguros (retornam default se tipo errado)
+    // ============================================
+    [[nodiscard]] bool getBool(bool defaultValue = false) const noexcept {
+        return isBool() ? node_->boolean : defaultValue;
+    }
+    [[nodiscard]] double getNumber(double defaultValue = 0.0) const noexcept {
+        if (!isNumber()) return defaultValue;
+        switch (node_->numberKind) {
+            case NumberKind::Int:  return static_cast<double>(node_->integer);
+            case NumberKind::UInt: return static_cast<double>(node_->uinteger);
+            case NumberKind::Decimal: return decimal().toDouble();
+            default:               return node_->number;
+        }
+    }
+
+    // Inteiros exatos; fração truncada; fora da faixa: defaultValue (como Json)
+    [[nodiscard]] int64_t getInt(int64_t defaultValue = 0) const noexcept {
+        if (!isNumber()) return defaultValue;
+        switch (node_->numberKind) {
+            case NumberKind::Int:  return node_->integer;
+            case NumberKind::UInt: return defaultValue;
+            case NumberKind::Decimal: return truncated();
+            default:
+                return node_->number >= -9223372036854775808.0 && node_->number < 9223372036854775808.0
+                    ? static_cast<int64_t>(node_->number) : defaultValue;
+        }
+    }
+    [[nodiscard]] uint64_t getUInt(uint64_t defaultValue = 0) const noexcept {
+        if (!isNumber()) return defaultValue;
+        switch (node_->numberKind) {
+            case NumberKind::Int:  return node_->integer >= 0 ? static_cast<uint64_t>(node_->integer) : defaultValue;
+            case NumberKind::UInt: return node_->uinteger;
+            case NumberKind::Decimal: {
+                const int64_t value = truncated();
+                return value >= 0 ? static_cast<uint64_t>(value) : defaultValue;
+            }
+            default:
+                return node_->number > -1.0 && node_->number < 18446744073709551616.0
+                    ? static_cast<uint64_t>(node_->number) : defaultValue;
+        }
+    }
+    [[nodiscard]] bool isInteger() const noexcept {
+        return isNumber() && (node_->numberKind == NumberKind::Int || node_->numberKind == NumberKind::UInt);
+    }
+    [[nodiscard]] bool isDecimal() const noexcept {
+        return isNumber() && node_->numberKind == NumberKind::Decimal;
+    }
+
+    // Exato para números com fração e strings numéricas (como Json::getDecimal)
+    [[nodiscard]] Decimal getDecimal(Decimal defaultValue = {}) const noexcept {
+        if (isString()) return Decimal::parse(getString()).value_or(defaultValue);
+        if (!isNumber()) return defaultValue;
+        switch (node_->numberKind) {
+            case NumberKind::Int:     return Decimal(node_->integer, 0);
+            case NumberKind::UInt:    return defaultValue;
+            case NumberKind::Decimal: return decimal();
+            default:                  return Decimal::fromDouble(node_->number).value_or(defaultValue);
+        }
+    }
+    [[nodiscard]] std::string_view getString(std::string_view defaultValue = "") const noexcept {
+        return isString() ? std::string_view(node_->string, node_->length) : defaultValue;
+    }
+
+    // ============================================
+    // Arrays e Objects
+    // ============================================
+    [[nodiscard]] size_t size() const noexcept {
+        return isArray() || isObject() ? node_->length : 0;
+    }
+    [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+
+    /**
+     * @brief Elemento do array (nulo se não for array ou fora do limite).
+     */
+    [[nodiscard]] JsonValue operator[](size_t index) const noexcept {
+        if (!isArray() || index >= node_->length) return JsonValue();
+        return JsonValue(&node_->elements[index]);
+    }
+
+    /**
+     * @brief Valor da chave (nulo se ausente). Chave repetida: vale a última.
+     * @note Busca linear: objects de mensagens têm poucas chaves
+     */
+    [[nodiscard]] JsonValue operator[](std::string_view key) const noexcept {
+        if (!isObject()) return JsonValue();
+        for (uint32_t i = node_->length; i-- > 0;) {
+            const Member& member = node_->members[i];
+            if (std::string_view(member.key, member.keyLength) == key) {
+                return JsonValue(&member.value);
+            }
+        }
+        return JsonValue();
+    }
+
+    [[nodiscard]] JsonValue get(std::string_view key) const noexcept { return (*this)[key]; }
+    [[nodiscard]] bool contains(std::string_view key) const noexcept {
+        return isObject() && !(*this)[key].isMissing();
+    }
+
+    /**
+     * @brief Itera sobre elementos de array, na ordem do documento.
+     */
+    template<typename Fn>
+    void forEach(Fn&& fn) const {
+        if (!isArray()) return;
+        for (uint32_t i = 0; i < node_->length; ++i) {
+            fn(JsonValue(&node_->elements[i]));
+        }
+    }
+
+    /**
+     * @brief Itera sobre pares (key, value) de object, na ordem do documento.
+     */
+    template<typename Fn>
+    void forEachPair(Fn&& fn) const {
+        if (!isObject()) return;
+        for (uint32_t i = 0; i < node_->length; ++i) {
+            const Member& member = node_->members[i];
+            fn(std::string_view(member.key, member.keyLength), JsonValue(&member.value));
+        }
+    }
+
+    /**
+     * @brief Cópia independente do documento (aloca).
+     */
+    [[nodiscard]] Json toJson() const;
+
+private:
+    const Node* node_;
+
+    static const Node& nullNode() noexcept {
+        static const Node null{Json::Type::Null, NumberKind::Double, 0, {false}};
+        return null;
+    }
+
+    // Chave ausente devolve o nó nulo compartilhado (diferente de um null do documento)
+    bool isMissing() const noexcept { return node_ == &nullNode(); }
+
+    Decimal decimal() const noexcept {
+        return Decimal(node_->integer, static_cast<uint8_t>(node_->length));
+    }
+
+    // Parte inteira de um Decimal (truncada para zero)
+    int64_t truncated() const noexcept {
+        int64_t value = node_->integer;
+        for (uint32_t i = 0; i < node_->length; ++i) value /= 10;
+        return value;
+    }
+};
+
+class JsonDocument {
+public:
+    /**
+     * @param initialArenaBytes Tamanho do primeiro bloco da arena
+     */
+    explicit JsonDocument(size_t initialArenaBytes = 4096);
+    ~JsonDocument();
+
+    JsonDocument(JsonDocument&&) noexcept;
+    JsonDocument& operator=(JsonDocument&&) noexcept;
+    JsonDocument(const JsonDocument&) = delete;
+    JsonDocument& operator=(const JsonDocument&) = delete;
+
+    /**
+     * @brief Faz parse de input, descartando o documento anterior.
+     * @param input Precisa continuar viva enquanto strings do documento forem lidas
+     * @return false em JSON inválido (root() fica nulo); nunca lança exceção
+     */
+    bool parse(std::string_view input) noexcept;
+
+    /**
+     * @brief Descarta o documento, mantendo a memória da arena.
+     */
+    void reset() noexcept;
+
+    [[nodiscard]] JsonValue root() const noexcept { return JsonValue(root_); }
+    [[nodiscard]] JsonValue operator[](std::string_view key) const noexcept { return root()[key]; }
+    [[nodiscard]] JsonValue operator[](size_t index) const noexcept { return root()[index]; }
+
+    /**
+     * @brief Bytes reservados pela arena (não cai entre mensagens).
+     */
+    [[nodiscard]] size_t arenaCapacity() const noexcept;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+    const JsonValue::Node* root_ = nullptr;
+};
+
+} // namespace gg
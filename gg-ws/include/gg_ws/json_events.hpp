@@ -0,0 +1,306 @@
+#pragma once
+
+/**
+ * @file json_events.hpp
+ * @brief Parse JSON por eventos (SAX): Json::parseEvents, sem DOM e sem alocação.
+ *
+ * O handler é qualquer tipo com os callbacks que interessam; os ausentes
+ * são ignorados e a escolha é feita em compilação (sem virtual, sem
+ * std::function). Strings, chaves e números chegam como views da entrada.
+ *
+ * Callbacks (todos opcionais; retornar false interrompe o parse):
+ *   onStartObject()  onKey(std::string_view)  onEndObject()
+ *   onStartArray()   onEndArray()
+ *   onString(std::string_view)  onNumber(const JsonNumber&)
+ *   onBool(bool)     onNull()
+ *
+ * Exemplo:
+ * @code
+ *   struct Levels {
+ *       int count = 0;
+ *       void onStartArray() noexcept { ++count; }
+ *   } levels;
+ *   if (!gg::Json::parseEvents(msg, levels)) return;
+ * @endcode
+ *
+ * @note O estágio 1 (índice estrutural) é o mesmo de Json::parse. Strings
+ *       com escape são decodificadas num buffer da thread: a view vale só
+ *       durante o callback. parseEvents não é reentrante na mesma thread
+ *       (não chame parseEvents de dentro de um callback).
+ */
+
+#include "json.hpp"
+
+#include <cstring>
+#include <type_traits>
+
+namespace gg {
+
+namespace detail {
+class TokenReader;
+
+// Estágio 1 de parseEvents: índice da thread (separado do de Json::parse)
+bool indexEvents(std::string_view input, const uint32_t*& begin, const uint32_t*& end) noexcept;
+
+// Decodifica os escapes de [begin, close) num buffer da thread
+bool unescapeEvent(const char* begin, const char* close, std::string_view& out) noexcept;
+} // namespace detail
+
+/**
+ * @brief Número visto por parseEvents: texto da entrada e valor já convertido.
+ *
+ * Mesma regra de representação e mesmos getters de Json (inteiro exato
+ * quando cabe, Decimal para frações sem expoente).
+ */
+class JsonNumber {
+public:
+    [[nodiscard]] std::string_view text() const noexcept { return text_; }
+    [[nodiscard]] bool isInteger() const noexcept { return kind_ == Kind::Int || kind_ == Kind::UInt; }
+    [[nodiscard]] bool isDecimal() const noexcept { return kind_ == Kind::Decimal; }
+
+    [[nodiscard]] double getNumber() const noexcept;
+    [[nodiscard]] int64_t getInt(int64_t defaultValue = 0) const noexcept;
+    [[nodiscard]] uint64_t getUInt(uint64_t defaultValue = 0) const noexcept;
+    [[nodiscard]] Decimal getDecimal(Decimal defaultValue = {}) const noexcept;
+
+private:
+    friend class detail::TokenReader;
+
+    enum class Kind : uint8_t { Double, Int, UInt, Decimal };
+
+    std::string_view text_;
+    Kind kind_ = Kind::Int;
+    uint8_t scale_ = 0;             // Só para Decimal
+    union {
+        double number_;
+        int64_t integer_ = 0;       // Int; mantissa do Decimal
+        uint64_t uinteger_;
+    };
+
+    // Lê o número em p; nullptr se inválido
+    static const char* parse(const char* p, const char* end, JsonNumber& out) noexcept;
+};
+
+namespace detail {
+
+/**
+ * Leitura dos tokens do índice estrutural: escalares, strings e números
+ * validados como em Json::parse. Base de parseEvents e do decode de
+ * structs (json_bind.hpp).
+ */
+class TokenReader {
+public:
+    // Mesmo limite de aninhamento de Json::parse
+    static constexpr int MaxDepth = 512;
+
+    TokenReader(std::string_view input, const uint32_t* begin, const uint32_t* end) noexcept
+        : base_(input.data()), size_(input.size()), pos_(begin), end_(end) {}
+
+    [[nodiscard]] bool done() const noexcept { return pos_ == end_; }
+
+    // Caractere do token atual ('\0' depois do último)
+    [[nodiscard]] char peek() const noexcept { return pos_ < end_ ? base_[*pos_] : '\0'; }
+
+    // Byte do token atual (tamanho da entrada depois do último)
+    [[nodiscard]] size_t offset() const noexcept { return pos_ < end_ ? *pos_ : size_; }
+    [[nodiscard]] size_t inputSize() const noexcept { return size_; }
+
+    void advance() noexcept { ++pos_; }
+
+    // Operador esperado no token atual (':' ',' ']' '}')
+    bool expect(char op) noexcept {
+        if (peek() != op) return false;
+        ++pos_;
+        return true;
+    }
+
+    bool literal(const char* word, size_t len) noexcept {
+        const char* p = base_ + *pos_;
+        if (static_cast<size_t>(base_ + size_ - p) < len || std::memcmp(p, word, len) != 0) return false;
+        return finishScalar(p + len);
+    }
+
+    /**
+     * Token atual na aspa de abertura; o índice já marca a de fechamento.
+     * Sem escape: view da entrada; com escape: view do buffer da thread.
+     */
+    bool string(std::string_view& out, bool& escaped) noexcept {
+        if (end_ - pos_ < 2) return false;
+        const char* begin = base_ + pos_[0] + 1;
+        const char* close = base_ + pos_[1];
+        pos_ += 2;
+        const size_t raw = static_cast<size_t>(close - begin);
+        escaped = std::memchr(begin, '\\', raw) != nullptr;
+        if (!escaped) {
+            out = std::string_view(begin, raw);
+            return true;
+        }
+        return unescapeEvent(begin, close, out);
+    }
+
+    bool string(std::string_view& out) noexcept {
+        bool escaped;
+        return string(out, escaped);
+    }
+
+    bool number(JsonNumber& out) noexcept;
+
+    // Número ou string numérica ("67234.50"), como os feeds enviam preços
+    bool numberOrString(JsonNumber& out) noexcept;
+
+private:
+    const char* base_;
+    size_t size_;
+    const uint32_t* pos_;
+    const uint32_t* end_;
+
+    // Escalar [base_ + *pos_, scalarEnd): até o próximo token só pode haver espaço
+    bool finishScalar(const char* scalarEnd) noexcept {
+        const char* limit = pos_ + 1 < end_ ? base_ + pos_[1] : base_ + size_;
+        for (; scalarEnd < limit; ++scalarEnd) {
+            const char c = *scalarEnd;
+            if (c != ' ' && c != '\t' && c != '\n' && c != '\r') return false;
+        }
+        ++pos_;
+        return true;
+    }
+};
+
+/**
+ * Estágio 2 de parseEvents: mesmo caminho de Json::parse pelo índice
+ * estrutural, mas cada valor vira uma chamada no handler em vez de um nó.
+ */
+template<typename Handler>
+class EventParser {
+public:
+    EventParser(TokenReader& reader, Handler& handler) noexcept : reader_(reader), handler_(handler) {}
+
+    Json::EventResult run() noexcept {
+        if (!reader_.done() && value(0) && reader_.done()) {
+            return {Json::EventResult::Status::Ok, reader_.inputSize()};
+        }
+        return {stopped_ ? Json::EventResult::Status::Stopped : Json::EventResult::Status::Invalid,
+                reader_.offset()};
+    }
+
+    // Um valor completo a partir do token atual (também usado para pular valores)
+    bool value(int depth) noexcept {
+        switch (reader_.peek()) {
+            case 'n':
+                return reader_.literal("null", 4) &&
+                       notify([](auto& h) -> decltype(h.onNull()) { return h.onNull(); });
+            case 't':
+                return reader_.literal("true", 4) &&
+                       notify([](auto& h) -> decltype(h.onBool(true)) { return h.onBool(true); });
+            case 'f':
+                return reader_.literal("false", 5) &&
+                       notify([](auto& h) -> decltype(h.onBool(false)) { return h.onBool(false); });
+            case '"': {
+                std::string_view text;
+                return reader_.string(text) &&
+                       notify([&text](auto& h) -> decltype(h.onString(text)) { return h.onString(text); });
+            }
+            case '[':
+                return depth < TokenReader::MaxDepth && array(depth + 1);
+            case '{':
+                return depth < TokenReader::MaxDepth && object(depth + 1);
+            case '-': case '0': case '1': case '2': case '3': case '4':
+            case '5': case '6': case '7': case '8': case '9': {
+                JsonNumber number;
+                return reader_.number(number) &&
+                       notify([&number](auto& h) -> decltype(h.onNumber(number)) { return h.onNumber(number); });
+            }
+            default:
+                return false;
+        }
+    }
+
+private:
+    TokenReader& reader_;
+    Handler& handler_;
+    bool stopped_ = false;
+
+    /**
+     * Chama o callback se o handler o declara (call é uma lambda genérica
+     * com tipo de retorno via decltype: sem o método, não é invocável).
+     * Callback void continua; bool false interrompe.
+     */
+    template<typename Call>
+    bool notify(Call&& call) noexcept {
+        if constexpr (std::is_invocable_v<Call&, Handler&>) {
+            if constexpr (std::is_same_v<std::invoke_result_t<Call&, Handler&>, bool>) {
+                if (call(handler_)) return true;
+                stopped_ = true;
+                return false;
+            } else {
+                call(handler_);
+                return true;
+            }
+        } else {
+            return true;
+        }
+    }
+
+    bool array(int depth) noexcept {
+        reader_.advance();
+        if (!notify([](auto& h) -> decltype(h.onStartArray()) { return h.onStartArray(); })) return false;
+        if (!reader_.expect(']')) {
+            for (;;) {
+                if (!value(depth)) return false;
+                if (reader_.expect(']')) break;
+                if (!reader_.expect(',')) return false;
+            }
+        }
+        return notify([](auto& h) -> decltype(h.onEndArray()) { return h.onEndArray(); });
+    }
+
+    bool object(int depth) noexcept {
+        reader_.advance();
+        if (!notify([](auto& h) -> decltype(h.onStartObject()) { return h.onStartObject(); })) return false;
+        if (!reader_.expect('}')) {
+            for (;;) {
+                // Chave deve ser string
+                std::string_view key;
+                if (reader_.peek() != '"' || !reader_.string(key)) return false;
+                if (!notify([&key](auto& h) -> decltype(h.onKey(key)) { return h.onKey(key); })) return false;
+                if (!reader_.expect(':') || !value(depth)) return false;
+                if (reader_.expect('}')) break;
+                if (!reader_.expect(',')) return false;
+            }
+        }
+        return notify([](auto& h) -> decltype(h.onEndObject()) { return h.onEndObject(); });
+    }
+};
+
+inline bool TokenReader::number(JsonNumber& out) noexcept {
+    const char* begin = base_ + *pos_;
+    const char* end = JsonNumber::parse(begin, base_ + size_, out);
+    if (!end || !finishScalar(end)) return false;
+    out.text_ = std::string_view(begin, static_cast<size_t>(end - begin));
+    return true;
+}
+
+inline bool TokenReader::numberOrString(JsonNumber& out) noexcept {
+    if (peek() != '"') return number(out);
+    if (end_ - pos_ < 2) return false;
+    const char* begin = base_ + pos_[0] + 1;
+    const char* close = base_ + pos_[1];
+    // O número tem que ocupar a string inteira
+    if (begin == close || JsonNumber::parse(begin, close, out) != close) return false;
+    out.text_ = std::string_view(begin, static_cast<size_t>(close - begin));
+    pos_ += 2;
+    return true;
+}
+
+} // namespace detail
+
+template<typename Handler>
+Json::EventResult Json::parseEvents(std::string_view input, Handler&& handler) noexcept {
+    const uint32_t* begin;
+    const uint32_t* end;
+    if (!detail::indexEvents(input, begin, end)) return {EventResult::Status::Invalid, 0};
+    detail::TokenReader reader(input, begin, end);
+    return detail::EventParser<std::remove_reference_t<Handler>>(reader, handler).run();
+}
+
+} // namespace gg
@@ -0,0 +1,209 @@
+#pragma once
+
+/**
+ * @file json_object.hpp
+ * @brief Json::Object: membros contíguos na ordem de inserção, chaves internadas.
+ *
+ * Um object guarda (chave, valor) na ordem em que as chaves entraram (a
+ * do documento, no parse), em blocos contíguos que nunca se movem: o parse
+ * reserva o tamanho exato (um bloco só) e inserções que não cabem abrem um
+ * bloco novo. Até IndexThreshold membros a busca é linear; acima, um
+ * índice por hash (endereçamento aberto) é montado ao lado. As chaves são
+ * internadas numa tabela global: a mesma chave em milhões de mensagens é o
+ * mesmo texto, guardado uma vez, e duas chaves internadas se comparam por
+ * ponteiro.
+ *
+ * Referências a valores (operator[], find) continuam válidas depois de
+ * outras inserções, como no unordered_map: `o["b"] = o["a"]` é seguro.
+ * erase() invalida as do membro removido e dos seguintes (que andam uma
+ * posição para manter a ordem).
+ *
+ * @note Incluído por json.hpp (Member só fica completo depois de Json).
+ *       Chaves longas (> MaxInternedSize) ou além do limite da tabela são
+ *       copiadas para o membro, como antes.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace gg {
+
+class Json;
+
+namespace detail {
+
+// Hash das chaves de object (FNV-1a 64 bits)
+constexpr uint64_t objectKeyHash(std::string_view key) noexcept {
+    uint64_t h = 0xcbf29ce484222325ull;
+    for (char c : key) h = (h ^ static_cast<uint8_t>(c)) * 0x100000001b3ull;
+    return h;
+}
+
+// Texto da chave logo depois do cabeçalho
+struct KeyData {
+    uint64_t hash;
+    uint32_t size;
+    bool interned;                  // false: cópia do membro (liberada com ele)
+
+    [[nodiscard]] const char* text() const noexcept { return reinterpret_cast<const char*>(this + 1); }
+};
+
+/**
+ * Chave de um membro: ponteiro para a entrada internada (cópia barata) ou
+ * para uma cópia própria.
+ */
+class KeyHandle {
+public:
+    // Chaves internadas ficam vivas até o fim do processo
+    static constexpr size_t MaxInternedSize = 64;
+    static constexpr size_t MaxInterned = 65536;
+
+    explicit KeyHandle(std::string_view text) : KeyHandle(text, objectKeyHash(text)) {}
+    KeyHandle(std::string_view text, uint64_t hash);
+    KeyHandle(const KeyHandle& other);
+    KeyHandle(KeyHandle&& other) noexcept : data_(other.data_) { other.data_ = nullptr; }
+    KeyHandle& operator=(const KeyHandle& other);
+    KeyHandle& operator=(KeyHandle&& other) noexcept;
+    ~KeyHandle();
+
+    [[nodiscard]] std::string_view view() const noexcept { return {data_->text(), data_->size}; }
+    [[nodiscard]] uint64_t hash() const noexcept { return data_->hash; }
+
+    [[nodiscard]] bool matches(std::string_view text, uint64_t hash) const noexcept {
+        return data_->hash == hash && view() == text;
+    }
+
+    // Internadas: mesmo texto é mesmo ponteiro
+    [[nodiscard]] bool operator==(const KeyHandle& other) const noexcept {
+        if (data_ == other.data_) return true;
+        if (data_->interned && other.data_->interned) return false;
+        return matches(other.view(), other.hash());
+    }
+
+private:
+    const KeyData* data_;
+};
+
+} // namespace detail
+
+class JsonObject {
+    struct Chunk;
+
+    // Percorre os blocos em ordem; M é Member ou const Member
+    template<typename M>
+    class Iterator {
+    public:
+        Iterator() noexcept = default;
+        Iterator(Chunk* chunk, uint32_t position) noexcept : chunk_(chunk), position_(position) { settle(); }
+
+        M& operator*() const noexcept;     // Em json.hpp (Member completo)
+        M* operator->() const noexcept { return &**this; }
+        Iterator& operator++() noexcept {
+            ++position_;
+            settle();
+            return *this;
+        }
+        bool operator==(const Iterator& other) const noexcept {
+            return chunk_ == other.chunk_ && position_ == other.position_;
+        }
+        bool operator!=(const Iterator& other) const noexcept { return !(*this == other); }
+
+    private:
+        Chunk* chunk_ = nullptr;
+        uint32_t position_ = 0;
+
+        // Fim de bloco (ou bloco vazio) vai para o início do próximo
+        void settle() noexcept;
+    };
+
+public:
+    class Member;
+    using iterator = Iterator<Member>;
+    using const_iterator = Iterator<const Member>;
+
+    // Acima disto a busca usa o índice por hash
+    static constexpr size_t IndexThreshold = 16;
+
+    JsonObject() noexcept;
+    JsonObject(const JsonObject& other);
+    JsonObject(JsonObject&& other) noexcept;
+    JsonObject& operator=(const JsonObject& other);
+    JsonObject& operator=(JsonObject&& other) noexcept;
+    ~JsonObject();
+
+    [[nodiscard]] size_t size() const noexcept { return size_; }
+    [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
+    void reserve(size_t count);
+    void clear() noexcept;
+
+    // Membros na ordem de inserção
+    [[nodiscard]] const_iterator begin() const noexcept { return const_iterator(first_, 0); }
+    [[nodiscard]] const_iterator end() const noexcept { return const_iterator(); }
+    [[nodiscard]] iterator begin() noexcept { return iterator(first_, 0); }
+    [[nodiscard]] iterator end() noexcept { return iterator(); }
+
+    /**
+     * @brief Valor da chave, ou nullptr.
+     */
+    [[nodiscard]] const Json* find(std::string_view key) const noexcept;
+    [[nodiscard]] Json* find(std::string_view key) noexcept;
+    [[nodiscard]] bool contains(std::string_view key) const noexcept { return find(key) != nullptr; }
+
+    // Com o hash já calculado (objectKeyHash(key), como em Json::Key)
+    [[nodiscard]] const Json* find(std::string_view key, uint64_t hash) const noexcept;
+    [[nodiscard]] Json* find(std::string_view key, uint64_t hash) noexcept;
+
+    // Valor da chave (null inserido no fim se não existe)
+    Json& operator[](std::string_view key);
+
+    Json& insert_or_assign(std::string_view key, Json value);
+    Json& insert_or_assign(Member member);
+
+    // Remove mantendo a ordem dos demais
+    bool erase(std::string_view key);
+
+    // Mesmas chaves com valores iguais, em qualquer ordem
+    [[nodiscard]] bool operator==(const JsonObject& other) const noexcept;
+    [[nodiscard]] bool operator!=(const JsonObject& other) const noexcept { return !(*this == other); }
+
+private:
+    struct Index;
+
+    Chunk* first_ = nullptr;
+    Chunk* last_ = nullptr;             // Recebe as inserções
+    size_t size_ = 0;
+    std::unique_ptr<Index> index_;      // Só acima de IndexThreshold membros
+
+    [[nodiscard]] const Member* lookup(std::string_view key, uint64_t hash) const noexcept;
+    [[nodiscard]] const Member* lookup(const detail::KeyHandle& key) const noexcept;
+    [[nodiscard]] const Json* findIndexed(std::string_view key, uint64_t hash) const noexcept;
+    Json& append(Member&& member);
+    Chunk* addChunk(size_t capacity);
+    void rebuildIndex();
+};
+
+/**
+ * Bloco de membros: cabeçalho seguido de capacity membros, dos quais os
+ * size primeiros estão construídos.
+ */
+struct JsonObject::Chunk {
+    Chunk* next;
+    uint32_t size;
+    uint32_t capacity;
+
+    [[nodiscard]] Member* members() noexcept { return reinterpret_cast<Member*>(this + 1); }
+    [[nodiscard]] const Member* members() const noexcept { return reinterpret_cast<const Member*>(this + 1); }
+};
+
+template<typename M>
+void JsonObject::Iterator<M>::settle() noexcept {
+    while (chunk_ && position_ == chunk_->size) {
+        chunk_ = chunk_->next;
+        position_ = 0;
+    }
+}
+
+} // namespace gg
@@ -0,0 +1,130 @@
+#pragma once
+
+/**
+ * @file json_query.hpp
+ * @brief Extração de campos por caminho (JSON Pointer) sem construir DOM.
+ *
+ * JsonQuery compila os caminhos uma vez numa árvore de segmentos.
+ * extract() percorre a entrada uma única vez, desce só pelos caminhos
+ * pedidos, pula as outras subárvores sem interpretá-las e para assim que
+ * todos os campos foram achados. Cada campo é uma view da entrada.
+ *
+ * Exemplo:
+ * @code
+ *   static const gg::JsonQuery query({"/p", "/q", "/T"});
+ *   ws.onRawMessage([](std::string_view msg) {
+ *       std::array<gg::JsonField, 3> fields;
+ *       if (query.extract(msg, fields) != fields.size()) return;
+ *       gg::Decimal price = fields[0].getDecimal();
+ *       int64_t time = fields[2].getInt();
+ *   });
+ * @endcode
+ *
+ * @note Caminhos seguem a RFC 6901: "/data/b/0" é o primeiro elemento do
+ *       array "b" de "data"; "~1" é '/' e "~0" é '~' dentro de uma chave;
+ *       "" é o documento inteiro. Com chaves repetidas vale a primeira.
+ *       Só o trecho percorrido é validado: um erro de sintaxe encerra a
+ *       busca e os campos ainda não achados ficam com found() == false.
+ */
+
+#include "json.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace gg {
+
+/**
+ * @brief Valor achado por JsonQuery: tipo e texto JSON na entrada (cópia barata).
+ *
+ * Getters com a semântica de Json: tipo errado retorna o default.
+ */
+class JsonField {
+public:
+    [[nodiscard]] bool found() const noexcept { return found_; }
+    [[nodiscard]] Json::Type type() const noexcept { return type_; }
+
+    // Texto JSON do valor (strings com aspas, containers inteiros)
+    [[nodiscard]] std::string_view raw() const noexcept { return raw_; }
+
+    [[nodiscard]] bool isNull() const noexcept { return found_ && type_ == Json::Type::Null; }
+    [[nodiscard]] bool isString() const noexcept { return type_ == Json::Type::String; }
+    [[nodiscard]] bool isNumber() const noexcept { return type_ == Json::Type::Number; }
+
+    [[nodiscard]] bool getBool(bool defaultValue = false) const noexcept;
+    [[nodiscard]] double getNumber(double defaultValue = 0.0) const noexcept;
+    [[nodiscard]] int64_t getInt(int64_t defaultValue = 0) const noexcept;
+    [[nodiscard]] uint64_t getUInt(uint64_t defaultValue = 0) const noexcept;
+
+    // Números e strings numéricas ("67234.50"), como Json::getDecimal
+    [[nodiscard]] Decimal getDecimal(Decimal defaultValue = {}) const noexcept;
+
+    /**
+     * @brief Conteúdo da string (view da entrada).
+     * @return defaultValue se não é string ou se tem escapes (use getStringCopy)
+     */
+    [[nodiscard]] std::string_view getString(std::string_view defaultValue = "") const noexcept;
+    [[nodiscard]] bool isEscaped() const noexcept { return escaped_; }
+
+    /**
+     * @brief Conteúdo da string com os escapes decodificados (aloca).
+     */
+    [[nodiscard]] std::string getStringCopy(const std::string& defaultValue = "") const;
+
+private:
+    friend class JsonQuery;
+
+    std::string_view raw_;
+    Json::Type type_ = Json::Type::Null;
+    bool found_ = false;
+    bool escaped_ = false;
+};
+
+class JsonQuery {
+public:
+    /**
+     * @param paths Caminhos JSON Pointer; o campo i de extract() é paths[i]
+     */
+    JsonQuery(std::initializer_list<std::string_view> paths);
+    explicit JsonQuery(const std::vector<std::string>& paths);
+    ~JsonQuery();
+
+    JsonQuery(JsonQuery&&) noexcept;
+    JsonQuery& operator=(JsonQuery&&) noexcept;
+    JsonQuery(const JsonQuery&) = delete;
+    JsonQuery& operator=(const JsonQuery&) = delete;
+
+    /**
+     * @brief false se algum caminho é inválido (não começa com '/' ou tem '~' solto).
+     */
+    [[nodiscard]] bool valid() const noexcept;
+
+    // Número de caminhos
+    [[nodiscard]] size_t size() const noexcept;
+
+    /**
+     * @brief Procura os caminhos em input, numa passada, sem alocar.
+     * @param out Campo i recebe o caminho i (até count; os demais não são buscados)
+     * @return Quantos campos foram achados
+     */
+    size_t extract(std::string_view input, JsonField* out, size_t count) const noexcept;
+
+    // Qualquer contêiner contíguo de JsonField (std::array, std::vector, JsonField[N])
+    template<typename Fields>
+    size_t extract(std::string_view input, Fields& out) const noexcept {
+        return extract(input, std::data(out), std::size(out));
+    }
+
+private:
+    struct Impl;
+    class Scanner;
+    std::unique_ptr<Impl> impl_;
+};
+
+} // namespace gg
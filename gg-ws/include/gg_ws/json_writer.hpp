@@ -0,0 +1,153 @@
+#pragma once
+
+/**
+ * @file json_writer.hpp
+ * @brief Escrita de JSON em streaming, direto numa string reutilizável ou num buffer.
+ *
+ * JsonWriter monta o texto à medida que os valores chegam: vírgulas,
+ * dois-pontos e indentação são postos pelo writer, sem DOM intermediário.
+ * Json::stringify usa o mesmo writer.
+ *
+ * Exemplo (ordem sem montar um Json):
+ * @code
+ *   std::string out;                    // Reutilizada: clear() entre mensagens
+ *   gg::JsonWriter writer(out);
+ *   writer.beginObject()
+ *         .field("symbol", "BTCUSDT")
+ *         .field("side", "BUY")
+ *         .field("price", gg::Decimal(6723450, 2))
+ *         .field("quantity", 0.001)
+ *         .field("timestamp", int64_t{1700000000123})
+ *         .endObject();
+ *   ws.send(writer.view());
+ * @endcode
+ *
+ * Números: inteiros com todos os dígitos; Decimal com as mesmas casas;
+ * double com a menor representação que volta ao mesmo valor (inteiros
+ * abaixo de 1e15 sem ponto; NaN/inf viram null).
+ *
+ * @note No modo string, o writer escreve direto na memória da string e
+ *       só ajusta out ao tamanho final em flush() ou no destrutor; até lá
+ *       use view(). A ordem das chamadas não é validada (key() fora de
+ *       object gera JSON inválido); complete() indica se todos os
+ *       containers fecharam. No modo buffer, o que não cabe é descartado e
+ *       overflow() fica true.
+ */
+
+#include "decimal.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace gg {
+
+class Json;
+
+class JsonWriter {
+public:
+    /**
+     * @brief Acrescenta a out (o conteúdo anterior é mantido).
+     */
+    explicit JsonWriter(std::string& out, bool pretty = false) noexcept;
+
+    /**
+     * @brief Escreve em buffer[0, capacity), sem alocar.
+     */
+    JsonWriter(char* buffer, size_t capacity, bool pretty = false) noexcept;
+
+    ~JsonWriter() { flush(); }
+
+    JsonWriter(const JsonWriter&) = delete;
+    JsonWriter& operator=(const JsonWriter&) = delete;
+
+    // ============================================
+    // Containers e chaves
+    // ============================================
+    JsonWriter& beginObject() { return open('{'); }
+    JsonWriter& endObject() { return close('}'); }
+    JsonWriter& beginArray() { return open('['); }
+    JsonWriter& endArray() { return close(']'); }
+    JsonWriter& key(std::string_view name);
+
+    // ============================================
+    // Valores
+    // ============================================
+    JsonWriter& null() { return scalar("null", 4); }
+    JsonWriter& value(std::nullptr_t) { return null(); }
+    JsonWriter& value(bool value) { return value ? scalar("true", 4) : scalar("false", 5); }
+    JsonWriter& value(double value);
+    JsonWriter& value(Decimal value);
+    JsonWriter& value(std::string_view value);
+    JsonWriter& value(const char* value) { return this->value(std::string_view(value)); }
+    JsonWriter& value(const std::string& value) { return this->value(std::string_view(value)); }
+    JsonWriter& value(const Json& value);
+
+    // Qualquer inteiro (int, size_t, int64_t...), sem passar por double
+    template<typename T, typename = std::enable_if_t<std::is_integral_v<T> && !std::is_same_v<T, bool>>>
+    JsonWriter& value(T value) {
+        if constexpr (std::is_signed_v<T>) return integer(static_cast<int64_t>(value));
+        else return unsignedInteger(static_cast<uint64_t>(value));
+    }
+
+    /**
+     * @brief Valor já serializado (copiado como está).
+     */
+    JsonWriter& rawValue(std::string_view json) { return scalar(json.data(), json.size()); }
+
+    // key(name) + value(value)
+    template<typename T>
+    JsonWriter& field(std::string_view name, const T& value) {
+        key(name);
+        return this->value(value);
+    }
+
+    // ============================================
+    // Resultado
+    // ============================================
+
+    // Bytes escritos por este writer
+    [[nodiscard]] size_t size() const noexcept { return static_cast<size_t>(pos_ - begin_); }
+    [[nodiscard]] std::string_view view() const noexcept { return std::string_view(begin_, size()); }
+
+    /**
+     * @brief Modo string: ajusta out ao texto escrito (o destrutor também faz).
+     */
+    void flush() noexcept;
+
+    [[nodiscard]] bool overflow() const noexcept { return overflow_; }
+
+    // true depois de um valor completo com todos os containers fechados
+    [[nodiscard]] bool complete() const noexcept { return depth_ == 0 && needComma_ && !overflow_; }
+
+private:
+    std::string* string_ = nullptr;     // Modo string (nullptr: modo buffer)
+    size_t start_ = 0;                  // Tamanho de *string_ na construção
+    char* begin_ = nullptr;             // Primeiro byte deste writer
+    char* pos_ = nullptr;
+    char* end_ = nullptr;               // Fim do espaço disponível
+    int depth_ = 0;
+    bool pretty_ = false;
+    bool needComma_ = false;            // Último item do nível atual já foi escrito
+    bool afterKey_ = false;             // Próximo valor é de uma chave
+    bool overflow_ = false;
+
+    // Espaço para n bytes em pos_ (cresce a string; no buffer, false se não cabe)
+    bool reserve(size_t n) { return static_cast<size_t>(end_ - pos_) >= n || grow(n); }
+    bool grow(size_t n);
+
+    // Separador do próximo item, com o espaço para mais n bytes
+    bool separator(size_t n);
+
+    JsonWriter& open(char bracket);
+    JsonWriter& close(char bracket);
+    JsonWriter& scalar(const char* text, size_t size);
+    JsonWriter& integer(int64_t value);
+    JsonWriter& unsignedInteger(uint64_t value);
+    bool string(std::string_view value);
+    void indent();
+};
+
+} // namespace gg
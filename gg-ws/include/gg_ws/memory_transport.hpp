@@ -0,0 +1,155 @@
+#pragma once
+
+/**
+ * @file memory_transport.hpp
+ * @brief Transporte em memória para BasicWebSocket<policy::MemoryTransport>.
+ *
+ * Um MemoryPipe faz o papel do servidor: o que for escrito nele chega ao
+ * cliente como se viesse do socket (já depois do upgrade HTTP), e o que o
+ * cliente envia fica capturado para inspeção. Decoder, dispatch, JSON,
+ * router e callbacks rodam exatamente como com TCP/TLS, sem syscalls.
+ *
+ * Exemplo:
+ * @code
+ *   auto pipe = gg::MemoryPipe::create("md");
+ *   gg::BasicWebSocket<gg::policy::MemoryTransport,
+ *                      gg::policy::ExternalDriven> ws({.url = "memory://md"});
+ *   ws.connect();
+ *
+ *   pipe->writeText(R"({"type":"trade"})");
+ *   ws.poll();
+ *   std::string sent = pipe->drainOutbound();   // Frames mascarados do cliente
+ * @endcode
+ *
+ * @note Benchmarks podem instalar uma Source, chamada pela própria leitura do
+ *       cliente para gerar bytes direto no buffer de recepção.
+ */
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+namespace gg {
+
+class MemoryPipe {
+public:
+    /**
+     * @brief Gera bytes sob demanda no buffer do cliente.
+     * @return Bytes escritos em out (0 = sem dados agora)
+     */
+    using Source = std::function<size_t(char* out, size_t capacity)>;
+
+    /**
+     * @brief Retorno de read() quando não há bytes (equivale a EAGAIN).
+     */
+    static constexpr std::ptrdiff_t WouldBlock = -1;
+
+    /**
+     * @brief Cria um pipe e o registra como memory://name.
+     *
+     * O registro guarda só uma referência fraca: o pipe vive enquanto o
+     * chamador (ou um cliente conectado) mantiver o shared_ptr.
+     */
+    static std::shared_ptr<MemoryPipe> create(std::string name);
+
+    /**
+     * @brief Busca um pipe registrado (nullptr se não existe mais).
+     */
+    static std::shared_ptr<MemoryPipe> find(std::string_view name);
+
+    MemoryPipe(const MemoryPipe&) = delete;
+    MemoryPipe& operator=(const MemoryPipe&) = delete;
+
+    // ============================================
+    // Lado servidor (teste/benchmark)
+    // ============================================
+
+    /**
+     * @brief Enfileira bytes crus para o cliente (frames já codificados).
+     */
+    void write(std::string_view bytes);
+
+    /**
+     * @brief Enfileira um frame de servidor (sem máscara, FIN).
+     */
+    void writeFrame(uint8_t opcode, std::string_view payload);
+    void writeText(std::string_view payload) { writeFrame(0x1, payload); }
+    void writeBinary(std::string_view payload) { writeFrame(0x2, payload); }
+
+    /**
+     * @brief Instala (ou remove, com nullptr) o gerador de bytes.
+     * @note Consultado quando a fila de write() está vazia. Troque apenas
+     *       sem cliente conectado.
+     */
+    void setSource(Source source);
+
+    /**
+     * @brief Bytes enviados pelo cliente desde a última chamada.
+     */
+    std::string drainOutbound();
+
+    /**
+     * @brief Fecha o pipe: o cliente lê EOF após consumir a fila e novas
+     *        conexões falham até reopen().
+     */
+    void close();
+    void reopen();
+
+    [[nodiscard]] bool attached() const;
+    [[nodiscard]] const std::string& name() const noexcept { return name_; }
+
+    // ============================================
+    // Lado cliente (usado pelo WebSocketClient)
+    // ============================================
+
+    /**
+     * @brief Conecta um cliente; falha se fechado ou já ocupado.
+     */
+    bool attach();
+
+    /**
+     * @brief Solta o cliente (fim da conexão). Dados pendentes são descartados.
+     */
+    void detach();
+
+    /**
+     * @brief Derruba o link atual sem fechar o pipe (equivale a shutdown()).
+     */
+    void hangup();
+
+    /**
+     * @return Bytes lidos, 0 em EOF ou WouldBlock (nunca bloqueia)
+     */
+    std::ptrdiff_t read(char* out, size_t capacity);
+
+    /**
+     * @return len, ou -1 se o link caiu
+     */
+    std::ptrdiff_t send(const char* data, size_t len);
+
+    /**
+     * @brief Espera até haver bytes (ou EOF) por até timeoutMs.
+     */
+    bool waitReadable(int timeoutMs);
+
+private:
+    explicit MemoryPipe(std::string name) : name_(std::move(name)) {}
+
+    const std::string name_;
+    mutable std::mutex mutex_;
+    std::condition_variable readable_;
+    std::string inbound_;
+    size_t inboundHead_ = 0;
+    std::string outbound_;
+    Source source_;
+    bool closed_ = false;
+    bool attached_ = false;
+    bool hungUp_ = false;           // Link atual derrubado (até o próximo attach)
+};
+
+} // namespace gg
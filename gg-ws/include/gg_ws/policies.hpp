@@ -0,0 +1,185 @@
+#pragma once
+
+#include <type_traits>
+
+namespace gg {
+
+/**
+ * @brief Políticas de compilação para BasicWebSocket.
+ *
+ * Cada política pertence a uma categoria; BasicWebSocket<Policies...> aceita
+ * qualquer subconjunto, em qualquer ordem, e usa o default das categorias
+ * omitidas. Recursos desligados não geram código no caminho de recepção.
+ *
+ * Exemplo:
+ * @code
+ *   // Feed raw em TCP puro, sem JSON, heartbeat ou métricas
+ *   gg::BasicWebSocket<gg::policy::TcpTransport,
+ *                      gg::policy::JsonOff,
+ *                      gg::policy::HeartbeatOff> feed({.url = "ws://10.0.0.5:9000/md"});
+ * @endcode
+ */
+namespace policy {
+
+// ============================================
+// Categorias
+// ============================================
+struct TransportCategory {};
+struct ThreadingCategory {};
+struct JsonCategory {};
+struct HeartbeatCategory {};
+struct MetricsCategory {};
+
+// ============================================
+// Transporte
+// ============================================
+enum class TransportKind {
+    Auto,   // ws:// → TCP, wss:// → TLS (decidido em runtime pela URL)
+    Tcp,    // Somente TCP; URLs wss:// são rejeitadas
+    Tls,    // Somente TLS; URLs ws:// são rejeitadas
+    Memory  // MemoryPipe do processo (URL memory://nome); sem sockets
+};
+
+struct AutoTransport {
+    using category = TransportCategory;
+    static constexpr TransportKind kind = TransportKind::Auto;
+};
+
+struct TcpTransport {
+    using category = TransportCategory;
+    static constexpr TransportKind kind = TransportKind::Tcp;
+};
+
+struct TlsTransport {
+    using category = TransportCategory;
+    static constexpr TransportKind kind = TransportKind::Tls;
+};
+
+struct MemoryTransport {            // Benchmarks e testes do stack completo
+    using category = TransportCategory;
+    static constexpr TransportKind kind = TransportKind::Memory;
+};
+
+// ============================================
+// Threading
+// ============================================
+struct OwnThread {                  // connect() inicia thread de I/O própria
+    using category = ThreadingCategory;
+    static constexpr bool external = false;
+};
+
+struct ExternalDriven {             // Caller chama poll(); sem thread nem mutexes
+    using category = ThreadingCategory;
+    static constexpr bool external = true;
+};
+
+// ============================================
+// JSON
+// ============================================
+struct JsonOn {
+    using category = JsonCategory;
+    static constexpr bool enabled = true;
+};
+
+struct JsonOff {
+    using category = JsonCategory;
+    static constexpr bool enabled = false;
+};
+
+// ============================================
+// Heartbeat
+// ============================================
+struct HeartbeatOn {
+    using category = HeartbeatCategory;
+    static constexpr bool enabled = true;
+};
+
+struct HeartbeatOff {
+    using category = HeartbeatCategory;
+    static constexpr bool enabled = false;
+};
+
+// ============================================
+// Métricas
+// ============================================
+struct MetricsOn {
+    using category = MetricsCategory;
+    static constexpr bool enabled = true;
+};
+
+struct MetricsOff {
+    using category = MetricsCategory;
+    static constexpr bool enabled = false;
+};
+
+} // namespace policy
+
+/**
+ * @brief Conjunto canônico de políticas (uma por categoria).
+ */
+template<typename Transport, typename Threading, typename JsonP, typename HeartbeatP, typename MetricsP>
+struct PolicySet {
+    static constexpr policy::TransportKind transport = Transport::kind;
+    static constexpr bool externalDriven = Threading::external;
+    static constexpr bool threaded = !Threading::external;
+    static constexpr bool json = JsonP::enabled;
+    static constexpr bool heartbeat = HeartbeatP::enabled;
+    static constexpr bool metrics = MetricsP::enabled;
+
+    static constexpr bool memory = transport == policy::TransportKind::Memory;
+    static constexpr bool tcpPossible = transport == policy::TransportKind::Auto ||
+                                        transport == policy::TransportKind::Tcp;
+    static constexpr bool tlsPossible = transport == policy::TransportKind::Auto ||
+                                        transport == policy::TransportKind::Tls;
+};
+
+namespace detail {
+
+template<typename Category, typename Default, typename... Policies>
+struct SelectPolicy {
+    using type = Default;
+};
+
+template<typename Category, typename Default, typename First, typename... Rest>
+struct SelectPolicy<Category, Default, First, Rest...> {
+    using type = std::conditional_t<
+        std::is_same_v<typename First::category, Category>,
+        First,
+        typename SelectPolicy<Category, Default, Rest...>::type>;
+};
+
+template<typename Category, typename... Policies>
+constexpr int countCategory() {
+    return (0 + ... + (std::is_same_v<typename Policies::category, Category> ? 1 : 0));
+}
+
+} // namespace detail
+
+/**
+ * @brief Resolve uma lista de políticas (qualquer ordem) para o PolicySet canônico.
+ */
+template<typename... Policies>
+struct ResolvePolicies {
+    static_assert(detail::countCategory<policy::TransportCategory, Policies...>() <= 1,
+                  "Mais de uma política de transporte");
+    static_assert(detail::countCategory<policy::ThreadingCategory, Policies...>() <= 1,
+                  "Mais de uma política de threading");
+    static_assert(detail::countCategory<policy::JsonCategory, Policies...>() <= 1,
+                  "Mais de uma política de JSON");
+    static_assert(detail::countCategory<policy::HeartbeatCategory, Policies...>() <= 1,
+                  "Mais de uma política de heartbeat");
+    static_assert(detail::countCategory<policy::MetricsCategory, Policies...>() <= 1,
+                  "Mais de uma política de métricas");
+
+    using type = PolicySet<
+        typename detail::SelectPolicy<policy::TransportCategory, policy::AutoTransport, Policies...>::type,
+        typename detail::SelectPolicy<policy::ThreadingCategory, policy::OwnThread, Policies...>::type,
+        typename detail::SelectPolicy<policy::JsonCategory, policy::JsonOn, Policies...>::type,
+        typename detail::SelectPolicy<policy::HeartbeatCategory, policy::HeartbeatOn, Policies...>::type,
+        typename detail::SelectPolicy<policy::MetricsCategory, policy::MetricsOn, Policies...>::type>;
+};
+
+template<typename... Policies>
+using ResolvePoliciesT = typename ResolvePolicies<Policies...>::type;
+
+} // namespace gg
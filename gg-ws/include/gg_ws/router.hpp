@@ -0,0 +1,95 @@
+#pragma once
+
+/**
+ * @file router.hpp
+ * @brief Roteamento de mensagens por conteúdo sem parse completo.
+ *
+ * O router localiza a chave de roteamento (ex: "e", "channel", "topic")
+ * varrendo os bytes crus da mensagem e escolhe o handler numa tabela de
+ * hash perfeito montada em build(): uma lookup = um hash + uma comparação.
+ *
+ * Exemplo:
+ * @code
+ *   gg::MessageRouter router("e");
+ *   router.on("trade", [](std::string_view msg) { onTrade(msg); })
+ *         .on("depthUpdate", [](std::string_view msg) { onDepth(msg); })
+ *         .otherwise([](std::string_view msg) { log(msg); });
+ *
+ *   ws.route(std::move(router));   // build() é chamado aqui
+ * @endcode
+ *
+ * @note A varredura usa a primeira ocorrência de "<chave>": no texto, em
+ *       qualquer nível de aninhamento. Valores são comparados byte a byte,
+ *       sem decodificar escapes.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace gg {
+
+class MessageRouter {
+public:
+    using Handler = std::function<void(std::string_view message)>;
+
+    /**
+     * @param key Nome do campo de roteamento (sem aspas)
+     */
+    explicit MessageRouter(std::string_view key);
+
+    /**
+     * @brief Registra handler para um valor da chave.
+     * @note Valor repetido substitui o handler anterior
+     */
+    MessageRouter& on(std::string_view value, Handler handler);
+
+    /**
+     * @brief Handler para mensagens sem a chave ou com valor não registrado.
+     */
+    MessageRouter& otherwise(Handler handler);
+
+    /**
+     * @brief Monta a tabela de hash perfeito para os valores registrados.
+     * @note Sem build(), dispatch() faz busca linear
+     */
+    void build();
+
+    /**
+     * @brief Entrega a mensagem ao handler do seu valor de roteamento.
+     * @return true se um handler registrado com on() foi chamado
+     */
+    bool dispatch(std::string_view message) const;
+
+    /**
+     * @brief Localiza o valor da chave nos bytes crus.
+     * @return View do valor (sem aspas), ou view nula se a chave não existe
+     */
+    std::string_view findValue(std::string_view message) const noexcept;
+
+    [[nodiscard]] std::string_view key() const noexcept;
+    [[nodiscard]] size_t size() const noexcept { return routes_.size(); }
+    [[nodiscard]] size_t tableSize() const noexcept { return table_.size(); }
+    [[nodiscard]] bool built() const noexcept { return !table_.empty() || routes_.empty(); }
+
+private:
+    struct Route {
+        std::string value;
+        Handler handler;
+    };
+
+    std::string quotedKey_;         // "\"<key>\""
+    std::vector<Route> routes_;
+    std::vector<int32_t> table_;    // slot → índice em routes_ (-1 = vazio)
+    uint64_t seed_ = 0;
+    uint64_t mask_ = 0;
+    Handler fallback_;
+
+    const Route* lookup(std::string_view value) const noexcept;
+    static uint64_t hash(std::string_view value, uint64_t seed) noexcept;
+};
+
+} // namespace gg
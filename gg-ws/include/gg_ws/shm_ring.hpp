@@ -0,0 +1,403 @@
+#pragma once
+
+/**
+ * @file shm_ring.hpp
+ * @brief Ring SPMC em memória compartilhada POSIX para fan-out de mensagens.
+ *
+ * Um processo (o dono da conexão WebSocket) publica cada mensagem recebida;
+ * qualquer número de processos lê o mesmo ring sem syscalls depois do open().
+ *
+ * Layout: header + buffer circular de bytes (potência de 2). Cada mensagem é
+ * um registro contíguo {seq, len, flags, payload} alinhado a 16 bytes; quando
+ * não cabe até o fim do buffer, o writer grava um registro de padding e volta
+ * ao início.
+ *
+ * O writer nunca espera leitores. Um leitor lento é "lapped": o seqlock
+ * claim/commit detecta que o registro foi sobrescrito durante a cópia, o
+ * leitor pula para a posição atual do writer e contabiliza as mensagens
+ * perdidas pelo salto no número de sequência.
+ *
+ * Exemplo (consumidor):
+ * @code
+ *   gg::ShmSubscriber sub;
+ *   if (sub.open("/gg_btcusdt")) {
+ *       while (running) {
+ *           sub.poll([](const gg::ShmMessage& msg) {
+ *               handle(msg.seq, msg.data);
+ *           });
+ *       }
+ *   }
+ * @endcode
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace gg {
+
+namespace shm_detail {
+
+constexpr uint64_t Magic = 0x47475F57535F524EULL;  // "GG_WS_RN"
+constexpr uint32_t Version = 1;
+constexpr uint32_t FlagPadding = 1u << 0;
+constexpr uint32_t FlagBinary = 1u << 1;
+constexpr size_t RecordAlign = 16;
+
+struct RecordHeader {
+    uint64_t seq;
+    uint32_t len;
+    uint32_t flags;
+};
+static_assert(sizeof(RecordHeader) == RecordAlign, "RecordHeader deve ter 16 bytes");
+
+struct RingHeader {
+    uint64_t magic;
+    uint32_t version;
+    uint32_t reserved;
+    uint64_t capacity;                              // Bytes de dados (potência de 2)
+
+    alignas(64) std::atomic<uint64_t> claim;        // Bytes reservados pelo writer
+    alignas(64) std::atomic<uint64_t> commit;       // Bytes publicados
+    alignas(64) std::atomic<uint64_t> nextSeq;      // Próximo número de sequência
+};
+
+inline size_t alignRecord(size_t n) noexcept {
+    return (n + RecordAlign - 1) & ~(RecordAlign - 1);
+}
+
+inline uint64_t roundUpPow2(uint64_t v) noexcept {
+    uint64_t p = 4096;
+    while (p < v) p <<= 1;
+    return p;
+}
+
+/**
+ * @brief Mapeamento RAII de um segmento shm_open.
+ */
+class Mapping {
+public:
+    Mapping() = default;
+    ~Mapping() { reset(); }
+
+    Mapping(const Mapping&) = delete;
+    Mapping& operator=(const Mapping&) = delete;
+
+    bool map(int fd, size_t size, bool writable) noexcept {
+        int prot = PROT_READ | (writable ? PROT_WRITE : 0);
+        void* p = ::mmap(nullptr, size, prot, MAP_SHARED, fd, 0);
+        if (p == MAP_FAILED) return false;
+        base_ = p;
+        size_ = size;
+        return true;
+    }
+
+    void reset() noexcept {
+        if (base_) {
+            ::munmap(base_, size_);
+            base_ = nullptr;
+            size_ = 0;
+        }
+    }
+
+    RingHeader* header() const noexcept { return static_cast<RingHeader*>(base_); }
+    char* data() const noexcept { return static_cast<char*>(base_) + sizeof(RingHeader); }
+    bool valid() const noexcept { return base_ != nullptr; }
+
+private:
+    void* base_ = nullptr;
+    size_t size_ = 0;
+};
+
+} // namespace shm_detail
+
+/**
+ * @brief Mensagem entregue pelo ShmSubscriber.
+ * @note `data` aponta para o buffer interno do subscriber e só vale durante o callback.
+ */
+struct ShmMessage {
+    uint64_t seq;
+    std::string_view data;
+    bool binary;
+};
+
+/**
+ * @brief Lado produtor (único) do ring.
+ */
+class ShmPublisher {
+public:
+    ShmPublisher() = default;
+    ~ShmPublisher() { close(); }
+
+    ShmPublisher(const ShmPublisher&) = delete;
+    ShmPublisher& operator=(const ShmPublisher&) = delete;
+
+    /**
+     * @brief Cria (ou reabre) o segmento de memória compartilhada.
+     * @param name Nome POSIX (ex: "/gg_btcusdt")
+     * @param capacity Bytes de dados, arredondado para potência de 2
+     * @return true se sucesso
+     * @note Se já existe um ring com a mesma capacidade, continua a partir da
+     *       posição e sequência atuais para não confundir leitores conectados.
+     */
+    [[nodiscard]] bool open(std::string_view name, size_t capacity = 64 * 1024 * 1024) {
+        using namespace shm_detail;
+        close();
+
+        name_ = std::string(name);
+        uint64_t cap = roundUpPow2(capacity);
+        size_t total = sizeof(RingHeader) + cap;
+
+        int fd = ::shm_open(name_.c_str(), O_CREAT | O_RDWR, 0600);
+        if (fd < 0) return false;
+
+        struct stat st{};
+        bool resume = ::fstat(fd, &st) == 0 && static_cast<size_t>(st.st_size) == total;
+        if (!resume && ::ftruncate(fd, static_cast<off_t>(total)) != 0) {
+            ::close(fd);
+            return false;
+        }
+
+        bool ok = mapping_.map(fd, total, true);
+        ::close(fd);
+        if (!ok) return false;
+
+        RingHeader* h = mapping_.header();
+        if (!(resume && h->magic == Magic && h->version == Version && h->capacity == cap)) {
+            h->version = Version;
+            h->capacity = cap;
+            h->claim.store(0, std::memory_order_relaxed);
+            h->commit.store(0, std::memory_order_relaxed);
+            h->nextSeq.store(1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            h->magic = Magic;
+        }
+
+        capacity_ = cap;
+        pos_ = h->commit.load(std::memory_order_relaxed);
+        seq_ = h->nextSeq.load(std::memory_order_relaxed);
+        return true;
+    }
+
+    /**
+     * @brief Desmapeia o segmento (não remove o nome; ver unlink()).
+     */
+    void close() noexcept {
+        mapping_.reset();
+    }
+
+    /**
+     * @brief Remove o nome do segmento do sistema.
+     */
+    static void unlink(std::string_view name) {
+        ::shm_unlink(std::string(name).c_str());
+    }
+
+    [[nodiscard]] bool isOpen() const noexcept { return mapping_.valid(); }
+
+    /**
+     * @brief Publica uma mensagem. Nunca bloqueia.
+     * @return Número de sequência atribuído, ou 0 se a mensagem não cabe no ring
+     */
+    uint64_t publish(std::string_view message, bool binary = false) noexcept {
+        using namespace shm_detail;
+        if (!mapping_.valid()) return 0;
+
+        size_t total = alignRecord(sizeof(RecordHeader) + message.size());
+        if (total > capacity_ / 2) return 0;
+
+        RingHeader* h = mapping_.header();
+        char* data = mapping_.data();
+        uint64_t mask = capacity_ - 1;
+
+        uint64_t offset = pos_ & mask;
+        uint64_t pad = (offset + total > capacity_) ? capacity_ - offset : 0;
+
+        // Reserva a região antes de escrever (leitores validam contra claim)
+        h->claim.store(pos_ + pad + total, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        if (pad > 0) {
+            RecordHeader padding{0, static_cast<uint32_t>(pad - sizeof(RecordHeader)), FlagPadding};
+            std::memcpy(data + offset, &padding, sizeof(padding));
+            pos_ += pad;
+            offset = 0;
+        }
+
+        uint64_t seq = seq_++;
+        RecordHeader rec{seq, static_cast<uint32_t>(message.size()), binary ? FlagBinary : 0u};
+        std::memcpy(data + offset, &rec, sizeof(rec));
+        std::memcpy(data + offset + sizeof(rec), message.data(), message.size());
+        pos_ += total;
+
+        h->nextSeq.store(seq_, std::memory_order_relaxed);
+        h->commit.store(pos_, std::memory_order_release);
+        return seq;
+    }
+
+private:
+    shm_detail::Mapping mapping_;
+    std::string name_;
+    uint64_t capacity_ = 0;
+    uint64_t pos_ = 0;
+    uint64_t seq_ = 1;
+};
+
+/**
+ * @brief Lado consumidor do ring (um por processo/thread).
+ */
+class ShmSubscriber {
+public:
+    ShmSubscriber() = default;
+    ~ShmSubscriber() = default;
+
+    ShmSubscriber(const ShmSubscriber&) = delete;
+    ShmSubscriber& operator=(const ShmSubscriber&) = delete;
+
+    /**
+     * @brief Abre um ring existente (somente leitura).
+     * @return false se o segmento não existe ou não foi inicializado
+     * @note Começa na posição atual do writer: só recebe mensagens novas.
+     */
+    [[nodiscard]] bool open(std::string_view name) {
+        using namespace shm_detail;
+        mapping_.reset();
+
+        int fd = ::shm_open(std::string(name).c_str(), O_RDONLY, 0);
+        if (fd < 0) return false;
+
+        struct stat st{};
+        if (::fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(RingHeader)) {
+            ::close(fd);
+            return false;
+        }
+
+        bool ok = mapping_.map(fd, static_cast<size_t>(st.st_size), false);
+        ::close(fd);
+        if (!ok) return false;
+
+        RingHeader* h = mapping_.header();
+        if (h->magic != Magic || h->version != Version ||
+            sizeof(RingHeader) + h->capacity != static_cast<size_t>(st.st_size)) {
+            mapping_.reset();
+            return false;
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+
+        capacity_ = h->capacity;
+        resync();
+        return true;
+    }
+
+    [[nodiscard]] bool isOpen() const noexcept { return mapping_.valid(); }
+
+    /**
+     * @brief Entrega as mensagens disponíveis em ordem de sequência.
+     * @param fn Callback void(const ShmMessage&)
+     * @param maxMessages Limite de mensagens nesta chamada
+     * @return Número de mensagens entregues
+     */
+    template<typename Fn>
+    size_t poll(Fn&& fn, size_t maxMessages = static_cast<size_t>(-1)) {
+        using namespace shm_detail;
+        if (!mapping_.valid()) return 0;
+
+        RingHeader* h = mapping_.header();
+        const char* data = mapping_.data();
+        uint64_t mask = capacity_ - 1;
+        size_t delivered = 0;
+
+        while (delivered < maxMessages) {
+            uint64_t commit = h->commit.load(std::memory_order_acquire);
+            if (commit == pos_) break;
+            if (commit - pos_ > capacity_) {
+                lap(commit);
+                continue;
+            }
+
+            RecordHeader rec;
+            std::memcpy(&rec, data + (pos_ & mask), sizeof(rec));
+            size_t total = alignRecord(sizeof(RecordHeader) + rec.len);
+
+            if (total > capacity_ - (pos_ & mask)) {
+                // Header inconsistente: foi sobrescrito durante a leitura
+                lap(commit);
+                continue;
+            }
+
+            if (!(rec.flags & FlagPadding)) {
+                buffer_.assign(data + (pos_ & mask) + sizeof(rec), rec.len);
+            }
+
+            // Valida que o writer não reservou a região enquanto copiávamos
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (h->claim.load(std::memory_order_relaxed) - pos_ > capacity_) {
+                lap(h->commit.load(std::memory_order_acquire));
+                continue;
+            }
+
+            pos_ += total;
+            if (rec.flags & FlagPadding) continue;
+
+            if (expectedSeq_ != 0 && rec.seq > expectedSeq_) {
+                dropped_ += rec.seq - expectedSeq_;
+            }
+            expectedSeq_ = rec.seq + 1;
+
+            fn(ShmMessage{rec.seq, std::string_view(buffer_), (rec.flags & FlagBinary) != 0});
+            delivered++;
+        }
+
+        return delivered;
+    }
+
+    /**
+     * @brief Mensagens perdidas por ter sido ultrapassado pelo writer.
+     */
+    [[nodiscard]] uint64_t dropped() const noexcept { return dropped_; }
+
+    /**
+     * @brief Número de vezes que o leitor foi ultrapassado (lapped).
+     */
+    [[nodiscard]] uint64_t laps() const noexcept { return laps_; }
+
+    /**
+     * @brief Mensagens publicadas ainda não lidas (aproximado).
+     */
+    [[nodiscard]] uint64_t backlogBytes() const noexcept {
+        if (!mapping_.valid()) return 0;
+        return mapping_.header()->commit.load(std::memory_order_acquire) - pos_;
+    }
+
+private:
+    shm_detail::Mapping mapping_;
+    uint64_t capacity_ = 0;
+    uint64_t pos_ = 0;
+    uint64_t expectedSeq_ = 0;
+    uint64_t dropped_ = 0;
+    uint64_t laps_ = 0;
+    std::string buffer_;
+
+    void resync() noexcept {
+        shm_detail::RingHeader* h = mapping_.header();
+        pos_ = h->commit.load(std::memory_order_acquire);
+        expectedSeq_ = h->nextSeq.load(std::memory_order_relaxed);
+    }
+
+    void lap(uint64_t commit) noexcept {
+        // Registros sempre começam em commit: salta para a posição do writer.
+        // As mensagens puladas aparecem como gap de sequência em dropped().
+        laps_++;
+        pos_ = commit;
+    }
+};
+
+} // namespace gg
@@ -1,11 +1,13 @@
 #pragma once
 
+#include <array>
 #include <chrono>
 #include <cstddef>
 #include <cstdint>
 #include <functional>
 #include <string>
 #include <string_view>
+#include <vector>
 
 namespace gg {
 
@@ -13,7 +15,7 @@ namespace gg {
 // Forward Declarations
 // ============================================
 class Json;
-class WebSocket;
+template<typename Policies> class WebSocketClient;
 
 // ============================================
 // Tipos de Ping
@@ -35,18 +37,149 @@ struct PingConfig {
     bool autoPong{true};                            // Responder pings automaticamente
 };
 
+// ============================================
+// TLS
+// ============================================
+struct TlsConfig {
+    std::string caFile;                             // CAs em PEM (vazio = trust store do sistema)
+    bool verifyPeer{true};                          // Verifica a cadeia do servidor
+    bool resumeSessions{true};                      // Reconexões retomam a sessão do mesmo host:port
+};
+
+// ============================================
+// Assinaturas por tópico
+// ============================================
+enum class SubscriptionAction {
+    Subscribe,
+    Unsubscribe
+};
+
+// Monta a mensagem de um lote de tópicos (ex: {"method":"SUBSCRIBE","params":[...]})
+using SubscriptionEncoder = std::function<std::string(SubscriptionAction action,
+                                                      const std::vector<std::string_view>& topics)>;
+
+struct SubscriptionConfig {
+    SubscriptionEncoder encode;                     // Obrigatório para subscribeTopics()
+    size_t maxTopicsPerMessage{100};                // Tópicos por mensagem aceitos pelo servidor (0 = sem limite)
+    double messagesPerSecond{5.0};                  // Ritmo das mensagens de assinatura (<= 0 = sem limite)
+    size_t burst{5};                                // Mensagens seguidas antes do ritmo valer
+};
+
+// ============================================
+// Rotação make-before-break
+// ============================================
+
+// Identidade de uma mensagem (ex: id sequencial); view vazia = sem chave
+using RotationKey = std::function<std::string_view(std::string_view message)>;
+using RotationSend = std::function<bool(std::string_view message)>;
+using OnRotationSubscribe = std::function<void(const RotationSend& send)>;
+
+struct RotationConfig {
+    std::chrono::milliseconds interval{0};              // Rotação periódica (0 = só rotate())
+    std::chrono::milliseconds overlapTimeout{10000};    // Espera máxima por mensagem em comum
+    size_t maxBuffered{100000};                         // Mensagens do novo link retidas até a troca
+    size_t keyWindow{100000};                           // Chaves do link antigo lembradas
+    RotationKey key;                                    // Obrigatório para rotacionar
+    OnRotationSubscribe subscribe;                      // Assina o novo link (vazio = reenvia subscribe())
+};
+
 // ============================================
 // Configuração do WebSocket
 // ============================================
 struct WebSocketConfig {
-    std::string url;
+    std::string url;                                // ws://, wss://, ws+unix:///sock:/path ou memory://nome
     std::chrono::milliseconds connectTimeout{10000};
     size_t maxMessageSize{16 * 1024 * 1024};        // 16MB
     bool autoReconnect{true};
-    int maxReconnectAttempts{5};
+    int maxReconnectAttempts{5};                    // Por queda (< 0 = sem limite)
+    std::chrono::milliseconds reconnectFirstDelay{0};     // 1ª tentativa (queda isolada volta logo)
+    std::chrono::milliseconds reconnectBaseDelay{200};    // Demais: aleatório em [0, base * 2^(n-2)]
+    std::chrono::milliseconds reconnectMaxDelay{30000};   // Teto do backoff exponencial
+    bool validateUtf8{false};                       // Valida o texto, fragmentos inclusive (fecha com 1007 se inválido)
+    std::chrono::milliseconds dnsCacheTtl{60000};   // Validade do cache de DNS do processo
+    std::chrono::milliseconds connectAttemptDelay{250};  // Happy Eyeballs: atraso entre tentativas
+    std::vector<std::string> endpoints{};           // URLs equivalentes a url: connect() corre todas
     
     // Configuração de ping/pong
-    PingConfig ping;
+    PingConfig ping{};
+    
+    // TLS (wss://): contexto compartilhado por todas as conexões com a mesma configuração
+    TlsConfig tls{};
+    
+    // Assinaturas por tópico: lotes, ritmo e reenvio após reconexão
+    SubscriptionConfig subscriptions{};
+    
+    // Rotação de conexão (policy::OwnThread)
+    RotationConfig rotation{};
+};
+
+// ============================================
+// Métricas (policy::MetricsOn)
+// ============================================
+
+// batchSizes[i]: leituras que entregaram [2^i, 2^(i+1)) mensagens (o último acumula o resto)
+constexpr size_t BatchSizeBuckets = 8;
+
+struct WebSocketStats {
+    uint64_t messagesReceived{0};
+    uint64_t bytesReceived{0};
+    uint64_t framesReceived{0};
+    uint64_t messagesSent{0};
+    uint64_t bytesSent{0};
+    uint64_t sendWrites{0};                 // Escritas no socket (envios concorrentes são combinados)
+    uint64_t jsonParseFailures{0};
+    uint64_t reconnects{0};
+    uint64_t reconnectAttempts{0};          // Inclui as que falharam
+    uint64_t lastRecoveryUs{0};             // Da queda à conexão restabelecida
+    uint64_t maxRecoveryUs{0};
+    uint64_t totalRecoveryUs{0};
+    uint64_t rotations{0};
+    std::array<uint64_t, BatchSizeBuckets> batchSizes{};
+};
+
+// ============================================
+// Corrida de endpoints
+// ============================================
+enum class EndpointOutcome {
+    Winner,     // Completou primeiro; conexão adotada
+    Slower,     // Completou depois do vencedor e foi fechado
+    Cancelled,  // Interrompido quando outro endpoint venceu
+    Failed      // Erro ou timeout antes de completar
+};
+
+struct EndpointTiming {
+    std::string url;
+    EndpointOutcome outcome{EndpointOutcome::Failed};
+    std::chrono::microseconds dns{0};       // Resolução (≈0 com cache)
+    std::chrono::microseconds tcp{0};       // Connect (Happy Eyeballs)
+    std::chrono::microseconds tls{0};       // Handshake TLS (0 em ws://)
+    bool tlsResumed{false};                 // Sessão retomada (handshake abreviado)
+    std::chrono::microseconds upgrade{0};   // GET → 101
+    std::chrono::microseconds total{0};     // Do início da corrida ao fim deste endpoint
+    int errorCode{0};
+    std::string error;
+};
+
+// ============================================
+// Entrega em lote
+// ============================================
+struct MessageView {
+    std::string_view data;
+    bool binary{false};
+};
+
+// Mensagens decodificadas de uma mesma leitura, em ordem de chegada.
+// Views válidas só durante o callback.
+struct MessageBatch {
+    const MessageView* messages{nullptr};
+    size_t count{0};
+    std::chrono::steady_clock::time_point receivedAt;  // Decodificação da primeira
+    
+    const MessageView* begin() const noexcept { return messages; }
+    const MessageView* end() const noexcept { return messages + count; }
+    const MessageView& operator[](size_t i) const noexcept { return messages[i]; }
+    size_t size() const noexcept { return count; }
+    bool empty() const noexcept { return count == 0; }
 };
 
 // ============================================
@@ -59,6 +192,9 @@ using OnConnect = std::function<void()>;
 using OnDisconnect = std::function<void(int code)>;
 using OnPing = std::function<void(std::string_view payload)>;
 using OnPong = std::function<void(std::string_view payload)>;
+using OnEndpointRace = std::function<void(const std::vector<EndpointTiming>& endpoints)>;
+using OnMessageBatch = std::function<void(const MessageBatch& batch)>;
+using OnReconnect = std::function<void(int attempts, std::chrono::microseconds downtime)>;
 
 // ============================================
 // Códigos de Erro
@@ -76,6 +212,7 @@ namespace ErrorCode {
     constexpr int InvalidFrame = 1009;
     constexpr int PingTimeout = 1010;
     constexpr int Disconnected = 1011;
+    constexpr int RotationFailed = 1012;
 }
 
 // ============================================
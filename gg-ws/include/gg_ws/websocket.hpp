@@ -2,12 +2,17 @@
 
 #include "types.hpp"
 #include "json.hpp"
+#include "policies.hpp"
+#include "router.hpp"
 
 #include <chrono>
 #include <functional>
+#include <limits>
 #include <memory>
 #include <string>
 #include <string_view>
+#include <type_traits>
+#include <vector>
 
 namespace gg {
 
@@ -21,6 +26,21 @@ namespace gg {
  * - CPU affinity via pinThread()
  * - Parser JSON integrado
  * 
+ * Os recursos são escolhidos em tempo de compilação pelo PolicySet (ver
+ * policies.hpp). Use os aliases:
+ * - gg::WebSocket: políticas default (todas as features)
+ * - gg::BasicWebSocket<Policies...>: qualquer combinação
+ * 
+ * Métodos de features desligadas não existem no tipo (erro de compilação),
+ * e o caminho de recepção não contém branches para elas.
+ * 
+ * Callbacks podem ser trocados a qualquer momento; o dispatch não usa lock
+ * (lê um snapshot atômico). Por isso onError pode rodar na thread de
+ * heartbeat ao mesmo tempo que callbacks de mensagem na thread de I/O.
+ * O callback (ou router) substituído é destruído, com suas captures, no
+ * próprio setter se não houver despacho em andamento, senão na volta
+ * seguinte do loop de I/O (ou na próxima chamada de poll()).
+ * 
  * Exemplo:
  * @code
  *   gg::WebSocket ws({
@@ -37,18 +57,21 @@ namespace gg {
  *   ws.connect();
  * @endcode
  */
-class WebSocket {
+template<typename Policies>
+class WebSocketClient {
 public:
-    explicit WebSocket(WebSocketConfig config);
-    ~WebSocket();
+    using policies = Policies;
+    
+    explicit WebSocketClient(WebSocketConfig config);
+    ~WebSocketClient();
     
     // Não copiável
-    WebSocket(const WebSocket&) = delete;
-    WebSocket& operator=(const WebSocket&) = delete;
+    WebSocketClient(const WebSocketClient&) = delete;
+    WebSocketClient& operator=(const WebSocketClient&) = delete;
     
     // Movível
-    WebSocket(WebSocket&& other) noexcept;
-    WebSocket& operator=(WebSocket&& other) noexcept;
+    WebSocketClient(WebSocketClient&& other) noexcept;
+    WebSocketClient& operator=(WebSocketClient&& other) noexcept;
 
     // ============================================
     // CPU Affinity
@@ -60,7 +83,8 @@ public:
      * @return true se sucesso, false se falhou (núcleo inválido ou sem permissão)
      * @note Deve ser chamado ANTES de connect() para maior efetividade
      */
-    bool pinThread(int core);
+    template<typename P = Policies, std::enable_if_t<P::threaded, int> = 0>
+    bool pinThread(int core) { return setPinnedCore(core); }
     
     /**
      * @brief Retorna o número de núcleos disponíveis na CPU.
@@ -90,8 +114,64 @@ public:
     
     /**
      * @brief Aguarda até desconectar (bloqueante).
+     * @note Reconexões em andamento não contam: retorna após disconnect()
+     *       ou quando as tentativas se esgotam
+     */
+    template<typename P = Policies, std::enable_if_t<P::threaded, int> = 0>
+    void wait() { waitStopped(); }
+    
+    /**
+     * @brief Troca a conexão sem buraco nem duplicata (make-before-break).
+     * 
+     * Abre e assina (RotationConfig::subscribe) um novo link enquanto o atual
+     * continua entregando; o novo só disca depois que o atual entrega a
+     * primeira mensagem da rotação (a chave só é calculada na rotação). Quando os dois viram a mesma mensagem (mesma
+     * RotationConfig::key), a entrega passa para o novo link, mensagens já
+     * entregues pelo antigo são descartadas e o antigo é fechado. Com
+     * RotationConfig::interval, roda periodicamente em thread própria.
+     * 
+     * @return true se a troca aconteceu; false mantém o link atual
+     *         (erro reportado como ErrorCode::RotationFailed)
+     * @note Bloqueia até a troca ou overlapTimeout. Se o servidor fechar o
+     *       link antigo durante a rotação, a troca é imediata.
+     */
+    template<typename P = Policies, std::enable_if_t<P::threaded && !P::memory, int> = 0>
+    bool rotate() { return rotateConnection(); }
+    
+    // ============================================
+    // Loop externo (ExternalDriven)
+    // ============================================
+    
+    /**
+     * @brief Lê, decodifica e despacha frames na thread do caller.
+     * 
+     * Envios pendentes (sendAsync) são descarregados antes da leitura e o
+     * heartbeat avança aqui. Callbacks rodam dentro desta chamada.
+     * 
+     * @param budget Máximo de frames despachados nesta chamada
+     * @param timeoutMs Espera máxima por dados se nada estiver disponível (0 = não bloqueia)
+     * @return Número de frames processados
+     * @note Se o budget esgotar, frames restantes ficam no buffer interno e
+     *       não acordam epoll: consulte hasBufferedData()
+     */
+    template<typename P = Policies, std::enable_if_t<P::externalDriven, int> = 0>
+    size_t poll(size_t budget = std::numeric_limits<size_t>::max(), int timeoutMs = 0) {
+        return pollFrames(budget, timeoutMs);
+    }
+    
+    /**
+     * @brief Descritor do socket, para registrar no epoll/poll do caller.
+     * @return fd, ou -1 se desconectado (sempre -1 com MemoryTransport)
+     * @note Muda a cada (re)conexão: registre novamente em onConnect()
      */
-    void wait();
+    template<typename P = Policies, std::enable_if_t<P::externalDriven, int> = 0>
+    [[nodiscard]] int fd() const noexcept { return nativeHandle(); }
+    
+    /**
+     * @brief Há bytes já lidos (ou decifrados pelo TLS) aguardando poll().
+     */
+    template<typename P = Policies, std::enable_if_t<P::externalDriven, int> = 0>
+    [[nodiscard]] bool hasBufferedData() const noexcept { return bufferedData(); }
 
     // ============================================
     // Envio (Thread-Safe)
@@ -101,15 +181,33 @@ public:
      * @brief Envia mensagem de texto.
      * @param message Mensagem a enviar
      * @return true se enviado com sucesso
+     * @note Com OwnThread, envios concorrentes são combinados: uma das threads
+     *       escreve os frames de todas numa única escrita e cada uma recebe
+     *       o status da escrita que levou o seu frame.
      */
     bool send(std::string_view message);
     
+    /**
+     * @brief Sobrecargas para literais e std::string (evitam ambiguidade com Json).
+     */
+    bool send(const char* message);
+    bool send(const std::string& message);
+    
     /**
      * @brief Envia objeto JSON.
+     *
+     * Serializa num buffer da thread, reaproveitado entre envios (sem
+     * string temporária por mensagem).
      * @param message JSON a enviar
      * @return true se enviado com sucesso
      */
-    bool send(const Json& message);
+    template<typename P = Policies, std::enable_if_t<P::json, int> = 0>
+    bool send(const Json& message) {
+        thread_local std::string buffer;
+        buffer.clear();
+        message.stringify(buffer);
+        return send(std::string_view(buffer));
+    }
     
     /**
      * @brief Envia dados binários.
@@ -126,6 +224,60 @@ public:
      */
     void sendAsync(std::string_view message);
 
+    // ============================================
+    // Assinaturas
+    // ============================================
+    
+    /**
+     * @brief Envia e registra uma mensagem de assinatura.
+     * 
+     * Assinaturas registradas são reenviadas, na ordem de registro, a cada
+     * (re)conexão antes de qualquer outro envio, e no novo link de uma
+     * rotação sem RotationConfig::subscribe.
+     * 
+     * @return true se enviada agora; desconectado, só registra (sai no connect)
+     * @note Mensagem repetida não é registrada duas vezes
+     */
+    bool subscribe(std::string_view message);
+    
+    /**
+     * @brief Remove uma assinatura do registro.
+     * @param unsubscribeMessage Enviada se não vazia e conectado
+     * @return true se a assinatura estava registrada
+     */
+    bool unsubscribe(std::string_view message, std::string_view unsubscribeMessage = {});
+    
+    /**
+     * @brief Assinaturas registradas, na ordem de reenvio.
+     */
+    [[nodiscard]] std::vector<std::string> subscriptions() const;
+    
+    /**
+     * @brief Assina tópicos em lote (WebSocketConfig::subscriptions).
+     * 
+     * Pedidos pendentes são agrupados em mensagens de até maxTopicsPerMessage
+     * tópicos, montadas por SubscriptionConfig::encode e enviadas no ritmo
+     * messagesPerSecond/burst. Assinar e cancelar o mesmo tópico antes do
+     * envio se anulam. A cada (re)conexão o conjunto ativo é reenviado no
+     * menor número de mensagens, depois das de subscribe().
+     * 
+     * @return false se SubscriptionConfig::encode não foi definido
+     * @note O que o ritmo não deixa sair agora vai pela thread de I/O
+     *       (OwnThread) ou pelo próximo poll() (ExternalDriven)
+     */
+    bool subscribeTopics(const std::vector<std::string>& topics);
+    
+    /**
+     * @brief Cancela tópicos (mensagens SubscriptionAction::Unsubscribe em lote).
+     * @return false se SubscriptionConfig::encode não foi definido
+     */
+    bool unsubscribeTopics(const std::vector<std::string>& topics);
+    
+    /**
+     * @brief Tópicos ativos, na ordem de assinatura.
+     */
+    [[nodiscard]] std::vector<std::string> topics() const;
+
     // ============================================
     // Ping/Pong
     // ============================================
@@ -153,17 +305,20 @@ public:
     /**
      * @brief Altera modo de ping em runtime.
      */
-    void setPingMode(PingMode mode);
+    template<typename P = Policies, std::enable_if_t<P::heartbeat, int> = 0>
+    void setPingMode(PingMode mode) { configureHeartbeat(&mode, nullptr, nullptr); }
     
     /**
      * @brief Altera intervalo de ping em runtime.
      */
-    void setPingInterval(std::chrono::milliseconds interval);
+    template<typename P = Policies, std::enable_if_t<P::heartbeat, int> = 0>
+    void setPingInterval(std::chrono::milliseconds interval) { configureHeartbeat(nullptr, &interval, nullptr); }
     
     /**
      * @brief Altera timeout de pong em runtime.
      */
-    void setPingTimeout(std::chrono::milliseconds timeout);
+    template<typename P = Policies, std::enable_if_t<P::heartbeat, int> = 0>
+    void setPingTimeout(std::chrono::milliseconds timeout) { configureHeartbeat(nullptr, nullptr, &timeout); }
     
     /**
      * @brief Ativa/desativa auto pong.
@@ -178,13 +333,33 @@ public:
      * @brief Define callback para mensagens JSON.
      * @note Tenta parsear como JSON, se falhar não é chamado
      */
-    void onMessage(OnMessage callback);
+    template<typename P = Policies, std::enable_if_t<P::json, int> = 0>
+    void onMessage(OnMessage callback) { setJsonCallback(std::move(callback)); }
     
     /**
      * @brief Define callback para mensagens raw (texto).
      */
     void onRawMessage(OnRawMessage callback);
     
+    /**
+     * @brief Define callback para todas as mensagens de uma leitura de uma vez.
+     * 
+     * Um recv que traz N frames gera uma chamada com N views (texto e
+     * binário, em ordem), depois dos callbacks por mensagem: um burst é
+     * processado numa chamada, com dados contíguos no cache.
+     * 
+     * @note As views apontam para o buffer de recepção: copie o que precisar
+     *       guardar depois do retorno
+     */
+    void onMessageBatch(OnMessageBatch callback);
+    
+    /**
+     * @brief Encaminha cada mensagem ao handler escolhido pelo router.
+     * @param router Router com os handlers (build() é chamado se preciso)
+     * @note Roda depois de onRawMessage, sem parse JSON. Substitui o router anterior.
+     */
+    void route(MessageRouter router);
+    
     /**
      * @brief Define callback para erros.
      */
@@ -200,6 +375,13 @@ public:
      */
     void onDisconnect(OnDisconnect callback);
     
+    /**
+     * @brief Define callback para reconexão automática bem-sucedida.
+     * @note Chamado depois de onConnect(), com as tentativas gastas e o tempo
+     *       desde a queda
+     */
+    void onReconnect(OnReconnect callback);
+    
     /**
      * @brief Define callback para pings recebidos.
      */
@@ -210,23 +392,100 @@ public:
      */
     void onPong(OnPong callback);
 
+    // ============================================
+    // Fan-out para outros processos
+    // ============================================
+    
+    /**
+     * @brief Publica cada mensagem recebida num ring SPMC em memória compartilhada.
+     * @param name Nome POSIX do segmento (ex: "/gg_btcusdt")
+     * @param capacity Tamanho do ring em bytes (arredondado para potência de 2)
+     * @return true se o segmento foi criado/aberto
+     * @note Deve ser chamado ANTES de connect(). A publicação roda na thread de
+     *       I/O antes dos callbacks; consumidores usam gg::ShmSubscriber
+     *       (gg_ws/shm_ring.hpp) e nunca bloqueiam o publisher.
+     */
+    bool publishToSharedMemory(std::string_view name, size_t capacity = 64 * 1024 * 1024);
+    
     // ============================================
     // Configuração
     // ============================================
     
     /**
-     * @brief Retorna a URL de conexão.
+     * @brief Retorna a URL da conexão atual (vencedora da última corrida).
      */
     [[nodiscard]] std::string_view url() const noexcept;
     
+    /**
+     * @brief Tempos por endpoint da última corrida de connect().
+     * 
+     * Com WebSocketConfig::endpoints, connect() (e cada reconexão) roda DNS,
+     * TCP, TLS e upgrade de todos os candidatos em paralelo; o primeiro a
+     * completar vence e os demais são fechados.
+     */
+    [[nodiscard]] std::vector<EndpointTiming> endpointTimings() const;
+    
+    /**
+     * @brief Callback chamado ao fim de cada corrida (sucesso ou falha).
+     */
+    void onEndpointRace(OnEndpointRace callback);
+    
     /**
      * @brief Ativa/desativa reconexão automática.
+     * 
+     * Após uma queda (erro, EOF, Close do servidor ou pong timeout), a
+     * primeira tentativa espera reconnectFirstDelay; as seguintes usam
+     * backoff exponencial com jitter total (ver WebSocketConfig). Com
+     * OwnThread, um supervisor reconecta fora da thread de I/O; com
+     * ExternalDriven, poll() dispara cada tentativa, que disca numa thread
+     * auxiliar, e adota o link pronto (callbacks seguem na thread do
+     * caller e poll(0) não bloqueia durante a discagem).
      */
     void setAutoReconnect(bool enabled);
 
+    // ============================================
+    // Métricas
+    // ============================================
+    
+    /**
+     * @brief Retorna snapshot dos contadores (MetricsOn).
+     */
+    template<typename P = Policies, std::enable_if_t<P::metrics, int> = 0>
+    [[nodiscard]] WebSocketStats stats() const noexcept { return readStats(); }
+
 private:
     struct Impl;
     std::unique_ptr<Impl> impl_;
+    
+    // Implementações das APIs condicionais (existem em todas as instanciações)
+    bool setPinnedCore(int core);
+    void waitStopped();
+    bool rotateConnection();
+    size_t pollFrames(size_t budget, int timeoutMs);
+    int nativeHandle() const noexcept;
+    bool bufferedData() const noexcept;
+    void setJsonCallback(OnMessage callback);
+    void configureHeartbeat(const PingMode* mode,
+                            const std::chrono::milliseconds* interval,
+                            const std::chrono::milliseconds* timeout);
+    WebSocketStats readStats() const noexcept;
 };
 
+/**
+ * @brief WebSocket com políticas escolhidas em tempo de compilação.
+ * 
+ * Aceita políticas de gg::policy em qualquer ordem; categorias omitidas
+ * usam o default (AutoTransport, OwnThread, JsonOn, HeartbeatOn, MetricsOn).
+ */
+template<typename... Policies>
+using BasicWebSocket = WebSocketClient<ResolvePoliciesT<Policies...>>;
+
+/**
+ * @brief Cliente completo com as políticas default.
+ */
+using WebSocket = BasicWebSocket<>;
+
+// Todas as combinações são instanciadas em websocket.cpp
+extern template class WebSocketClient<ResolvePoliciesT<>>;
+
 } // namespace gg
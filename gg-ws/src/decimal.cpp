@@ -0,0 +1,126 @@
+#include "gg_ws/decimal.hpp"
+#include "internal/json_number.hpp"
+
+#include <charconv>
+#include <cmath>
+#include <cstdio>
+
+namespace gg {
+
+namespace {
+
+constexpr int64_t PowersOfTen[] = {
+    1LL, 10LL, 100LL, 1000LL, 10000LL, 100000LL, 1000000LL, 10000000LL, 100000000LL,
+    1000000000LL, 10000000000LL, 100000000000LL, 1000000000000LL, 10000000000000LL,
+    100000000000000LL, 1000000000000000LL, 10000000000000000LL, 100000000000000000LL,
+    1000000000000000000LL
+};
+
+// Maior mantissa que ainda pode ser multiplicada por 10^k (sem divisão no caminho quente)
+constexpr int64_t MaxBeforeScaling[] = {
+    INT64_MAX / PowersOfTen[0],  INT64_MAX / PowersOfTen[1],  INT64_MAX / PowersOfTen[2],
+    INT64_MAX / PowersOfTen[3],  INT64_MAX / PowersOfTen[4],  INT64_MAX / PowersOfTen[5],
+    INT64_MAX / PowersOfTen[6],  INT64_MAX / PowersOfTen[7],  INT64_MAX / PowersOfTen[8],
+    INT64_MAX / PowersOfTen[9],  INT64_MAX / PowersOfTen[10], INT64_MAX / PowersOfTen[11],
+    INT64_MAX / PowersOfTen[12], INT64_MAX / PowersOfTen[13], INT64_MAX / PowersOfTen[14],
+    INT64_MAX / PowersOfTen[15], INT64_MAX / PowersOfTen[16], INT64_MAX / PowersOfTen[17],
+    INT64_MAX / PowersOfTen[18]
+};
+
+uint64_t magnitude(int64_t value) noexcept {
+    return value < 0 ? 0 - static_cast<uint64_t>(value) : static_cast<uint64_t>(value);
+}
+
+} // anonymous namespace
+
+std::optional<Decimal> Decimal::parse(std::string_view text) noexcept {
+    if (text.empty()) return std::nullopt;
+    const char* end = text.data() + text.size();
+    Decimal result;
+    if (internal::json::parseDecimal(text.data(), end, result.mantissa, result.scale) != end) {
+        return std::nullopt;
+    }
+    return result;
+}
+
+std::optional<Decimal> Decimal::fromDouble(double value) noexcept {
+    if (!std::isfinite(value)) return std::nullopt;
+    char buffer[32];
+#if defined(__cpp_lib_to_chars)
+    auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    if (result.ec != std::errc()) return std::nullopt;
+    const size_t length = static_cast<size_t>(result.ptr - buffer);
+#else
+    const int written = std::snprintf(buffer, sizeof(buffer), "%.17g", value);
+    if (written <= 0 || static_cast<size_t>(written) >= sizeof(buffer)) return std::nullopt;
+    const size_t length = static_cast<size_t>(written);
+#endif
+    return parse(std::string_view(buffer, length));
+}
+
+double Decimal::toDouble() const noexcept {
+    return internal::json::decimalToDouble(magnitude(mantissa), -static_cast<int64_t>(scale), mantissa < 0);
+}
+
+std::optional<int64_t> Decimal::toTicks(uint8_t tickScale) const noexcept {
+    if (scale > MaxScale || tickScale > MaxScale) return std::nullopt;
+    if (tickScale >= scale) {
+        const int shift = tickScale - scale;
+        if (magnitude(mantissa) > static_cast<uint64_t>(MaxBeforeScaling[shift])) return std::nullopt;
+        return mantissa * PowersOfTen[shift];
+    }
+    // Menos casas: só se as descartadas forem zero
+    const int64_t divisor = PowersOfTen[scale - tickScale];
+    if (mantissa % divisor != 0) return std::nullopt;
+    return mantissa / divisor;
+}
+
+char* Decimal::toChars(char* out) const noexcept {
+    if (mantissa < 0) *out++ = '-';
+    char digits[20];
+    auto result = std::to_chars(digits, digits + sizeof(digits), magnitude(mantissa));
+    const size_t count = static_cast<size_t>(result.ptr - digits);
+
+    if (scale == 0) {
+        std::char_traits<char>::copy(out, digits, count);
+        return out + count;
+    }
+    if (scale > MaxScale) {
+        // "0." + scale casas não tem limite: mesmo valor com expoente
+        std::char_traits<char>::copy(out, digits, count);
+        out += count;
+        *out++ = 'e';
+        *out++ = '-';
+        return std::to_chars(out, out + 3, scale).ptr;
+    }
+    if (count <= scale) {
+        // 0.000123: zeros entre o ponto e os dígitos
+        *out++ = '0';
+        *out++ = '.';
+        for (size_t i = count; i < scale; ++i) *out++ = '0';
+        std::char_traits<char>::copy(out, digits, count);
+        return out + count;
+    }
+    const size_t integerDigits = count - scale;
+    std::char_traits<char>::copy(out, digits, integerDigits);
+    out += integerDigits;
+    *out++ = '.';
+    std::char_traits<char>::copy(out, digits + integerDigits, scale);
+    return out + scale;
+}
+
+std::string Decimal::toString() const {
+    char buffer[MaxChars];
+    return std::string(buffer, toChars(buffer));
+}
+
+bool Decimal::operator==(const Decimal& other) const noexcept {
+    if (scale == other.scale) return mantissa == other.mantissa;
+    // Leva os dois à maior escala; estouro significa valores diferentes
+    const uint8_t common = scale > other.scale ? scale : other.scale;
+    auto a = toTicks(common);
+    auto b = other.toTicks(common);
+    return a && b && *a == *b;
+}
+
+} // namespace gg
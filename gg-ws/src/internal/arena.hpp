@@ -0,0 +1,88 @@
+#pragma once
+
+/**
+ * @file arena.hpp
+ * @brief Arena monotônica: alocação por incremento de ponteiro, liberação em bloco.
+ *
+ * Não há free individual: reset() devolve tudo de uma vez. Se a arena
+ * precisou de mais de um bloco, reset() os troca por um único bloco do
+ * tamanho somado, e a próxima rodada do mesmo tamanho não aloca nada.
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <vector>
+
+namespace gg::internal {
+
+class MonotonicArena {
+public:
+    explicit MonotonicArena(size_t initialBytes = 4096)
+        : initialBytes_(std::max<size_t>(initialBytes, 64)) {}
+
+    MonotonicArena(const MonotonicArena&) = delete;
+    MonotonicArena& operator=(const MonotonicArena&) = delete;
+
+    /**
+     * @brief Reserva `bytes` alinhados a `align` (potência de 2).
+     * @note Lança std::bad_alloc se o sistema negar um bloco novo
+     */
+    void* allocate(size_t bytes, size_t align = alignof(std::max_align_t)) {
+        uintptr_t cursor = (reinterpret_cast<uintptr_t>(cursor_) + (align - 1)) & ~static_cast<uintptr_t>(align - 1);
+        if (cursor_ && cursor + bytes <= reinterpret_cast<uintptr_t>(end_)) {
+            cursor_ = reinterpret_cast<char*>(cursor + bytes);
+            return reinterpret_cast<void*>(cursor);
+        }
+        grow(bytes + align);
+        return allocate(bytes, align);
+    }
+
+    template<typename T>
+    T* allocateArray(size_t count) {
+        return static_cast<T*>(allocate(sizeof(T) * count, alignof(T)));
+    }
+
+    /**
+     * @brief Libera tudo, mantendo (e consolidando) a memória.
+     */
+    void reset() noexcept {
+        if (blocks_.size() > 1) {
+            // Um bloco só com a capacidade que a última rodada precisou
+            size_t total = capacity_;
+            blocks_.clear();
+            capacity_ = 0;
+            cursor_ = end_ = nullptr;
+            auto* block = new (std::nothrow) char[total];
+            if (block) {
+                blocks_.emplace_back(block);
+                capacity_ = total;
+                end_ = block + total;
+            }
+        }
+        cursor_ = blocks_.empty() ? nullptr : blocks_.front().get();
+    }
+
+    [[nodiscard]] size_t capacity() const noexcept { return capacity_; }
+    [[nodiscard]] size_t blocks() const noexcept { return blocks_.size(); }
+
+private:
+    size_t initialBytes_;
+    std::vector<std::unique_ptr<char[]>> blocks_;
+    char* cursor_ = nullptr;
+    char* end_ = nullptr;
+    size_t capacity_ = 0;
+
+    void grow(size_t minimum) {
+        // Dobra a cada bloco: poucas alocações até o tamanho de regime
+        size_t size = std::max({minimum, initialBytes_, capacity_});
+        blocks_.emplace_back(new char[size]);
+        cursor_ = blocks_.back().get();
+        end_ = cursor_ + size;
+        capacity_ += size;
+    }
+};
+
+} // namespace gg::internal
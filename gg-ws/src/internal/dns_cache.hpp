@@ -0,0 +1,262 @@
+#pragma once
+
+/**
+ * @file dns_cache.hpp
+ * @brief Cache de DNS do processo, compartilhado por todas as conexões.
+ *
+ * getaddrinfo não informa o TTL do registro; cada entrada expira após o TTL
+ * passado pelo chamador (WebSocketConfig::dnsCacheTtl). Falhas não são
+ * cacheadas. Um miss entra numa fila atendida por até MaxResolvers threads
+ * (criadas sob demanda, encerradas quando a fila esvazia e juntadas no fim
+ * do processo), para que o connectTimeout também limite a espera pelo
+ * resolver. Misses simultâneos do mesmo host:port esperam a mesma consulta.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#ifdef _WIN32
+    #include <winsock2.h>
+    #include <ws2tcpip.h>
+#else
+    #include <netdb.h>
+    #include <sys/socket.h>
+#endif
+
+namespace gg::internal {
+
+/**
+ * @brief Endereço pronto para connect().
+ */
+struct ResolvedAddress {
+    sockaddr_storage addr{};
+    socklen_t len = 0;
+    int family = AF_UNSPEC;
+};
+
+class DnsCache {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    enum class Status {
+        Ok,
+        NotFound,
+        Timeout
+    };
+
+    static DnsCache& instance() {
+        static DnsCache cache;
+        return cache;
+    }
+
+    /**
+     * @brief Resolve host:port (IPv4 e IPv6), consultando o cache antes.
+     * @param ttl Validade da entrada criada por um miss
+     * @param deadline Limite para esperar o resolver
+     * @param cancel Se não nulo e virar true, desiste da espera (retorna Timeout)
+     */
+    Status resolve(const std::string& host, uint16_t port, std::chrono::milliseconds ttl,
+                   Clock::time_point deadline, std::vector<ResolvedAddress>& out,
+                   const std::atomic<bool>* cancel = nullptr) {
+        const std::string key = makeKey(host, port);
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = entries_.find(key);
+            if (it != entries_.end() && Clock::now() < it->second.expires) {
+                out = it->second.addresses;
+                hits_.fetch_add(1, std::memory_order_relaxed);
+                return Status::Ok;
+            }
+        }
+        misses_.fetch_add(1, std::memory_order_relaxed);
+
+        // IP literal não precisa de resolver nem de cache
+        if (lookup(host, port, AI_NUMERICHOST, out)) {
+            return Status::Ok;
+        }
+
+        // Resolver bloqueante na fila; se o deadline estourar, a consulta
+        // continua e o resultado ainda entra no cache
+        std::shared_future<std::vector<ResolvedAddress>> future;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = pending_.find(key);
+            if (it != pending_.end()) {
+                future = it->second;
+            } else {
+                Job job{key, host, port, ttl, {}};
+                future = job.result.get_future().share();
+                pending_.emplace(key, future);
+                queue_.push_back(std::move(job));
+                startResolver();
+            }
+        }
+
+        // Espera em fatias curtas para reagir ao cancelamento
+        for (;;) {
+            auto slice = std::min(deadline, Clock::now() + std::chrono::milliseconds(10));
+            if (future.wait_until(slice) == std::future_status::ready) break;
+            if (Clock::now() >= deadline || (cancel && cancel->load(std::memory_order_relaxed))) {
+                return Status::Timeout;
+            }
+        }
+        out = future.get();
+        return out.empty() ? Status::NotFound : Status::Ok;
+    }
+
+    /**
+     * @brief Grava (ou substitui) uma entrada; útil para pré-aquecer o cache.
+     */
+    void insert(const std::string& host, uint16_t port,
+                std::vector<ResolvedAddress> addresses, std::chrono::milliseconds ttl) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        entries_[makeKey(host, port)] = Entry{std::move(addresses), Clock::now() + ttl};
+    }
+
+    void invalidate(const std::string& host, uint16_t port) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        entries_.erase(makeKey(host, port));
+    }
+
+    void clear() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        entries_.clear();
+    }
+
+    uint64_t hits() const noexcept { return hits_.load(std::memory_order_relaxed); }
+    uint64_t misses() const noexcept { return misses_.load(std::memory_order_relaxed); }
+
+    DnsCache(const DnsCache&) = delete;
+    DnsCache& operator=(const DnsCache&) = delete;
+
+    ~DnsCache() {
+        std::vector<std::thread> resolvers;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+            resolvers.swap(resolvers_);
+        }
+        for (auto& resolver : resolvers) {
+            resolver.join();
+        }
+    }
+
+private:
+    // Consultas em paralelo (um host que não responde não segura os demais)
+    static constexpr size_t MaxResolvers = 4;
+
+    struct Entry {
+        std::vector<ResolvedAddress> addresses;
+        Clock::time_point expires;
+    };
+
+    struct Job {
+        std::string key;
+        std::string host;
+        uint16_t port;
+        std::chrono::milliseconds ttl;
+        std::promise<std::vector<ResolvedAddress>> result;
+    };
+
+    std::mutex mutex_;
+    std::unordered_map<std::string, Entry> entries_;
+    std::atomic<uint64_t> hits_{0};
+    std::atomic<uint64_t> misses_{0};
+
+    // Sob mutex_
+    std::unordered_map<std::string, std::shared_future<std::vector<ResolvedAddress>>> pending_;
+    std::deque<Job> queue_;
+    std::vector<std::thread> resolvers_;
+    std::vector<std::thread::id> finished_;     // Saíram do loop; falta o join
+    size_t activeResolvers_ = 0;
+    bool stop_ = false;
+
+    DnsCache() = default;
+
+    // Sob mutex_, com job novo na fila
+    void startResolver() {
+        // Junta as que já saíram (não tocam mais no mutex)
+        for (auto id : finished_) {
+            auto it = std::find_if(resolvers_.begin(), resolvers_.end(),
+                                   [id](const std::thread& t) { return t.get_id() == id; });
+            if (it != resolvers_.end()) {
+                it->join();
+                resolvers_.erase(it);
+            }
+        }
+        finished_.clear();
+
+        if (!stop_ && activeResolvers_ < MaxResolvers) {
+            activeResolvers_++;
+            resolvers_.emplace_back(&DnsCache::resolverLoop, this);
+        }
+    }
+
+    // Atende a fila até esvaziar; no fim do processo só descarta
+    void resolverLoop() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (!queue_.empty()) {
+            Job job = std::move(queue_.front());
+            queue_.pop_front();
+            const bool stopping = stop_;
+            lock.unlock();
+
+            std::vector<ResolvedAddress> addresses;
+            if (!stopping) {
+                lookup(job.host, job.port, AI_ADDRCONFIG, addresses);
+            }
+
+            lock.lock();
+            if (!addresses.empty()) {
+                entries_[job.key] = Entry{addresses, Clock::now() + job.ttl};
+            }
+            pending_.erase(job.key);
+            job.result.set_value(std::move(addresses));
+        }
+        activeResolvers_--;
+        finished_.push_back(std::this_thread::get_id());
+    }
+
+    static std::string makeKey(const std::string& host, uint16_t port) {
+        return host + ':' + std::to_string(port);
+    }
+
+    static bool lookup(const std::string& host, uint16_t port, int flags,
+                       std::vector<ResolvedAddress>& out) {
+        addrinfo hints{};
+        hints.ai_family = AF_UNSPEC;
+        hints.ai_socktype = SOCK_STREAM;
+        hints.ai_flags = flags;
+
+        addrinfo* result = nullptr;
+        std::string portStr = std::to_string(port);
+        if (getaddrinfo(host.c_str(), portStr.c_str(), &hints, &result) != 0) {
+            return false;
+        }
+
+        out.clear();
+        for (addrinfo* ai = result; ai; ai = ai->ai_next) {
+            if (ai->ai_family != AF_INET && ai->ai_family != AF_INET6) continue;
+            ResolvedAddress address;
+            std::memcpy(&address.addr, ai->ai_addr, ai->ai_addrlen);
+            address.len = static_cast<socklen_t>(ai->ai_addrlen);
+            address.family = ai->ai_family;
+            out.push_back(address);
+        }
+        freeaddrinfo(result);
+        return !out.empty();
+    }
+};
+
+} // namespace gg::internal
@@ -62,10 +62,48 @@ public:
         timerThread_ = std::thread(&HeartbeatManager::timerLoop, this);
     }
     
+    /**
+     * @brief Arma o heartbeat sem thread própria (modo ExternalDriven).
+     * @note O dono deve chamar tick() periodicamente na sua própria thread.
+     */
+    void startManual(SendPingFn sendPing, SendTextPingFn sendTextPing, OnTimeoutFn onTimeout) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        
+        if (config_.mode == PingMode::Disabled) {
+            return;
+        }
+        
+        sendPing_ = std::move(sendPing);
+        sendTextPing_ = std::move(sendTextPing);
+        onTimeout_ = std::move(onTimeout);
+        
+        manual_ = true;
+        waitingPong_.store(false, std::memory_order_release);
+        nextBeat_ = std::chrono::steady_clock::now() + config_.interval;
+    }
+    
+    /**
+     * @brief Executa o heartbeat se o intervalo venceu (modo manual).
+     */
+    void tick(std::chrono::steady_clock::time_point now) {
+        if (!manual_ || now < nextBeat_) {
+            return;
+        }
+        
+        std::unique_lock<std::mutex> lock(mutex_);
+        auto timeout = config_.timeout;
+        auto mode = config_.mode;
+        nextBeat_ = now + config_.interval;
+        lock.unlock();
+        
+        beat(timeout, mode);
+    }
+    
     /**
      * @brief Para o timer de heartbeat.
      */
     void stop() {
+        manual_ = false;
         {
             std::lock_guard<std::mutex> lock(mutex_);
             if (!running_.load(std::memory_order_acquire)) {
@@ -110,9 +148,12 @@ public:
      * @brief Altera modo de ping em runtime.
      */
     void setMode(PingMode mode) {
-        std::lock_guard<std::mutex> lock(mutex_);
-        config_.mode = mode;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            config_.mode = mode;
+        }
         
+        // stop() pega mutex_ e junta a thread do timer
         if (mode == PingMode::Disabled) {
             stop();
         }
@@ -134,6 +175,9 @@ private:
     std::chrono::steady_clock::time_point lastPingSent_;
     std::chrono::steady_clock::time_point lastPongReceived_;
     
+    bool manual_ = false;
+    std::chrono::steady_clock::time_point nextBeat_;
+    
     std::thread timerThread_;
     mutable std::mutex mutex_;
     std::condition_variable cv_;
@@ -164,31 +208,35 @@ private:
                 break;
             }
             
-            // Verifica timeout do pong anterior
-            if (waitingPong_.load(std::memory_order_acquire)) {
-                auto elapsed = std::chrono::steady_clock::now() - lastPingSent_;
-                if (elapsed > timeout) {
-                    // Timeout! Chama callback
-                    if (onTimeout_) {
-                        onTimeout_();
-                    }
-                    waitingPong_.store(false, std::memory_order_release);
-                    continue;
+            beat(timeout, mode);
+        }
+    }
+    
+    void beat(std::chrono::milliseconds timeout, PingMode mode) {
+        // Verifica timeout do pong anterior
+        if (waitingPong_.load(std::memory_order_acquire)) {
+            auto elapsed = std::chrono::steady_clock::now() - lastPingSent_;
+            if (elapsed > timeout) {
+                // Timeout! Chama callback
+                if (onTimeout_) {
+                    onTimeout_();
                 }
+                waitingPong_.store(false, std::memory_order_release);
+                return;
             }
-            
-            // Envia ping
-            bool sent = false;
-            if (mode == PingMode::Opcode && sendPing_) {
-                sent = sendPing_();
-            } else if (mode == PingMode::TextMessage && sendTextPing_) {
-                sent = sendTextPing_(config_.textMessage);
-            }
-            
-            if (sent) {
-                lastPingSent_ = std::chrono::steady_clock::now();
-                waitingPong_.store(true, std::memory_order_release);
-            }
+        }
+        
+        // Envia ping
+        bool sent = false;
+        if (mode == PingMode::Opcode && sendPing_) {
+            sent = sendPing_();
+        } else if (mode == PingMode::TextMessage && sendTextPing_) {
+            sent = sendTextPing_(config_.textMessage);
+        }
+        
+        if (sent) {
+            lastPingSent_ = std::chrono::steady_clock::now();
+            waitingPong_.store(true, std::memory_order_release);
         }
     }
 };
@@ -0,0 +1,133 @@
+#pragma once
+
+/**
+ * @file json_lexer.hpp
+ * @brief Peças de tokenização JSON sobre ponteiros crus (sem alocação).
+ *
+ * Usadas no estágio 2 dos parsers (Json::parse, JsonDocument): validam a
+ * gramática de strings e decodificam escapes direto num buffer do
+ * chamador. Números ficam em json_number.hpp.
+ */
+
+#include <cstddef>
+#include <cstdint>
+
+namespace gg::internal::json {
+
+inline bool isSpace(char c) noexcept {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+inline bool isDigit(char c) noexcept {
+    return c >= '0' && c <= '9';
+}
+
+inline const char* skipSpace(const char* p, const char* end) noexcept {
+    while (p < end && isSpace(*p)) ++p;
+    return p;
+}
+
+/**
+ * @brief Acha o fim de uma string (p logo após a aspa de abertura).
+ * @param escaped true se a string contém escapes (precisa de unescape())
+ * @return Posição da aspa de fechamento, ou nullptr se inválida/não terminada
+ */
+inline const char* scanString(const char* p, const char* end, bool& escaped) noexcept {
+    escaped = false;
+    while (p < end) {
+        const char c = *p;
+        if (c == '"') return p;
+        if (c == '\\') {
+            escaped = true;
+            if (++p >= end) return nullptr;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            return nullptr;     // Caracteres de controle não são permitidos
+        }
+        ++p;
+    }
+    return nullptr;
+}
+
+inline int hexValue(char c) noexcept {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return 10 + c - 'a';
+    if (c >= 'A' && c <= 'F') return 10 + c - 'A';
+    return -1;
+}
+
+inline bool readHex4(const char* p, const char* end, uint32_t& out) noexcept {
+    if (end - p < 4) return false;
+    out = 0;
+    for (int i = 0; i < 4; ++i) {
+        int v = hexValue(p[i]);
+        if (v < 0) return false;
+        out = out * 16 + static_cast<uint32_t>(v);
+    }
+    return true;
+}
+
+inline char* appendUtf8(char* out, uint32_t codepoint) noexcept {
+    if (codepoint < 0x80) {
+        *out++ = static_cast<char>(codepoint);
+    } else if (codepoint < 0x800) {
+        *out++ = static_cast<char>(0xC0 | (codepoint >> 6));
+        *out++ = static_cast<char>(0x80 | (codepoint & 0x3F));
+    } else if (codepoint < 0x10000) {
+        *out++ = static_cast<char>(0xE0 | (codepoint >> 12));
+        *out++ = static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F));
+        *out++ = static_cast<char>(0x80 | (codepoint & 0x3F));
+    } else {
+        *out++ = static_cast<char>(0xF0 | (codepoint >> 18));
+        *out++ = static_cast<char>(0x80 | ((codepoint >> 12) & 0x3F));
+        *out++ = static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F));
+        *out++ = static_cast<char>(0x80 | (codepoint & 0x3F));
+    }
+    return out;
+}
+
+/**
+ * @brief Decodifica os escapes de [p, end) (conteúdo entre aspas).
+ * @param out Buffer com pelo menos end - p bytes (o resultado nunca cresce)
+ * @return Bytes escritos, ou -1 se um escape é inválido
+ */
+inline std::ptrdiff_t unescape(const char* p, const char* end, char* out) noexcept {
+    char* const start = out;
+    while (p < end) {
+        const char c = *p++;
+        if (c != '\\') {
+            *out++ = c;
+            continue;
+        }
+        if (p >= end) return -1;
+        switch (*p++) {
+            case '"':  *out++ = '"'; break;
+            case '\\': *out++ = '\\'; break;
+            case '/':  *out++ = '/'; break;
+            case 'b':  *out++ = '\b'; break;
+            case 'f':  *out++ = '\f'; break;
+            case 'n':  *out++ = '\n'; break;
+            case 'r':  *out++ = '\r'; break;
+            case 't':  *out++ = '\t'; break;
+            case 'u': {
+                uint32_t codepoint;
+                if (!readHex4(p, end, codepoint)) return -1;
+                p += 4;
+                // Par de surrogates UTF-16 (ex: emoji) vira um só code point
+                uint32_t low;
+                if (codepoint >= 0xD800 && codepoint < 0xDC00 && end - p >= 6 &&
+                    p[0] == '\\' && p[1] == 'u' && readHex4(p + 2, end, low) &&
+                    low >= 0xDC00 && low < 0xE000) {
+                    codepoint = 0x10000 + ((codepoint - 0xD800) << 10) + (low - 0xDC00);
+                    p += 6;
+                }
+                out = appendUtf8(out, codepoint);
+                break;
+            }
+            default:
+                return -1;
+        }
+    }
+    return out - start;
+}
+
+} // namespace gg::internal::json
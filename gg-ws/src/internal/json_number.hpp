@@ -0,0 +1,432 @@
+#pragma once
+
+/**
+ * @file json_number.hpp
+ * @brief Parse de números JSON direto da entrada, sem strtod.
+ *
+ * Inteiros sem fração nem expoente saem exatos em int64 (ou uint64 acima
+ * de INT64_MAX); com fração e sem expoente, como decimal de ponto fixo
+ * (mantissa int64 + casas). O resto vira double pelo caminho mais curto
+ * que ainda dá o arredondamento correto:
+ *   1. Clinger: mantissa <= 2^53 e |expoente| <= 22 (uma multiplicação exata)
+ *   2. Eisel–Lemire: mantissa de até 19 dígitos × 5^q em 128 bits
+ *   3. Fallback (std::from_chars): só com mais de 19 dígitos significativos
+ *      em que o truncamento deixa o arredondamento ambíguo
+ *
+ * Independe de locale (strtod usa o separador decimal do locale corrente).
+ */
+
+#include "json_lexer.hpp"
+#include "json_pow5_table.hpp"
+
+#include <cfloat>
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+#if __has_include(<charconv>)
+#include <charconv>
+#endif
+#if !defined(__cpp_lib_to_chars)
+#include <cstdlib>
+#include <string>
+#endif
+
+namespace gg::internal::json {
+
+/**
+ * @brief Valor numérico: inteiro exato quando cabe, senão double.
+ */
+struct Number {
+    enum class Kind : uint8_t {
+        Double,
+        Int,        // Cabe em int64
+        UInt,       // Acima de INT64_MAX, cabe em uint64
+        Decimal     // Com fração: i × 10^-scale, exato (sem expoente, até 18 casas)
+    };
+
+    Kind kind = Kind::Double;
+    uint8_t scale = 0;
+    union {
+        double d;
+        int64_t i;
+        uint64_t u;
+    };
+
+    Number() noexcept : d(0.0) {}
+};
+
+namespace number_detail {
+
+struct U128 {
+    uint64_t high;
+    uint64_t low;
+};
+
+inline U128 multiply(uint64_t a, uint64_t b) noexcept {
+#if defined(__SIZEOF_INT128__)
+    const unsigned __int128 r = static_cast<unsigned __int128>(a) * b;
+    return {static_cast<uint64_t>(r >> 64), static_cast<uint64_t>(r)};
+#else
+    const uint64_t aLo = a & 0xFFFFFFFF, aHi = a >> 32;
+    const uint64_t bLo = b & 0xFFFFFFFF, bHi = b >> 32;
+    const uint64_t ll = aLo * bLo, lh = aLo * bHi, hl = aHi * bLo, hh = aHi * bHi;
+    const uint64_t mid = (ll >> 32) + (lh & 0xFFFFFFFF) + (hl & 0xFFFFFFFF);
+    return {hh + (lh >> 32) + (hl >> 32) + (mid >> 32), (mid << 32) | (ll & 0xFFFFFFFF)};
+#endif
+}
+
+inline int leadingZeros(uint64_t x) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_clzll(x);
+#else
+    int n = 0;
+    while (!(x & (uint64_t{1} << 63))) { x <<= 1; ++n; }
+    return n;
+#endif
+}
+
+// Formato binary64
+constexpr int MantissaBits = 52;
+constexpr int MinimumExponent = -1023;
+constexpr int InfinitePower = 0x7FF;
+constexpr int64_t MinRoundToEven = -4;
+constexpr int64_t MaxRoundToEven = 23;
+
+// Mantissa (sem o bit implícito) e expoente binário já deslocado
+struct Binary {
+    uint64_t mantissa;
+    int32_t power2;
+
+    bool operator==(const Binary& o) const noexcept {
+        return mantissa == o.mantissa && power2 == o.power2;
+    }
+};
+
+/**
+ * @brief Eisel–Lemire: w × 10^q arredondado para o double mais próximo.
+ * @note Exato para w com até 19 dígitos (w != 0 normalizado internamente)
+ */
+inline Binary eiselLemire(int64_t q, uint64_t w) noexcept {
+    if (w == 0 || q < SmallestPowerOfFive) return {0, 0};
+    if (q > LargestPowerOfFive) return {0, InfinitePower};
+
+    const int lz = leadingZeros(w);
+    w <<= lz;
+
+    // Produto truncado de 128 bits; a segunda metade da potência só entra
+    // quando os bits abaixo da precisão necessária estão todos em 1
+    const Pow5& pow5 = PowersOfFive[q - SmallestPowerOfFive];
+    U128 product = multiply(w, pow5.high);
+    constexpr uint64_t PrecisionMask = ~uint64_t{0} >> (MantissaBits + 3);
+    if ((product.high & PrecisionMask) == PrecisionMask) {
+        const U128 second = multiply(w, pow5.low);
+        product.low += second.high;
+        if (second.high > product.low) ++product.high;
+    }
+
+    const int upperBit = static_cast<int>(product.high >> 63);
+    const int shift = upperBit + 64 - MantissaBits - 3;
+    Binary answer;
+    answer.mantissa = product.high >> shift;
+    // floor(log2(10^q)) + 63, com log2(10) ≈ 217706 / 2^16
+    const int32_t power = static_cast<int32_t>(((152170 + 65536) * q) >> 16) + 63;
+    answer.power2 = power + upperBit - lz - MinimumExponent;
+
+    if (answer.power2 <= 0) {
+        // Subnormal
+        if (-answer.power2 + 1 >= 64) return {0, 0};
+        answer.mantissa >>= -answer.power2 + 1;
+        answer.mantissa += answer.mantissa & 1;
+        answer.mantissa >>= 1;
+        answer.power2 = answer.mantissa < (uint64_t{1} << MantissaBits) ? 0 : 1;
+        return answer;
+    }
+
+    // Empate exato (só possível com expoentes pequenos): arredonda para par
+    if (product.low <= 1 && q >= MinRoundToEven && q <= MaxRoundToEven &&
+        (answer.mantissa & 3) == 1 && (answer.mantissa << shift) == product.high) {
+        answer.mantissa &= ~uint64_t{1};
+    }
+    answer.mantissa += answer.mantissa & 1;
+    answer.mantissa >>= 1;
+    if (answer.mantissa >= (uint64_t{2} << MantissaBits)) {
+        answer.mantissa = uint64_t{1} << MantissaBits;
+        ++answer.power2;
+    }
+    answer.mantissa &= ~(uint64_t{1} << MantissaBits);
+    if (answer.power2 >= InfinitePower) return {0, InfinitePower};
+    return answer;
+}
+
+inline double toDouble(Binary b, bool negative) noexcept {
+    uint64_t bits = b.mantissa | (static_cast<uint64_t>(b.power2) << MantissaBits);
+    if (negative) bits |= uint64_t{1} << 63;
+    double d;
+    std::memcpy(&d, &bits, sizeof(d));
+    return d;
+}
+
+/**
+ * @brief Conversão de referência (arredondamento correto) para os casos ambíguos.
+ */
+inline double slowToDouble(const char* p, const char* end) noexcept {
+#if defined(__cpp_lib_to_chars)
+    double d = 0.0;
+    std::from_chars(p, end, d);
+    return d;
+#else
+    // Sem from_chars de ponto flutuante: strtod (sensível ao locale)
+    char local[64];
+    const size_t len = static_cast<size_t>(end - p);
+    if (len < sizeof(local)) {
+        std::memcpy(local, p, len);
+        local[len] = '\0';
+        return std::strtod(local, nullptr);
+    }
+    try {
+        std::string copy(p, len);
+        return std::strtod(copy.c_str(), nullptr);
+    } catch (...) {
+        return 0.0;
+    }
+#endif
+}
+
+constexpr double ExactPowersOfTen[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+} // namespace number_detail
+
+/**
+ * @brief mantissa × 10^exponent, arredondado corretamente (mantissa exata).
+ */
+inline double decimalToDouble(uint64_t mantissa, int64_t exponent, bool negative) noexcept {
+    using namespace number_detail;
+#if defined(FLT_EVAL_METHOD) && FLT_EVAL_METHOD == 0
+    // Clinger: os dois operandos são exatos em double
+    if (exponent >= -22 && exponent <= 22 && mantissa <= (uint64_t{1} << 53)) {
+        double value = static_cast<double>(mantissa);
+        value = exponent < 0 ? value / ExactPowersOfTen[-exponent] : value * ExactPowersOfTen[exponent];
+        return negative ? -value : value;
+    }
+#endif
+    return toDouble(eiselLemire(exponent, mantissa), negative);
+}
+
+/**
+ * @brief Valida (RFC 8259 §6) e converte o número que começa em p.
+ * @return Fim do número, ou nullptr se a gramática é inválida
+ */
+inline const char* parseNumber(const char* p, const char* end, Number& out) noexcept {
+    using namespace number_detail;
+    const char* const begin = p;
+    const bool negative = p < end && *p == '-';
+    if (negative) ++p;
+
+    // Parte inteira: "0" ou [1-9][0-9]*
+    const char* const intBegin = p;
+    uint64_t mantissa = 0;
+    if (p < end && *p == '0') {
+        ++p;
+    } else if (p < end && *p >= '1' && *p <= '9') {
+        while (p < end && isDigit(*p)) {
+            mantissa = mantissa * 10 + static_cast<uint64_t>(*p - '0');     // Pode estourar: ver digits
+            ++p;
+        }
+    } else {
+        return nullptr;
+    }
+    const char* const intEnd = p;
+    int64_t digits = intEnd - intBegin;
+
+    const char* fracBegin = nullptr;
+    const char* fracEnd = nullptr;
+    int64_t exponent = 0;
+    if (p < end && *p == '.') {
+        fracBegin = ++p;
+        while (p < end && isDigit(*p)) {
+            mantissa = mantissa * 10 + static_cast<uint64_t>(*p - '0');
+            ++p;
+        }
+        fracEnd = p;
+        if (fracEnd == fracBegin) return nullptr;
+        exponent = fracBegin - fracEnd;
+        digits += fracEnd - fracBegin;
+    }
+
+    int64_t explicitExponent = 0;
+    bool hasExponent = false;
+    if (p < end && (*p == 'e' || *p == 'E')) {
+        hasExponent = true;
+        ++p;
+        bool negativeExponent = false;
+        if (p < end && (*p == '+' || *p == '-')) negativeExponent = *p++ == '-';
+        if (p >= end || !isDigit(*p)) return nullptr;
+        while (p < end && isDigit(*p)) {
+            // Satura: além disso o resultado já é 0 ou infinito
+            if (explicitExponent < 0x10000) explicitExponent = explicitExponent * 10 + (*p - '0');
+            ++p;
+        }
+        exponent += negativeExponent ? -explicitExponent : explicitExponent;
+    }
+    const char* const numberEnd = p;
+
+    // ============================================
+    // Inteiro exato
+    // ============================================
+    constexpr uint64_t Int64Max = static_cast<uint64_t>(std::numeric_limits<int64_t>::max());
+    if (!fracBegin && !hasExponent) {
+        bool fits = digits <= 19;
+        if (digits == 20) {
+            // Até 18446744073709551615: compara como texto (o acumulado estourou)
+            fits = std::memcmp(intBegin, "18446744073709551615", 20) <= 0;
+            if (fits) {
+                mantissa = 0;
+                for (const char* d = intBegin; d < intEnd; ++d) mantissa = mantissa * 10 + static_cast<uint64_t>(*d - '0');
+            }
+        }
+        if (fits) {
+            if (!negative && mantissa <= Int64Max) {
+                out.kind = Number::Kind::Int;
+                out.i = static_cast<int64_t>(mantissa);
+                return numberEnd;
+            }
+            if (!negative) {
+                out.kind = Number::Kind::UInt;
+                out.u = mantissa;
+                return numberEnd;
+            }
+            if (mantissa <= Int64Max + 1) {
+                out.kind = Number::Kind::Int;
+                out.i = static_cast<int64_t>(0 - mantissa);
+                return numberEnd;
+            }
+        }
+        // Grande demais para 64 bits: vira double
+    }
+
+    // ============================================
+    // Decimal exato ("67234.50", "0.00012")
+    // ============================================
+    if (fracBegin && !hasExponent && digits <= 19 && mantissa <= Int64Max &&
+        fracEnd - fracBegin <= 18 && !(negative && mantissa == 0)) {     // -0.0 fica double
+        out.kind = Number::Kind::Decimal;
+        out.scale = static_cast<uint8_t>(fracEnd - fracBegin);
+        out.i = negative ? -static_cast<int64_t>(mantissa) : static_cast<int64_t>(mantissa);
+        return numberEnd;
+    }
+
+    out.kind = Number::Kind::Double;
+
+    // ============================================
+    // Mais de 19 dígitos significativos: trunca em 19
+    // ============================================
+    bool truncated = false;
+    if (digits > 19) {
+        // Zeros à esquerda ("0.000123") não contam
+        for (const char* s = intBegin; s < numberEnd && (*s == '0' || *s == '.'); ++s) {
+            if (*s == '0') --digits;
+        }
+        if (digits > 19) {
+            truncated = true;
+            constexpr uint64_t MinNineteenDigits = 1000000000000000000ULL;
+            mantissa = 0;
+            const char* s = intBegin;
+            while (mantissa < MinNineteenDigits && s < intEnd) {
+                mantissa = mantissa * 10 + static_cast<uint64_t>(*s++ - '0');
+            }
+            if (mantissa >= MinNineteenDigits) {
+                exponent = (intEnd - s) + (exponent - (fracBegin ? fracBegin - fracEnd : 0));
+            } else {
+                s = fracBegin;
+                while (mantissa < MinNineteenDigits && s < fracEnd) {
+                    mantissa = mantissa * 10 + static_cast<uint64_t>(*s++ - '0');
+                }
+                exponent = (fracBegin - s) + (exponent - (fracBegin - fracEnd));
+            }
+        }
+    }
+
+    if (!truncated) {
+        out.d = decimalToDouble(mantissa, exponent, negative);
+        return numberEnd;
+    }
+
+    // Truncado: o valor real está entre mantissa e mantissa + 1; se os dois
+    // arredondam igual, esse é o resultado
+    const Binary binary = eiselLemire(exponent, mantissa);
+    out.d = binary == eiselLemire(exponent, mantissa + 1)
+        ? toDouble(binary, negative)
+        : slowToDouble(begin, numberEnd);
+    return numberEnd;
+}
+
+/**
+ * @brief Decimal exato de um texto com a gramática de número JSON.
+ *
+ * Aceita expoente ("1.5e-3" vira 15 com 4 casas) e zeros à direita além de
+ * 18 casas. Falha se o valor não cabe em int64 com até 18 casas.
+ * @return Fim do número, ou nullptr se inválido ou não representável
+ */
+inline const char* parseDecimal(const char* p, const char* end, int64_t& mantissa, uint8_t& scale) noexcept {
+    const bool negative = p < end && *p == '-';
+    if (negative) ++p;
+    if (p >= end || !isDigit(*p)) return nullptr;
+    if (*p == '0' && p + 1 < end && isDigit(p[1])) return nullptr;     // Zero à esquerda
+
+    // Até 19 dígitos significativos cabem em uint64; zeros à esquerda não contam
+    uint64_t value = 0;
+    const char* first = nullptr;
+    while (p < end && isDigit(*p)) {
+        if (!first && *p != '0') first = p;
+        value = value * 10 + static_cast<uint64_t>(*p++ - '0');
+    }
+    if (first && p - first > 19) return nullptr;
+    int64_t places = 0;
+    if (p < end && *p == '.') {
+        const char* fracBegin = ++p;
+        if (p >= end || !isDigit(*p)) return nullptr;
+        while (p < end && isDigit(*p)) {
+            if (!first && *p != '0') first = p;
+            value = value * 10 + static_cast<uint64_t>(*p++ - '0');
+        }
+        places = p - fracBegin;
+        if (first && p - first - (first < fracBegin ? 1 : 0) > 19) return nullptr;
+    }
+    if (p < end && (*p == 'e' || *p == 'E')) {
+        ++p;
+        bool negativeExponent = false;
+        if (p < end && (*p == '+' || *p == '-')) negativeExponent = *p++ == '-';
+        if (p >= end || !isDigit(*p)) return nullptr;
+        int64_t exponent = 0;
+        while (p < end && isDigit(*p)) {
+            if (exponent < 0x10000) exponent = exponent * 10 + (*p - '0');
+            ++p;
+        }
+        places += negativeExponent ? exponent : -exponent;
+    }
+
+    // Zeros à direita além do limite de casas não mudam o valor
+    while (places > 18 && value % 10 == 0 && value != 0) {
+        value /= 10;
+        --places;
+    }
+    if (value == 0) places = std::min<int64_t>(std::max<int64_t>(places, 0), 18);
+    if (places > 18) return nullptr;
+    for (; places < 0; ++places) {
+        if (value > std::numeric_limits<uint64_t>::max() / 10) return nullptr;
+        value *= 10;
+    }
+    if (value > static_cast<uint64_t>(std::numeric_limits<int64_t>::max()) + (negative ? 1 : 0)) return nullptr;
+
+    mantissa = negative ? static_cast<int64_t>(0 - value) : static_cast<int64_t>(value);
+    scale = static_cast<uint8_t>(places);
+    return p;
+}
+
+} // namespace gg::internal::json
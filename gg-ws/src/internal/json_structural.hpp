@@ -0,0 +1,115 @@
+#pragma once
+
+/**
+ * @file json_structural.hpp
+ * @brief Estágio 1 do parse JSON: índice de caracteres estruturais (estilo simdjson).
+ *
+ * Uma passada vetorizada (AVX2, SSE2 ou escalar) classifica blocos de 64
+ * bytes em máscaras de aspas, barras invertidas, operadores e espaços,
+ * resolve escapes e o interior das strings com aritmética de bits e grava
+ * a posição de cada token:
+ *   - operadores fora de strings: { } [ ] : ,
+ *   - aspas de abertura e de fechamento (o conteúdo fica entre as duas)
+ *   - início de cada escalar (número, true/false/null ou lixo)
+ *
+ * O estágio 2 de Json::parse caminha por esse índice em vez de examinar a
+ * entrada byte a byte. O JsonDocument não usa: em mensagens pequenas sem
+ * alocação, a passada única dele já custa menos que o índice.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+
+namespace gg::internal::json {
+
+class StructuralIndex {
+public:
+    enum class Kernel : uint8_t {
+        Auto,       // Melhor disponível na CPU (detectado uma vez)
+        Scalar,
+        Sse2,
+        Avx2
+    };
+
+    /**
+     * @brief Indexa input, reaproveitando o buffer da chamada anterior.
+     * @return false se há string não terminada, caractere de controle numa
+     *         string ou entrada maior que 4 GiB
+     */
+    bool build(std::string_view input, Kernel kernel = Kernel::Auto);
+
+    [[nodiscard]] const uint32_t* begin() const noexcept { return positions_.get(); }
+    [[nodiscard]] const uint32_t* end() const noexcept { return positions_.get() + count_; }
+    [[nodiscard]] size_t size() const noexcept { return count_; }
+
+    /**
+     * @brief Kernel que Kernel::Auto usa nesta CPU.
+     */
+    static Kernel bestKernel() noexcept;
+    static const char* kernelName(Kernel kernel) noexcept;
+
+private:
+    std::unique_ptr<uint32_t[]> positions_;
+    size_t capacity_ = 0;
+    size_t count_ = 0;
+};
+
+/**
+ * @brief Cursor do estágio 2 sobre os tokens do índice.
+ */
+class TokenCursor {
+public:
+    TokenCursor(std::string_view input, const StructuralIndex& index) noexcept
+        : base_(input.data()), size_(input.size()), pos_(index.begin()), end_(index.end()) {}
+
+    [[nodiscard]] bool done() const noexcept { return pos_ == end_; }
+
+    // Caractere do token atual ('\0' depois do último)
+    [[nodiscard]] char peek() const noexcept { return pos_ < end_ ? base_[*pos_] : '\0'; }
+
+    [[nodiscard]] const char* current() const noexcept { return base_ + *pos_; }
+
+    // Início do próximo token (fim da entrada depois do último)
+    [[nodiscard]] const char* next() const noexcept {
+        return pos_ + 1 < end_ ? base_ + pos_[1] : base_ + size_;
+    }
+
+    [[nodiscard]] const char* inputEnd() const noexcept { return base_ + size_; }
+
+    void advance(size_t tokens = 1) noexcept { pos_ += tokens; }
+
+    /**
+     * @brief String no token atual (aspa de abertura): conteúdo e avanço das duas aspas.
+     */
+    bool takeString(const char*& begin, const char*& close) noexcept {
+        if (end_ - pos_ < 2) return false;
+        begin = base_ + pos_[0] + 1;
+        close = base_ + pos_[1];
+        pos_ += 2;
+        return true;
+    }
+
+    /**
+     * @brief Escalar [current(), scalarEnd) válido só se o resto até o próximo token é espaço.
+     */
+    bool finishScalar(const char* scalarEnd) noexcept {
+        const char* limit = next();
+        while (scalarEnd < limit) {
+            const char c = *scalarEnd;
+            if (c != ' ' && c != '\t' && c != '\n' && c != '\r') return false;
+            ++scalarEnd;
+        }
+        ++pos_;
+        return true;
+    }
+
+private:
+    const char* base_;
+    size_t size_;
+    const uint32_t* pos_;
+    const uint32_t* end_;
+};
+
+} // namespace gg::internal::json
@@ -0,0 +1,121 @@
+#pragma once
+
+/**
+ * @file send_combiner.hpp
+ * @brief Flat combining para envios concorrentes na mesma conexão.
+ *
+ * Cada thread publica seu pedido (na própria pilha) numa lista lock-free.
+ * Quem conseguir o papel de escritor retira a lista inteira, codifica todos
+ * os frames num buffer e faz uma única escrita; as demais esperam o status
+ * do seu pedido em vez de disputar o mutex de envio e enfileirar syscalls.
+ */
+
+#include <atomic>
+#include <cstdint>
+#include <string_view>
+#include <thread>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__)
+    #include <immintrin.h>
+#endif
+
+namespace gg::internal {
+
+/**
+ * @brief Pedido de envio publicado por uma thread.
+ *
+ * Vive na pilha de quem chamou submit(); o escritor não o toca depois de
+ * publicar o status.
+ */
+struct SendRequest {
+    enum State : uint8_t {
+        Pending,
+        Sent,
+        Failed
+    };
+
+    uint8_t opcode = 0;
+    std::string_view payload;
+    SendRequest* next = nullptr;
+    std::atomic<uint8_t> state{Pending};
+};
+
+class SendCombiner {
+public:
+    // Rodadas extras que um escritor faz com pedidos que chegaram durante a escrita
+    static constexpr int MaxPasses = 4;
+
+    /**
+     * @brief Publica o pedido e espera ele ser escrito (por esta ou outra thread).
+     * @param flush bool(SendRequest* fifo): escreve a lista (ordem de chegada)
+     * @return true se o frame foi escrito
+     */
+    template<typename Flush>
+    bool submit(SendRequest& request, Flush&& flush) {
+        SendRequest* head = pending_.load(std::memory_order_relaxed);
+        do {
+            request.next = head;
+        } while (!pending_.compare_exchange_weak(head, &request,
+                                                 std::memory_order_release,
+                                                 std::memory_order_relaxed));
+
+        for (unsigned spins = 0;; ++spins) {
+            uint8_t state = request.state.load(std::memory_order_acquire);
+            if (state != SendRequest::Pending) {
+                return state == SendRequest::Sent;
+            }
+            if (!writing_.load(std::memory_order_relaxed) &&
+                !writing_.exchange(true, std::memory_order_acquire)) {
+                combine(flush);
+                writing_.store(false, std::memory_order_release);
+                continue;
+            }
+            pause(spins);
+        }
+    }
+
+private:
+    std::atomic<SendRequest*> pending_{nullptr};
+    std::atomic<bool> writing_{false};
+
+    template<typename Flush>
+    void combine(Flush& flush) {
+        for (int pass = 0; pass < MaxPasses; ++pass) {
+            SendRequest* stack = pending_.exchange(nullptr, std::memory_order_acquire);
+            if (!stack) {
+                return;
+            }
+
+            // A pilha sai invertida: restaura a ordem de chegada
+            SendRequest* fifo = nullptr;
+            while (stack) {
+                SendRequest* next = stack->next;
+                stack->next = fifo;
+                fifo = stack;
+                stack = next;
+            }
+
+            const uint8_t state = flush(fifo) ? SendRequest::Sent : SendRequest::Failed;
+
+            // next lido antes de liberar: o dono pode retornar em seguida
+            while (fifo) {
+                SendRequest* next = fifo->next;
+                fifo->state.store(state, std::memory_order_release);
+                fifo = next;
+            }
+        }
+    }
+
+    // Espera curta em spin; depois cede a CPU ao escritor
+    static void pause(unsigned spins) {
+        if (spins < 64) {
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__)
+            _mm_pause();
+#endif
+        } else {
+            std::this_thread::yield();
+        }
+    }
+};
+
+} // namespace gg::internal
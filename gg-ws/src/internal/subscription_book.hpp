@@ -0,0 +1,274 @@
+#pragma once
+
+/**
+ * @file subscription_book.hpp
+ * @brief Registro de tópicos assinados, com lotes e ritmo de envio.
+ *
+ * Guarda, por tópico, o estado desejado (wanted) e o que o link atual já
+ * recebeu (live). Só a diferença vira mensagem: assinar e cancelar antes
+ * do envio se anulam, e vários tópicos da mesma ação saem numa mensagem
+ * (até SubscriptionConfig::maxTopicsPerMessage). As mensagens respeitam um
+ * token bucket (messagesPerSecond/burst), reiniciado a cada link novo.
+ *
+ * Não é thread-safe: o WebSocket serializa o acesso com subscriptionMutex.
+ */
+
+#include "gg_ws/types.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace gg::internal {
+
+/**
+ * @brief Token bucket: até `burst` mensagens seguidas, depois `perSecond`.
+ */
+class SendPacer {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    SendPacer() = default;
+    SendPacer(double perSecond, size_t burst)
+        : perSecond_(perSecond), burst_(static_cast<double>(std::max<size_t>(1, burst))), tokens_(burst_) {}
+
+    void reset(Clock::time_point now) {
+        tokens_ = burst_;
+        last_ = now;
+    }
+
+    bool tryAcquire(Clock::time_point now) {
+        refill(now);
+        if (tokens_ < 1.0) {
+            return false;
+        }
+        tokens_ -= 1.0;
+        return true;
+    }
+
+    /**
+     * @brief Espera até a próxima mensagem poder sair (0 = já pode).
+     */
+    std::chrono::milliseconds untilNext(Clock::time_point now) {
+        refill(now);
+        if (tokens_ >= 1.0) {
+            return std::chrono::milliseconds(0);
+        }
+        return std::chrono::milliseconds(static_cast<int64_t>((1.0 - tokens_) * 1000.0 / perSecond_) + 1);
+    }
+
+private:
+    double perSecond_ = 0;
+    double burst_ = 1;
+    double tokens_ = 1;
+    Clock::time_point last_{};
+
+    void refill(Clock::time_point now) {
+        if (perSecond_ <= 0) {
+            tokens_ = burst_;
+            return;
+        }
+        if (now > last_) {
+            tokens_ = std::min(burst_, tokens_ + std::chrono::duration<double>(now - last_).count() * perSecond_);
+            last_ = now;
+        }
+    }
+};
+
+class SubscriptionBook {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit SubscriptionBook(SubscriptionConfig config)
+        : config_(std::move(config)), pacer_(newPacer()) {}
+
+    /**
+     * @brief Marca tópicos como desejados.
+     * @return Quantos não estavam desejados
+     */
+    size_t add(const std::vector<std::string>& topics) {
+        size_t added = 0;
+        for (const auto& name : topics) {
+            auto& entry = *topics_.try_emplace(name).first;
+            if (entry.second.wanted) continue;
+            entry.second.wanted = true;
+            order_.push_back(name);
+            enqueue(entry);
+            added++;
+        }
+        return added;
+    }
+
+    /**
+     * @brief Desmarca tópicos.
+     * @return Quantos estavam desejados
+     */
+    size_t remove(const std::vector<std::string>& topics) {
+        size_t removed = 0;
+        for (const auto& name : topics) {
+            auto it = topics_.find(name);
+            if (it == topics_.end() || !it->second.wanted) continue;
+            it->second.wanted = false;
+            enqueue(*it);
+            removed++;
+        }
+        if (removed > 0) {
+            order_.erase(std::remove_if(order_.begin(), order_.end(), [this](const std::string& name) {
+                return !topics_.find(name)->second.wanted;
+            }), order_.end());
+        }
+        return removed;
+    }
+
+    /**
+     * @brief Tópicos desejados, na ordem de assinatura.
+     */
+    const std::vector<std::string>& active() const noexcept { return order_; }
+
+    /**
+     * @brief Há diferença entre o desejado e o link atual.
+     */
+    bool pending() const noexcept { return !queue_.empty(); }
+
+    /**
+     * @brief Link novo: nada assinado nele, ritmo reiniciado.
+     */
+    void resetLink(Clock::time_point now) {
+        adoptLink({}, newPacer());
+        pacer_.reset(now);
+    }
+
+    /**
+     * @brief Link novo que já recebeu `live` (rotação), com o ritmo já gasto nele.
+     */
+    void adoptLink(const std::vector<std::string>& live, const SendPacer& pacer) {
+        for (auto& entry : topics_) {
+            entry.second.live = false;
+            entry.second.queued = false;
+        }
+        for (const auto& name : live) {
+            topics_.try_emplace(name).first->second.live = true;
+        }
+        for (auto it = topics_.begin(); it != topics_.end();) {
+            it = !it->second.wanted && !it->second.live ? topics_.erase(it) : std::next(it);
+        }
+        queue_.clear();
+        for (auto& entry : topics_) {
+            if (entry.second.live && !entry.second.wanted) enqueue(entry);
+        }
+        for (const auto& name : order_) {
+            enqueue(*topics_.find(name));
+        }
+        pacer_ = pacer;
+    }
+
+    /**
+     * @brief Envia as diferenças pendentes enquanto o ritmo permitir.
+     * @param send bool(std::string_view message)
+     * @return false se um envio falhou (o lote continua pendente)
+     */
+    template<typename Send>
+    bool pump(Clock::time_point now, Send&& send) {
+        settle();
+        std::vector<std::string_view> batch;
+        while (!queue_.empty() && pacer_.tryAcquire(now)) {
+            // Ação da mudança mais antiga; o lote leva as mesmas em ordem de chegada
+            const bool subscribing = queue_.front()->second.wanted;
+            batch.clear();
+            for (auto* entry : queue_) {
+                if (batch.size() == batchLimit()) break;
+                if (entry->second.wanted == subscribing) batch.push_back(entry->first);
+            }
+
+            if (!send(config_.encode(subscribing ? SubscriptionAction::Subscribe
+                                                 : SubscriptionAction::Unsubscribe, batch))) {
+                return false;
+            }
+
+            size_t marked = 0;
+            for (auto* entry : queue_) {
+                if (marked == batch.size()) break;
+                if (entry->second.wanted == subscribing) {
+                    entry->second.live = subscribing;
+                    marked++;
+                }
+            }
+            settle();
+        }
+        return true;
+    }
+
+    /**
+     * @brief Espera até o próximo lote pendente poder sair (-1 = nada pendente).
+     */
+    int waitMs(Clock::time_point now) {
+        if (queue_.empty()) {
+            return -1;
+        }
+        return static_cast<int>(pacer_.untilNext(now).count());
+    }
+
+    /**
+     * @brief Mensagens que assinam `topics` do zero (ex: novo link da rotação).
+     */
+    std::vector<std::string> encodeAll(const std::vector<std::string>& topics) const {
+        std::vector<std::string> messages;
+        std::vector<std::string_view> batch;
+        for (size_t i = 0; i < topics.size(); i += batch.size()) {
+            const size_t count = std::min(topics.size() - i, batchLimit());
+            batch.assign(topics.begin() + static_cast<std::ptrdiff_t>(i),
+                         topics.begin() + static_cast<std::ptrdiff_t>(i + count));
+            messages.push_back(config_.encode(SubscriptionAction::Subscribe, batch));
+        }
+        return messages;
+    }
+
+    SendPacer newPacer() const {
+        return SendPacer(config_.messagesPerSecond, config_.burst);
+    }
+
+private:
+    struct Topic {
+        bool wanted = false;    // Assinatura pedida pelo usuário
+        bool live = false;      // Já enviada no link atual
+        bool queued = false;    // Em queue_
+    };
+    using TopicMap = std::unordered_map<std::string, Topic>;
+
+    SubscriptionConfig config_;
+    SendPacer pacer_;
+    TopicMap topics_;
+    std::vector<std::string> order_;                // Desejados, ordem de assinatura
+    std::vector<TopicMap::value_type*> queue_;      // wanted != live, ordem de chegada
+
+    size_t batchLimit() const noexcept {
+        return config_.maxTopicsPerMessage > 0 ? config_.maxTopicsPerMessage : std::numeric_limits<size_t>::max();
+    }
+
+    void enqueue(TopicMap::value_type& entry) {
+        if (!entry.second.queued && entry.second.wanted != entry.second.live) {
+            entry.second.queued = true;
+            queue_.push_back(&entry);
+        }
+    }
+
+    // Tira da fila o que já está em dia; esquece tópicos cancelados
+    void settle() {
+        auto done = std::stable_partition(queue_.begin(), queue_.end(), [](const TopicMap::value_type* entry) {
+            return entry->second.wanted != entry->second.live;
+        });
+        for (auto it = done; it != queue_.end(); ++it) {
+            (*it)->second.queued = false;
+            if (!(*it)->second.wanted) {
+                topics_.erase(topics_.find((*it)->first));
+            }
+        }
+        queue_.erase(done, queue_.end());
+    }
+};
+
+} // namespace gg::internal
@@ -0,0 +1,309 @@
+#pragma once
+
+/**
+ * @file tcp_connector.hpp
+ * @brief Connect TCP não bloqueante com corrida Happy Eyeballs (RFC 8305).
+ *
+ * Os endereços são intercalados por família (IPv6, IPv4, IPv6, ...) e uma
+ * nova tentativa começa a cada attemptDelay, ou imediatamente quando a
+ * anterior falha. O primeiro socket a completar o 3-way handshake vence e
+ * os demais são fechados. Nenhuma tentativa passa do deadline.
+ *
+ * connectUnix() cobre URLs ws+unix:// (proxies locais, sem pilha TCP).
+ */
+
+#include "dns_cache.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+    #include <winsock2.h>
+    #include <ws2tcpip.h>
+#else
+    #include <fcntl.h>
+    #include <poll.h>
+    #include <sys/socket.h>
+    #include <sys/un.h>
+    #include <unistd.h>
+#endif
+
+namespace gg::internal {
+
+#ifdef _WIN32
+using native_socket = SOCKET;
+constexpr native_socket InvalidNativeSocket = INVALID_SOCKET;
+#else
+using native_socket = int;
+constexpr native_socket InvalidNativeSocket = -1;
+#endif
+
+struct ConnectResult {
+    native_socket socket = InvalidNativeSocket;
+    bool timedOut = false;
+    int lastError = 0;              // errno da última tentativa que falhou
+    size_t attempts = 0;            // Tentativas iniciadas
+    size_t winner = 0;              // Índice (na ordem intercalada) do vencedor
+};
+
+/**
+ * @brief Intercala famílias mantendo a ordem relativa do resolver.
+ *
+ * A família do primeiro endereço vai na frente (preferência do sistema).
+ */
+inline std::vector<ResolvedAddress> interleaveFamilies(const std::vector<ResolvedAddress>& addresses) {
+    if (addresses.empty()) return {};
+
+    const int preferred = addresses.front().family;
+    std::vector<ResolvedAddress> first, second;
+    for (const auto& address : addresses) {
+        (address.family == preferred ? first : second).push_back(address);
+    }
+
+    std::vector<ResolvedAddress> out;
+    out.reserve(addresses.size());
+    for (size_t i = 0; i < std::max(first.size(), second.size()); ++i) {
+        if (i < first.size()) out.push_back(first[i]);
+        if (i < second.size()) out.push_back(second[i]);
+    }
+    return out;
+}
+
+namespace tcp_detail {
+
+inline int lastSocketError() {
+#ifdef _WIN32
+    return WSAGetLastError();
+#else
+    return errno;
+#endif
+}
+
+inline bool inProgress(int err) {
+#ifdef _WIN32
+    return err == WSAEWOULDBLOCK || err == WSAEINPROGRESS;
+#else
+    return err == EINPROGRESS || err == EINTR;
+#endif
+}
+
+inline void closeSocket(native_socket s) {
+#ifdef _WIN32
+    closesocket(s);
+#else
+    ::close(s);
+#endif
+}
+
+inline bool setBlocking(native_socket s, bool blocking) {
+#ifdef _WIN32
+    u_long mode = blocking ? 0 : 1;
+    return ioctlsocket(s, FIONBIO, &mode) == 0;
+#else
+    int flags = fcntl(s, F_GETFL, 0);
+    if (flags < 0) return false;
+    flags = blocking ? (flags & ~O_NONBLOCK) : (flags | O_NONBLOCK);
+    return fcntl(s, F_SETFL, flags) == 0;
+#endif
+}
+
+inline int pollSockets(pollfd* fds, size_t count, int timeoutMs) {
+#ifdef _WIN32
+    return WSAPoll(fds, static_cast<ULONG>(count), timeoutMs);
+#else
+    return ::poll(fds, static_cast<nfds_t>(count), timeoutMs);
+#endif
+}
+
+} // namespace tcp_detail
+
+/**
+ * @brief Conecta ao primeiro endereço que responder.
+ * @param addresses Endereços já intercalados (ver interleaveFamilies)
+ * @param deadline Limite absoluto para toda a corrida
+ * @param attemptDelay Espera antes de iniciar a próxima tentativa em paralelo
+ * @param cancel Se não nulo e virar true, aborta a corrida (timedOut = true)
+ * @return Socket conectado (modo bloqueante) ou InvalidNativeSocket
+ */
+inline ConnectResult connectHappyEyeballs(const std::vector<ResolvedAddress>& addresses,
+                                          std::chrono::steady_clock::time_point deadline,
+                                          std::chrono::milliseconds attemptDelay,
+                                          const std::atomic<bool>* cancel = nullptr) {
+    using Clock = std::chrono::steady_clock;
+
+    ConnectResult result;
+    std::vector<pollfd> pending;
+    std::vector<size_t> pendingIndex;
+    size_t next = 0;
+    Clock::time_point nextStart = Clock::now();
+
+    auto closePending = [&](native_socket keep) {
+        for (const auto& pfd : pending) {
+            if (static_cast<native_socket>(pfd.fd) != keep) {
+                tcp_detail::closeSocket(static_cast<native_socket>(pfd.fd));
+            }
+        }
+        pending.clear();
+        pendingIndex.clear();
+    };
+
+    for (;;) {
+        const auto now = Clock::now();
+        if (now >= deadline || (cancel && cancel->load(std::memory_order_relaxed))) {
+            result.timedOut = true;
+            break;
+        }
+
+        // Inicia a próxima tentativa (no horário, ou já se não há nenhuma em voo)
+        if (next < addresses.size() && (now >= nextStart || pending.empty())) {
+            const size_t index = next++;
+            const auto& address = addresses[index];
+            result.attempts++;
+            nextStart = now + attemptDelay;
+
+            native_socket s = ::socket(address.family, SOCK_STREAM, IPPROTO_TCP);
+            if (s == InvalidNativeSocket) {
+                result.lastError = tcp_detail::lastSocketError();
+                nextStart = now;
+                continue;
+            }
+            tcp_detail::setBlocking(s, false);
+
+            if (::connect(s, reinterpret_cast<const sockaddr*>(&address.addr), address.len) == 0) {
+                closePending(InvalidNativeSocket);
+                tcp_detail::setBlocking(s, true);
+                result.socket = s;
+                result.winner = index;
+                return result;
+            }
+
+            int err = tcp_detail::lastSocketError();
+            if (!tcp_detail::inProgress(err)) {
+                result.lastError = err;
+                tcp_detail::closeSocket(s);
+                nextStart = now;
+                continue;
+            }
+
+            pollfd pfd{};
+            pfd.fd = s;
+            pfd.events = POLLOUT;
+            pending.push_back(pfd);
+            pendingIndex.push_back(index);
+            continue;
+        }
+
+        if (pending.empty()) {
+            break;  // Todos os endereços falharam
+        }
+
+        // Espera até a próxima tentativa ou o deadline
+        auto until = deadline;
+        if (next < addresses.size()) until = std::min(until, nextStart);
+        if (cancel) until = std::min(until, now + std::chrono::milliseconds(10));
+        auto waitMs = std::chrono::duration_cast<std::chrono::milliseconds>(until - now).count() + 1;
+        for (auto& pfd : pending) pfd.revents = 0;
+        if (tcp_detail::pollSockets(pending.data(), pending.size(), static_cast<int>(waitMs)) <= 0) {
+            continue;
+        }
+
+        for (size_t i = 0; i < pending.size();) {
+            if (pending[i].revents == 0) {
+                ++i;
+                continue;
+            }
+
+            native_socket s = static_cast<native_socket>(pending[i].fd);
+            int err = 0;
+            socklen_t len = sizeof(err);
+            getsockopt(s, SOL_SOCKET, SO_ERROR, reinterpret_cast<char*>(&err), &len);
+
+            if (err == 0 && (pending[i].revents & POLLOUT)) {
+                result.winner = pendingIndex[i];
+                closePending(s);
+                tcp_detail::setBlocking(s, true);
+                result.socket = s;
+                return result;
+            }
+
+            // Falhou: remove e antecipa a próxima tentativa
+            result.lastError = err;
+            tcp_detail::closeSocket(s);
+            pending.erase(pending.begin() + static_cast<std::ptrdiff_t>(i));
+            pendingIndex.erase(pendingIndex.begin() + static_cast<std::ptrdiff_t>(i));
+            nextStart = Clock::now();
+        }
+    }
+
+    closePending(InvalidNativeSocket);
+    return result;
+}
+
+/**
+ * @brief Conecta a um Unix domain socket (SOCK_STREAM).
+ *
+ * O connect local completa (ou falha) sem esperar a rede; só bloqueia com o
+ * backlog do servidor cheio, e nesse caso é limitado pelo deadline.
+ * @return Socket conectado (modo bloqueante) ou InvalidNativeSocket
+ */
+inline ConnectResult connectUnix(const std::string& path,
+                                 std::chrono::steady_clock::time_point deadline,
+                                 const std::atomic<bool>* cancel = nullptr) {
+    ConnectResult result;
+    result.attempts = 1;
+#ifdef _WIN32
+    (void)path;
+    (void)deadline;
+    (void)cancel;
+    result.lastError = WSAEAFNOSUPPORT;
+    return result;
+#else
+    using Clock = std::chrono::steady_clock;
+
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(addr.sun_path)) {
+        result.lastError = ENAMETOOLONG;
+        return result;
+    }
+    std::memcpy(addr.sun_path, path.c_str(), path.size() + 1);
+
+    native_socket s = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (s == InvalidNativeSocket) {
+        result.lastError = tcp_detail::lastSocketError();
+        return result;
+    }
+    tcp_detail::setBlocking(s, false);
+
+    // Backlog cheio: EAGAIN, sem conexão em andamento; tenta de novo
+    for (;;) {
+        if (::connect(s, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) == 0) {
+            break;
+        }
+        int err = tcp_detail::lastSocketError();
+        if (err != EAGAIN && err != EINTR) {
+            result.lastError = err;
+            tcp_detail::closeSocket(s);
+            return result;
+        }
+        if (Clock::now() >= deadline || (cancel && cancel->load(std::memory_order_relaxed))) {
+            result.timedOut = true;
+            tcp_detail::closeSocket(s);
+            return result;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    tcp_detail::setBlocking(s, true);
+    result.socket = s;
+    return result;
+#endif
+}
+
+} // namespace gg::internal
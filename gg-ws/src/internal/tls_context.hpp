@@ -0,0 +1,153 @@
+#pragma once
+
+/**
+ * @file tls_context.hpp
+ * @brief SSL_CTX do processo e cache de sessões TLS para retomada.
+ *
+ * Um contexto por configuração de confiança (TlsConfig::caFile/verifyPeer),
+ * criado na primeira conexão: a inicialização do OpenSSL e a leitura do
+ * trust store acontecem uma vez. Cada contexto guarda a última sessão
+ * recebida de cada host:port (TLS 1.2 session id/ticket ou NewSessionTicket
+ * do TLS 1.3); a próxima conexão a oferece e, se o servidor aceitar, o
+ * handshake pula a troca de certificados e o key exchange completo.
+ */
+
+#include "gg_ws/types.hpp"
+
+#include <openssl/err.h>
+#include <openssl/ssl.h>
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace gg::internal {
+
+class TlsContext {
+public:
+    /**
+     * @brief Contexto compartilhado para a configuração (criado na 1ª chamada).
+     * @param error Preenchido se a criação falhar
+     * @return nullptr em erro
+     */
+    static TlsContext* get(const TlsConfig& config, std::string& error) {
+        static std::mutex mutex;
+        static std::unordered_map<std::string, std::unique_ptr<TlsContext>> contexts;
+
+        const std::string key = config.caFile + (config.verifyPeer ? "|verify" : "|noverify");
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = contexts.find(key);
+        if (it != contexts.end()) {
+            return it->second.get();
+        }
+
+        OPENSSL_init_ssl(OPENSSL_INIT_LOAD_SSL_STRINGS | OPENSSL_INIT_LOAD_CRYPTO_STRINGS, nullptr);
+        SSL_CTX* ctx = SSL_CTX_new(TLS_client_method());
+        if (!ctx) {
+            error = "Falha ao criar SSL context";
+            return nullptr;
+        }
+
+        // Configurações de segurança
+        SSL_CTX_set_verify(ctx, config.verifyPeer ? SSL_VERIFY_PEER : SSL_VERIFY_NONE, nullptr);
+        SSL_CTX_set_min_proto_version(ctx, TLS1_2_VERSION);
+        bool trusted = config.caFile.empty()
+            ? SSL_CTX_set_default_verify_paths(ctx) == 1
+            : SSL_CTX_load_verify_locations(ctx, config.caFile.c_str(), nullptr) == 1;
+        if (!trusted) {
+            error = "Falha ao carregar CAs: " + (config.caFile.empty() ? std::string("sistema") : config.caFile);
+            SSL_CTX_free(ctx);
+            return nullptr;
+        }
+
+        // Cache só no lado cliente e fora do OpenSSL: indexado por host:port
+        SSL_CTX_set_session_cache_mode(ctx, SSL_SESS_CACHE_CLIENT | SSL_SESS_CACHE_NO_INTERNAL_STORE);
+        SSL_CTX_sess_set_new_cb(ctx, &TlsContext::onNewSession);
+
+        auto context = std::unique_ptr<TlsContext>(new TlsContext(ctx));
+        SSL_CTX_set_app_data(ctx, context.get());
+        return contexts.emplace(key, std::move(context)).first->second.get();
+    }
+
+    ~TlsContext() {
+        for (auto& entry : sessions_) {
+            SSL_SESSION_free(entry.second);
+        }
+        SSL_CTX_free(ctx_);
+    }
+
+    TlsContext(const TlsContext&) = delete;
+    TlsContext& operator=(const TlsContext&) = delete;
+
+    /**
+     * @brief Cria o SSL de uma conexão, oferecendo a sessão guardada de peer.
+     * @param peer host:port; vazio não oferece nem guarda sessões
+     */
+    SSL* newConnection(const std::string& peer) {
+        SSL* ssl = SSL_new(ctx_);
+        if (!ssl || peer.empty()) {
+            return ssl;
+        }
+        SSL_set_ex_data(ssl, peerIndex(), new std::string(peer));
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = sessions_.find(peer);
+        if (it != sessions_.end()) {
+            SSL_set_session(ssl, it->second);   // Incrementa a referência
+        }
+        return ssl;
+    }
+
+    /**
+     * @brief Descarta a sessão de peer (handshake falhou com ela).
+     */
+    void forget(const std::string& peer) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = sessions_.find(peer);
+        if (it != sessions_.end()) {
+            SSL_SESSION_free(it->second);
+            sessions_.erase(it);
+        }
+    }
+
+    size_t cachedSessions() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return sessions_.size();
+    }
+
+private:
+    SSL_CTX* ctx_;
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, SSL_SESSION*> sessions_;
+
+    explicit TlsContext(SSL_CTX* ctx) : ctx_(ctx) {}
+
+    // host:port de cada SSL (liberado junto com o SSL)
+    static int peerIndex() {
+        static const int index = SSL_get_ex_new_index(0, nullptr, nullptr, nullptr,
+            [](void*, void* ptr, CRYPTO_EX_DATA*, int, long, void*) {
+                delete static_cast<std::string*>(ptr);
+            });
+        return index;
+    }
+
+    // Chamado no handshake (TLS 1.2) ou ao ler um NewSessionTicket (TLS 1.3)
+    static int onNewSession(SSL* ssl, SSL_SESSION* session) {
+        auto* peer = static_cast<std::string*>(SSL_get_ex_data(ssl, peerIndex()));
+        auto* self = static_cast<TlsContext*>(SSL_CTX_get_app_data(SSL_get_SSL_CTX(ssl)));
+        if (!peer || !self || !SSL_SESSION_is_resumable(session)) {
+            return 0;
+        }
+
+        std::lock_guard<std::mutex> lock(self->mutex_);
+        SSL_SESSION*& slot = self->sessions_[*peer];
+        if (slot) {
+            SSL_SESSION_free(slot);
+        }
+        slot = session;
+        return 1;   // Ficamos com a referência
+    }
+};
+
+} // namespace gg::internal
@@ -0,0 +1,400 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define GG_WS_UTF8_X86 1
+#include <immintrin.h>
+#endif
+
+namespace gg::internal {
+
+/**
+ * @brief Validação UTF-8 (RFC 3629) para frames de texto (RFC 6455 §8.1).
+ *
+ * Três implementações com o mesmo resultado:
+ * - utf8ValidateScalar: fallback portátil com fast path ASCII de 8 bytes
+ * - utf8ValidateSse: SSSE3, 16 bytes por iteração
+ * - utf8ValidateAvx2: AVX2, 32 bytes por iteração
+ *
+ * As versões vetoriais usam o algoritmo de lookup de Keiser & Lemire
+ * ("Validating UTF-8 In Less Than One Instruction Per Byte"): três
+ * tabelas de 16 entradas indexadas por nibbles classificam cada par de
+ * bytes consecutivos, e blocos 100% ASCII pulam toda a verificação.
+ *
+ * utf8Validate() escolhe a melhor implementação uma única vez (cpuid).
+ */
+
+// ============================================
+// Scalar
+// ============================================
+inline bool utf8ValidateScalar(const char* data, size_t len) noexcept {
+    const auto* s = reinterpret_cast<const uint8_t*>(data);
+    size_t i = 0;
+
+    while (i < len) {
+        // Fast path: 8 bytes ASCII de uma vez
+        if (i + 8 <= len) {
+            uint64_t word;
+            std::memcpy(&word, s + i, 8);
+            if ((word & 0x8080808080808080ULL) == 0) {
+                i += 8;
+                continue;
+            }
+        }
+
+        uint8_t c = s[i];
+        if (c < 0x80) {
+            i++;
+            continue;
+        }
+
+        size_t n;
+        uint8_t lo = 0x80, hi = 0xBF;  // Faixa do segundo byte
+        if (c >= 0xC2 && c <= 0xDF) {
+            n = 2;
+        } else if (c >= 0xE0 && c <= 0xEF) {
+            n = 3;
+            if (c == 0xE0) lo = 0xA0;        // Overlong
+            else if (c == 0xED) hi = 0x9F;   // Surrogates
+        } else if (c >= 0xF0 && c <= 0xF4) {
+            n = 4;
+            if (c == 0xF0) lo = 0x90;        // Overlong
+            else if (c == 0xF4) hi = 0x8F;   // > U+10FFFF
+        } else {
+            return false;
+        }
+
+        if (i + n > len) return false;
+        if (s[i + 1] < lo || s[i + 1] > hi) return false;
+        for (size_t k = 2; k < n; ++k) {
+            if ((s[i + k] & 0xC0) != 0x80) return false;
+        }
+        i += n;
+    }
+
+    return true;
+}
+
+#ifdef GG_WS_UTF8_X86
+
+namespace utf8_detail {
+
+// Bits de erro das tabelas de lookup
+constexpr uint8_t TOO_SHORT = 1 << 0;
+constexpr uint8_t TOO_LONG = 1 << 1;
+constexpr uint8_t OVERLONG_3 = 1 << 2;
+constexpr uint8_t TOO_LARGE = 1 << 3;
+constexpr uint8_t SURROGATE = 1 << 4;
+constexpr uint8_t OVERLONG_2 = 1 << 5;
+constexpr uint8_t TOO_LARGE_1000 = 1 << 6;
+constexpr uint8_t OVERLONG_4 = 1 << 6;
+constexpr uint8_t TWO_CONTS = 1 << 7;
+constexpr uint8_t CARRY = TOO_SHORT | TOO_LONG | TWO_CONTS;
+
+#define GG_WS_UTF8_BYTE1_HIGH \
+    TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, \
+    TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, \
+    TWO_CONTS, TWO_CONTS, TWO_CONTS, TWO_CONTS, \
+    TOO_SHORT | OVERLONG_2, \
+    TOO_SHORT, \
+    TOO_SHORT | OVERLONG_3 | SURROGATE, \
+    TOO_SHORT | TOO_LARGE | TOO_LARGE_1000 | OVERLONG_4
+
+#define GG_WS_UTF8_BYTE1_LOW \
+    CARRY | OVERLONG_3 | OVERLONG_2 | OVERLONG_4, \
+    CARRY | OVERLONG_2, \
+    CARRY, \
+    CARRY, \
+    CARRY | TOO_LARGE, \
+    CARRY | TOO_LARGE | TOO_LARGE_1000, \
+    CARRY | TOO_LARGE | TOO_LARGE_1000, \
+    CARRY | TOO_LARGE | TOO_LARGE_1000, \
+    CARRY | TOO_LARGE | TOO_LARGE_1000, \
+    CARRY | TOO_LARGE | TOO_LARGE_1000, \
+    CARRY | TOO_LARGE | TOO_LARGE_1000, \
+    CARRY | TOO_LARGE | TOO_LARGE_1000, \
+    CARRY | TOO_LARGE | TOO_LARGE_1000, \
+    CARRY | TOO_LARGE | TOO_LARGE_1000 | SURROGATE, \
+    CARRY | TOO_LARGE | TOO_LARGE_1000, \
+    CARRY | TOO_LARGE | TOO_LARGE_1000
+
+#define GG_WS_UTF8_BYTE2_HIGH \
+    TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, \
+    TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, \
+    TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE_1000 | OVERLONG_4, \
+    TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE, \
+    TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE, \
+    TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE, \
+    TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT
+
+// ============================================
+// SSSE3 (16 bytes)
+// ============================================
+__attribute__((target("ssse3")))
+inline __m128i sseCheckBlock(__m128i input, __m128i prevInput) noexcept {
+    const __m128i lowNibble = _mm_set1_epi8(0x0F);
+    const __m128i byte1HighTable = _mm_setr_epi8(GG_WS_UTF8_BYTE1_HIGH);
+    const __m128i byte1LowTable = _mm_setr_epi8(GG_WS_UTF8_BYTE1_LOW);
+    const __m128i byte2HighTable = _mm_setr_epi8(GG_WS_UTF8_BYTE2_HIGH);
+
+    __m128i prev1 = _mm_alignr_epi8(input, prevInput, 16 - 1);
+    __m128i byte1High = _mm_shuffle_epi8(byte1HighTable,
+        _mm_and_si128(_mm_srli_epi16(prev1, 4), lowNibble));
+    __m128i byte1Low = _mm_shuffle_epi8(byte1LowTable, _mm_and_si128(prev1, lowNibble));
+    __m128i byte2High = _mm_shuffle_epi8(byte2HighTable,
+        _mm_and_si128(_mm_srli_epi16(input, 4), lowNibble));
+    __m128i special = _mm_and_si128(_mm_and_si128(byte1High, byte1Low), byte2High);
+
+    // Bytes que precisam ser a 3ª/4ª posição de uma sequência
+    __m128i prev2 = _mm_alignr_epi8(input, prevInput, 16 - 2);
+    __m128i prev3 = _mm_alignr_epi8(input, prevInput, 16 - 3);
+    __m128i isThird = _mm_subs_epu8(prev2, _mm_set1_epi8(static_cast<char>(0xE0 - 0x80)));
+    __m128i isFourth = _mm_subs_epu8(prev3, _mm_set1_epi8(static_cast<char>(0xF0 - 0x80)));
+    __m128i must23 = _mm_and_si128(_mm_or_si128(isThird, isFourth),
+        _mm_set1_epi8(static_cast<char>(0x80)));
+
+    return _mm_xor_si128(must23, special);
+}
+
+__attribute__((target("ssse3")))
+inline __m128i sseIncomplete(__m128i input) noexcept {
+    // Lead bytes nas últimas posições exigem continuação no próximo bloco
+    const __m128i maxValue = _mm_setr_epi8(
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        static_cast<char>(0xF0 - 1), static_cast<char>(0xE0 - 1), static_cast<char>(0xC0 - 1));
+    return _mm_subs_epu8(input, maxValue);
+}
+
+} // namespace utf8_detail
+
+__attribute__((target("ssse3")))
+inline bool utf8ValidateSse(const char* data, size_t len) noexcept {
+    using namespace utf8_detail;
+
+    __m128i error = _mm_setzero_si128();
+    __m128i prevInput = _mm_setzero_si128();
+    __m128i prevIncomplete = _mm_setzero_si128();
+
+    auto process = [&](__m128i input) __attribute__((target("ssse3"))) {
+        if (_mm_movemask_epi8(input) == 0) {
+            // Bloco ASCII: só herda sequência incompleta do anterior
+            error = _mm_or_si128(error, prevIncomplete);
+        } else {
+            error = _mm_or_si128(error, sseCheckBlock(input, prevInput));
+            prevIncomplete = sseIncomplete(input);
+        }
+        prevInput = input;
+    };
+
+    size_t i = 0;
+    for (; i + 16 <= len; i += 16) {
+        process(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i)));
+    }
+    if (i < len) {
+        alignas(16) char tail[16] = {};
+        std::memcpy(tail, data + i, len - i);
+        process(_mm_load_si128(reinterpret_cast<const __m128i*>(tail)));
+    }
+    error = _mm_or_si128(error, prevIncomplete);
+
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(error, _mm_setzero_si128())) == 0xFFFF;
+}
+
+// ============================================
+// AVX2 (32 bytes)
+// ============================================
+namespace utf8_detail {
+
+__attribute__((target("avx2")))
+inline __m256i avxPrev(__m256i input, __m256i prevInput, int n) noexcept {
+    // Bytes [prev[16..31], input[0..15]] alinhados para deslocar por lane
+    __m256i shifted = _mm256_permute2x128_si256(prevInput, input, 0x21);
+    switch (n) {
+        case 1: return _mm256_alignr_epi8(input, shifted, 16 - 1);
+        case 2: return _mm256_alignr_epi8(input, shifted, 16 - 2);
+        default: return _mm256_alignr_epi8(input, shifted, 16 - 3);
+    }
+}
+
+__attribute__((target("avx2")))
+inline __m256i avxCheckBlock(__m256i input, __m256i prevInput) noexcept {
+    const __m256i lowNibble = _mm256_set1_epi8(0x0F);
+    const __m256i byte1HighTable = _mm256_setr_epi8(GG_WS_UTF8_BYTE1_HIGH, GG_WS_UTF8_BYTE1_HIGH);
+    const __m256i byte1LowTable = _mm256_setr_epi8(GG_WS_UTF8_BYTE1_LOW, GG_WS_UTF8_BYTE1_LOW);
+    const __m256i byte2HighTable = _mm256_setr_epi8(GG_WS_UTF8_BYTE2_HIGH, GG_WS_UTF8_BYTE2_HIGH);
+
+    __m256i prev1 = avxPrev(input, prevInput, 1);
+    __m256i byte1High = _mm256_shuffle_epi8(byte1HighTable,
+        _mm256_and_si256(_mm256_srli_epi16(prev1, 4), lowNibble));
+    __m256i byte1Low = _mm256_shuffle_epi8(byte1LowTable, _mm256_and_si256(prev1, lowNibble));
+    __m256i byte2High = _mm256_shuffle_epi8(byte2HighTable,
+        _mm256_and_si256(_mm256_srli_epi16(input, 4), lowNibble));
+    __m256i special = _mm256_and_si256(_mm256_and_si256(byte1High, byte1Low), byte2High);
+
+    __m256i prev2 = avxPrev(input, prevInput, 2);
+    __m256i prev3 = avxPrev(input, prevInput, 3);
+    __m256i isThird = _mm256_subs_epu8(prev2, _mm256_set1_epi8(static_cast<char>(0xE0 - 0x80)));
+    __m256i isFourth = _mm256_subs_epu8(prev3, _mm256_set1_epi8(static_cast<char>(0xF0 - 0x80)));
+    __m256i must23 = _mm256_and_si256(_mm256_or_si256(isThird, isFourth),
+        _mm256_set1_epi8(static_cast<char>(0x80)));
+
+    return _mm256_xor_si256(must23, special);
+}
+
+__attribute__((target("avx2")))
+inline __m256i avxIncomplete(__m256i input) noexcept {
+    const __m256i maxValue = _mm256_setr_epi8(
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        static_cast<char>(0xF0 - 1), static_cast<char>(0xE0 - 1), static_cast<char>(0xC0 - 1));
+    return _mm256_subs_epu8(input, maxValue);
+}
+
+#undef GG_WS_UTF8_BYTE1_HIGH
+#undef GG_WS_UTF8_BYTE1_LOW
+#undef GG_WS_UTF8_BYTE2_HIGH
+
+} // namespace utf8_detail
+
+__attribute__((target("avx2")))
+inline bool utf8ValidateAvx2(const char* data, size_t len) noexcept {
+    using namespace utf8_detail;
+
+    __m256i error = _mm256_setzero_si256();
+    __m256i prevInput = _mm256_setzero_si256();
+    __m256i prevIncomplete = _mm256_setzero_si256();
+
+    auto process = [&](__m256i input) __attribute__((target("avx2"))) {
+        if (_mm256_movemask_epi8(input) == 0) {
+            error = _mm256_or_si256(error, prevIncomplete);
+        } else {
+            error = _mm256_or_si256(error, avxCheckBlock(input, prevInput));
+            prevIncomplete = avxIncomplete(input);
+        }
+        prevInput = input;
+    };
+
+    size_t i = 0;
+    for (; i + 32 <= len; i += 32) {
+        process(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i)));
+    }
+    if (i < len) {
+        alignas(32) char tail[32] = {};
+        std::memcpy(tail, data + i, len - i);
+        process(_mm256_load_si256(reinterpret_cast<const __m256i*>(tail)));
+    }
+    error = _mm256_or_si256(error, prevIncomplete);
+
+    return _mm256_testz_si256(error, error);
+}
+
+#endif // GG_WS_UTF8_X86
+
+// ============================================
+// Dispatch
+// ============================================
+using Utf8ValidateFn = bool (*)(const char*, size_t) noexcept;
+
+/**
+ * @brief Retorna a melhor implementação suportada pela CPU atual.
+ */
+inline Utf8ValidateFn utf8BestImpl() noexcept {
+#ifdef GG_WS_UTF8_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) return &utf8ValidateAvx2;
+    if (__builtin_cpu_supports("ssse3")) return &utf8ValidateSse;
+#endif
+    return &utf8ValidateScalar;
+}
+
+/**
+ * @brief Valida se o buffer é UTF-8 bem-formado.
+ * @return true se válido (buffer vazio é válido)
+ */
+inline bool utf8Validate(const char* data, size_t len) noexcept {
+    static const Utf8ValidateFn impl = utf8BestImpl();
+    return impl(data, len);
+}
+
+/**
+ * @brief Tamanho da sequência iniciada pelo lead byte (0 se não é lead válido).
+ */
+constexpr size_t utf8SequenceLength(uint8_t lead) noexcept {
+    if (lead >= 0xC2 && lead <= 0xDF) return 2;
+    if (lead >= 0xE0 && lead <= 0xEF) return 3;
+    if (lead >= 0xF0 && lead <= 0xF4) return 4;
+    return 0;
+}
+
+/**
+ * @brief Validação de uma mensagem de texto fragmentada (RFC 6455 §5.6).
+ *
+ * Um caractere pode ser dividido entre dois fragmentos: a sequência aberta
+ * no fim de um fragmento (até 3 bytes) fica guardada e é completada pelo
+ * início do seguinte. Só o fragmento com FIN precisa terminar numa
+ * fronteira de caractere. O corpo de cada fragmento passa por
+ * utf8Validate().
+ */
+class Utf8Stream {
+public:
+    /**
+     * @brief Valida o próximo fragmento da mensagem.
+     * @param fin Último fragmento: nenhuma sequência pode ficar aberta
+     * @return false se inválido
+     */
+    bool feed(const char* data, size_t len, bool fin) noexcept {
+        const auto* s = reinterpret_cast<const uint8_t*>(data);
+        size_t i = 0;
+        active_ = !fin;
+
+        // Completa a sequência aberta no fragmento anterior
+        if (pendingSize_ > 0) {
+            const size_t need = utf8SequenceLength(pending_[0]);
+            while (pendingSize_ < need && i < len) {
+                pending_[pendingSize_++] = s[i++];
+            }
+            if (pendingSize_ < need) {
+                return !fin;
+            }
+            if (!utf8ValidateScalar(reinterpret_cast<const char*>(pending_), need)) {
+                return false;
+            }
+            pendingSize_ = 0;
+        }
+
+        // Lead sem todas as continuações no fim: fica para o próximo fragmento
+        size_t end = len;
+        if (!fin) {
+            for (size_t k = 1; k <= 3 && k <= len - i; ++k) {
+                const uint8_t c = s[len - k];
+                if ((c & 0xC0) == 0x80) continue;
+                if (utf8SequenceLength(c) > k) end = len - k;
+                break;
+            }
+        }
+        if (!utf8Validate(data + i, end - i)) {
+            return false;
+        }
+        std::memcpy(pending_, s + end, len - end);
+        pendingSize_ = static_cast<uint8_t>(len - end);
+        return true;
+    }
+
+    // Mensagem em andamento (último fragmento visto sem FIN)
+    [[nodiscard]] bool active() const noexcept { return active_; }
+
+    void reset() noexcept {
+        pendingSize_ = 0;
+        active_ = false;
+    }
+
+private:
+    uint8_t pending_[4] = {};
+    uint8_t pendingSize_ = 0;
+    bool active_ = false;
+};
+
+} // namespace gg::internal
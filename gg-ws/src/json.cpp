@@ -1,8 +1,11 @@
 #include "gg_ws/json.hpp"
+#include "gg_ws/json_writer.hpp"
+#include "internal/json_lexer.hpp"
+#include "internal/json_number.hpp"
+#include "internal/json_structural.hpp"
+
 #include <cmath>
 #include <cstring>
-#include <sstream>
-#include <iomanip>
 
 namespace gg {
 
@@ -32,7 +35,7 @@ Json::Json(std::initializer_list<Json> init) {
         type_ = Type::Object;
         Object obj;
         for (const auto& item : init) {
-            obj[std::string(item[0].getString())] = item[1];
+            obj[item[0].getString()] = item[1];
         }
         value_ = std::move(obj);
     } else {
@@ -46,270 +49,185 @@ Json::Json(std::initializer_list<Json> init) {
 // ============================================
 namespace {
 
+namespace lexer = internal::json;
+
+// Aninhamento máximo (recursão limitada mesmo com entrada hostil)
+constexpr int MaxDepth = 512;
+
+// Estado reaproveitado entre parses da mesma thread (sem crescer em regime)
+struct ParseScratch {
+    lexer::StructuralIndex index;
+
+    // Filhos dos containers abertos até o fechamento, quando viram um
+    // Array de tamanho exato ou um Object com reserve() (como no JsonDocument)
+    std::vector<Json> elements;
+    std::vector<Json::Object::Member> members;
+    std::string key;                    // Chave com escape, decodificada
+};
+
+/**
+ * Estágio 2: constrói o DOM caminhando pelo índice estrutural. Não há
+ * varredura de espaços nem busca por delimitadores: cada token já é a
+ * posição do próximo operador, aspa ou escalar.
+ */
 class JsonParser {
 public:
-    explicit JsonParser(std::string_view input) : input_(input), pos_(0) {}
-    
-    std::optional<Json> parse() noexcept {
-        try {
-            skipWhitespace();
-            if (pos_ >= input_.size()) {
-                return std::nullopt;
-            }
-            
-            auto result = parseValue();
-            if (!result) return std::nullopt;
-            
-            skipWhitespace();
-            // Deve ter consumido toda a entrada
-            if (pos_ != input_.size()) {
-                return std::nullopt;
-            }
-            
-            return result;
-        } catch (...) {
-            return std::nullopt;
-        }
+    JsonParser(std::string_view input, ParseScratch& scratch) noexcept
+        : cursor_(input, scratch.index), elements_(scratch.elements), members_(scratch.members),
+          key_(scratch.key) {}
+
+    bool parse(Json& out) {
+        if (cursor_.done() || !parseValue(out, 0)) return false;
+        // Deve ter consumido toda a entrada
+        return cursor_.done();
     }
 
 private:
-    std::string_view input_;
-    size_t pos_;
-    
-    char peek() const noexcept {
-        if (pos_ >= input_.size()) return '\0';
-        return input_[pos_];
-    }
-    
-    char consume() noexcept {
-        if (pos_ >= input_.size()) return '\0';
-        return input_[pos_++];
-    }
-    
-    bool consume(char expected) noexcept {
-        if (peek() != expected) return false;
-        pos_++;
-        return true;
+    lexer::TokenCursor cursor_;
+    std::vector<Json>& elements_;
+    std::vector<Json::Object::Member>& members_;
+    std::string& key_;
+
+    bool literal(const char* word, size_t len) noexcept {
+        const char* p = cursor_.current();
+        if (static_cast<size_t>(cursor_.inputEnd() - p) < len || std::memcmp(p, word, len) != 0) {
+            return false;
+        }
+        return cursor_.finishScalar(p + len);
     }
-    
-    void skipWhitespace() noexcept {
-        while (pos_ < input_.size()) {
-            char c = input_[pos_];
-            if (c == ' ' || c == '\t' || c == '\n' || c == '\r') {
-                pos_++;
-            } else {
-                break;
+
+    bool parseValue(Json& out, int depth) {
+        switch (cursor_.peek()) {
+            case 'n':
+                out = Json(nullptr);
+                return literal("null", 4);
+            case 't':
+                out = Json(true);
+                return literal("true", 4);
+            case 'f':
+                out = Json(false);
+                return literal("false", 5);
+            case '"': {
+                std::string value;
+                if (!parseString(value)) return false;
+                out = Json(std::move(value));
+                return true;
+            }
+            case '[':
+                return depth < MaxDepth && parseArray(out, depth + 1);
+            case '{':
+                return depth < MaxDepth && parseObject(out, depth + 1);
+            case '-': case '0': case '1': case '2': case '3': case '4':
+            case '5': case '6': case '7': case '8': case '9': {
+                lexer::Number number;
+                const char* end = lexer::parseNumber(cursor_.current(), cursor_.inputEnd(), number);
+                if (!end) return false;
+                switch (number.kind) {
+                    case lexer::Number::Kind::Int:  out = Json(number.i); break;
+                    case lexer::Number::Kind::UInt: out = Json(number.u); break;
+                    case lexer::Number::Kind::Decimal: out = Json(Decimal(number.i, number.scale)); break;
+                    default:                        out = Json(number.d); break;
+                }
+                return cursor_.finishScalar(end);
             }
+            default:
+                return false;
         }
     }
-    
-    std::optional<Json> parseValue() noexcept {
-        skipWhitespace();
-        
-        char c = peek();
-        
-        if (c == 'n') return parseNull();
-        if (c == 't' || c == 'f') return parseBool();
-        if (c == '"') return parseString();
-        if (c == '[') return parseArray();
-        if (c == '{') return parseObject();
-        if (c == '-' || (c >= '0' && c <= '9')) return parseNumber();
-        
-        return std::nullopt;
-    }
-    
-    std::optional<Json> parseNull() noexcept {
-        if (input_.substr(pos_, 4) == "null") {
-            pos_ += 4;
-            return Json(nullptr);
+
+    // Token atual na aspa de abertura; o índice já marca a de fechamento
+    bool parseString(std::string& out) {
+        const char* begin;
+        const char* close;
+        if (!cursor_.takeString(begin, close)) return false;
+        const size_t raw = static_cast<size_t>(close - begin);
+        if (!std::memchr(begin, '\\', raw)) {
+            out.assign(begin, raw);
+            return true;
         }
-        return std::nullopt;
+        out.resize(raw);
+        std::ptrdiff_t n = lexer::unescape(begin, close, out.data());
+        if (n < 0) return false;
+        out.resize(static_cast<size_t>(n));
+        return true;
     }
-    
-    std::optional<Json> parseBool() noexcept {
-        if (input_.substr(pos_, 4) == "true") {
-            pos_ += 4;
-            return Json(true);
-        }
-        if (input_.substr(pos_, 5) == "false") {
-            pos_ += 5;
-            return Json(false);
+
+    // Chave como view: da entrada, ou de key_ se tem escape
+    bool parseKey(std::string_view& out) {
+        const char* begin;
+        const char* close;
+        if (!cursor_.takeString(begin, close)) return false;
+        const size_t raw = static_cast<size_t>(close - begin);
+        if (!std::memchr(begin, '\\', raw)) {
+            out = std::string_view(begin, raw);
+            return true;
         }
-        return std::nullopt;
+        key_.resize(raw);
+        std::ptrdiff_t n = lexer::unescape(begin, close, key_.data());
+        if (n < 0) return false;
+        out = std::string_view(key_.data(), static_cast<size_t>(n));
+        return true;
     }
-    
-    std::optional<Json> parseNumber() noexcept {
-        size_t start = pos_;
-        
-        // Opcional: sinal negativo
-        if (peek() == '-') consume();
-        
-        // Parte inteira
-        if (peek() == '0') {
-            consume();
-        } else if (peek() >= '1' && peek() <= '9') {
-            while (peek() >= '0' && peek() <= '9') consume();
+
+    bool parseArray(Json& out, int depth) {
+        cursor_.advance();
+        const size_t base = elements_.size();
+        if (cursor_.peek() == ']') {
+            cursor_.advance();
         } else {
-            return std::nullopt;
-        }
-        
-        // Parte decimal (opcional)
-        if (peek() == '.') {
-            consume();
-            if (!(peek() >= '0' && peek() <= '9')) return std::nullopt;
-            while (peek() >= '0' && peek() <= '9') consume();
-        }
-        
-        // Expoente (opcional)
-        if (peek() == 'e' || peek() == 'E') {
-            consume();
-            if (peek() == '+' || peek() == '-') consume();
-            if (!(peek() >= '0' && peek() <= '9')) return std::nullopt;
-            while (peek() >= '0' && peek() <= '9') consume();
-        }
-        
-        std::string numStr(input_.substr(start, pos_ - start));
-        
-        // Conversão segura
-        char* end;
-        double value = std::strtod(numStr.c_str(), &end);
-        if (end != numStr.c_str() + numStr.size()) {
-            return std::nullopt;
-        }
-        
-        return Json(value);
-    }
-    
-    std::optional<Json> parseString() noexcept {
-        if (!consume('"')) return std::nullopt;
-        
-        std::string result;
-        result.reserve(32);
-        
-        while (pos_ < input_.size()) {
-            char c = consume();
-            
-            if (c == '"') {
-                return Json(std::move(result));
-            }
-            
-            if (c == '\\') {
-                if (pos_ >= input_.size()) return std::nullopt;
-                
-                char escaped = consume();
-                switch (escaped) {
-                    case '"':  result += '"'; break;
-                    case '\\': result += '\\'; break;
-                    case '/':  result += '/'; break;
-                    case 'b':  result += '\b'; break;
-                    case 'f':  result += '\f'; break;
-                    case 'n':  result += '\n'; break;
-                    case 'r':  result += '\r'; break;
-                    case 't':  result += '\t'; break;
-                    case 'u': {
-                        // Unicode escape \uXXXX
-                        if (pos_ + 4 > input_.size()) return std::nullopt;
-                        
-                        uint32_t codepoint = 0;
-                        for (int i = 0; i < 4; i++) {
-                            char hex = consume();
-                            codepoint *= 16;
-                            if (hex >= '0' && hex <= '9') codepoint += hex - '0';
-                            else if (hex >= 'a' && hex <= 'f') codepoint += 10 + hex - 'a';
-                            else if (hex >= 'A' && hex <= 'F') codepoint += 10 + hex - 'A';
-                            else return std::nullopt;
-                        }
-                        
-                        // Converte para UTF-8
-                        if (codepoint < 0x80) {
-                            result += static_cast<char>(codepoint);
-                        } else if (codepoint < 0x800) {
-                            result += static_cast<char>(0xC0 | (codepoint >> 6));
-                            result += static_cast<char>(0x80 | (codepoint & 0x3F));
-                        } else {
-                            result += static_cast<char>(0xE0 | (codepoint >> 12));
-                            result += static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F));
-                            result += static_cast<char>(0x80 | (codepoint & 0x3F));
-                        }
-                        break;
-                    }
-                    default:
-                        return std::nullopt;
-                }
-            } else if (static_cast<unsigned char>(c) < 0x20) {
-                // Caracteres de controle não são permitidos
-                return std::nullopt;
-            } else {
-                result += c;
+            for (;;) {
+                Json element;
+                if (!parseValue(element, depth)) return false;
+                elements_.push_back(std::move(element));
+
+                const char c = cursor_.peek();
+                cursor_.advance();
+                if (c == ']') break;
+                if (c != ',') return false;
             }
         }
-        
-        return std::nullopt; // String não terminada
+
+        auto first = elements_.begin() + static_cast<std::ptrdiff_t>(base);
+        Json::Array arr(std::make_move_iterator(first), std::make_move_iterator(elements_.end()));
+        elements_.erase(first, elements_.end());
+        out = Json(std::move(arr));
+        return true;
     }
-    
-    std::optional<Json> parseArray() noexcept {
-        if (!consume('[')) return std::nullopt;
-        
-        Json::Array arr;
-        skipWhitespace();
-        
-        if (peek() == ']') {
-            consume();
-            return Json(std::move(arr));
-        }
-        
-        while (true) {
-            auto value = parseValue();
-            if (!value) return std::nullopt;
-            
-            arr.push_back(std::move(*value));
-            
-            skipWhitespace();
-            
-            if (peek() == ']') {
-                consume();
-                return Json(std::move(arr));
+
+    bool parseObject(Json& out, int depth) {
+        cursor_.advance();
+        const size_t base = members_.size();
+        if (cursor_.peek() == '}') {
+            cursor_.advance();
+        } else {
+            for (;;) {
+                // Chave deve ser string; internada antes do valor (key_ é reaproveitada)
+                std::string_view key;
+                if (cursor_.peek() != '"' || !parseKey(key)) return false;
+                if (cursor_.peek() != ':') return false;
+                cursor_.advance();
+                detail::KeyHandle handle(key);
+                Json value;
+                if (!parseValue(value, depth)) return false;
+                members_.emplace_back(std::move(handle), std::move(value));
+
+                const char c = cursor_.peek();
+                cursor_.advance();
+                if (c == '}') break;
+                if (c != ',') return false;
             }
-            
-            if (!consume(',')) return std::nullopt;
         }
-    }
-    
-    std::optional<Json> parseObject() noexcept {
-        if (!consume('{')) return std::nullopt;
-        
+
+        auto first = members_.begin() + static_cast<std::ptrdiff_t>(base);
         Json::Object obj;
-        skipWhitespace();
-        
-        if (peek() == '}') {
-            consume();
-            return Json(std::move(obj));
-        }
-        
-        while (true) {
-            skipWhitespace();
-            
-            // Chave deve ser string
-            auto key = parseString();
-            if (!key || !key->isString()) return std::nullopt;
-            
-            skipWhitespace();
-            if (!consume(':')) return std::nullopt;
-            
-            auto value = parseValue();
-            if (!value) return std::nullopt;
-            
-            obj[std::string(key->getString())] = std::move(*value);
-            
-            skipWhitespace();
-            
-            if (peek() == '}') {
-                consume();
-                return Json(std::move(obj));
-            }
-            
-            if (!consume(',')) return std::nullopt;
+        obj.reserve(members_.size() - base);
+        for (auto it = first; it != members_.end(); ++it) {
+            // Chave repetida: vale a última
+            obj.insert_or_assign(std::move(*it));
         }
+        members_.erase(first, members_.end());
+        out = Json(std::move(obj));
+        return true;
     }
 };
 
@@ -319,110 +237,105 @@ private:
 // Parsing
 // ============================================
 std::optional<Json> Json::parse(std::string_view input) noexcept {
-    JsonParser parser(input);
-    return parser.parse();
+    thread_local ParseScratch scratch;
+    std::optional<Json> result;
+    try {
+        if (scratch.index.build(input)) {
+            JsonParser parser(input, scratch);
+            result.emplace();
+            if (!parser.parse(*result)) result.reset();
+        }
+    } catch (...) {
+        result.reset();
+    }
+    // Erro no meio de um container: descarta o que ficou nas pilhas
+    scratch.elements.clear();
+    scratch.members.clear();
+    return result;
 }
 
 bool Json::isValid(std::string_view input) noexcept {
-    return parse(input).has_value();
+    // Handler vazio: só a gramática, sem DOM
+    struct Validator {} validator;
+    return static_cast<bool>(parseEvents(input, validator));
 }
 
 // ============================================
-// Serialização
+// Parse por Eventos
 // ============================================
-namespace {
+namespace detail {
+
+bool indexEvents(std::string_view input, const uint32_t*& begin, const uint32_t*& end) noexcept {
+    thread_local lexer::StructuralIndex index;
+    try {
+        if (!index.build(input)) return false;
+    } catch (...) {
+        return false;
+    }
+    begin = index.begin();
+    end = index.end();
+    return true;
+}
 
-void escapeString(std::ostringstream& out, std::string_view str) {
-    out << '"';
-    for (char c : str) {
-        switch (c) {
-            case '"':  out << "\\\""; break;
-            case '\\': out << "\\\\"; break;
-            case '\b': out << "\\b"; break;
-            case '\f': out << "\\f"; break;
-            case '\n': out << "\\n"; break;
-            case '\r': out << "\\r"; break;
-            case '\t': out << "\\t"; break;
-            default:
-                if (static_cast<unsigned char>(c) < 0x20) {
-                    out << "\\u" << std::hex << std::setfill('0') << std::setw(4) 
-                        << static_cast<int>(static_cast<unsigned char>(c));
-                } else {
-                    out << c;
-                }
-        }
+bool unescapeEvent(const char* begin, const char* close, std::string_view& out) noexcept {
+    // Cresce até a maior string com escape vista; depois, sem alocação
+    thread_local std::string buffer;
+    try {
+        if (buffer.size() < static_cast<size_t>(close - begin)) buffer.resize(static_cast<size_t>(close - begin));
+    } catch (...) {
+        return false;
     }
-    out << '"';
+    const std::ptrdiff_t n = lexer::unescape(begin, close, buffer.data());
+    if (n < 0) return false;
+    out = std::string_view(buffer.data(), static_cast<size_t>(n));
+    return true;
 }
 
-void stringifyImpl(std::ostringstream& out, const Json& json, bool pretty, int indent) {
-    std::string indentStr(indent * 2, ' ');
-    std::string nextIndent((indent + 1) * 2, ' ');
-    
-    switch (json.type()) {
-        case Json::Type::Null:
-            out << "null";
-            break;
-            
-        case Json::Type::Bool:
-            out << (json.getBool() ? "true" : "false");
-            break;
-            
-        case Json::Type::Number: {
-            double num = json.getNumber();
-            if (std::isnan(num) || std::isinf(num)) {
-                out << "null";
-            } else if (num == std::floor(num) && std::abs(num) < 1e15) {
-                out << static_cast<int64_t>(num);
-            } else {
-                out << std::setprecision(17) << num;
-            }
+} // namespace detail
+
+const char* JsonNumber::parse(const char* p, const char* end, JsonNumber& out) noexcept {
+    lexer::Number number;
+    const char* numberEnd = lexer::parseNumber(p, end, number);
+    switch (number.kind) {
+        case lexer::Number::Kind::Int:
+            out.kind_ = Kind::Int;
+            out.integer_ = number.i;
             break;
-        }
-            
-        case Json::Type::String:
-            escapeString(out, json.getString());
+        case lexer::Number::Kind::UInt:
+            out.kind_ = Kind::UInt;
+            out.uinteger_ = number.u;
             break;
-            
-        case Json::Type::Array: {
-            out << '[';
-            bool first = true;
-            json.forEach([&](const Json& item) {
-                if (!first) out << ',';
-                if (pretty) out << '\n' << nextIndent;
-                first = false;
-                stringifyImpl(out, item, pretty, indent + 1);
-            });
-            if (pretty && json.size() > 0) out << '\n' << indentStr;
-            out << ']';
+        case lexer::Number::Kind::Decimal:
+            out.kind_ = Kind::Decimal;
+            out.integer_ = number.i;
+            out.scale_ = number.scale;
             break;
-        }
-            
-        case Json::Type::Object: {
-            out << '{';
-            bool first = true;
-            json.forEachPair([&](const std::string& key, const Json& value) {
-                if (!first) out << ',';
-                if (pretty) out << '\n' << nextIndent;
-                first = false;
-                escapeString(out, key);
-                out << ':';
-                if (pretty) out << ' ';
-                stringifyImpl(out, value, pretty, indent + 1);
-            });
-            if (pretty && json.size() > 0) out << '\n' << indentStr;
-            out << '}';
+        default:
+            out.kind_ = Kind::Double;
+            out.number_ = number.d;
             break;
-        }
     }
+    return numberEnd;
 }
 
-} // anonymous namespace
-
+// ============================================
+// Serialização
+// ============================================
 std::string Json::stringify(bool pretty) const {
-    std::ostringstream out;
-    stringifyImpl(out, *this, pretty, 0);
-    return out.str();
+    std::string out;
+    stringify(out, pretty);
+    return out;
+}
+
+void Json::stringify(std::string& out, bool pretty) const {
+    JsonWriter writer(out, pretty);
+    writer.value(*this);
+}
+
+size_t Json::stringify(char* buffer, size_t capacity, bool pretty) const noexcept {
+    JsonWriter writer(buffer, capacity, pretty);
+    writer.value(*this);
+    return writer.overflow() ? 0 : writer.size();
 }
 
 // ============================================
@@ -433,14 +346,93 @@ bool Json::getBool(bool defaultValue) const noexcept {
     return std::get<bool>(value_);
 }
 
+namespace {
+
+// Parte inteira (truncada para zero) de um Decimal
+int64_t truncate(const Decimal& decimal) noexcept {
+    int64_t value = decimal.mantissa;
+    for (uint8_t i = 0; i < decimal.scale; ++i) value /= 10;
+    return value;
+}
+
+} // anonymous namespace
+
 double Json::getNumber(double defaultValue) const noexcept {
-    if (type_ != Type::Number) return defaultValue;
-    return std::get<double>(value_);
+    if (const auto* d = std::get_if<double>(&value_)) return *d;
+    if (const auto* decimal = std::get_if<Decimal>(&value_)) return decimal->toDouble();
+    if (const auto* i = std::get_if<int64_t>(&value_)) return static_cast<double>(*i);
+    if (const auto* u = std::get_if<uint64_t>(&value_)) return static_cast<double>(*u);
+    return defaultValue;
 }
 
 int64_t Json::getInt(int64_t defaultValue) const noexcept {
-    if (type_ != Type::Number) return defaultValue;
-    return static_cast<int64_t>(std::get<double>(value_));
+    if (const auto* i = std::get_if<int64_t>(&value_)) return *i;
+    if (const auto* decimal = std::get_if<Decimal>(&value_)) return truncate(*decimal);
+    if (const auto* d = std::get_if<double>(&value_)) {
+        // [-2^63, 2^63): fora disso a conversão seria indefinida
+        if (*d >= -9223372036854775808.0 && *d < 9223372036854775808.0) return static_cast<int64_t>(*d);
+    }
+    return defaultValue;     // Inclui uint64 acima de INT64_MAX
+}
+
+uint64_t Json::getUInt(uint64_t defaultValue) const noexcept {
+    if (const auto* i = std::get_if<int64_t>(&value_)) {
+        return *i >= 0 ? static_cast<uint64_t>(*i) : defaultValue;
+    }
+    if (const auto* u = std::get_if<uint64_t>(&value_)) return *u;
+    if (const auto* decimal = std::get_if<Decimal>(&value_)) {
+        const int64_t i = truncate(*decimal);
+        return i >= 0 ? static_cast<uint64_t>(i) : defaultValue;
+    }
+    if (const auto* d = std::get_if<double>(&value_)) {
+        if (*d > -1.0 && *d < 18446744073709551616.0) return static_cast<uint64_t>(*d);
+    }
+    return defaultValue;
+}
+
+// JsonNumber: mesmas conversões de Json
+double JsonNumber::getNumber() const noexcept {
+    switch (kind_) {
+        case Kind::Int:     return static_cast<double>(integer_);
+        case Kind::UInt:    return static_cast<double>(uinteger_);
+        case Kind::Decimal: return Decimal(integer_, scale_).toDouble();
+        default:            return number_;
+    }
+}
+
+int64_t JsonNumber::getInt(int64_t defaultValue) const noexcept {
+    switch (kind_) {
+        case Kind::Int:     return integer_;
+        case Kind::UInt:    return defaultValue;
+        case Kind::Decimal: return truncate(Decimal(integer_, scale_));
+        default:            return Json(number_).getInt(defaultValue);
+    }
+}
+
+uint64_t JsonNumber::getUInt(uint64_t defaultValue) const noexcept {
+    switch (kind_) {
+        case Kind::Int:     return integer_ >= 0 ? static_cast<uint64_t>(integer_) : defaultValue;
+        case Kind::UInt:    return uinteger_;
+        case Kind::Decimal: return Json(Decimal(integer_, scale_)).getUInt(defaultValue);
+        default:            return Json(number_).getUInt(defaultValue);
+    }
+}
+
+Decimal JsonNumber::getDecimal(Decimal defaultValue) const noexcept {
+    switch (kind_) {
+        case Kind::Int:     return Decimal(integer_, 0);
+        case Kind::UInt:    return defaultValue;
+        case Kind::Decimal: return Decimal(integer_, scale_);
+        default:            return Decimal::fromDouble(number_).value_or(defaultValue);
+    }
+}
+
+Decimal Json::getDecimal(Decimal defaultValue) const noexcept {
+    if (const auto* decimal = std::get_if<Decimal>(&value_)) return *decimal;
+    if (const auto* i = std::get_if<int64_t>(&value_)) return Decimal(*i, 0);
+    if (const auto* d = std::get_if<double>(&value_)) return Decimal::fromDouble(*d).value_or(defaultValue);
+    if (const auto* s = std::get_if<std::string>(&value_)) return Decimal::parse(*s).value_or(defaultValue);
+    return defaultValue;    // uint64 acima de INT64_MAX, outros tipos
 }
 
 std::string_view Json::getString(std::string_view defaultValue) const noexcept {
@@ -489,10 +481,8 @@ bool Json::empty() const noexcept {
 // ============================================
 const Json& Json::operator[](std::string_view key) const noexcept {
     if (type_ != Type::Object) return nullJson();
-    const auto& obj = std::get<Object>(value_);
-    auto it = obj.find(std::string(key));
-    if (it == obj.end()) return nullJson();
-    return it->second;
+    const Json* value = std::get<Object>(value_).find(key);
+    return value ? *value : nullJson();
 }
 
 Json& Json::operator[](std::string_view key) {
@@ -502,8 +492,7 @@ Json& Json::operator[](std::string_view key) {
         value_ = Object{};
     }
     if (type_ != Type::Object) return nullJson();
-    auto& obj = std::get<Object>(value_);
-    return obj[std::string(key)];
+    return std::get<Object>(value_)[key];
 }
 
 const Json& Json::get(std::string_view key) const noexcept {
@@ -512,8 +501,15 @@ const Json& Json::get(std::string_view key) const noexcept {
 
 bool Json::contains(std::string_view key) const noexcept {
     if (type_ != Type::Object) return false;
-    const auto& obj = std::get<Object>(value_);
-    return obj.find(std::string(key)) != obj.end();
+    return std::get<Object>(value_).contains(key);
+}
+
+// Json::Key (as buscas const são inline em json.hpp)
+Json& Json::operator[](Key key) {
+    if (type_ == Type::Object) {
+        if (Json* value = std::get<Object>(value_).find(key.text(), key.hash())) return *value;
+    }
+    return (*this)[key.text()];     // Inserção (ou conversão de null)
 }
 
 std::vector<std::string> Json::keys() const {
@@ -521,8 +517,8 @@ std::vector<std::string> Json::keys() const {
     if (type_ == Type::Object) {
         const auto& obj = std::get<Object>(value_);
         result.reserve(obj.size());
-        for (const auto& [key, _] : obj) {
-            result.push_back(key);
+        for (const auto& member : obj) {
+            result.emplace_back(member.key());
         }
     }
     return result;
@@ -548,7 +544,7 @@ void Json::pop() {
 
 void Json::erase(std::string_view key) {
     if (type_ != Type::Object) return;
-    std::get<Object>(value_).erase(std::string(key));
+    std::get<Object>(value_).erase(key);
 }
 
 void Json::clear() {
@@ -564,7 +560,26 @@ void Json::clear() {
 // ============================================
 bool Json::operator==(const Json& other) const noexcept {
     if (type_ != other.type_) return false;
-    return value_ == other.value_;
+    if (type_ != Type::Number || value_.index() == other.value_.index()) return value_ == other.value_;
+
+    // Representações diferentes do mesmo número (1 == 1.0): compara exato
+    if (isInteger() && other.isInteger()) return false;   // Canônicos: int64 e uint64 nunca coincidem
+    if (isDecimal() || other.isDecimal()) {
+        const Decimal missing(0, Decimal::MaxScale + 1);    // Escala impossível: não converteu
+        const Decimal a = getDecimal(missing);
+        const Decimal b = other.getDecimal(missing);
+        return a.scale <= Decimal::MaxScale && b.scale <= Decimal::MaxScale && a == b;
+    }
+    const Json& real = isInteger() ? other : *this;
+    const Json& integer = isInteger() ? *this : other;
+    const double d = real.getNumber();
+    if (d != std::floor(d)) return false;
+    if (std::holds_alternative<uint64_t>(integer.value_)) {
+        return d >= 9223372036854775808.0 && d < 18446744073709551616.0 &&
+               static_cast<uint64_t>(d) == integer.getUInt();
+    }
+    return d >= -9223372036854775808.0 && d < 9223372036854775808.0 &&
+           static_cast<int64_t>(d) == integer.getInt();
 }
 
 } // namespace gg
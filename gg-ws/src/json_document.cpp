@@ -0,0 +1,291 @@
+#include "gg_ws/json_document.hpp"
+#include "internal/arena.hpp"
+#include "internal/json_lexer.hpp"
+#include "internal/json_number.hpp"
+
+#include <cstring>
+#include <limits>
+#include <vector>
+
+namespace gg {
+
+using Node = JsonValue::Node;
+using Member = JsonValue::Member;
+
+// ============================================
+// Estado do documento
+// ============================================
+struct JsonDocument::Impl {
+    internal::MonotonicArena arena;
+
+    // Pilhas de trabalho: filhos dos containers abertos até o fechamento,
+    // quando viram um vetor exato na arena. Reaproveitadas entre parses.
+    std::vector<Node> elements;
+    std::vector<Member> members;
+
+    explicit Impl(size_t initialBytes) : arena(initialBytes) {}
+};
+
+// ============================================
+// Parser Interno
+// ============================================
+namespace {
+
+// Aninhamento máximo (recursão limitada mesmo com entrada hostil)
+constexpr int MaxDepth = 512;
+
+class DocumentParser {
+public:
+    DocumentParser(internal::MonotonicArena& arena, std::vector<Node>& elements,
+                   std::vector<Member>& members, std::string_view input)
+        : arena_(arena), elements_(elements), members_(members),
+          p_(input.data()), end_(input.data() + input.size()) {}
+
+    const Node* parse() {
+        Node* root = arena_.allocateArray<Node>(1);
+        p_ = internal::json::skipSpace(p_, end_);
+        if (!parseValue(*root, 0)) return nullptr;
+        p_ = internal::json::skipSpace(p_, end_);
+        // Deve ter consumido toda a entrada
+        return p_ == end_ ? root : nullptr;
+    }
+
+private:
+    internal::MonotonicArena& arena_;
+    std::vector<Node>& elements_;
+    std::vector<Member>& members_;
+    const char* p_;
+    const char* end_;
+
+    bool literal(const char* word, size_t len) noexcept {
+        if (static_cast<size_t>(end_ - p_) < len || std::memcmp(p_, word, len) != 0) return false;
+        p_ += len;
+        return true;
+    }
+
+    bool parseValue(Node& out, int depth) {
+        if (p_ >= end_) return false;
+        out.numberKind = JsonValue::NumberKind::Double;
+        out.length = 0;
+        switch (*p_) {
+            case 'n':
+                out.type = Json::Type::Null;
+                out.boolean = false;
+                return literal("null", 4);
+            case 't':
+                out.type = Json::Type::Bool;
+                out.boolean = true;
+                return literal("true", 4);
+            case 'f':
+                out.type = Json::Type::Bool;
+                out.boolean = false;
+                return literal("false", 5);
+            case '"': {
+                out.type = Json::Type::String;
+                return parseString(out.string, out.length);
+            }
+            case '[':
+                return depth < MaxDepth && parseArray(out, depth + 1);
+            case '{':
+                return depth < MaxDepth && parseObject(out, depth + 1);
+            default: {
+                internal::json::Number number;
+                const char* end = internal::json::parseNumber(p_, end_, number);
+                if (!end) return false;
+                out.type = Json::Type::Number;
+                switch (number.kind) {
+                    case internal::json::Number::Kind::Int:
+                        out.numberKind = JsonValue::NumberKind::Int;
+                        out.integer = number.i;
+                        break;
+                    case internal::json::Number::Kind::UInt:
+                        out.numberKind = JsonValue::NumberKind::UInt;
+                        out.uinteger = number.u;
+                        break;
+                    case internal::json::Number::Kind::Decimal:
+                        out.numberKind = JsonValue::NumberKind::Decimal;
+                        out.integer = number.i;
+                        out.length = number.scale;
+                        break;
+                    default:
+                        out.numberKind = JsonValue::NumberKind::Double;
+                        out.number = number.d;
+                        break;
+                }
+                p_ = end;
+                return true;
+            }
+        }
+    }
+
+    // p_ na aspa de abertura. Sem escape: view da entrada; com escape: cópia decodificada na arena.
+    bool parseString(const char*& data, uint32_t& length) {
+        bool escaped;
+        const char* begin = p_ + 1;
+        const char* close = internal::json::scanString(begin, end_, escaped);
+        if (!close) return false;
+        const size_t raw = static_cast<size_t>(close - begin);
+        if (raw > std::numeric_limits<uint32_t>::max()) return false;
+        p_ = close + 1;
+
+        if (!escaped) {
+            data = begin;
+            length = static_cast<uint32_t>(raw);
+            return true;
+        }
+        char* out = static_cast<char*>(arena_.allocate(raw, 1));
+        std::ptrdiff_t n = internal::json::unescape(begin, close, out);
+        if (n < 0) return false;
+        data = out;
+        length = static_cast<uint32_t>(n);
+        return true;
+    }
+
+    bool parseArray(Node& out, int depth) {
+        ++p_;
+        const size_t base = elements_.size();
+        p_ = internal::json::skipSpace(p_, end_);
+        if (p_ < end_ && *p_ == ']') {
+            ++p_;
+        } else {
+            for (;;) {
+                Node element;
+                p_ = internal::json::skipSpace(p_, end_);
+                if (!parseValue(element, depth)) return false;
+                elements_.push_back(element);
+
+                p_ = internal::json::skipSpace(p_, end_);
+                if (p_ >= end_) return false;
+                if (*p_ == ']') {
+                    ++p_;
+                    break;
+                }
+                if (*p_++ != ',') return false;
+            }
+        }
+
+        const size_t count = elements_.size() - base;
+        Node* elements = arena_.allocateArray<Node>(count);
+        std::copy(elements_.begin() + static_cast<std::ptrdiff_t>(base), elements_.end(), elements);
+        elements_.resize(base);
+
+        out.type = Json::Type::Array;
+        out.length = static_cast<uint32_t>(count);
+        out.elements = elements;
+        return true;
+    }
+
+    bool parseObject(Node& out, int depth) {
+        ++p_;
+        const size_t base = members_.size();
+        p_ = internal::json::skipSpace(p_, end_);
+        if (p_ < end_ && *p_ == '}') {
+            ++p_;
+        } else {
+            for (;;) {
+                Member member;
+                p_ = internal::json::skipSpace(p_, end_);
+
+                // Chave deve ser string
+                if (p_ >= end_ || *p_ != '"' || !parseString(member.key, member.keyLength)) return false;
+                p_ = internal::json::skipSpace(p_, end_);
+                if (p_ >= end_ || *p_++ != ':') return false;
+                p_ = internal::json::skipSpace(p_, end_);
+                if (!parseValue(member.value, depth)) return false;
+                members_.push_back(member);
+
+                p_ = internal::json::skipSpace(p_, end_);
+                if (p_ >= end_) return false;
+                if (*p_ == '}') {
+                    ++p_;
+                    break;
+                }
+                if (*p_++ != ',') return false;
+            }
+        }
+
+        const size_t count = members_.size() - base;
+        Member* members = arena_.allocateArray<Member>(count);
+        std::copy(members_.begin() + static_cast<std::ptrdiff_t>(base), members_.end(), members);
+        members_.resize(base);
+
+        out.type = Json::Type::Object;
+        out.length = static_cast<uint32_t>(count);
+        out.members = members;
+        return true;
+    }
+};
+
+} // anonymous namespace
+
+// ============================================
+// JsonDocument
+// ============================================
+JsonDocument::JsonDocument(size_t initialArenaBytes)
+    : impl_(std::make_unique<Impl>(initialArenaBytes)) {}
+
+JsonDocument::~JsonDocument() = default;
+JsonDocument::JsonDocument(JsonDocument&&) noexcept = default;
+JsonDocument& JsonDocument::operator=(JsonDocument&&) noexcept = default;
+
+bool JsonDocument::parse(std::string_view input) noexcept {
+    reset();
+    try {
+        DocumentParser parser(impl_->arena, impl_->elements, impl_->members, input);
+        root_ = parser.parse();
+    } catch (...) {
+        root_ = nullptr;
+    }
+    if (!root_) {
+        // Erro no meio de um container: descarta o que ficou nas pilhas
+        impl_->elements.clear();
+        impl_->members.clear();
+    }
+    return root_ != nullptr;
+}
+
+void JsonDocument::reset() noexcept {
+    root_ = nullptr;
+    impl_->arena.reset();
+}
+
+size_t JsonDocument::arenaCapacity() const noexcept {
+    return impl_->arena.capacity();
+}
+
+// ============================================
+// JsonValue
+// ============================================
+Json JsonValue::toJson() const {
+    switch (type()) {
+        case Json::Type::Null:
+            return Json(nullptr);
+        case Json::Type::Bool:
+            return Json(node_->boolean);
+        case Json::Type::Number:
+            switch (node_->numberKind) {
+                case NumberKind::Int:  return Json(node_->integer);
+                case NumberKind::UInt: return Json(node_->uinteger);
+                case NumberKind::Decimal: return Json(decimal());
+                default:               return Json(node_->number);
+            }
+        case Json::Type::String:
+            return Json(getString());
+        case Json::Type::Array: {
+            Json::Array array;
+            array.reserve(node_->length);
+            forEach([&array](JsonValue item) { array.push_back(item.toJson()); });
+            return Json(std::move(array));
+        }
+        case Json::Type::Object: {
+            Json::Object object;
+            forEachPair([&object](std::string_view key, JsonValue value) {
+                object.insert_or_assign(key, value.toJson());
+            });
+            return Json(std::move(object));
+        }
+    }
+    return Json();
+}
+
+} // namespace gg
@@ -0,0 +1,331 @@
+#include "gg_ws/json.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <mutex>
+#include <new>
+#include <unordered_map>
+
+namespace gg {
+
+namespace detail {
+
+// ============================================
+// Tabela de chaves internadas
+// ============================================
+namespace {
+
+KeyData* newKey(std::string_view text, uint64_t hash, bool interned) {
+    void* memory = ::operator new(sizeof(KeyData) + text.size());
+    auto* key = new (memory) KeyData{hash, static_cast<uint32_t>(text.size()), interned};
+    if (!text.empty()) std::memcpy(key + 1, text.data(), text.size());
+    return key;
+}
+
+void deleteKey(const KeyData* key) noexcept {
+    if (key && !key->interned) ::operator delete(const_cast<KeyData*>(key));
+}
+
+/**
+ * Tabela global (mutex) com um cache por thread na frente: em regime, as
+ * chaves de um feed são achadas no cache, sem trava. As entradas nunca
+ * são liberadas; o limite de MaxInterned segura chaves que não se repetem
+ * (ids usados como chave), que passam a ser copiadas. Com a tabela cheia,
+ * a falta no cache não toma mais a trava: a chave é copiada direto.
+ */
+class InternTable {
+public:
+    // Nunca destruída: as entradas vivem até o fim do processo
+    static InternTable& instance() {
+        static InternTable* table = new InternTable;
+        return *table;
+    }
+
+    // Entrada internada, ou nullptr se não cabe na tabela
+    const KeyData* intern(std::string_view text, uint64_t hash) {
+        if (text.size() > KeyHandle::MaxInternedSize) return nullptr;
+
+        thread_local const KeyData* cache[CacheSize] = {};
+        const KeyData*& cached = cache[hash & (CacheSize - 1)];
+        if (cached && cached->hash == hash && std::string_view(cached->text(), cached->size) == text) {
+            return cached;
+        }
+
+        // Chave que já está na tabela e caiu fora do cache também vira cópia
+        if (full_.load(std::memory_order_relaxed)) return nullptr;
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = keys_.find(text);
+        if (it == keys_.end()) {
+            if (keys_.size() >= KeyHandle::MaxInterned) {
+                full_.store(true, std::memory_order_relaxed);
+                return nullptr;
+            }
+            const KeyData* key = newKey(text, hash, true);
+            it = keys_.emplace(std::string_view(key->text(), key->size), key).first;
+        }
+        cached = it->second;
+        return cached;
+    }
+
+private:
+    static constexpr size_t CacheSize = 512;
+
+    std::mutex mutex_;
+    std::atomic<bool> full_{false};
+    std::unordered_map<std::string_view, const KeyData*> keys_;     // Views do texto das entradas
+};
+
+} // anonymous namespace
+
+KeyHandle::KeyHandle(std::string_view text, uint64_t hash) {
+    data_ = InternTable::instance().intern(text, hash);
+    if (!data_) data_ = newKey(text, hash, false);
+}
+
+// Cópia de um handle movido é outro handle vazio
+KeyHandle::KeyHandle(const KeyHandle& other)
+    : data_(!other.data_ || other.data_->interned ? other.data_ : newKey(other.view(), other.hash(), false)) {}
+
+KeyHandle& KeyHandle::operator=(const KeyHandle& other) {
+    if (this != &other) *this = KeyHandle(other);
+    return *this;
+}
+
+KeyHandle& KeyHandle::operator=(KeyHandle&& other) noexcept {
+    if (this != &other) {
+        deleteKey(data_);
+        data_ = other.data_;
+        other.data_ = nullptr;
+    }
+    return *this;
+}
+
+KeyHandle::~KeyHandle() {
+    deleteKey(data_);
+}
+
+} // namespace detail
+
+// ============================================
+// Índice por hash (objects grandes)
+// ============================================
+struct JsonObject::Index {
+    // Membros (nullptr = vazio); tamanho potência de 2, ocupação <= 1/2
+    std::vector<const Member*> slots;
+
+    void insert(const Member& member) noexcept {
+        const size_t mask = slots.size() - 1;
+        size_t slot = member.key_.hash() & mask;
+        while (slots[slot]) slot = (slot + 1) & mask;
+        slots[slot] = &member;
+    }
+};
+
+void JsonObject::rebuildIndex() {
+    if (size_ <= IndexThreshold) {
+        index_.reset();
+        return;
+    }
+    if (!index_) index_ = std::make_unique<Index>();
+    size_t capacity = 64;
+    while (capacity < size_ * 2) capacity *= 2;
+    index_->slots.assign(capacity, nullptr);
+    for (const Member& member : *this) index_->insert(member);
+}
+
+// ============================================
+// Blocos
+// ============================================
+JsonObject::Chunk* JsonObject::addChunk(size_t capacity) {
+    static_assert(sizeof(Chunk) % alignof(Member) == 0, "membros alinhados logo após o cabeçalho");
+    static_assert(alignof(Member) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__, "operator new alinha os membros");
+
+    void* memory = ::operator new(sizeof(Chunk) + capacity * sizeof(Member));
+    auto* chunk = new (memory) Chunk{nullptr, 0, static_cast<uint32_t>(capacity)};
+    if (last_) {
+        last_->next = chunk;
+    } else {
+        first_ = chunk;
+    }
+    last_ = chunk;
+    return chunk;
+}
+
+// ============================================
+// Construção
+// ============================================
+JsonObject::JsonObject() noexcept = default;
+
+JsonObject::JsonObject(const JsonObject& other) {
+    if (other.empty()) return;
+    Chunk* chunk = addChunk(other.size_);
+    for (const Member& member : other) {
+        new (chunk->members() + chunk->size) Member(member);
+        ++chunk->size;
+        ++size_;
+    }
+    // Os ponteiros do índice do outro não servem aqui
+    if (other.index_) rebuildIndex();
+}
+
+JsonObject::JsonObject(JsonObject&& other) noexcept
+    : first_(other.first_), last_(other.last_), size_(other.size_), index_(std::move(other.index_)) {
+    other.first_ = other.last_ = nullptr;
+    other.size_ = 0;
+}
+
+JsonObject& JsonObject::operator=(const JsonObject& other) {
+    if (this != &other) *this = JsonObject(other);
+    return *this;
+}
+
+JsonObject& JsonObject::operator=(JsonObject&& other) noexcept {
+    if (this != &other) {
+        clear();
+        first_ = other.first_;
+        last_ = other.last_;
+        size_ = other.size_;
+        index_ = std::move(other.index_);
+        other.first_ = other.last_ = nullptr;
+        other.size_ = 0;
+    }
+    return *this;
+}
+
+JsonObject::~JsonObject() {
+    clear();
+}
+
+// Um bloco com o que falta: o parse reserva o total e fica num bloco só
+void JsonObject::reserve(size_t count) {
+    const size_t available = last_ ? last_->capacity - last_->size : 0;
+    if (count > size_ + available) addChunk(count - size_);
+}
+
+void JsonObject::clear() noexcept {
+    for (Chunk* chunk = first_; chunk;) {
+        Chunk* next = chunk->next;
+        Member* members = chunk->members();
+        for (uint32_t i = 0; i < chunk->size; ++i) members[i].~Member();
+        chunk->~Chunk();
+        ::operator delete(chunk);
+        chunk = next;
+    }
+    first_ = last_ = nullptr;
+    size_ = 0;
+    index_.reset();
+}
+
+// ============================================
+// Busca
+// ============================================
+const JsonObject::Member* JsonObject::lookup(std::string_view key, uint64_t hash) const noexcept {
+    if (index_) {
+        const auto& slots = index_->slots;
+        const size_t mask = slots.size() - 1;
+        for (size_t slot = hash & mask; slots[slot]; slot = (slot + 1) & mask) {
+            if (slots[slot]->key_.matches(key, hash)) return slots[slot];
+        }
+        return nullptr;
+    }
+    for (const Member& member : *this) {
+        if (member.key_.matches(key, hash)) return &member;
+    }
+    return nullptr;
+}
+
+// Chave já internada: comparação por ponteiro na busca linear
+const JsonObject::Member* JsonObject::lookup(const detail::KeyHandle& key) const noexcept {
+    if (index_) return lookup(key.view(), key.hash());
+    for (const Member& member : *this) {
+        if (member.key_ == key) return &member;
+    }
+    return nullptr;
+}
+
+const Json* JsonObject::find(std::string_view key) const noexcept {
+    return find(key, detail::objectKeyHash(key));
+}
+
+Json* JsonObject::find(std::string_view key) noexcept {
+    return find(key, detail::objectKeyHash(key));
+}
+
+const Json* JsonObject::findIndexed(std::string_view key, uint64_t hash) const noexcept {
+    const Member* member = lookup(key, hash);
+    return member ? &member->value : nullptr;
+}
+
+// ============================================
+// Modificação
+// ============================================
+// Os membros já inseridos não se movem: bloco cheio abre outro (crescimento geométrico)
+Json& JsonObject::append(Member&& member) {
+    Chunk* chunk = last_;
+    if (!chunk || chunk->size == chunk->capacity) chunk = addChunk(std::max<size_t>(4, size_));
+    Member* added = new (chunk->members() + chunk->size) Member(std::move(member));
+    ++chunk->size;
+    ++size_;
+    if (index_ && size_ * 2 <= index_->slots.size()) {
+        index_->insert(*added);
+    } else if (size_ > IndexThreshold) {
+        rebuildIndex();
+    }
+    return added->value;
+}
+
+Json& JsonObject::operator[](std::string_view key) {
+    const uint64_t hash = detail::objectKeyHash(key);
+    if (const Member* member = lookup(key, hash)) return const_cast<Json&>(member->value);
+    return append(Member(detail::KeyHandle(key, hash), Json()));
+}
+
+Json& JsonObject::insert_or_assign(std::string_view key, Json value) {
+    Json& slot = (*this)[key];
+    slot = std::move(value);
+    return slot;
+}
+
+Json& JsonObject::insert_or_assign(Member member) {
+    if (const Member* existing = lookup(member.key_)) {
+        Json& slot = const_cast<Json&>(existing->value);
+        slot = std::move(member.value);
+        return slot;
+    }
+    return append(std::move(member));
+}
+
+bool JsonObject::erase(std::string_view key) {
+    const Member* member = lookup(key, detail::objectKeyHash(key));
+    if (!member) return false;
+
+    // Os seguintes andam uma posição (atravessando blocos); o último é destruído
+    iterator it = begin();
+    while (&*it != member) ++it;
+    for (iterator next = it; ++next != end(); it = next) {
+        *it = std::move(*next);
+    }
+    // it está no último membro, que fica no último bloco não vazio
+    Chunk* tail = first_;
+    for (Chunk* chunk = first_; chunk; chunk = chunk->next) {
+        if (chunk->size != 0) tail = chunk;
+    }
+    it->~Member();
+    --tail->size;
+    --size_;
+    if (index_) rebuildIndex();
+    return true;
+}
+
+bool JsonObject::operator==(const JsonObject& other) const noexcept {
+    if (size_ != other.size_) return false;
+    for (const Member& member : *this) {
+        const Member* match = other.lookup(member.key_);
+        if (!match || match->value != member.value) return false;
+    }
+    return true;
+}
+
+} // namespace gg
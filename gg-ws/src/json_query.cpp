@@ -0,0 +1,393 @@
+#include "gg_ws/json_query.hpp"
+#include "internal/json_lexer.hpp"
+#include "internal/json_number.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace gg {
+
+namespace lexer = internal::json;
+
+// ============================================
+// Caminhos compilados
+// ============================================
+namespace {
+
+// Segmento de caminho; a raiz é o nó 0
+struct QueryNode {
+    std::string key;                    // Já sem os escapes ~0 / ~1
+    int64_t index = -1;                 // Segmento como índice de array (-1 se não é)
+    std::vector<uint32_t> children;
+    std::vector<uint32_t> fields;       // Caminhos que terminam neste nó
+};
+
+// "0", "12" (sem zero à esquerda) é índice de array
+int64_t arrayIndex(std::string_view segment) noexcept {
+    if (segment.empty() || segment.size() > 9) return -1;
+    if (segment.size() > 1 && segment[0] == '0') return -1;
+    int64_t value = 0;
+    for (char c : segment) {
+        if (!lexer::isDigit(c)) return -1;
+        value = value * 10 + (c - '0');
+    }
+    return value;
+}
+
+} // anonymous namespace
+
+struct JsonQuery::Impl {
+    std::vector<QueryNode> nodes{1};
+    std::vector<uint32_t> validPaths;   // Índices dos caminhos válidos, em ordem
+    size_t paths = 0;
+
+    bool add(std::string_view path) {
+        const auto field = static_cast<uint32_t>(paths++);
+        if (!path.empty() && path[0] != '/') return false;
+
+        // Segmentos decodificados antes de tocar na árvore (caminho inválido não entra)
+        std::vector<std::string> segments;
+        for (size_t pos = 0; pos < path.size();) {
+            const size_t next = std::min(path.find('/', pos + 1), path.size());
+            std::string segment;
+            for (size_t i = pos + 1; i < next; ++i) {
+                if (path[i] != '~') {
+                    segment += path[i];
+                } else if (i + 1 < next && (path[i + 1] == '0' || path[i + 1] == '1')) {
+                    segment += path[++i] == '0' ? '~' : '/';
+                } else {
+                    return false;
+                }
+            }
+            segments.push_back(std::move(segment));
+            pos = next;
+        }
+
+        uint32_t node = 0;
+        for (auto& segment : segments) {
+            uint32_t child = 0;
+            for (uint32_t candidate : nodes[node].children) {
+                if (nodes[candidate].key == segment) child = candidate;
+            }
+            if (child == 0) {
+                child = static_cast<uint32_t>(nodes.size());
+                QueryNode created;
+                created.index = arrayIndex(segment);
+                created.key = std::move(segment);
+                nodes.push_back(std::move(created));
+                nodes[node].children.push_back(child);
+            }
+            node = child;
+        }
+        nodes[node].fields.push_back(field);
+        validPaths.push_back(field);
+        return true;
+    }
+};
+
+// ============================================
+// Busca
+// ============================================
+namespace {
+
+bool isDelimiter(char c) noexcept {
+    return c == ',' || c == '}' || c == ']' || lexer::isSpace(c);
+}
+
+} // anonymous namespace
+
+/**
+ * Uma passada pela entrada: desce pelos nós da árvore de caminhos e pula
+ * o resto contando só colchetes e aspas. Para quando não falta campo.
+ */
+class JsonQuery::Scanner {
+public:
+    Scanner(const std::vector<QueryNode>& nodes, std::string_view input,
+            JsonField* out, size_t count, size_t remaining) noexcept
+        : nodes_(nodes), p_(input.data()), end_(input.data() + input.size()),
+          out_(out), count_(count), remaining_(remaining) {}
+
+    size_t run() noexcept {
+        if (remaining_ > 0) value(&nodes_[0]);
+        return found_;
+    }
+
+private:
+    const std::vector<QueryNode>& nodes_;
+    const char* p_;
+    const char* end_;
+    JsonField* out_;
+    size_t count_;
+    size_t remaining_;
+    size_t found_ = 0;
+    bool done_ = false;
+
+    bool literal(const char* word, size_t len) noexcept {
+        if (static_cast<size_t>(end_ - p_) < len || std::memcmp(p_, word, len) != 0) return false;
+        p_ += len;
+        return true;
+    }
+
+    // node nulo: valor fora dos caminhos, só pulado
+    bool value(const QueryNode* node) noexcept {
+        p_ = lexer::skipSpace(p_, end_);
+        if (p_ >= end_) return false;
+        const char* begin = p_;
+        const bool walk = node && !node->children.empty();
+        bool escaped = false;
+        Json::Type type;
+        switch (*p_) {
+            case '{':
+                type = Json::Type::Object;
+                if (!(walk ? object(*node) : skipContainer())) return false;
+                break;
+            case '[':
+                type = Json::Type::Array;
+                if (!(walk ? array(*node) : skipContainer())) return false;
+                break;
+            case '"': {
+                type = Json::Type::String;
+                const char* close = lexer::scanString(p_ + 1, end_, escaped);
+                if (!close) return false;
+                p_ = close + 1;
+                break;
+            }
+            case 't':
+                type = Json::Type::Bool;
+                if (!literal("true", 4)) return false;
+                break;
+            case 'f':
+                type = Json::Type::Bool;
+                if (!literal("false", 5)) return false;
+                break;
+            case 'n':
+                type = Json::Type::Null;
+                if (!literal("null", 4)) return false;
+                break;
+            default:
+                type = Json::Type::Number;
+                if (node && !node->fields.empty()) {
+                    lexer::Number number;
+                    const char* end = lexer::parseNumber(p_, end_, number);
+                    if (!end) return false;
+                    p_ = end;
+                } else {
+                    while (p_ < end_ && !isDelimiter(*p_)) ++p_;
+                    if (p_ == begin) return false;
+                }
+                break;
+        }
+        if (node) record(*node, type, begin, escaped);
+        return !done_;
+    }
+
+    void record(const QueryNode& node, Json::Type type, const char* begin, bool escaped) noexcept {
+        for (uint32_t field : node.fields) {
+            if (field >= count_ || out_[field].found_) continue;
+            JsonField& out = out_[field];
+            out.raw_ = std::string_view(begin, static_cast<size_t>(p_ - begin));
+            out.type_ = type;
+            out.escaped_ = escaped;
+            out.found_ = true;
+            ++found_;
+            if (--remaining_ == 0) done_ = true;
+        }
+    }
+
+    const QueryNode* child(const QueryNode& node, std::string_view key) const noexcept {
+        for (uint32_t index : node.children) {
+            const std::string& candidate = nodes_[index].key;
+            // Tamanho e primeiro byte antes do memcmp (chaves de feed são curtas)
+            if (candidate.size() == key.size() && (key.empty() || candidate[0] == key[0]) &&
+                std::memcmp(candidate.data(), key.data(), key.size()) == 0) {
+                return &nodes_[index];
+            }
+        }
+        return nullptr;
+    }
+
+    const QueryNode* child(const QueryNode& node, int64_t index) const noexcept {
+        for (uint32_t i : node.children) {
+            if (nodes_[i].index == index) return &nodes_[i];
+        }
+        return nullptr;
+    }
+
+    // Chave com escape: decodifica antes de comparar (raro em feeds)
+    const QueryNode* escapedChild(const QueryNode& node, const char* begin, const char* close) const noexcept {
+        char local[128];
+        std::string heap;
+        char* buffer = local;
+        const auto raw = static_cast<size_t>(close - begin);
+        if (raw > sizeof(local)) {
+            try {
+                heap.resize(raw);
+            } catch (...) {
+                return nullptr;
+            }
+            buffer = heap.data();
+        }
+        const std::ptrdiff_t n = lexer::unescape(begin, close, buffer);
+        return n < 0 ? nullptr : child(node, std::string_view(buffer, static_cast<size_t>(n)));
+    }
+
+    bool object(const QueryNode& node) noexcept {
+        ++p_;
+        p_ = lexer::skipSpace(p_, end_);
+        if (p_ < end_ && *p_ == '}') {
+            ++p_;
+            return true;
+        }
+        for (;;) {
+            p_ = lexer::skipSpace(p_, end_);
+            if (p_ >= end_ || *p_ != '"') return false;
+            bool escaped;
+            const char* begin = p_ + 1;
+            const char* close = lexer::scanString(begin, end_, escaped);
+            if (!close) return false;
+            p_ = close + 1;
+            const QueryNode* next = escaped
+                ? escapedChild(node, begin, close)
+                : child(node, std::string_view(begin, static_cast<size_t>(close - begin)));
+
+            p_ = lexer::skipSpace(p_, end_);
+            if (p_ >= end_ || *p_ != ':') return false;
+            ++p_;
+            if (!value(next)) return false;
+
+            p_ = lexer::skipSpace(p_, end_);
+            if (p_ >= end_) return false;
+            const char c = *p_++;
+            if (c == '}') return true;
+            if (c != ',') return false;
+        }
+    }
+
+    bool array(const QueryNode& node) noexcept {
+        ++p_;
+        p_ = lexer::skipSpace(p_, end_);
+        if (p_ < end_ && *p_ == ']') {
+            ++p_;
+            return true;
+        }
+        for (int64_t index = 0;; ++index) {
+            if (!value(child(node, index))) return false;
+
+            p_ = lexer::skipSpace(p_, end_);
+            if (p_ >= end_) return false;
+            const char c = *p_++;
+            if (c == ']') return true;
+            if (c != ',') return false;
+        }
+    }
+
+    // Subárvore fora dos caminhos: só acha o fechamento (strings puladas inteiras)
+    bool skipContainer() noexcept {
+        int depth = 0;
+        while (p_ < end_) {
+            const char c = *p_++;
+            if (c == '"') {
+                bool escaped;
+                const char* close = lexer::scanString(p_, end_, escaped);
+                if (!close) return false;
+                p_ = close + 1;
+            } else if (c == '{' || c == '[') {
+                ++depth;
+            } else if (c == '}' || c == ']') {
+                if (--depth == 0) return true;
+            }
+        }
+        return false;
+    }
+};
+
+namespace {
+
+// Número do campo como Json, para reaproveitar as conversões (sem alocação)
+Json numberValue(std::string_view raw) noexcept {
+    lexer::Number number;
+    if (!lexer::parseNumber(raw.data(), raw.data() + raw.size(), number)) return Json();
+    switch (number.kind) {
+        case lexer::Number::Kind::Int:     return Json(number.i);
+        case lexer::Number::Kind::UInt:    return Json(number.u);
+        case lexer::Number::Kind::Decimal: return Json(Decimal(number.i, number.scale));
+        default:                           return Json(number.d);
+    }
+}
+
+} // anonymous namespace
+
+// ============================================
+// JsonQuery
+// ============================================
+JsonQuery::JsonQuery(std::initializer_list<std::string_view> paths) : impl_(std::make_unique<Impl>()) {
+    for (std::string_view path : paths) impl_->add(path);
+}
+
+JsonQuery::JsonQuery(const std::vector<std::string>& paths) : impl_(std::make_unique<Impl>()) {
+    for (const auto& path : paths) impl_->add(path);
+}
+
+JsonQuery::~JsonQuery() = default;
+JsonQuery::JsonQuery(JsonQuery&&) noexcept = default;
+JsonQuery& JsonQuery::operator=(JsonQuery&&) noexcept = default;
+
+bool JsonQuery::valid() const noexcept {
+    return impl_ && impl_->validPaths.size() == impl_->paths;
+}
+
+size_t JsonQuery::size() const noexcept {
+    return impl_ ? impl_->paths : 0;
+}
+
+size_t JsonQuery::extract(std::string_view input, JsonField* out, size_t count) const noexcept {
+    if (!impl_) return 0;
+    for (size_t i = 0; i < count; ++i) out[i] = JsonField();
+    const auto& paths = impl_->validPaths;
+    const auto wanted = static_cast<size_t>(
+        std::lower_bound(paths.begin(), paths.end(), count) - paths.begin());
+    return Scanner(impl_->nodes, input, out, count, wanted).run();
+}
+
+// ============================================
+// JsonField
+// ============================================
+bool JsonField::getBool(bool defaultValue) const noexcept {
+    return type_ == Json::Type::Bool ? raw_[0] == 't' : defaultValue;
+}
+
+double JsonField::getNumber(double defaultValue) const noexcept {
+    return isNumber() ? numberValue(raw_).getNumber(defaultValue) : defaultValue;
+}
+
+int64_t JsonField::getInt(int64_t defaultValue) const noexcept {
+    return isNumber() ? numberValue(raw_).getInt(defaultValue) : defaultValue;
+}
+
+uint64_t JsonField::getUInt(uint64_t defaultValue) const noexcept {
+    return isNumber() ? numberValue(raw_).getUInt(defaultValue) : defaultValue;
+}
+
+Decimal JsonField::getDecimal(Decimal defaultValue) const noexcept {
+    if (isNumber()) return numberValue(raw_).getDecimal(defaultValue);
+    if (isString() && !escaped_) return Decimal::parse(getString()).value_or(defaultValue);
+    return defaultValue;
+}
+
+std::string_view JsonField::getString(std::string_view defaultValue) const noexcept {
+    if (!isString() || escaped_) return defaultValue;
+    return raw_.substr(1, raw_.size() - 2);
+}
+
+std::string JsonField::getStringCopy(const std::string& defaultValue) const {
+    if (!isString()) return defaultValue;
+    const std::string_view content = raw_.substr(1, raw_.size() - 2);
+    if (!escaped_) return std::string(content);
+    std::string out(content.size(), '\0');
+    const std::ptrdiff_t n = lexer::unescape(content.data(), content.data() + content.size(), out.data());
+    if (n < 0) return defaultValue;
+    out.resize(static_cast<size_t>(n));
+    return out;
+}
+
+} // namespace gg
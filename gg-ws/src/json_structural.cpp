@@ -0,0 +1,319 @@
+#include "internal/json_structural.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define GG_WS_JSON_X86 1
+#include <immintrin.h>
+#endif
+
+namespace gg::internal::json {
+
+namespace {
+
+// ============================================
+// Classificação de blocos de 64 bytes
+// ============================================
+// Bit i de cada máscara corresponde ao byte i do bloco.
+struct BlockMasks {
+    uint64_t quote;
+    uint64_t backslash;
+    uint64_t op;            // { } [ ] : ,
+    uint64_t space;         // ' ' \t \n \r
+    uint64_t control;       // < 0x20 (inclui \t \n \r: proibidos em strings)
+};
+
+constexpr size_t BlockSize = 64;
+
+// Blocos classificados por chamada do kernel (amortiza a chamada indireta)
+constexpr size_t BatchBlocks = 16;
+
+using ClassifyFn = void (*)(const char* data, size_t blocks, BlockMasks* out) noexcept;
+
+void classifyScalar(const char* data, size_t blocks, BlockMasks* out) noexcept {
+    for (size_t b = 0; b < blocks; ++b, data += BlockSize) {
+        BlockMasks m{};
+        for (size_t i = 0; i < BlockSize; ++i) {
+            const auto c = static_cast<unsigned char>(data[i]);
+            const uint64_t bit = uint64_t{1} << i;
+            switch (c) {
+                case '"':  m.quote |= bit; break;
+                case '\\': m.backslash |= bit; break;
+                case '{': case '}': case '[': case ']': case ':': case ',':
+                    m.op |= bit;
+                    break;
+                case ' ':
+                    m.space |= bit;
+                    break;
+                case '\t': case '\n': case '\r':
+                    m.space |= bit;
+                    m.control |= bit;
+                    break;
+                default:
+                    if (c < 0x20) m.control |= bit;
+                    break;
+            }
+        }
+        out[b] = m;
+    }
+}
+
+#ifdef GG_WS_JSON_X86
+
+__attribute__((target("sse2")))
+void classifySse2(const char* data, size_t blocks, BlockMasks* out) noexcept {
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const __m128i lower = _mm_set1_epi8(0x20);
+    const __m128i openBrace = _mm_set1_epi8('{');     // '[' | 0x20 == '{'
+    const __m128i closeBrace = _mm_set1_epi8('}');    // ']' | 0x20 == '}'
+    const __m128i colon = _mm_set1_epi8(':');
+    const __m128i comma = _mm_set1_epi8(',');
+    const __m128i blank = _mm_set1_epi8(' ');
+    const __m128i tab = _mm_set1_epi8('\t');
+    const __m128i newline = _mm_set1_epi8('\n');
+    const __m128i carriage = _mm_set1_epi8('\r');
+    const __m128i controlMax = _mm_set1_epi8(0x1F);
+
+    for (size_t b = 0; b < blocks; ++b, data += BlockSize) {
+        BlockMasks m{};
+        for (int k = 0; k < 4; ++k) {
+            const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + k * 16));
+            const __m128i folded = _mm_or_si128(v, lower);
+            const __m128i op = _mm_or_si128(
+                _mm_or_si128(_mm_cmpeq_epi8(folded, openBrace), _mm_cmpeq_epi8(folded, closeBrace)),
+                _mm_or_si128(_mm_cmpeq_epi8(v, colon), _mm_cmpeq_epi8(v, comma)));
+            const __m128i space = _mm_or_si128(
+                _mm_or_si128(_mm_cmpeq_epi8(v, blank), _mm_cmpeq_epi8(v, tab)),
+                _mm_or_si128(_mm_cmpeq_epi8(v, newline), _mm_cmpeq_epi8(v, carriage)));
+            const __m128i control = _mm_cmpeq_epi8(_mm_max_epu8(v, controlMax), controlMax);
+
+            const int shift = k * 16;
+            auto bits = [shift](__m128i mask) __attribute__((target("sse2"))) {
+                return static_cast<uint64_t>(static_cast<uint16_t>(_mm_movemask_epi8(mask))) << shift;
+            };
+            m.quote |= bits(_mm_cmpeq_epi8(v, quote));
+            m.backslash |= bits(_mm_cmpeq_epi8(v, backslash));
+            m.op |= bits(op);
+            m.space |= bits(space);
+            m.control |= bits(control);
+        }
+        out[b] = m;
+    }
+}
+
+__attribute__((target("avx2")))
+void classifyAvx2(const char* data, size_t blocks, BlockMasks* out) noexcept {
+    const __m256i quote = _mm256_set1_epi8('"');
+    const __m256i backslash = _mm256_set1_epi8('\\');
+    const __m256i lower = _mm256_set1_epi8(0x20);
+    const __m256i openBrace = _mm256_set1_epi8('{');
+    const __m256i closeBrace = _mm256_set1_epi8('}');
+    const __m256i colon = _mm256_set1_epi8(':');
+    const __m256i comma = _mm256_set1_epi8(',');
+    const __m256i blank = _mm256_set1_epi8(' ');
+    const __m256i tab = _mm256_set1_epi8('\t');
+    const __m256i newline = _mm256_set1_epi8('\n');
+    const __m256i carriage = _mm256_set1_epi8('\r');
+    const __m256i controlMax = _mm256_set1_epi8(0x1F);
+
+    for (size_t b = 0; b < blocks; ++b, data += BlockSize) {
+        BlockMasks m{};
+        for (int k = 0; k < 2; ++k) {
+            const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + k * 32));
+            const __m256i folded = _mm256_or_si256(v, lower);
+            const __m256i op = _mm256_or_si256(
+                _mm256_or_si256(_mm256_cmpeq_epi8(folded, openBrace), _mm256_cmpeq_epi8(folded, closeBrace)),
+                _mm256_or_si256(_mm256_cmpeq_epi8(v, colon), _mm256_cmpeq_epi8(v, comma)));
+            const __m256i space = _mm256_or_si256(
+                _mm256_or_si256(_mm256_cmpeq_epi8(v, blank), _mm256_cmpeq_epi8(v, tab)),
+                _mm256_or_si256(_mm256_cmpeq_epi8(v, newline), _mm256_cmpeq_epi8(v, carriage)));
+            const __m256i control = _mm256_cmpeq_epi8(_mm256_max_epu8(v, controlMax), controlMax);
+
+            const int shift = k * 32;
+            auto bits = [shift](__m256i mask) __attribute__((target("avx2"))) {
+                return static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(mask))) << shift;
+            };
+            m.quote |= bits(_mm256_cmpeq_epi8(v, quote));
+            m.backslash |= bits(_mm256_cmpeq_epi8(v, backslash));
+            m.op |= bits(op);
+            m.space |= bits(space);
+            m.control |= bits(control);
+        }
+        out[b] = m;
+    }
+}
+
+#endif // GG_WS_JSON_X86
+
+ClassifyFn classifier(StructuralIndex::Kernel kernel) noexcept {
+    switch (kernel) {
+#ifdef GG_WS_JSON_X86
+        case StructuralIndex::Kernel::Avx2: return &classifyAvx2;
+        case StructuralIndex::Kernel::Sse2: return &classifySse2;
+#endif
+        default: return &classifyScalar;
+    }
+}
+
+// ============================================
+// Aritmética de bits (independente do kernel)
+// ============================================
+// Estado que atravessa a fronteira entre blocos
+struct Carry {
+    uint64_t oddBackslash = 0;  // Bloco anterior terminou com sequência ímpar de '\'
+    uint64_t inString = 0;      // Todos 1 se o bloco anterior terminou dentro de string
+    uint64_t boundary = 1;      // Último byte do bloco anterior separa tokens (início conta)
+};
+
+// Bytes precedidos por uma sequência ímpar de barras invertidas (escapados)
+inline uint64_t escapedBytes(uint64_t backslash, Carry& carry) noexcept {
+    constexpr uint64_t EvenBits = 0x5555555555555555ULL;
+    constexpr uint64_t OddBits = ~EvenBits;
+
+    const uint64_t starts = backslash & ~(backslash << 1);
+    const uint64_t evenStartMask = EvenBits ^ carry.oddBackslash;
+    const uint64_t evenStarts = starts & evenStartMask;
+    const uint64_t oddStarts = starts & ~evenStartMask;
+    const uint64_t evenCarries = backslash + evenStarts;
+
+    uint64_t oddCarries = backslash + oddStarts;
+    const bool endsOdd = oddCarries < backslash;        // Overflow: sequência chega ao fim do bloco
+    oddCarries |= carry.oddBackslash;
+    carry.oddBackslash = endsOdd ? 1 : 0;
+
+    const uint64_t evenCarryEnds = evenCarries & ~backslash;
+    const uint64_t oddCarryEnds = oddCarries & ~backslash;
+    return (evenCarryEnds & OddBits) | (oddCarryEnds & EvenBits);
+}
+
+// Bit i = XOR dos bits 0..i (1 entre aspa de abertura, inclusive, e a de fechamento, exclusive)
+inline uint64_t prefixXor(uint64_t x) noexcept {
+    x ^= x << 1;
+    x ^= x << 2;
+    x ^= x << 4;
+    x ^= x << 8;
+    x ^= x << 16;
+    x ^= x << 32;
+    return x;
+}
+
+inline int lowestBit(uint64_t x) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(x);
+#else
+    int n = 0;
+    while (!(x & 1)) { x >>= 1; ++n; }
+    return n;
+#endif
+}
+
+/**
+ * @brief Tokens de um bloco classificado.
+ * @return Ponteiro após a última posição gravada; nullptr se há controle numa string
+ */
+inline uint32_t* indexBlock(const BlockMasks& m, uint32_t base, Carry& carry, uint32_t* out) noexcept {
+    const uint64_t quotes = m.quote & ~escapedBytes(m.backslash, carry);
+    const uint64_t inString = prefixXor(quotes) ^ carry.inString;
+    carry.inString = static_cast<uint64_t>(static_cast<int64_t>(inString) >> 63);
+
+    if (m.control & inString) return nullptr;
+
+    const uint64_t outside = ~inString;
+    const uint64_t boundary = ((m.op | m.space) & outside) | quotes;
+    const uint64_t follows = (boundary << 1) | carry.boundary;
+    carry.boundary = boundary >> 63;
+
+    const uint64_t scalarStarts = ~(m.op | m.space | m.quote) & outside & follows;
+    uint64_t tokens = (m.op & outside) | quotes | scalarStarts;
+
+    while (tokens) {
+        *out++ = base + static_cast<uint32_t>(lowestBit(tokens));
+        tokens &= tokens - 1;
+    }
+    return out;
+}
+
+} // anonymous namespace
+
+// ============================================
+// StructuralIndex
+// ============================================
+StructuralIndex::Kernel StructuralIndex::bestKernel() noexcept {
+    static const Kernel best = [] {
+#ifdef GG_WS_JSON_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) return Kernel::Avx2;
+        if (__builtin_cpu_supports("sse2")) return Kernel::Sse2;
+#endif
+        return Kernel::Scalar;
+    }();
+    return best;
+}
+
+const char* StructuralIndex::kernelName(Kernel kernel) noexcept {
+    switch (kernel) {
+        case Kernel::Auto: return kernelName(bestKernel());
+        case Kernel::Scalar: return "scalar";
+        case Kernel::Sse2: return "SSE2";
+        case Kernel::Avx2: return "AVX2";
+    }
+    return "?";
+}
+
+bool StructuralIndex::build(std::string_view input, Kernel kernel) {
+    count_ = 0;
+    const size_t len = input.size();
+    if (len > std::numeric_limits<uint32_t>::max()) return false;
+
+    // Kernel pedido que a CPU não tem cai para o melhor disponível
+    const Kernel best = bestKernel();
+    if (kernel == Kernel::Auto || static_cast<uint8_t>(kernel) > static_cast<uint8_t>(best)) {
+        kernel = best;
+    }
+    const ClassifyFn classify = classifier(kernel);
+
+    // Cada token ocupa um byte distinto: len posições bastam
+    if (capacity_ < len) {
+        capacity_ = std::max(len, capacity_ * 2);
+        positions_.reset(new uint32_t[capacity_]);
+    }
+
+    const char* data = input.data();
+    uint32_t* out = positions_.get();
+    Carry carry;
+    BlockMasks masks[BatchBlocks];
+
+    const size_t fullBlocks = len / BlockSize;
+    size_t block = 0;
+    while (block < fullBlocks) {
+        const size_t n = std::min(BatchBlocks, fullBlocks - block);
+        classify(data + block * BlockSize, n, masks);
+        for (size_t i = 0; i < n; ++i) {
+            out = indexBlock(masks[i], static_cast<uint32_t>((block + i) * BlockSize), carry, out);
+            if (!out) return false;
+        }
+        block += n;
+    }
+
+    // Último bloco parcial: completado com espaços (não geram tokens)
+    const size_t rest = len - fullBlocks * BlockSize;
+    if (rest > 0) {
+        char tail[BlockSize];
+        std::memset(tail, ' ', sizeof(tail));
+        std::memcpy(tail, data + fullBlocks * BlockSize, rest);
+        classify(tail, 1, masks);
+        out = indexBlock(masks[0], static_cast<uint32_t>(fullBlocks * BlockSize), carry, out);
+        if (!out) return false;
+    }
+
+    // Terminou dentro de uma string
+    if (carry.inString) return false;
+
+    count_ = static_cast<size_t>(out - positions_.get());
+    return true;
+}
+
+} // namespace gg::internal::json
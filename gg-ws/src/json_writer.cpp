@@ -0,0 +1,279 @@
+#include "gg_ws/json_writer.hpp"
+#include "gg_ws/json.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE2__) && (defined(__GNUC__) || defined(__clang__))
+#define GG_WS_JSON_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace gg {
+
+namespace {
+
+// Primeiro byte que precisa de escape ('"', '\\' ou < 0x20), ou end
+const char* findEscape(const char* p, const char* end) noexcept {
+#ifdef GG_WS_JSON_SSE2
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const __m128i controlMax = _mm_set1_epi8(0x1F);
+    for (; end - p >= 16; p += 16) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        const __m128i escape = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(v, quote), _mm_cmpeq_epi8(v, backslash)),
+            _mm_cmpeq_epi8(_mm_max_epu8(v, controlMax), controlMax));
+        if (const int bits = _mm_movemask_epi8(escape)) return p + __builtin_ctz(static_cast<unsigned>(bits));
+    }
+#endif
+    for (; p < end; ++p) {
+        const auto c = static_cast<unsigned char>(*p);
+        if (c < 0x20 || c == '"' || c == '\\') return p;
+    }
+    return end;
+}
+
+constexpr double PowersOfTen[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8};
+
+// Somar e subtrair 1.5 * 2^52 arredonda para o inteiro mais próximo (|x| < 2^51)
+constexpr double RoundingBias = 6755399441055744.0;
+
+constexpr size_t MaxDoubleChars = 32;
+
+/**
+ * Menor texto que volta a value. Preços e quantidades costumam ter poucas
+ * casas: se m / 10^k (m inteiro exato, k <= 8) é value, "m com k casas"
+ * volta ao mesmo double (a divisão e o parse arredondam o mesmo quociente
+ * exato) e o menor k é o mais curto. O resto vai para std::to_chars
+ * (Ryu na libstdc++).
+ */
+char* formatDouble(double value, char* out) noexcept {
+    if (std::abs(value) < 1e7) {
+        for (int k = 1; k <= 8; ++k) {
+            const double mantissa = (value * PowersOfTen[k] + RoundingBias) - RoundingBias;
+            if (mantissa / PowersOfTen[k] == value) {
+                return Decimal(static_cast<int64_t>(mantissa), static_cast<uint8_t>(k)).toChars(out);
+            }
+        }
+    }
+    return std::to_chars(out, out + MaxDoubleChars, value).ptr;
+}
+
+} // anonymous namespace
+
+// ============================================
+// Construção
+// ============================================
+JsonWriter::JsonWriter(std::string& out, bool pretty) noexcept
+    : string_(&out), start_(out.size()), pretty_(pretty) {
+    begin_ = pos_ = end_ = out.data() + start_;
+}
+
+JsonWriter::JsonWriter(char* buffer, size_t capacity, bool pretty) noexcept
+    : begin_(buffer), pos_(buffer), end_(buffer + capacity), pretty_(pretty) {}
+
+void JsonWriter::flush() noexcept {
+    if (!string_) return;
+    const size_t used = static_cast<size_t>(pos_ - string_->data());
+    string_->resize(used);      // Só diminui: não aloca
+    begin_ = string_->data() + start_;
+    pos_ = end_ = string_->data() + used;
+}
+
+// ============================================
+// Saída
+// ============================================
+
+/**
+ * Modo string: a string cresce (dobrando) e o writer escreve direto nela;
+ * o tamanho certo é posto em flush(). Modo buffer: marca overflow e fecha
+ * o espaço, para nada mais ser escrito depois do trecho que não coube.
+ */
+bool JsonWriter::grow(size_t n) {
+    if (!string_) {
+        overflow_ = true;
+        end_ = pos_;
+        return false;
+    }
+    const size_t used = static_cast<size_t>(pos_ - string_->data());
+    string_->resize(std::max({used + n, string_->size() * 2, used + 256}));
+    begin_ = string_->data() + start_;
+    pos_ = string_->data() + used;
+    end_ = string_->data() + string_->size();
+    return true;
+}
+
+void JsonWriter::indent() {
+    const size_t spaces = static_cast<size_t>(depth_) * 2;
+    *pos_++ = '\n';
+    std::memset(pos_, ' ', spaces);
+    pos_ += spaces;
+}
+
+// Vírgula (e nova linha + indentação no modo pretty) antes de um item
+bool JsonWriter::separator(size_t n) {
+    if (afterKey_) {
+        afterKey_ = false;
+        return reserve(n);
+    }
+    const bool newline = pretty_ && depth_ > 0;
+    if (!reserve(n + 1 + (newline ? 1 + static_cast<size_t>(depth_) * 2 : 0))) return false;
+    if (needComma_) *pos_++ = ',';
+    if (newline) indent();
+    return true;
+}
+
+// Aspas, trecho sem escape de uma vez e escapes; deixa 6 bytes reservados
+bool JsonWriter::string(std::string_view value) {
+    static constexpr char Hex[] = "0123456789abcdef";
+    *pos_++ = '"';
+    const char* run = value.data();
+    const char* end = run + value.size();
+    for (;;) {
+        const char* p = findEscape(run, end);
+        const size_t n = static_cast<size_t>(p - run);
+        if (!reserve(n + 7)) return false;      // Trecho + escape (até 6) ou a aspa final
+        std::memcpy(pos_, run, n);
+        pos_ += n;
+        if (p == end) break;
+        const auto c = static_cast<unsigned char>(*p);
+        char escaped = 0;
+        switch (c) {
+            case '"':  escaped = '"'; break;
+            case '\\': escaped = '\\'; break;
+            case '\b': escaped = 'b'; break;
+            case '\f': escaped = 'f'; break;
+            case '\n': escaped = 'n'; break;
+            case '\r': escaped = 'r'; break;
+            case '\t': escaped = 't'; break;
+        }
+        *pos_++ = '\\';
+        if (escaped) {
+            *pos_++ = escaped;
+        } else {
+            pos_[0] = 'u';
+            pos_[1] = '0';
+            pos_[2] = '0';
+            pos_[3] = Hex[c >> 4];
+            pos_[4] = Hex[c & 0xF];
+            pos_ += 5;
+        }
+        run = p + 1;
+    }
+    *pos_++ = '"';
+    return true;
+}
+
+// ============================================
+// Containers e chaves
+// ============================================
+JsonWriter& JsonWriter::open(char bracket) {
+    if (separator(1)) *pos_++ = bracket;
+    ++depth_;
+    needComma_ = false;
+    return *this;
+}
+
+JsonWriter& JsonWriter::close(char bracket) {
+    --depth_;
+    // Container vazio fica "{}" / "[]" também no modo pretty
+    const bool newline = pretty_ && needComma_;
+    if (reserve(1 + (newline ? 1 + static_cast<size_t>(depth_) * 2 : 0))) {
+        if (newline) indent();
+        *pos_++ = bracket;
+    }
+    needComma_ = true;
+    return *this;
+}
+
+JsonWriter& JsonWriter::key(std::string_view name) {
+    if (separator(name.size() + 8) && string(name)) {
+        *pos_++ = ':';
+        if (pretty_) *pos_++ = ' ';
+    }
+    afterKey_ = true;
+    return *this;
+}
+
+// ============================================
+// Valores
+// ============================================
+JsonWriter& JsonWriter::scalar(const char* text, size_t size) {
+    if (separator(size)) {
+        std::memcpy(pos_, text, size);
+        pos_ += size;
+    }
+    needComma_ = true;
+    return *this;
+}
+
+// Números formatados direto na saída
+JsonWriter& JsonWriter::integer(int64_t value) {
+    if (separator(20)) pos_ = std::to_chars(pos_, pos_ + 20, value).ptr;
+    needComma_ = true;
+    return *this;
+}
+
+JsonWriter& JsonWriter::unsignedInteger(uint64_t value) {
+    if (separator(20)) pos_ = std::to_chars(pos_, pos_ + 20, value).ptr;
+    needComma_ = true;
+    return *this;
+}
+
+JsonWriter& JsonWriter::value(double value) {
+    if (std::isnan(value) || std::isinf(value)) return null();
+    // Inteiros exatos sem ponto
+    if (value == std::floor(value) && std::abs(value) < 1e15) return integer(static_cast<int64_t>(value));
+    if (separator(MaxDoubleChars)) pos_ = formatDouble(value, pos_);
+    needComma_ = true;
+    return *this;
+}
+
+JsonWriter& JsonWriter::value(Decimal value) {
+    if (separator(Decimal::MaxChars)) pos_ = value.toChars(pos_);
+    needComma_ = true;
+    return *this;
+}
+
+JsonWriter& JsonWriter::value(std::string_view value) {
+    if (separator(value.size() + 8)) string(value);
+    needComma_ = true;
+    return *this;
+}
+
+JsonWriter& JsonWriter::value(const Json& json) {
+    switch (json.type()) {
+        case Json::Type::Null:
+            return null();
+        case Json::Type::Bool:
+            return value(json.getBool());
+        case Json::Type::Number: {
+            if (json.isDecimal()) return value(json.getDecimal());
+            if (json.isInteger()) {
+                // Inteiros exatos: todos os dígitos, inclusive acima de 2^53
+                const uint64_t u = json.getUInt();
+                return u > static_cast<uint64_t>(INT64_MAX) ? unsignedInteger(u) : integer(json.getInt());
+            }
+            return value(json.getNumber());
+        }
+        case Json::Type::String:
+            return value(json.getString());
+        case Json::Type::Array:
+            beginArray();
+            json.forEach([this](const Json& item) { value(item); });
+            return endArray();
+        case Json::Type::Object:
+            beginObject();
+            json.forEachPair([this](std::string_view name, const Json& item) {
+                key(name);
+                value(item);
+            });
+            return endObject();
+    }
+    return *this;
+}
+
+} // namespace gg
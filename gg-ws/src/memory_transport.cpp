@@ -0,0 +1,193 @@
+#include "gg_ws/memory_transport.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <unordered_map>
+
+namespace gg {
+
+namespace {
+
+// Pipes por nome (memory://name); referências fracas
+struct Registry {
+    std::mutex mutex;
+    std::unordered_map<std::string, std::weak_ptr<MemoryPipe>> pipes;
+};
+
+Registry& registry() {
+    static Registry instance;
+    return instance;
+}
+
+} // anonymous namespace
+
+// ============================================
+// Registro
+// ============================================
+std::shared_ptr<MemoryPipe> MemoryPipe::create(std::string name) {
+    std::shared_ptr<MemoryPipe> pipe(new MemoryPipe(name));
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+
+    // Aproveita para varrer pipes que já morreram
+    for (auto it = reg.pipes.begin(); it != reg.pipes.end();) {
+        it = it->second.expired() ? reg.pipes.erase(it) : std::next(it);
+    }
+    reg.pipes[std::move(name)] = pipe;
+    return pipe;
+}
+
+std::shared_ptr<MemoryPipe> MemoryPipe::find(std::string_view name) {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    auto it = reg.pipes.find(std::string(name));
+    return it == reg.pipes.end() ? nullptr : it->second.lock();
+}
+
+// ============================================
+// Lado servidor
+// ============================================
+void MemoryPipe::write(std::string_view bytes) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        inbound_.append(bytes.data(), bytes.size());
+    }
+    readable_.notify_all();
+}
+
+void MemoryPipe::writeFrame(uint8_t opcode, std::string_view payload) {
+    // Header de servidor: FIN + opcode, sem máscara (RFC 6455 §5.2)
+    char header[10];
+    size_t headerLen = 2;
+    header[0] = static_cast<char>(0x80 | (opcode & 0x0F));
+    if (payload.size() < 126) {
+        header[1] = static_cast<char>(payload.size());
+    } else if (payload.size() <= 0xFFFF) {
+        header[1] = 126;
+        header[2] = static_cast<char>((payload.size() >> 8) & 0xFF);
+        header[3] = static_cast<char>(payload.size() & 0xFF);
+        headerLen = 4;
+    } else {
+        header[1] = 127;
+        for (int i = 0; i < 8; ++i) {
+            header[2 + i] = static_cast<char>((static_cast<uint64_t>(payload.size()) >> (56 - 8 * i)) & 0xFF);
+        }
+        headerLen = 10;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        inbound_.append(header, headerLen);
+        inbound_.append(payload.data(), payload.size());
+    }
+    readable_.notify_all();
+}
+
+void MemoryPipe::setSource(Source source) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        source_ = std::move(source);
+    }
+    readable_.notify_all();
+}
+
+std::string MemoryPipe::drainOutbound() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::string out;
+    out.swap(outbound_);
+    return out;
+}
+
+void MemoryPipe::close() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        closed_ = true;
+    }
+    readable_.notify_all();
+}
+
+void MemoryPipe::reopen() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    closed_ = false;
+}
+
+bool MemoryPipe::attached() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return attached_;
+}
+
+// ============================================
+// Lado cliente
+// ============================================
+bool MemoryPipe::attach() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (closed_ || attached_) {
+        return false;
+    }
+    attached_ = true;
+    hungUp_ = false;
+    return true;
+}
+
+void MemoryPipe::detach() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    attached_ = false;
+    inbound_.clear();
+    inboundHead_ = 0;
+}
+
+void MemoryPipe::hangup() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        hungUp_ = true;
+    }
+    readable_.notify_all();
+}
+
+std::ptrdiff_t MemoryPipe::read(char* out, size_t capacity) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (hungUp_) {
+            return 0;
+        }
+        if (inboundHead_ < inbound_.size()) {
+            size_t n = std::min(capacity, inbound_.size() - inboundHead_);
+            std::memcpy(out, inbound_.data() + inboundHead_, n);
+            inboundHead_ += n;
+            if (inboundHead_ == inbound_.size()) {
+                inbound_.clear();
+                inboundHead_ = 0;
+            }
+            return static_cast<std::ptrdiff_t>(n);
+        }
+        if (closed_) {
+            return 0;
+        }
+        if (!source_) {
+            return WouldBlock;
+        }
+    }
+
+    // Fora do lock: source_ só muda sem cliente conectado
+    size_t n = source_(out, capacity);
+    return n > 0 ? static_cast<std::ptrdiff_t>(n) : WouldBlock;
+}
+
+std::ptrdiff_t MemoryPipe::send(const char* data, size_t len) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (hungUp_ || closed_) {
+        return -1;
+    }
+    outbound_.append(data, len);
+    return static_cast<std::ptrdiff_t>(len);
+}
+
+bool MemoryPipe::waitReadable(int timeoutMs) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    return readable_.wait_for(lock, std::chrono::milliseconds(timeoutMs), [this] {
+        return hungUp_ || closed_ || source_ || inboundHead_ < inbound_.size();
+    });
+}
+
+} // namespace gg
@@ -0,0 +1,174 @@
+#include "gg_ws/router.hpp"
+
+#include <algorithm>
+
+namespace gg {
+
+namespace {
+
+constexpr bool isWhitespace(char c) noexcept {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+constexpr bool isTokenEnd(char c) noexcept {
+    return c == ',' || c == '}' || c == ']' || isWhitespace(c);
+}
+
+// Tentativas de seed antes de dobrar a tabela
+constexpr int MaxSeedAttempts = 256;
+
+} // anonymous namespace
+
+// ============================================
+// Construção
+// ============================================
+MessageRouter::MessageRouter(std::string_view key) {
+    quotedKey_.reserve(key.size() + 2);
+    quotedKey_ += '"';
+    quotedKey_.append(key.data(), key.size());
+    quotedKey_ += '"';
+}
+
+MessageRouter& MessageRouter::on(std::string_view value, Handler handler) {
+    for (auto& route : routes_) {
+        if (route.value == value) {
+            route.handler = std::move(handler);
+            return *this;
+        }
+    }
+    routes_.push_back({std::string(value), std::move(handler)});
+    table_.clear();
+    return *this;
+}
+
+MessageRouter& MessageRouter::otherwise(Handler handler) {
+    fallback_ = std::move(handler);
+    return *this;
+}
+
+std::string_view MessageRouter::key() const noexcept {
+    return std::string_view(quotedKey_).substr(1, quotedKey_.size() - 2);
+}
+
+// ============================================
+// Hash Perfeito
+// ============================================
+uint64_t MessageRouter::hash(std::string_view value, uint64_t seed) noexcept {
+    // FNV-1a com seed + finalizador (valores curtos: poucos ciclos)
+    uint64_t h = 0xcbf29ce484222325ULL ^ seed;
+    for (char c : value) {
+        h ^= static_cast<uint8_t>(c);
+        h *= 0x100000001b3ULL;
+    }
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    return h;
+}
+
+void MessageRouter::build() {
+    table_.clear();
+    if (routes_.empty()) {
+        return;
+    }
+
+    // Começa com fator de carga <= 0.5 e dobra até achar seed sem colisões
+    size_t size = 1;
+    while (size < routes_.size() * 2) size <<= 1;
+
+    for (;;) {
+        std::vector<int32_t> table(size, -1);
+        for (uint64_t seed = 1; seed <= MaxSeedAttempts; ++seed) {
+            std::fill(table.begin(), table.end(), -1);
+            bool collision = false;
+            for (size_t i = 0; i < routes_.size() && !collision; ++i) {
+                int32_t& slot = table[hash(routes_[i].value, seed) & (size - 1)];
+                collision = slot >= 0;
+                slot = static_cast<int32_t>(i);
+            }
+            if (!collision) {
+                table_ = std::move(table);
+                seed_ = seed;
+                mask_ = size - 1;
+                return;
+            }
+        }
+        size <<= 1;
+    }
+}
+
+const MessageRouter::Route* MessageRouter::lookup(std::string_view value) const noexcept {
+    if (!table_.empty()) {
+        int32_t index = table_[hash(value, seed_) & mask_];
+        if (index >= 0 && routes_[index].value == value) {
+            return &routes_[index];
+        }
+        return nullptr;
+    }
+
+    // Sem build(): busca linear
+    for (const auto& route : routes_) {
+        if (route.value == value) return &route;
+    }
+    return nullptr;
+}
+
+// ============================================
+// Varredura da Chave
+// ============================================
+std::string_view MessageRouter::findValue(std::string_view message) const noexcept {
+    size_t pos = 0;
+    while ((pos = message.find(quotedKey_, pos)) != std::string_view::npos) {
+        size_t start = pos;
+        pos += quotedKey_.size();
+
+        // "\"e\"" dentro de uma string escapada não é chave
+        if (start > 0 && message[start - 1] == '\\') continue;
+
+        size_t i = pos;
+        while (i < message.size() && isWhitespace(message[i])) ++i;
+        if (i >= message.size() || message[i] != ':') continue;  // Era um valor, não chave
+        ++i;
+        while (i < message.size() && isWhitespace(message[i])) ++i;
+        if (i >= message.size()) return {};
+
+        if (message[i] == '"') {
+            // Valor string: até a próxima aspa não escapada
+            size_t begin = ++i;
+            while (i < message.size()) {
+                if (message[i] == '\\') {
+                    i += 2;
+                    continue;
+                }
+                if (message[i] == '"') return message.substr(begin, i - begin);
+                ++i;
+            }
+            return {};
+        }
+
+        // Valor escalar (número, true, false, null)
+        size_t begin = i;
+        while (i < message.size() && !isTokenEnd(message[i])) ++i;
+        return message.substr(begin, i - begin);
+    }
+    return {};
+}
+
+// ============================================
+// Dispatch
+// ============================================
+bool MessageRouter::dispatch(std::string_view message) const {
+    std::string_view value = findValue(message);
+    if (value.data() != nullptr) {
+        if (const Route* route = lookup(value)) {
+            if (route->handler) route->handler(message);
+            return true;
+        }
+    }
+    if (fallback_) {
+        fallback_(message);
+    }
+    return false;
+}
+
+} // namespace gg
@@ -1,8 +1,19 @@
 #include "gg_ws/websocket.hpp"
+#include "gg_ws/memory_transport.hpp"
 #include "internal/cpu_affinity.hpp"
+#include "internal/dns_cache.hpp"
 #include "internal/heartbeat_manager.hpp"
 #include "internal/message_queue.hpp"
 #include "internal/memory_pool.hpp"
+#include "internal/send_combiner.hpp"
+#include "internal/subscription_book.hpp"
+#include "internal/tcp_connector.hpp"
+#include "internal/tls_context.hpp"
+#include "internal/utf8_validator.hpp"
+
+#ifndef _WIN32
+#include "gg_ws/shm_ring.hpp"
+#endif
 
 #include <openssl/ssl.h>
 #include <openssl/err.h>
@@ -10,12 +21,17 @@
 #include <algorithm>
 #include <array>
 #include <atomic>
+#include <cerrno>
 #include <cstring>
+#include <deque>
+#include <future>
+#include <limits>
 #include <mutex>
 #include <random>
 #include <shared_mutex>
 #include <sstream>
 #include <thread>
+#include <unordered_map>
 #include <condition_variable>
 
 #ifdef _WIN32
@@ -26,6 +42,7 @@
     using socket_t = SOCKET;
     #define SOCKET_ERROR_VALUE INVALID_SOCKET
     #define CLOSE_SOCKET(s) closesocket(s)
+    #define SEND_FLAGS 0
 #else
     #include <arpa/inet.h>
     #include <netdb.h>
@@ -37,6 +54,12 @@
     using socket_t = int;
     #define SOCKET_ERROR_VALUE (-1)
     #define CLOSE_SOCKET(s) close(s)
+    // Peer que caiu vira erro de send(), não SIGPIPE (a reconexão trata)
+    #ifdef MSG_NOSIGNAL
+        #define SEND_FLAGS MSG_NOSIGNAL
+    #else
+        #define SEND_FLAGS 0
+    #endif
 #endif
 
 namespace gg {
@@ -51,6 +74,7 @@ struct ParsedUrl {
     std::string host;
     uint16_t port = 0;
     std::string path;
+    std::string unixPath;       // ws+unix://: socket local no lugar de host:port
     
     bool valid() const { return !host.empty() && port > 0; }
 };
@@ -58,6 +82,20 @@ struct ParsedUrl {
 ParsedUrl parseUrl(std::string_view url) {
     ParsedUrl result;
     
+    // Unix domain socket (convenção do ws/Node): ws+unix:///tmp/app.sock:/path
+    if (url.substr(0, 10) == "ws+unix://") {
+        url.remove_prefix(10);
+        size_t pathPos = url.find(':');
+        result.unixPath = std::string(url.substr(0, pathPos));
+        result.path = pathPos == std::string_view::npos || pathPos + 1 == url.size()
+                          ? "/" : std::string(url.substr(pathPos + 1));
+        if (!result.unixPath.empty()) {
+            result.host = "localhost";
+            result.port = 80;
+        }
+        return result;
+    }
+    
     // Verifica protocolo
     if (url.substr(0, 6) == "wss://") {
         result.secure = true;
@@ -83,6 +121,19 @@ ParsedUrl parseUrl(std::string_view url) {
         result.path = "/";
     }
     
+    // IPv6 literal: [::1]:9000
+    if (!hostPort.empty() && hostPort.front() == '[') {
+        size_t close = hostPort.find(']');
+        if (close == std::string_view::npos) {
+            return result;  // Inválido
+        }
+        result.host = std::string(hostPort.substr(1, close - 1));
+        if (close + 1 < hostPort.size() && hostPort[close + 1] == ':') {
+            result.port = static_cast<uint16_t>(std::stoi(std::string(hostPort.substr(close + 2))));
+        }
+        return result;
+    }
+    
     // Encontra porta
     size_t colonPos = hostPort.rfind(':');
     if (colonPos != std::string_view::npos) {
@@ -116,6 +167,38 @@ std::string base64Encode(const unsigned char* data, size_t len) {
     return result;
 }
 
+// Mutex vazio para políticas sem concorrência (ExternalDriven)
+struct NullMutex {
+    void lock() noexcept {}
+    bool try_lock() noexcept { return true; }
+    void unlock() noexcept {}
+};
+
+// Espaço livre mínimo antes de cada leitura do socket
+constexpr size_t MinRecvSpace = 16 * 1024;
+
+// Limite da resposta HTTP do handshake
+constexpr size_t MaxHandshakeResponse = 16 * 1024;
+
+// Resultado de uma leitura do transporte
+enum class RecvStatus {
+    Data,        // Bytes novos no buffer
+    WouldBlock,  // Nada disponível agora (socket não bloqueante)
+    Closed       // EOF ou erro
+};
+
+// Resultado da decodificação de um frame do buffer
+enum class FrameStatus {
+    Dispatched,  // Frame completo processado
+    Incomplete,  // Faltam bytes
+    Stop         // Close recebido ou erro de protocolo
+};
+
+// Incremento de contador com escritor único (sem lock prefix)
+inline void bump(std::atomic<uint64_t>& counter, uint64_t n = 1) noexcept {
+    counter.store(counter.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+}
+
 // Gera chave WebSocket aleatória
 std::string generateWebSocketKey() {
     std::random_device rd;
@@ -130,283 +213,394 @@ std::string generateWebSocketKey() {
     return base64Encode(key, 16);
 }
 
-} // anonymous namespace
-
 // ============================================
-// WebSocket Implementation
+// Frames
 // ============================================
-struct WebSocket::Impl {
-    WebSocketConfig config;
-    ParsedUrl parsedUrl;
+
+// Frame recebido, já desmascarado in-place
+struct FrameView {
+    bool fin = false;
+    uint8_t opcode = 0;
+    std::string_view payload;
+    size_t length = 0;      // Bytes do frame (header + payload); se incompleto, o
+                            // total necessário (0 = header ainda incompleto)
+};
+
+enum class ParseStatus {
+    Complete,
+    Incomplete,
+    TooLarge
+};
+
+ParseStatus parseFrame(char* data, size_t available, size_t maxPayload, FrameView& frame) {
+    if (available < 2) {
+        return ParseStatus::Incomplete;
+    }
     
-    // Socket e SSL
-    socket_t socket = SOCKET_ERROR_VALUE;
-    SSL_CTX* sslCtx = nullptr;
-    SSL* ssl = nullptr;
+    auto* header = reinterpret_cast<uint8_t*>(data);
+    frame.fin = (header[0] & 0x80) != 0;
+    frame.opcode = header[0] & 0x0F;
+    bool masked = (header[1] & 0x80) != 0;
+    uint64_t payloadLen = header[1] & 0x7F;
     
-    // Estado
-    std::atomic<bool> connected{false};
-    std::atomic<bool> running{false};
-    std::atomic<bool> shouldReconnect{false};
-    int reconnectAttempts = 0;
+    // Payload length estendido
+    size_t headerLen = 2;
+    if (payloadLen == 126) {
+        headerLen += 2;
+        if (available < headerLen) return ParseStatus::Incomplete;
+        payloadLen = (static_cast<uint64_t>(header[2]) << 8) | header[3];
+    } else if (payloadLen == 127) {
+        headerLen += 8;
+        if (available < headerLen) return ParseStatus::Incomplete;
+        payloadLen = 0;
+        for (int i = 0; i < 8; ++i) {
+            payloadLen = (payloadLen << 8) | header[2 + i];
+        }
+    }
     
-    // Thread de I/O
-    std::thread ioThread;
-    int pinnedCore = -1;
+    // Verifica tamanho máximo
+    if (payloadLen > maxPayload) {
+        return ParseStatus::TooLarge;
+    }
     
-    // Callbacks
-    OnMessage onMessageCb;
-    OnRawMessage onRawMessageCb;
-    OnError onErrorCb;
-    OnConnect onConnectCb;
-    OnDisconnect onDisconnectCb;
-    OnPing onPingCb;
-    OnPong onPongCb;
+    // Mask key (se masked)
+    uint8_t maskKey[4] = {0};
+    if (masked) {
+        if (available < headerLen + 4) return ParseStatus::Incomplete;
+        std::memcpy(maskKey, header + headerLen, 4);
+        headerLen += 4;
+    }
     
-    // Mutexes
-    mutable std::shared_mutex stateMutex;
-    mutable std::mutex callbackMutex;
-    mutable std::mutex sendMutex;
-    std::condition_variable_any waitCv;
+    frame.length = headerLen + static_cast<size_t>(payloadLen);
+    if (available < frame.length) {
+        return ParseStatus::Incomplete;
+    }
     
-    // Fila de mensagens assíncronas
-    internal::LockFreeQueue<std::string> sendQueue;
+    // Aplica unmask
+    char* payload = data + headerLen;
+    if (masked) {
+        for (size_t i = 0; i < payloadLen; ++i) {
+            payload[i] ^= maskKey[i % 4];
+        }
+    }
+    frame.payload = std::string_view(payload, static_cast<size_t>(payloadLen));
+    return ParseStatus::Complete;
+}
+
+// Header máximo de frame de cliente: 2 + 8 (tamanho) + 4 (máscara)
+constexpr size_t MaxFrameHeader = 14;
+
+// Acrescenta um frame mascarado ao fim de `frame` (vários frames por escrita).
+// Não reserva: quem monta o lote reserva uma vez para todos
+void appendFrame(uint8_t opcode, std::string_view payload, std::vector<uint8_t>& frame) {
+    // Header
+    frame.push_back(0x80 | opcode);  // FIN + opcode
     
-    // Heartbeat
-    std::unique_ptr<internal::HeartbeatManager> heartbeat;
+    // Payload length + mask bit (client sempre mascara)
+    if (payload.size() < 126) {
+        frame.push_back(0x80 | static_cast<uint8_t>(payload.size()));
+    } else if (payload.size() <= 65535) {
+        frame.push_back(0x80 | 126);
+        frame.push_back(static_cast<uint8_t>((payload.size() >> 8) & 0xFF));
+        frame.push_back(static_cast<uint8_t>(payload.size() & 0xFF));
+    } else {
+        frame.push_back(0x80 | 127);
+        for (int i = 7; i >= 0; --i) {
+            frame.push_back(static_cast<uint8_t>((payload.size() >> (i * 8)) & 0xFF));
+        }
+    }
     
-    // Buffer pool
-    internal::BufferPool bufferPool{8192, 8};
+    // Mask key (RFC 6455 §5.3: imprevisível, não criptográfica). Gerador
+    // por thread semeado uma vez: random_device por frame custava uma syscall.
+    thread_local std::mt19937 gen{std::random_device{}()};
+    const uint32_t mask = static_cast<uint32_t>(gen());
+    uint8_t maskKey[4];
+    for (int i = 0; i < 4; ++i) {
+        maskKey[i] = static_cast<uint8_t>(mask >> (i * 8));
+        frame.push_back(maskKey[i]);
+    }
     
-    Impl(WebSocketConfig cfg) : config(std::move(cfg)) {
-        parsedUrl = parseUrl(config.url);
-        heartbeat = std::make_unique<internal::HeartbeatManager>(config.ping);
+    // Masked payload
+    for (size_t i = 0; i < payload.size(); ++i) {
+        frame.push_back(static_cast<uint8_t>(payload[i]) ^ maskKey[i % 4]);
     }
+}
+
+// Monta frame de cliente (sempre mascarado) em `frame`
+void encodeFrame(uint8_t opcode, std::string_view payload, std::vector<uint8_t>& frame) {
+    frame.clear();
+    frame.reserve(MaxFrameHeader + payload.size());
+    appendFrame(opcode, payload, frame);
+}
+
+// ============================================
+// Dial: TCP + TLS + upgrade de um endpoint
+// ============================================
+using Clock = std::chrono::steady_clock;
+
+std::chrono::microseconds elapsedSince(Clock::time_point start) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start);
+}
+
+// Limita recv/send bloqueantes (0 = sem limite)
+void setSocketTimeout(socket_t socket, std::chrono::milliseconds timeout) {
+#ifdef _WIN32
+    DWORD tv = static_cast<DWORD>(timeout.count());
+#else
+    timeval tv;
+    tv.tv_sec = static_cast<time_t>(timeout.count() / 1000);
+    tv.tv_usec = static_cast<suseconds_t>((timeout.count() % 1000) * 1000);
+#endif
+    setsockopt(socket, SOL_SOCKET, SO_RCVTIMEO, reinterpret_cast<const char*>(&tv), sizeof(tv));
+    setsockopt(socket, SOL_SOCKET, SO_SNDTIMEO, reinterpret_cast<const char*>(&tv), sizeof(tv));
+}
+
+/**
+ * Estabelece uma conexão WebSocket completa com um endpoint. Independente
+ * do cliente para que vários rodem em paralelo (corrida de endpoints); o
+ * vencedor é adotado pelo Impl.
+ */
+struct EndpointDialer {
+    const std::string& rawUrl;      // Aponta para WebSocketConfig (estável)
+    ParsedUrl url;
     
-    ~Impl() {
-        disconnect(CloseCode::GoingAway);
+    // Conexão (válida se dial() retornou true)
+    socket_t socket = SOCKET_ERROR_VALUE;
+    SSL* ssl = nullptr;
+    std::vector<char> rx = std::vector<char>(64 * 1024);  // Resposta HTTP + frames que vieram junto
+    size_t rxHead = 0;
+    size_t rxTail = 0;
+    internal::Utf8Stream utf8;      // Texto fragmentado já decodificado de rx
+    
+    EndpointTiming timing;
+    
+    // Socket exposto para interrupt() enquanto dial() roda em outra thread
+    std::atomic<socket_t> liveSocket{SOCKET_ERROR_VALUE};
+    
+    explicit EndpointDialer(const std::string& endpoint)
+        : rawUrl(endpoint), url(parseUrl(rawUrl)) {
+        timing.url = rawUrl;
     }
     
-    // ============================================
-    // Conexão
-    // ============================================
-    bool connect() {
-        if (!parsedUrl.valid()) {
-            triggerError(ErrorCode::InvalidUrl, "URL inválida");
-            return false;
-        }
-        
-        // Inicializa socket
-        if (!initSocket()) {
-            return false;
-        }
-        
-        // Conecta ao servidor
-        if (!connectSocket()) {
-            cleanup();
-            return false;
-        }
-        
-        // Inicializa TLS se necessário
-        if (parsedUrl.secure && !initTls()) {
-            cleanup();
-            return false;
-        }
-        
-        // Handshake WebSocket
-        if (!performHandshake()) {
-            cleanup();
-            return false;
-        }
-        
-        // Marca como conectado
-        {
-            std::unique_lock lock(stateMutex);
-            connected.store(true, std::memory_order_release);
-            running.store(true, std::memory_order_release);
-            reconnectAttempts = 0;
-        }
-        
-        // Inicia thread de I/O
-        ioThread = std::thread(&Impl::ioLoop, this);
-        
-        // Inicia heartbeat
-        heartbeat->start(
-            [this]() { return sendPingFrame(""); },
-            [this](std::string_view msg) { return sendTextMessage(std::string(msg)); },
-            [this]() { triggerError(ErrorCode::PingTimeout, "Pong timeout"); }
-        );
-        
-        // Callback
-        triggerConnect();
-        
-        return true;
+    ~EndpointDialer() {
+        release();
     }
     
-    void disconnect(int code) {
-        bool wasConnected = connected.exchange(false, std::memory_order_acq_rel);
-        running.store(false, std::memory_order_release);
-        
-        // Para heartbeat
-        if (heartbeat) {
-            heartbeat->stop();
-        }
-        
-        // Envia close frame
-        if (wasConnected) {
-            sendCloseFrame(code);
+    bool dial(const WebSocketConfig& config, Clock::time_point raceStart,
+              Clock::time_point deadline, const std::atomic<bool>* cancel) {
+        bool ok = connectTcp(config, deadline, cancel) &&
+                  (!url.secure || startTls(config.tls)) &&
+                  upgrade();
+        if (socket != SOCKET_ERROR_VALUE) {
+            setSocketTimeout(socket, std::chrono::milliseconds(0));
         }
-        
-        // Notifica thread
-        waitCv.notify_all();
-        
-        // Aguarda thread
-        if (ioThread.joinable()) {
-            ioThread.join();
+        timing.total = elapsedSince(raceStart);
+        if (!ok && cancel && cancel->load(std::memory_order_relaxed)) {
+            timing.outcome = EndpointOutcome::Cancelled;
         }
-        
-        // Limpa recursos
-        cleanup();
-        
-        // Callback
-        if (wasConnected) {
-            triggerDisconnect(code);
+        return ok;
+    }
+    
+    // Desbloqueia um dial() em andamento (chamado por outra thread)
+    void interrupt() {
+        socket_t s = liveSocket.load(std::memory_order_acquire);
+        if (s != SOCKET_ERROR_VALUE) {
+#ifdef _WIN32
+            ::shutdown(s, SD_BOTH);
+#else
+            ::shutdown(s, SHUT_RDWR);
+#endif
         }
     }
     
     // ============================================
-    // Envio
+    // I/O bloqueante (dono único: quem discou ou o rotacionador)
     // ============================================
-    bool send(std::string_view message) {
-        if (!connected.load(std::memory_order_acquire)) {
-            return false;
+    bool writeAll(const char* data, size_t len) {
+        size_t sent = 0;
+        while (sent < len) {
+            ssize_t n = ssl ? SSL_write(ssl, data + sent, static_cast<int>(len - sent))
+                            : ::send(socket, data + sent, len - sent, SEND_FLAGS);
+            if (n <= 0) return false;
+            sent += static_cast<size_t>(n);
         }
-        return sendFrame(Opcode::Text, message);
+        return true;
     }
     
-    bool sendBinary(const void* data, size_t size) {
-        if (!connected.load(std::memory_order_acquire)) {
-            return false;
-        }
-        return sendFrame(Opcode::Binary, std::string_view(static_cast<const char*>(data), size));
+    bool sendFrame(uint8_t opcode, std::string_view payload) {
+        std::vector<uint8_t> frame;
+        encodeFrame(opcode, payload, frame);
+        return writeAll(reinterpret_cast<const char*>(frame.data()), frame.size());
     }
     
-    void sendAsync(std::string_view message) {
-        sendQueue.push(std::string(message));
+    bool waitReadable(int timeoutMs) {
+        if (ssl && SSL_pending(ssl) > 0) return true;
+        pollfd pfd{};
+        pfd.fd = socket;
+        pfd.events = POLLIN;
+#ifdef _WIN32
+        return WSAPoll(&pfd, 1, timeoutMs) > 0;
+#else
+        return ::poll(&pfd, 1, timeoutMs) > 0;
+#endif
     }
     
-    bool sendPingFrame(std::string_view payload) {
-        if (!connected.load(std::memory_order_acquire)) {
-            return false;
+    // Uma leitura para o fim de rx (compacta/cresce antes)
+    ssize_t readSome() {
+        if (rxHead == rxTail) {
+            rxHead = rxTail = 0;
+        } else if (rx.size() - rxTail < MinRecvSpace && rxHead > 0) {
+            std::memmove(rx.data(), rx.data() + rxHead, rxTail - rxHead);
+            rxTail -= rxHead;
+            rxHead = 0;
         }
-        return sendFrame(Opcode::Ping, payload);
+        if (rx.size() - rxTail < MinRecvSpace) {
+            rx.resize(rx.size() * 2);
+        }
+        ssize_t n = ssl ? SSL_read(ssl, rx.data() + rxTail, static_cast<int>(rx.size() - rxTail))
+                        : ::recv(socket, rx.data() + rxTail, rx.size() - rxTail, 0);
+        if (n > 0) rxTail += static_cast<size_t>(n);
+        return n;
     }
     
-    bool sendPongFrame(std::string_view payload) {
-        if (!connected.load(std::memory_order_acquire)) {
-            return false;
+    void release() {
+        if (ssl) {
+            SSL_free(ssl);
+            ssl = nullptr;
         }
-        return sendFrame(Opcode::Pong, payload);
+        if (socket != SOCKET_ERROR_VALUE) {
+            CLOSE_SOCKET(socket);
+            socket = SOCKET_ERROR_VALUE;
+        }
+        liveSocket.store(SOCKET_ERROR_VALUE, std::memory_order_release);
     }
     
-    bool sendTextMessage(const std::string& msg) {
-        return send(msg);
-    }
-
 private:
-    // ============================================
-    // Socket Init
-    // ============================================
-    bool initSocket() {
-#ifdef _WIN32
-        WSADATA wsaData;
-        if (WSAStartup(MAKEWORD(2, 2), &wsaData) != 0) {
-            triggerError(ErrorCode::ConnectionFailed, "WSAStartup falhou");
-            return false;
+    bool fail(int code, std::string message) {
+        timing.errorCode = code;
+        timing.error = std::move(message);
+        return false;
+    }
+    
+    bool connectTcp(const WebSocketConfig& config, Clock::time_point deadline,
+                    const std::atomic<bool>* cancel) {
+        if (!url.unixPath.empty()) {
+            return connectUnix(deadline, cancel);
         }
-#endif
         
-        socket = ::socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
-        if (socket == SOCKET_ERROR_VALUE) {
-            triggerError(ErrorCode::ConnectionFailed, "Falha ao criar socket");
-            return false;
+        // Resolve hostname (cache do processo, A + AAAA)
+        auto phase = Clock::now();
+        std::vector<internal::ResolvedAddress> addresses;
+        auto status = internal::DnsCache::instance().resolve(
+            url.host, url.port, config.dnsCacheTtl, deadline, addresses, cancel);
+        timing.dns = elapsedSince(phase);
+        if (status == internal::DnsCache::Status::Timeout) {
+            return fail(ErrorCode::Timeout, "Timeout no DNS lookup: " + url.host);
+        }
+        if (status != internal::DnsCache::Status::Ok) {
+            return fail(ErrorCode::ConnectionFailed, "DNS lookup falhou: " + url.host);
+        }
+        
+        // Corrida entre todos os endereços (IPv6/IPv4 intercalados)
+        phase = Clock::now();
+        auto result = internal::connectHappyEyeballs(
+            internal::interleaveFamilies(addresses), deadline, config.connectAttemptDelay, cancel);
+        timing.tcp = elapsedSince(phase);
+        if (result.socket == internal::InvalidNativeSocket) {
+            if (result.timedOut) {
+                if (cancel && cancel->load(std::memory_order_relaxed)) {
+                    return fail(ErrorCode::ConnectionFailed, "Cancelado");
+                }
+                // Endereços do cache podem ter mudado: força novo lookup
+                internal::DnsCache::instance().invalidate(url.host, url.port);
+                return fail(ErrorCode::Timeout, "Timeout de conexão (" +
+                            std::to_string(config.connectTimeout.count()) + "ms)");
+            }
+            return fail(ErrorCode::ConnectionFailed,
+                        std::string("Conexão falhou: ") + std::strerror(result.lastError));
         }
+        socket = result.socket;
         
         // Desabilita Nagle para menor latência
         int flag = 1;
         setsockopt(socket, IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<char*>(&flag), sizeof(flag));
-        
-        return true;
+        return publishSocket(deadline, cancel);
     }
     
-    bool connectSocket() {
-        // Resolve hostname
-        struct addrinfo hints{}, *result = nullptr;
-        hints.ai_family = AF_INET;
-        hints.ai_socktype = SOCK_STREAM;
-        
-        std::string portStr = std::to_string(parsedUrl.port);
-        if (getaddrinfo(parsedUrl.host.c_str(), portStr.c_str(), &hints, &result) != 0) {
-            triggerError(ErrorCode::ConnectionFailed, "DNS lookup falhou: " + parsedUrl.host);
-            return false;
+    // ws+unix://: sem DNS nem Happy Eyeballs
+    bool connectUnix(Clock::time_point deadline, const std::atomic<bool>* cancel) {
+        auto phase = Clock::now();
+        auto result = internal::connectUnix(url.unixPath, deadline, cancel);
+        timing.tcp = elapsedSince(phase);
+        if (result.socket == internal::InvalidNativeSocket) {
+            if (result.timedOut) {
+                return fail(ErrorCode::Timeout, "Timeout de conexão: " + url.unixPath);
+            }
+            return fail(ErrorCode::ConnectionFailed, "Conexão falhou: " + url.unixPath +
+                        ": " + std::strerror(result.lastError));
         }
+        socket = result.socket;
+        return publishSocket(deadline, cancel);
+    }
+    
+    bool publishSocket(Clock::time_point deadline, const std::atomic<bool>* cancel) {
+        liveSocket.store(socket, std::memory_order_release);
         
-        // Conecta
-        int err = ::connect(socket, result->ai_addr, static_cast<int>(result->ai_addrlen));
-        freeaddrinfo(result);
+        // TLS e upgrade usam I/O bloqueante limitado pelo tempo restante
+        setSocketTimeout(socket, std::max(std::chrono::milliseconds(1),
+            std::chrono::duration_cast<std::chrono::milliseconds>(deadline - Clock::now())));
         
-        if (err != 0) {
-            triggerError(ErrorCode::ConnectionFailed, "Conexão falhou");
-            return false;
+        // Cancelado entre o connect e a publicação do socket
+        if (cancel && cancel->load(std::memory_order_acquire)) {
+            return fail(ErrorCode::ConnectionFailed, "Cancelado");
         }
-        
         return true;
     }
     
-    bool initTls() {
-        // Inicializa OpenSSL
-        SSL_library_init();
-        SSL_load_error_strings();
+    bool startTls(const TlsConfig& config) {
+        auto phase = Clock::now();
         
-        sslCtx = SSL_CTX_new(TLS_client_method());
-        if (!sslCtx) {
-            triggerError(ErrorCode::TlsError, "Falha ao criar SSL context");
-            return false;
+        // Contexto do processo: OpenSSL e trust store já inicializados
+        std::string error;
+        internal::TlsContext* context = internal::TlsContext::get(config, error);
+        if (!context) {
+            return fail(ErrorCode::TlsError, error);
         }
         
-        // Configurações de segurança
-        SSL_CTX_set_verify(sslCtx, SSL_VERIFY_PEER, nullptr);
-        SSL_CTX_set_default_verify_paths(sslCtx);
-        SSL_CTX_set_min_proto_version(sslCtx, TLS1_2_VERSION);
-        
-        ssl = SSL_new(sslCtx);
+        // Oferece a última sessão deste host:port (reconexão abreviada)
+        const std::string peer = config.resumeSessions ? url.host + ':' + std::to_string(url.port) : "";
+        ssl = context->newConnection(peer);
         if (!ssl) {
-            triggerError(ErrorCode::TlsError, "Falha ao criar SSL");
-            return false;
+            return fail(ErrorCode::TlsError, "Falha ao criar SSL");
         }
         
         SSL_set_fd(ssl, static_cast<int>(socket));
-        SSL_set_tlsext_host_name(ssl, parsedUrl.host.c_str());
+        SSL_set_tlsext_host_name(ssl, url.host.c_str());
         
         if (SSL_connect(ssl) != 1) {
             char errBuf[256];
             ERR_error_string_n(ERR_get_error(), errBuf, sizeof(errBuf));
-            triggerError(ErrorCode::TlsError, std::string("TLS handshake falhou: ") + errBuf);
-            return false;
+            if (!peer.empty()) {
+                context->forget(peer);
+            }
+            return fail(ErrorCode::TlsError, std::string("TLS handshake falhou: ") + errBuf);
         }
         
+        timing.tls = elapsedSince(phase);
+        timing.tlsResumed = SSL_session_reused(ssl) == 1;
         return true;
     }
     
-    bool performHandshake() {
+    bool upgrade() {
+        auto phase = Clock::now();
         std::string key = generateWebSocketKey();
         
         // Monta request
         std::ostringstream request;
-        request << "GET " << parsedUrl.path << " HTTP/1.1\r\n";
-        request << "Host: " << parsedUrl.host;
-        if ((parsedUrl.secure && parsedUrl.port != 443) || (!parsedUrl.secure && parsedUrl.port != 80)) {
-            request << ":" << parsedUrl.port;
+        request << "GET " << url.path << " HTTP/1.1\r\n";
+        request << "Host: " << url.host;
+        if ((url.secure && url.port != 443) || (!url.secure && url.port != 80)) {
+            request << ":" << url.port;
         }
         request << "\r\n";
         request << "Upgrade: websocket\r\n";
@@ -416,65 +610,1302 @@ private:
         request << "\r\n";
         
         std::string req = request.str();
-        if (!rawSend(req.data(), req.size())) {
-            triggerError(ErrorCode::HandshakeFailed, "Falha ao enviar handshake");
-            return false;
+        if (!writeAll(req.data(), req.size())) {
+            return fail(ErrorCode::HandshakeFailed, "Falha ao enviar handshake");
         }
         
-        // Lê resposta
-        char buffer[1024];
-        ssize_t received = rawRecv(buffer, sizeof(buffer) - 1);
-        if (received <= 0) {
-            triggerError(ErrorCode::HandshakeFailed, "Sem resposta do servidor");
-            return false;
+        // Lê resposta até o fim dos headers; bytes seguintes já são frames
+        // e ficam no buffer de recepção
+        size_t headerEnd = std::string_view::npos;
+        while (headerEnd == std::string_view::npos) {
+            if (rxTail >= MaxHandshakeResponse) {
+                return fail(ErrorCode::HandshakeFailed, "Resposta de handshake muito grande");
+            }
+            ssize_t received = ssl ? SSL_read(ssl, rx.data() + rxTail, static_cast<int>(rx.size() - rxTail))
+                                   : ::recv(socket, rx.data() + rxTail, rx.size() - rxTail, 0);
+            if (received <= 0) {
+                return fail(ErrorCode::HandshakeFailed, "Sem resposta do servidor");
+            }
+            rxTail += static_cast<size_t>(received);
+            headerEnd = std::string_view(rx.data(), rxTail).find("\r\n\r\n");
         }
-        buffer[received] = '\0';
+        rxHead = headerEnd + 4;
         
         // Verifica resposta
-        std::string response(buffer, received);
-        if (response.find("101") == std::string::npos ||
-            response.find("Upgrade") == std::string::npos) {
-            triggerError(ErrorCode::HandshakeFailed, "Handshake rejeitado pelo servidor");
-            return false;
+        std::string_view response(rx.data(), headerEnd);
+        if (response.find("101") == std::string_view::npos ||
+            response.find("Upgrade") == std::string_view::npos) {
+            return fail(ErrorCode::HandshakeFailed, "Handshake rejeitado pelo servidor");
         }
         
+        timing.upgrade = elapsedSince(phase);
         return true;
     }
+};
+
+} // anonymous namespace
+
+// ============================================
+// WebSocket Implementation
+// ============================================
+template<typename P>
+struct WebSocketClient<P>::Impl {
+    using TransportKind = policy::TransportKind;
     
-    // ============================================
-    // I/O Loop
-    // ============================================
-    void ioLoop() {
-        // Aplica CPU affinity se configurado
-        if (pinnedCore >= 0) {
-            internal::pinCurrentThread(pinnedCore);
-        }
-        
-        std::vector<char> frameBuffer;
-        frameBuffer.reserve(config.maxMessageSize);
-        
-        while (running.load(std::memory_order_acquire)) {
-            // Processa fila de envio assíncrono
-            while (auto msg = sendQueue.pop()) {
-                send(*msg);
+    // Sem thread própria não há concorrência: locks viram no-op
+    using CallbackMutex = std::conditional_t<P::threaded, std::mutex, NullMutex>;
+    using SendMutex = std::conditional_t<P::threaded, std::mutex, NullMutex>;
+    
+    WebSocketConfig config;
+    ParsedUrl parsedUrl;        // Endpoint da conexão atual
+    std::atomic<const std::string*> currentUrl{nullptr};  // config.url ou um de config.endpoints
+    std::vector<EndpointTiming> lastRace;
+    
+    // Socket e SSL (SSL_CTX é do processo: internal::TlsContext)
+    socket_t socket = SOCKET_ERROR_VALUE;
+    SSL* ssl = nullptr;
+    
+    // MemoryTransport: pipe no lugar do socket
+    std::shared_ptr<MemoryPipe> pipe;
+    
+    // Estado
+    std::atomic<bool> connected{false};
+    std::atomic<bool> running{false};
+    std::atomic<bool> reconnecting{false};  // Link caiu e a reconexão ainda tenta
+    std::atomic<bool> abortDial{false};     // disconnect(): interrompe corrida/backoff
+    int linkCloseCode = CloseCode::AbnormalClosure;  // Motivo da queda do link atual
+    
+    // Thread de I/O
+    std::thread ioThread;
+    int pinnedCore = -1;
+    
+    // Supervisor de reconexão (OwnThread): a thread de I/O só sinaliza a
+    // queda e sai; o supervisor a junta, espera o backoff e reconecta
+    std::thread supervisorThread;
+    std::mutex supervisorMutex;
+    std::condition_variable supervisorCv;
+    bool supervisorStop = false;
+    bool linkLost = false;
+    int lostCode = CloseCode::AbnormalClosure;
+    Clock::time_point lostAt;
+    
+    // Reconexão conduzida por poll() (ExternalDriven): a corrida roda numa
+    // thread auxiliar e poll() só adota o resultado, sem bloquear
+    struct DialOutcome {
+        std::vector<std::unique_ptr<EndpointDialer>> dialers;
+        EndpointDialer* winner = nullptr;
+    };
+    int pendingAttempts = 0;
+    Clock::time_point nextAttemptAt;
+    std::thread dialThread;
+    std::future<DialOutcome> pendingDial;
+    
+    std::mt19937_64 jitterRng{std::random_device{}()};
+    
+    // Assinaturas reenviadas a cada (re)conexão, na ordem de registro
+    std::vector<std::string> subscriptionList;
+    mutable CallbackMutex subscriptionMutex;
+    
+    // Assinaturas por tópico, sob subscriptionMutex. topicsPending avisa o
+    // loop de I/O (sem lock) que há lote esperando o ritmo
+    internal::SubscriptionBook topicBook;
+    std::atomic<bool> topicsPending{false};
+    
+    // Callbacks: snapshot imutável publicado por ponteiro atômico.
+    // Setters copiam, alteram, publicam e aposentam o anterior. O loop de
+    // despacho (I/O ou poll(), dentro de um DispatchScope) lê o ponteiro com
+    // um load acquire por mensagem, sem contador: os aposentados são
+    // liberados nos pontos quiescentes dele (topo do loop / de poll()), ou
+    // pelo setter se nenhum loop estiver ativo. Os demais leitores (conexão,
+    // erro, reconexão, raros) se contam em callbackReaders.
+    struct CallbackSet {
+        OnMessage message;
+        OnRawMessage raw;
+        OnError error;
+        OnConnect connect;
+        OnDisconnect disconnect;
+        OnPing ping;
+        OnPong pong;
+        OnEndpointRace race;
+        OnReconnect reconnect;
+        OnMessageBatch batch;
+        std::shared_ptr<const MessageRouter> router;
+    };
+    std::atomic<const CallbackSet*> callbacks{nullptr};
+    std::atomic<uint32_t> callbackDispatchers{0};      // DispatchScopes ativos
+    mutable std::atomic<uint32_t> callbackReaders{0};  // CallbackReaders ativos
+    std::atomic<bool> callbacksRetired{false};
+    std::unique_ptr<CallbackSet> callbackSnapshot;                  // Sob callbackMutex
+    std::vector<std::unique_ptr<CallbackSet>> retiredCallbacks;     // Sob callbackMutex
+    
+    // Loop de despacho ativo: enquanto vive, os aposentados só são liberados
+    // pelo próprio loop (reclaimCallbacks). Um por execução de ioLoop ou poll()
+    class DispatchScope {
+    public:
+        explicit DispatchScope(Impl& impl) noexcept : dispatchers_(impl.callbackDispatchers) {
+            if constexpr (P::threaded) {
+                // Fence: um setter que viu 0 loops publicou antes dos loads deste
+                dispatchers_.fetch_add(1, std::memory_order_seq_cst);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+            } else {
+                dispatchers_.store(dispatchers_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            }
+        }
+        ~DispatchScope() {
+            if constexpr (P::threaded) {
+                dispatchers_.fetch_sub(1, std::memory_order_release);
+            } else {
+                dispatchers_.store(dispatchers_.load(std::memory_order_relaxed) - 1, std::memory_order_relaxed);
+            }
+        }
+        
+        DispatchScope(const DispatchScope&) = delete;
+        DispatchScope& operator=(const DispatchScope&) = delete;
+        
+    private:
+        std::atomic<uint32_t>& dispatchers_;
+    };
+    
+    // Só dentro de um DispatchScope, na thread dele
+    const CallbackSet& dispatchCallbacks() const noexcept {
+        return *callbacks.load(std::memory_order_acquire);
+    }
+    
+    // Fora do loop de despacho: o snapshot não é liberado enquanto o guard vive
+    class CallbackReader {
+    public:
+        explicit CallbackReader(const Impl& impl) noexcept : readers_(impl.callbackReaders) {
+            // seq_cst com o store + load do setter: se ele viu 0 leitores,
+            // este load já vê o snapshot novo
+            readers_.fetch_add(1, std::memory_order_seq_cst);
+            set_ = impl.callbacks.load(std::memory_order_seq_cst);
+        }
+        ~CallbackReader() { readers_.fetch_sub(1, std::memory_order_release); }
+        
+        CallbackReader(const CallbackReader&) = delete;
+        CallbackReader& operator=(const CallbackReader&) = delete;
+        
+        const CallbackSet& operator*() const noexcept { return *set_; }
+        
+    private:
+        std::atomic<uint32_t>& readers_;
+        const CallbackSet* set_;
+    };
+    
+    // Mutexes
+    mutable std::shared_mutex stateMutex;
+    mutable CallbackMutex callbackMutex;  // Só serializa setters
+    mutable SendMutex sendMutex;
+    std::condition_variable_any waitCv;
+    bool stopped = true;                    // Sob stateMutex: wait() retorna
+    
+    // Fila de mensagens assíncronas
+    internal::LockFreeQueue<std::string> sendQueue;
+    
+    // Envio combinado (OwnThread): o escritor da vez codifica em combineBuffer
+    internal::SendCombiner sendCombiner;
+    std::vector<uint8_t> combineBuffer;
+    
+    // Rotação make-before-break (OwnThread). O rotacionador disca, assina e
+    // lê o novo link; a thread de I/O registra as chaves que já entregou e
+    // troca de link entre duas leituras. Campos sob rotation.mutex.
+    struct PendingMessage {
+        std::string payload;
+        bool binary;
+    };
+    struct Rotation {
+        std::mutex mutex;
+        std::condition_variable cv;
+        bool active = false;                // Rotação em andamento
+        bool aligned = false;               // Os dois links viram a mesma mensagem
+        bool takeover = false;              // Link antigo caiu: trocar sem alinhar
+        bool switched = false;              // Thread de I/O adotou o novo link
+        std::unique_ptr<EndpointDialer> standby;                // Novo link pronto para a troca
+        std::unordered_map<std::string, uint32_t> delivered;   // Chaves entregues pelo link antigo
+        std::deque<std::string> deliveredOrder;                 // Janela FIFO de delivered
+        std::vector<PendingMessage> pending;                    // Recebidas pelo novo link
+        std::unordered_map<std::string, size_t> pendingIndex;  // Chave → último índice em pending
+        size_t matchEnd = 0;                // pending[0, matchEnd) já saiu pelo link antigo
+        std::vector<std::string> topics;    // Tópicos já assinados no novo link
+        internal::SendPacer topicPacer;     // Ritmo já gasto no novo link
+    } rotation;
+    std::atomic<bool> rotating{false};      // Filtro ativo em handleMessage
+    std::atomic<bool> handoffReady{false};  // rotation.standby aguardando a troca
+    std::mutex rotateMutex;                 // Uma rotação por vez
+    
+    // Após a troca, descarta o que o link antigo já entregou (só thread de I/O)
+    bool deduplicating = false;
+    std::unordered_map<std::string, uint32_t> dedupKeys;
+    
+    // Rotação periódica (RotationConfig::interval)
+    std::thread rotationThread;
+    std::mutex schedulerMutex;
+    std::condition_variable schedulerCv;
+    bool schedulerStop = false;
+    
+    // Heartbeat (nulo com HeartbeatOff)
+    std::unique_ptr<internal::HeartbeatManager> heartbeat;
+    
+    // Buffer pool
+    internal::BufferPool bufferPool{8192, 8};
+    
+    // Buffer de recepção: bytes lidos do socket ainda não decodificados.
+    // Frames são decodificados in-place; callbacks recebem views para cá.
+    std::vector<char> rxBuffer;
+    size_t rxHead = 0;
+    size_t rxTail = 0;
+    internal::Utf8Stream utf8Text;  // Mensagem de texto fragmentada em andamento
+    
+    // Mensagens da leitura atual para onMessageBatch (views em rxBuffer)
+    std::vector<MessageView> batchViews;
+    size_t batchCount = 0;
+    Clock::time_point batchStart;
+    
+    // Métricas (só atualizadas com MetricsOn)
+    struct Counters {
+        std::atomic<uint64_t> messagesReceived{0};
+        std::atomic<uint64_t> bytesReceived{0};
+        std::atomic<uint64_t> framesReceived{0};
+        std::atomic<uint64_t> messagesSent{0};
+        std::atomic<uint64_t> bytesSent{0};
+        std::atomic<uint64_t> sendWrites{0};
+        std::atomic<uint64_t> jsonParseFailures{0};
+        std::atomic<uint64_t> reconnects{0};
+        std::atomic<uint64_t> reconnectAttempts{0};
+        std::atomic<uint64_t> lastRecoveryUs{0};
+        std::atomic<uint64_t> maxRecoveryUs{0};
+        std::atomic<uint64_t> totalRecoveryUs{0};
+        std::atomic<uint64_t> rotations{0};
+        std::atomic<uint64_t> batchSizes[BatchSizeBuckets]{};
+    } counters;
+    
+#ifndef _WIN32
+    // Fan-out opcional para outros processos
+    std::unique_ptr<ShmPublisher> shmPublisher;
+#endif
+    
+    Impl(WebSocketConfig cfg) : config(std::move(cfg)), topicBook(config.subscriptions) {
+        parsedUrl = parseUrl(config.url);
+        currentUrl.store(&config.url, std::memory_order_relaxed);
+        callbackSnapshot = std::make_unique<CallbackSet>();
+        callbacks.store(callbackSnapshot.get(), std::memory_order_release);
+        if constexpr (P::heartbeat) {
+            heartbeat = std::make_unique<internal::HeartbeatManager>(config.ping);
+        }
+        rxBuffer.resize(64 * 1024);
+    }
+    
+    ~Impl() {
+        disconnect(CloseCode::GoingAway);
+    }
+    
+    // ============================================
+    // Conexão
+    // ============================================
+    bool connect() {
+        if (connected.load(std::memory_order_acquire) || reconnecting.load(std::memory_order_acquire)) {
+            return false;
+        }
+        abortDial.store(false, std::memory_order_release);
+        
+        if (!connectLink()) {
+            return false;
+        }
+        
+        // Supervisor e rotação periódica vivem até disconnect()
+        if constexpr (P::threaded) {
+            if (!supervisorThread.joinable()) {
+                std::lock_guard<std::mutex> lock(supervisorMutex);
+                supervisorStop = false;
+                linkLost = false;
+                supervisorThread = std::thread(&Impl::supervisorLoop, this);
+            }
+            if (!P::memory && config.rotation.interval.count() > 0 && !rotationThread.joinable()) {
+                schedulerStop = false;
+                rotationThread = std::thread(&Impl::rotationScheduler, this);
+            }
+        }
+        return true;
+    }
+    
+    // Disca, assina e ativa um link (connect() e cada reconexão)
+    bool connectLink() {
+        if constexpr (P::memory) {
+            if (!attachPipe()) {
+                return false;
+            }
+        } else {
+            // Inicializa socket
+            if (!initSocket()) {
+                return false;
+            }
+            
+            auto winner = dialEndpoints();
+            if (!winner) {
+                cleanup();
+                return false;
+            }
+            // Como em switchToStandby: nenhum envio vê a troca pela metade
+            std::lock_guard<SendMutex> lock(sendMutex);
+            adoptConnection(*winner);
+        }
+        return activateLink();
+    }
+    
+    // Link já adotado: assinaturas, I/O, heartbeat e onConnect
+    bool activateLink() {
+        linkCloseCode = CloseCode::AbnormalClosure;
+        
+        // ExternalDriven: leituras nunca bloqueiam a thread do caller
+        if constexpr (P::externalDriven) {
+            setNonBlocking();
+        }
+        
+        // Assinaturas saem antes de qualquer send(): subscribe() concorrente
+        // espera aqui e depois já encontra o link conectado
+        {
+            std::lock_guard<CallbackMutex> subscriptions(subscriptionMutex);
+            for (const auto& message : subscriptionList) {
+                sendFrame(Opcode::Text, message);
+            }
+            
+            // Tópicos: o burst sai já; o resto no ritmo, pelo loop de I/O ou poll()
+            topicBook.resetLink(Clock::now());
+            pumpTopicsLocked();
+            
+            // Marca como conectado
+            std::unique_lock lock(stateMutex);
+            connected.store(true, std::memory_order_release);
+            running.store(true, std::memory_order_release);
+            stopped = false;
+        }
+        
+        // Inicia thread de I/O (ExternalDriven: o caller chama poll()).
+        // A anterior já saiu do loop (queda sem reconexão).
+        if constexpr (P::threaded) {
+            if (ioThread.joinable()) {
+                if (ioThread.get_id() == std::this_thread::get_id()) {
+                    ioThread.detach();
+                } else {
+                    ioThread.join();
+                }
+            }
+            ioThread = std::thread(&Impl::ioLoop, this);
+        }
+        
+        // Inicia heartbeat
+        if constexpr (P::heartbeat) {
+            auto sendPing = [this]() { return sendPingFrame(""); };
+            auto sendText = [this](std::string_view msg) { return sendTextMessage(std::string(msg)); };
+            auto onTimeout = [this]() {
+                triggerError(ErrorCode::PingTimeout, "Pong timeout");
+                interruptLink();
+            };
+            if constexpr (P::threaded) {
+                heartbeat->start(sendPing, sendText, onTimeout);
+            } else {
+                heartbeat->startManual(sendPing, sendText, onTimeout);
+            }
+        }
+        
+        // Callback
+        triggerConnect();
+        
+        return true;
+    }
+    
+    // MemoryTransport: o link já nasce pronto (sem upgrade HTTP)
+    bool attachPipe() {
+        constexpr std::string_view scheme = "memory://";
+        std::string_view url = config.url;
+        if (url.substr(0, scheme.size()) != scheme) {
+            triggerError(ErrorCode::InvalidUrl, "MemoryTransport requer URL memory://nome");
+            return false;
+        }
+        auto found = MemoryPipe::find(url.substr(scheme.size()));
+        if (!found || !found->attach()) {
+            triggerError(ErrorCode::ConnectionFailed, "MemoryPipe indisponível: " + config.url);
+            return false;
+        }
+        pipe = std::move(found);
+        rxHead = rxTail = 0;
+        utf8Text.reset();
+        currentUrl.store(&config.url, std::memory_order_release);
+        return true;
+    }
+    
+    // Derruba o link sem fechar o fd: a leitura vê EOF e a reconexão assume
+    void interruptLink() {
+        if constexpr (P::memory) {
+            if (pipe) pipe->hangup();
+            return;
+        }
+        if (socket != SOCKET_ERROR_VALUE) {
+#ifdef _WIN32
+            ::shutdown(socket, SD_BOTH);
+#else
+            ::shutdown(socket, SHUT_RDWR);
+#endif
+        }
+    }
+    
+    // ============================================
+    // Corrida de endpoints
+    // ============================================
+    
+    // Corre url + endpoints; o vencedor sai com a conexão pronta (ou nulo)
+    std::unique_ptr<EndpointDialer> dialEndpoints() {
+        DialOutcome outcome = raceDialers();
+        return settleDial(outcome);
+    }
+    
+    // A corrida em si: não toca callbacks nem o link atual, então pode
+    // rodar fora da thread dona (discagem em segundo plano do poll()).
+    // watched: mesmo um único endpoint corre em raceEndpoints, que
+    // interrompe TLS/upgrade assim que disconnect() liga abortDial
+    DialOutcome raceDialers(bool watched = false) {
+        // connectTimeout cobre DNS, TCP, TLS e o upgrade HTTP
+        const auto raceStart = Clock::now();
+        const auto deadline = raceStart + config.connectTimeout;
+        
+        // Candidatos: url + endpoints equivalentes
+        DialOutcome outcome;
+        auto& dialers = outcome.dialers;
+        if (!config.url.empty()) {
+            dialers.push_back(std::make_unique<EndpointDialer>(config.url));
+        }
+        for (const auto& endpoint : config.endpoints) {
+            dialers.push_back(std::make_unique<EndpointDialer>(endpoint));
+        }
+        
+        std::vector<EndpointDialer*> runnable;
+        for (auto& dialer : dialers) {
+            if (acceptsEndpoint(*dialer)) {
+                runnable.push_back(dialer.get());
+            }
+        }
+        
+        if (runnable.size() == 1 && !watched) {
+            if (runnable[0]->dial(config, raceStart, deadline, &abortDial)) {
+                outcome.winner = runnable[0];
+            }
+        } else if (!runnable.empty()) {
+            outcome.winner = raceEndpoints(runnable, raceStart, deadline);
+        }
+        return outcome;
+    }
+    
+    // Relata a corrida (onEndpointRace/onError) e entrega o vencedor
+    std::unique_ptr<EndpointDialer> settleDial(DialOutcome& outcome) {
+        reportRace(outcome.dialers, outcome.winner);
+        if (!outcome.winner) {
+            reportConnectFailure(outcome.dialers);
+            return nullptr;
+        }
+        for (auto& dialer : outcome.dialers) {
+            if (dialer.get() == outcome.winner) return std::move(dialer);
+        }
+        return nullptr;
+    }
+    
+    // Esquema precisa ser válido e compatível com a política de transporte
+    bool acceptsEndpoint(EndpointDialer& dialer) {
+        auto reject = [&](const char* reason) {
+            dialer.timing.errorCode = ErrorCode::InvalidUrl;
+            dialer.timing.error = reason;
+            return false;
+        };
+        if (!dialer.url.valid()) {
+            return reject("URL inválida");
+        }
+        if constexpr (P::transport == TransportKind::Tcp) {
+            if (dialer.url.secure) return reject("wss:// requer transporte TLS");
+        } else if constexpr (P::transport == TransportKind::Tls) {
+            if (!dialer.url.secure) return reject("ws:// requer transporte TCP");
+        }
+        return true;
+    }
+    
+    // Todos os endpoints em paralelo; o primeiro a completar o upgrade
+    // (menor RTT de handshake) vence e os demais são interrompidos
+    EndpointDialer* raceEndpoints(const std::vector<EndpointDialer*>& racers,
+                                  Clock::time_point raceStart, Clock::time_point deadline) {
+        std::atomic<bool> cancel{false};
+        std::mutex raceMutex;
+        std::condition_variable raceCv;
+        EndpointDialer* winner = nullptr;
+        size_t finished = 0;
+        
+        std::vector<std::thread> threads;
+        threads.reserve(racers.size());
+        for (EndpointDialer* racer : racers) {
+            threads.emplace_back([&, racer]() {
+                bool ok = racer->dial(config, raceStart, deadline, &cancel);
+                std::lock_guard<std::mutex> lock(raceMutex);
+                if (ok && !winner) {
+                    winner = racer;
+                    cancel.store(true, std::memory_order_release);
+                }
+                finished++;
+                raceCv.notify_all();
+            });
+        }
+        
+        {
+            // disconnect() cancela a corrida (verificado em fatias curtas)
+            std::unique_lock<std::mutex> lock(raceMutex);
+            while (!raceCv.wait_for(lock, std::chrono::milliseconds(10),
+                                    [&] { return winner || finished == racers.size(); })) {
+                if (abortDial.load(std::memory_order_acquire)) {
+                    cancel.store(true, std::memory_order_release);
+                }
+            }
+        }
+        
+        // Perdedores presos em TLS/upgrade acordam com shutdown()
+        for (EndpointDialer* racer : racers) {
+            if (racer != winner) racer->interrupt();
+        }
+        for (auto& t : threads) {
+            t.join();
+        }
+        return winner;
+    }
+    
+    void reportRace(const std::vector<std::unique_ptr<EndpointDialer>>& dialers,
+                    const EndpointDialer* winner) {
+        std::vector<EndpointTiming> timings;
+        timings.reserve(dialers.size());
+        for (const auto& dialer : dialers) {
+            EndpointTiming timing = dialer->timing;
+            if (dialer.get() == winner) {
+                timing.outcome = EndpointOutcome::Winner;
+            } else if (timing.outcome != EndpointOutcome::Cancelled && timing.errorCode == 0) {
+                timing.outcome = EndpointOutcome::Slower;
+            }
+            timings.push_back(std::move(timing));
+        }
+        
+        {
+            std::unique_lock lock(stateMutex);
+            lastRace = timings;
+        }
+        
+        CallbackReader reader(*this);
+        const CallbackSet& cbs = *reader;
+        if (cbs.race) {
+            cbs.race(timings);
+        }
+    }
+    
+    void reportConnectFailure(const std::vector<std::unique_ptr<EndpointDialer>>& dialers) {
+        if (dialers.empty()) {
+            triggerError(ErrorCode::InvalidUrl, "URL inválida");
+            return;
+        }
+        if (dialers.size() == 1) {
+            triggerError(dialers[0]->timing.errorCode, dialers[0]->timing.error);
+            return;
+        }
+        
+        bool allTimedOut = true;
+        std::string message = "Nenhum endpoint conectou:";
+        for (const auto& dialer : dialers) {
+            allTimedOut = allTimedOut && dialer->timing.errorCode == ErrorCode::Timeout;
+            message += " " + dialer->rawUrl + " (" + dialer->timing.error + ");";
+        }
+        message.pop_back();
+        triggerError(allTimedOut ? ErrorCode::Timeout : ErrorCode::ConnectionFailed, message);
+    }
+    
+    // Troca a conexão atual pela do dialer (que fica com a antiga para fechar).
+    // Exige sendMutex
+    void adoptConnection(EndpointDialer& dialer) {
+        std::swap(socket, dialer.socket);
+        std::swap(ssl, dialer.ssl);
+        dialer.liveSocket.store(dialer.socket, std::memory_order_release);
+        
+        rxBuffer.swap(dialer.rx);
+        std::swap(rxHead, dialer.rxHead);
+        std::swap(rxTail, dialer.rxTail);
+        std::swap(utf8Text, dialer.utf8);
+        
+        parsedUrl = dialer.url;
+        currentUrl.store(&dialer.rawUrl, std::memory_order_release);
+    }
+    
+    void disconnect(int code) {
+        // Supervisor primeiro: nenhuma reconexão começa depois daqui
+        abortDial.store(true, std::memory_order_release);
+        if constexpr (P::threaded) {
+            stopSupervisor();
+        } else {
+            abandonDial();
+        }
+        
+        bool wasConnected = connected.exchange(false, std::memory_order_acq_rel);
+        running.store(false, std::memory_order_release);
+        reconnecting.store(false, std::memory_order_release);
+        
+        // Para heartbeat
+        if (heartbeat) {
+            heartbeat->stop();
+        }
+        
+        // Envia close frame
+        if (wasConnected) {
+            sendCloseFrame(code);
+        }
+        
+        // Aguarda thread (um callback pode chamar disconnect() de dentro dela)
+        if (ioThread.joinable() && ioThread.get_id() != std::this_thread::get_id()) {
+            ioThread.join();
+        }
+        
+        // Para a rotação periódica (e acorda um rotate() em andamento)
+        if constexpr (P::threaded) {
+            {
+                std::lock_guard<std::mutex> lock(rotation.mutex);
+                rotation.cv.notify_all();
+            }
+            {
+                std::lock_guard<std::mutex> lock(schedulerMutex);
+                schedulerStop = true;
+            }
+            schedulerCv.notify_all();
+            if (rotationThread.joinable() && rotationThread.get_id() != std::this_thread::get_id()) {
+                rotationThread.join();
+            }
+        }
+        
+        // Limpa recursos
+        cleanup();
+        notifyStopped();
+        
+        // Callback
+        if (wasConnected) {
+            triggerDisconnect(code);
+        }
+    }
+    
+    // wait(): até disconnect() ou o fim das tentativas de reconexão
+    void waitStopped() {
+        std::unique_lock lock(stateMutex);
+        waitCv.wait(lock, [this] { return stopped; });
+    }
+    
+    void notifyStopped() {
+        {
+            std::unique_lock lock(stateMutex);
+            stopped = true;
+        }
+        waitCv.notify_all();
+    }
+    
+    // ============================================
+    // Reconexão
+    // ============================================
+    
+    // Espera antes da tentativa n (1-based): a primeira usa
+    // reconnectFirstDelay; as demais, jitter total sobre base * 2^(n-2)
+    std::chrono::milliseconds backoffDelay(int attempt) {
+        if (attempt <= 1) {
+            return config.reconnectFirstDelay;
+        }
+        const int64_t base = std::max<int64_t>(config.reconnectBaseDelay.count(), 0);
+        const int64_t cap = std::max<int64_t>(config.reconnectMaxDelay.count(), 0);
+        const int shift = std::min(attempt - 2, 30);
+        const int64_t ceiling = base > (cap >> shift) ? cap : base << shift;
+        std::uniform_int_distribution<int64_t> jitter(0, ceiling);
+        return std::chrono::milliseconds(jitter(jitterRng));
+    }
+    
+    bool attemptsLeft(int attempts) const {
+        return config.autoReconnect &&
+               (config.maxReconnectAttempts < 0 || attempts < config.maxReconnectAttempts);
+    }
+    
+    // Link caiu (thread de I/O ou poll()): agenda a reconexão ou encerra
+    void handleDisconnect(int code) {
+        connected.store(false, std::memory_order_release);
+        if (heartbeat) {
+            heartbeat->stop();
+        }
+        
+        if (!attemptsLeft(0)) {
+            giveUp(code);
+            return;
+        }
+        
+        // wait() continua bloqueado: stopped só muda em giveUp()/disconnect()
+        reconnecting.store(true, std::memory_order_release);
+        running.store(false, std::memory_order_release);
+        
+        if constexpr (P::threaded) {
+            {
+                std::lock_guard<std::mutex> lock(rotation.mutex);
+                rotation.cv.notify_all();
+            }
+            // A thread de I/O sai do loop; o supervisor faz o resto
+            std::lock_guard<std::mutex> lock(supervisorMutex);
+            linkLost = true;
+            lostCode = code;
+            lostAt = Clock::now();
+            supervisorCv.notify_all();
+        } else {
+            cleanup();
+            lostCode = code;
+            lostAt = Clock::now();
+            pendingAttempts = 0;
+            nextAttemptAt = lostAt + backoffDelay(1);
+        }
+    }
+    
+    // Sem reconexão (ou tentativas esgotadas): a queda vira desconexão
+    // definitiva. wait() só retorna depois de onDisconnect.
+    void giveUp(int code) {
+        running.store(false, std::memory_order_release);
+        if constexpr (P::threaded) {
+            std::lock_guard<std::mutex> lock(rotation.mutex);
+            rotation.cv.notify_all();
+        }
+        triggerDisconnect(code);
+        reconnecting.store(false, std::memory_order_release);
+        notifyStopped();
+    }
+    
+    void recordRecovery(int attempts, Clock::time_point since) {
+        reconnecting.store(false, std::memory_order_release);
+        const auto downtime = elapsedSince(since);
+        
+        if constexpr (P::metrics) {
+            const auto us = static_cast<uint64_t>(downtime.count());
+            bump(counters.reconnects);
+            counters.lastRecoveryUs.store(us, std::memory_order_relaxed);
+            bump(counters.totalRecoveryUs, us);
+            if (us > counters.maxRecoveryUs.load(std::memory_order_relaxed)) {
+                counters.maxRecoveryUs.store(us, std::memory_order_relaxed);
+            }
+        }
+        
+        CallbackReader reader(*this);
+        const CallbackSet& cbs = *reader;
+        if (cbs.reconnect) {
+            cbs.reconnect(attempts, downtime);
+        }
+    }
+    
+    // Uma tentativa de reconexão (supervisor ou poll())
+    bool reconnectOnce() {
+        if constexpr (P::metrics) {
+            bump(counters.reconnectAttempts);
+        }
+        return connectLink();
+    }
+    
+    void supervisorLoop() {
+        std::unique_lock<std::mutex> lock(supervisorMutex);
+        for (;;) {
+            supervisorCv.wait(lock, [this] { return supervisorStop || linkLost; });
+            if (supervisorStop) return;
+            linkLost = false;
+            const int code = lostCode;
+            const auto since = lostAt;
+            lock.unlock();
+            recover(code, since);
+            lock.lock();
+        }
+    }
+    
+    // Supervisor: junta a thread de I/O que caiu e reconecta com backoff
+    void recover(int code, Clock::time_point since) {
+        if (ioThread.joinable()) {
+            ioThread.join();
+        }
+        cleanup();
+        
+        int attempts = 0;
+        while (attemptsLeft(attempts)) {
+            const auto delay = backoffDelay(++attempts);
+            {
+                std::unique_lock<std::mutex> lock(supervisorMutex);
+                if (supervisorCv.wait_for(lock, delay, [this] { return supervisorStop; })) {
+                    return;
+                }
+            }
+            if (reconnectOnce()) {
+                recordRecovery(attempts, since);
+                return;
+            }
+            if (abortDial.load(std::memory_order_acquire)) {
+                return;
+            }
+        }
+        giveUp(code);
+    }
+    
+    void stopSupervisor() {
+        {
+            std::lock_guard<std::mutex> lock(supervisorMutex);
+            supervisorStop = true;
+        }
+        supervisorCv.notify_all();
+        if (supervisorThread.joinable() && supervisorThread.get_id() != std::this_thread::get_id()) {
+            supervisorThread.join();
+        }
+    }
+    
+    // ExternalDriven: poll() dispara a tentativa quando o backoff vence e,
+    // nas chamadas seguintes, adota o link discado em segundo plano.
+    // Nunca bloqueia além de timeoutMs
+    void pumpReconnect(int timeoutMs) {
+        if (dialThread.joinable()) {
+            const auto wait = std::chrono::milliseconds(std::max(timeoutMs, 0));
+            if (pendingDial.wait_for(wait) != std::future_status::ready) return;
+            dialThread.join();
+            DialOutcome outcome = pendingDial.get();
+            finishAttempt(adoptDial(outcome));
+            return;
+        }
+        
+        auto now = Clock::now();
+        if (now < nextAttemptAt) {
+            if (timeoutMs == 0) return;
+            std::this_thread::sleep_for(std::min<Clock::duration>(nextAttemptAt - now,
+                                                                  std::chrono::milliseconds(timeoutMs)));
+            if (Clock::now() < nextAttemptAt) return;
+        }
+        
+        ++pendingAttempts;
+        if constexpr (P::memory) {
+            // attachPipe não bloqueia: a tentativa roda aqui mesmo
+            finishAttempt(reconnectOnce());
+        } else {
+            if constexpr (P::metrics) {
+                bump(counters.reconnectAttempts);
+            }
+            if (!initSocket()) {
+                finishAttempt(false);
+                return;
+            }
+            std::promise<DialOutcome> result;
+            pendingDial = result.get_future();
+            dialThread = std::thread([this, result = std::move(result)]() mutable {
+                result.set_value(raceDialers(true));
+            });
+        }
+    }
+    
+    // Corrida em segundo plano terminou: relata e ativa o vencedor aqui,
+    // na thread de poll(), como faria connectLink()
+    bool adoptDial(DialOutcome& outcome) {
+        auto winner = settleDial(outcome);
+        if (!winner) {
+            cleanup();
+            return false;
+        }
+        {
+            std::lock_guard<SendMutex> lock(sendMutex);
+            adoptConnection(*winner);
+        }
+        return activateLink();
+    }
+    
+    void finishAttempt(bool ok) {
+        if (ok) {
+            recordRecovery(pendingAttempts, lostAt);
+            return;
+        }
+        if (!attemptsLeft(pendingAttempts)) {
+            giveUp(lostCode);
+            return;
+        }
+        nextAttemptAt = Clock::now() + backoffDelay(pendingAttempts + 1);
+    }
+    
+    // disconnect(): abortDial já está ligado, a corrida desiste em ~10 ms
+    // e as conexões que ela abriu fecham junto com o resultado descartado
+    void abandonDial() {
+        if (dialThread.joinable()) {
+            dialThread.join();
+            pendingDial = {};
+        }
+    }
+    
+    // ============================================
+    // Assinaturas
+    // ============================================
+    bool subscribe(std::string_view message) {
+        std::lock_guard<CallbackMutex> lock(subscriptionMutex);
+        if (std::find(subscriptionList.begin(), subscriptionList.end(), message) == subscriptionList.end()) {
+            subscriptionList.emplace_back(message);
+        }
+        return connected.load(std::memory_order_acquire) && sendFrame(Opcode::Text, message);
+    }
+    
+    bool unsubscribe(std::string_view message, std::string_view unsubscribeMessage) {
+        std::lock_guard<CallbackMutex> lock(subscriptionMutex);
+        auto it = std::find(subscriptionList.begin(), subscriptionList.end(), message);
+        if (it == subscriptionList.end()) {
+            return false;
+        }
+        subscriptionList.erase(it);
+        if (!unsubscribeMessage.empty() && connected.load(std::memory_order_acquire)) {
+            sendFrame(Opcode::Text, unsubscribeMessage);
+        }
+        return true;
+    }
+    
+    std::vector<std::string> subscriptions() const {
+        std::lock_guard<CallbackMutex> lock(subscriptionMutex);
+        return subscriptionList;
+    }
+    
+    bool subscribeTopics(const std::vector<std::string>& topics) {
+        if (!config.subscriptions.encode) {
+            return false;
+        }
+        std::lock_guard<CallbackMutex> lock(subscriptionMutex);
+        topicBook.add(topics);
+        if (connected.load(std::memory_order_acquire)) {
+            pumpTopicsLocked();
+        }
+        return true;
+    }
+    
+    bool unsubscribeTopics(const std::vector<std::string>& topics) {
+        if (!config.subscriptions.encode) {
+            return false;
+        }
+        std::lock_guard<CallbackMutex> lock(subscriptionMutex);
+        topicBook.remove(topics);
+        if (connected.load(std::memory_order_acquire)) {
+            pumpTopicsLocked();
+        }
+        return true;
+    }
+    
+    std::vector<std::string> topics() const {
+        std::lock_guard<CallbackMutex> lock(subscriptionMutex);
+        return topicBook.active();
+    }
+    
+    // Exige subscriptionMutex: envia no link atual o que o ritmo permitir
+    void pumpTopicsLocked() {
+        topicBook.pump(Clock::now(), [this](std::string_view message) {
+            return sendFrame(Opcode::Text, message);
+        });
+        topicsPending.store(topicBook.pending(), std::memory_order_relaxed);
+    }
+    
+    // Loop de I/O e poll(): lotes que esperavam o ritmo
+    void pumpTopics() {
+        if (!topicsPending.load(std::memory_order_relaxed) || !connected.load(std::memory_order_acquire)) {
+            return;
+        }
+        std::lock_guard<CallbackMutex> lock(subscriptionMutex);
+        pumpTopicsLocked();
+    }
+    
+    // Encurta a espera por dados até o próximo lote poder sair
+    int topicWaitMs(int timeoutMs) {
+        if (!topicsPending.load(std::memory_order_relaxed)) {
+            return timeoutMs;
+        }
+        std::lock_guard<CallbackMutex> lock(subscriptionMutex);
+        int due = topicBook.waitMs(Clock::now());
+        if (due < 0) {
+            return timeoutMs;
+        }
+        due = std::max(due, 1);
+        return timeoutMs < 0 ? due : std::min(timeoutMs, due);
+    }
+    
+    // ============================================
+    // Envio
+    // ============================================
+    bool send(std::string_view message) {
+        if (!connected.load(std::memory_order_acquire)) {
+            return false;
+        }
+        return sendFrame(Opcode::Text, message);
+    }
+    
+    bool sendBinary(const void* data, size_t size) {
+        if (!connected.load(std::memory_order_acquire)) {
+            return false;
+        }
+        return sendFrame(Opcode::Binary, std::string_view(static_cast<const char*>(data), size));
+    }
+    
+    template<typename Mutate>
+    void updateCallbacks(Mutate&& mutate) {
+        std::vector<std::unique_ptr<CallbackSet>> reclaimed;
+        {
+            std::lock_guard<CallbackMutex> lock(callbackMutex);
+            auto next = std::make_unique<CallbackSet>(*callbackSnapshot);
+            mutate(*next);
+            callbacks.store(next.get(), std::memory_order_seq_cst);
+            retiredCallbacks.push_back(std::move(callbackSnapshot));
+            callbackSnapshot = std::move(next);
+            callbacksRetired.store(true, std::memory_order_relaxed);
+            takeRetiredCallbacks(reclaimed, 0);
+        }
+        // Captures destruídas fora do lock (podem chamar um setter)
+    }
+    
+    // Ponto quiescente do loop de despacho (topo de ioLoop / poll()), que
+    // detém ownScopes DispatchScopes e nenhum snapshot
+    void reclaimCallbacks(uint32_t ownScopes) {
+        if (!callbacksRetired.load(std::memory_order_relaxed)) {
+            return;
+        }
+        std::vector<std::unique_ptr<CallbackSet>> reclaimed;
+        std::unique_lock<CallbackMutex> lock(callbackMutex, std::try_to_lock);
+        if (lock.owns_lock()) {
+            takeRetiredCallbacks(reclaimed, ownScopes);
+            lock.unlock();
+        }
+    }
+    
+    // Sob callbackMutex, depois do store do snapshot atual. Sem leitores
+    // nem outros loops ativos, quem ler depois já vê o atual: os
+    // aposentados estão livres
+    void takeRetiredCallbacks(std::vector<std::unique_ptr<CallbackSet>>& out, uint32_t ownScopes) {
+        if (callbackReaders.load(std::memory_order_seq_cst) != 0 ||
+            callbackDispatchers.load(std::memory_order_seq_cst) != ownScopes) {
+            return;
+        }
+        out.swap(retiredCallbacks);
+        callbacksRetired.store(false, std::memory_order_relaxed);
+    }
+    
+    void sendAsync(std::string_view message) {
+        sendQueue.push(std::string(message));
+    }
+    
+    bool sendPingFrame(std::string_view payload) {
+        if (!connected.load(std::memory_order_acquire)) {
+            return false;
+        }
+        return sendFrame(Opcode::Ping, payload);
+    }
+    
+    bool sendPongFrame(std::string_view payload) {
+        if (!connected.load(std::memory_order_acquire)) {
+            return false;
+        }
+        return sendFrame(Opcode::Pong, payload);
+    }
+    
+    bool sendTextMessage(const std::string& msg) {
+        return send(msg);
+    }
+    
+    // ============================================
+    // ExternalDriven
+    // ============================================
+    size_t pollFrames(size_t budget, int timeoutMs) {
+        if (reconnecting.load(std::memory_order_relaxed)) {
+            pumpReconnect(timeoutMs);
+            return 0;
+        }
+        if (!running.load(std::memory_order_acquire)) {
+            return 0;
+        }
+        reclaimCallbacks(0);
+        DispatchScope scope(*this);
+        
+        // Envios pendentes saem antes de despachar novos frames
+        while (auto msg = sendQueue.pop()) {
+            send(*msg);
+        }
+        pumpTopics();
+        
+        if constexpr (P::heartbeat) {
+            heartbeat->tick(std::chrono::steady_clock::now());
+        }
+        
+        // Frames que já estavam no buffer (budget anterior esgotado)
+        size_t dispatched = 0;
+        bool alive = dispatchFrames(budget, dispatched);
+        bool waited = false;
+        
+        while (alive && dispatched < budget) {
+            RecvStatus status = fillRx();
+            if (status == RecvStatus::WouldBlock) {
+                // Só espera se nada foi processado nesta chamada
+                if (dispatched > 0 || waited || timeoutMs == 0) break;
+                waited = true;
+                if (!waitForData(topicWaitMs(timeoutMs))) break;
+                continue;
+            }
+            if (status == RecvStatus::Closed) {
+                alive = false;
+                break;
+            }
+            alive = dispatchFrames(budget, dispatched);
+        }
+        
+        if (!alive && connected.load(std::memory_order_acquire)) {
+            handleDisconnect(linkCloseCode);
+        }
+        return dispatched;
+    }
+    
+    bool hasBufferedData() const noexcept {
+        return rxTail > rxHead || hasBufferedTlsData();
+    }
+    
+    // ============================================
+    // Rotação make-before-break
+    // ============================================
+    bool rotateConnection() {
+        std::lock_guard<std::mutex> serial(rotateMutex);
+        if (!config.rotation.key) {
+            triggerError(ErrorCode::RotationFailed, "RotationConfig::key não definido");
+            return false;
+        }
+        if (!connected.load(std::memory_order_acquire)) {
+            triggerError(ErrorCode::RotationFailed, "Sem conexão para rotacionar");
+            return false;
+        }
+        
+        // Link atual passa a registrar as chaves que entrega. O novo só disca
+        // depois da primeira registrada: é a âncora que ele vai repetir se
+        // começar atrás (e o atual cair antes de entregar mais alguma)
+        {
+            std::unique_lock<std::mutex> lock(rotation.mutex);
+            resetRotation();
+            rotation.active = true;
+            rotating.store(true, std::memory_order_release);
+            rotation.cv.wait_for(lock, config.rotation.overlapTimeout, [this] {
+                return !rotation.deliveredOrder.empty() || rotation.takeover ||
+                       !running.load(std::memory_order_acquire);
+            });
+        }
+        
+        const char* failure = nullptr;
+        auto standby = dialEndpoints();
+        if (!standby) {
+            failure = "Novo link não conectou";
+        } else {
+            if (config.rotation.subscribe) {
+                config.rotation.subscribe([&standby](std::string_view message) {
+                    return standby->sendFrame(Opcode::Text, message);
+                });
+            } else {
+                for (const auto& message : subscriptions()) {
+                    standby->sendFrame(Opcode::Text, message);
+                }
+            }
+            subscribeStandbyTopics(*standby);
+            failure = alignStandby(*standby);
+        }
+        
+        std::unique_lock<std::mutex> lock(rotation.mutex);
+        if (!failure) {
+            // A thread de I/O troca de link na próxima volta do loop
+            rotation.standby = std::move(standby);
+            handoffReady.store(true, std::memory_order_release);
+            rotation.cv.notify_all();
+            rotation.cv.wait(lock, [this] {
+                return rotation.switched || !running.load(std::memory_order_acquire);
+            });
+            if (rotation.switched) {
+                return true;
+            }
+            failure = "Conexão encerrada durante a rotação";
+        }
+        
+        handoffReady.store(false, std::memory_order_release);
+        resetRotation();
+        rotation.cv.notify_all();
+        lock.unlock();
+        
+        triggerError(ErrorCode::RotationFailed, failure);
+        return false;
+    }
+
+private:
+    // ============================================
+    // Socket Init
+    // ============================================
+    bool initSocket() {
+#ifdef _WIN32
+        WSADATA wsaData;
+        if (WSAStartup(MAKEWORD(2, 2), &wsaData) != 0) {
+            triggerError(ErrorCode::ConnectionFailed, "WSAStartup falhou");
+            return false;
+        }
+#endif
+        
+        return true;
+    }
+    
+    // ============================================
+    // I/O Loop
+    // ============================================
+    void ioLoop() {
+        // Aplica CPU affinity se configurado
+        if (pinnedCore >= 0) {
+            internal::pinCurrentThread(pinnedCore);
+        }
+        
+        DispatchScope scope(*this);
+        while (running.load(std::memory_order_acquire)) {
+            reclaimCallbacks(1);
+            
+            // Processa fila de envio assíncrono
+            while (auto msg = sendQueue.pop()) {
+                send(*msg);
+            }
+            pumpTopics();
+            
+            // Rotação: novo link alinhado esperando a troca
+            if (handoffReady.load(std::memory_order_acquire)) {
+                switchToStandby();
+            }
+            
+            // Despacha frames completos já no buffer (ex: vindos com o handshake)
+            size_t dispatched = 0;
+            if (!dispatchFrames(std::numeric_limits<size_t>::max(), dispatched)) {
+                if (connected.load(std::memory_order_acquire)) {
+                    handleDisconnect(linkCloseCode);
+                }
+                break;
             }
             
-            // Verifica dados disponíveis
-            if (!waitForData(100)) {
+            // Verifica dados disponíveis (durante a rotação, acorda mais cedo para a troca)
+            if (!hasBufferedTlsData() && !waitForData(topicWaitMs(rotating.load(std::memory_order_relaxed) ? 10 : 100))) {
                 continue;
             }
             
-            // Lê frame
-            if (!readFrame(frameBuffer)) {
+            // Uma leitura traz quantos frames couberem no buffer
+            if (fillRx() == RecvStatus::Closed) {
+                if (rotating.load(std::memory_order_acquire) && takeOverStandby()) {
+                    continue;
+                }
                 if (connected.load(std::memory_order_acquire)) {
-                    handleDisconnect();
+                    handleDisconnect(linkCloseCode);
                 }
                 break;
             }
         }
     }
     
+    // Registros TLS já decifrados não aparecem no poll() do socket
+    bool hasBufferedTlsData() const noexcept {
+        if constexpr (P::tlsPossible) {
+            return ssl && SSL_pending(ssl) > 0;
+        }
+        return false;
+    }
+    
     bool waitForData(int timeoutMs) {
+        if constexpr (P::memory) {
+            return pipe && pipe->waitReadable(timeoutMs);
+        }
 #ifdef _WIN32
         fd_set readSet;
         FD_ZERO(&readSet);
@@ -489,78 +1920,147 @@ private:
         pollfd pfd;
         pfd.fd = socket;
         pfd.events = POLLIN;
-        return poll(&pfd, 1, timeoutMs) > 0 && (pfd.revents & POLLIN);
+        return ::poll(&pfd, 1, timeoutMs) > 0 && (pfd.revents & (POLLIN | POLLHUP | POLLERR));
 #endif
     }
     
-    bool readFrame(std::vector<char>& buffer) {
-        // Lê header (2 bytes mínimo)
-        uint8_t header[2];
-        if (rawRecv(reinterpret_cast<char*>(header), 2) != 2) {
-            return false;
+    // ============================================
+    // Buffer de recepção
+    // ============================================
+    
+    // Decodifica e despacha frames completos do buffer, até o budget.
+    // @return false se a conexão terminou (Close ou erro de protocolo)
+    bool dispatchFrames(size_t budget, size_t& dispatched) {
+        bool alive = true;
+        while (dispatched < budget && running.load(std::memory_order_relaxed)) {
+            FrameStatus status = decodeFrame();
+            if (status == FrameStatus::Incomplete) break;
+            if (status == FrameStatus::Stop) {
+                alive = false;
+                break;
+            }
+            dispatched++;
         }
-        
-        bool fin = (header[0] & 0x80) != 0;
-        uint8_t opcode = header[0] & 0x0F;
-        bool masked = (header[1] & 0x80) != 0;
-        uint64_t payloadLen = header[1] & 0x7F;
-        
-        // Lê payload length estendido
-        if (payloadLen == 126) {
-            uint8_t lenBytes[2];
-            if (rawRecv(reinterpret_cast<char*>(lenBytes), 2) != 2) return false;
-            payloadLen = (static_cast<uint64_t>(lenBytes[0]) << 8) | lenBytes[1];
-        } else if (payloadLen == 127) {
-            uint8_t lenBytes[8];
-            if (rawRecv(reinterpret_cast<char*>(lenBytes), 8) != 8) return false;
-            payloadLen = 0;
-            for (int i = 0; i < 8; ++i) {
-                payloadLen = (payloadLen << 8) | lenBytes[i];
+        // Antes da próxima leitura (que pode compactar o buffer sob as views)
+        flushBatch();
+        return alive;
+    }
+    
+    // Entrega o lote da leitura atual e registra seu tamanho
+    void flushBatch() {
+        if (batchCount == 0) {
+            return;
+        }
+        if constexpr (P::metrics) {
+            size_t bucket = 0;
+            while (bucket + 1 < BatchSizeBuckets && (batchCount >> (bucket + 1)) != 0) {
+                bucket++;
             }
+            bump(counters.batchSizes[bucket]);
         }
+        batchCount = 0;
         
-        // Verifica tamanho máximo
-        if (payloadLen > config.maxMessageSize) {
-            triggerError(ErrorCode::MessageTooLarge, "Mensagem muito grande");
-            return false;
+        if (batchViews.empty()) {
+            return;
         }
-        
-        // Lê mask key (se masked)
-        uint8_t maskKey[4] = {0};
-        if (masked) {
-            if (rawRecv(reinterpret_cast<char*>(maskKey), 4) != 4) return false;
+        const CallbackSet& cbs = dispatchCallbacks();
+        if (cbs.batch) {
+            cbs.batch(MessageBatch{batchViews.data(), batchViews.size(), batchStart});
+        }
+        batchViews.clear();
+    }
+    
+    // Lê do transporte para o fim do buffer (uma chamada de recv/SSL_read)
+    RecvStatus fillRx() {
+        if (rxHead == rxTail) {
+            rxHead = rxTail = 0;
+        }
+        if (rxBuffer.size() - rxTail < MinRecvSpace) {
+            reserveRx(rxTail - rxHead + MinRecvSpace);
         }
         
-        // Lê payload
-        buffer.resize(payloadLen);
-        if (payloadLen > 0) {
-            size_t totalRead = 0;
-            while (totalRead < payloadLen) {
-                ssize_t n = rawRecv(buffer.data() + totalRead, payloadLen - totalRead);
-                if (n <= 0) return false;
-                totalRead += n;
-            }
-            
-            // Aplica unmask
-            if (masked) {
-                for (size_t i = 0; i < payloadLen; ++i) {
-                    buffer[i] ^= maskKey[i % 4];
+        ssize_t n = rawRecv(rxBuffer.data() + rxTail, rxBuffer.size() - rxTail);
+        if (n > 0) {
+            rxTail += static_cast<size_t>(n);
+            return RecvStatus::Data;
+        }
+        return n < 0 && wouldBlock(n) ? RecvStatus::WouldBlock : RecvStatus::Closed;
+    }
+    
+    // Garante `bytes` contíguos a partir de rxHead (compacta e/ou cresce).
+    // O lote pendente aponta para o buffer: sai antes de ele mudar
+    void reserveRx(size_t bytes) {
+        flushBatch();
+        if (rxHead > 0) {
+            std::memmove(rxBuffer.data(), rxBuffer.data() + rxHead, rxTail - rxHead);
+            rxTail -= rxHead;
+            rxHead = 0;
+        }
+        if (rxBuffer.size() < bytes) {
+            rxBuffer.resize(std::max(bytes, rxBuffer.size() * 2));
+        }
+    }
+    
+    FrameStatus decodeFrame() {
+        FrameView frame;
+        switch (parseFrame(rxBuffer.data() + rxHead, rxTail - rxHead, config.maxMessageSize, frame)) {
+            case ParseStatus::Incomplete:
+                // Header já lido: garante espaço para o frame inteiro
+                if (frame.length > 0 && rxBuffer.size() - rxHead < frame.length) {
+                    reserveRx(frame.length);
                 }
-            }
+                return FrameStatus::Incomplete;
+            case ParseStatus::TooLarge:
+                triggerError(ErrorCode::MessageTooLarge, "Mensagem muito grande");
+                return FrameStatus::Stop;
+            case ParseStatus::Complete:
+                break;
         }
+        rxHead += frame.length;
+        
+        // Processa baseado no opcode (view válida até a próxima leitura)
+        std::string_view payload = frame.payload;
         
-        // Processa baseado no opcode
-        std::string_view payload(buffer.data(), buffer.size());
+        if constexpr (P::metrics) {
+            bump(counters.framesReceived);
+        }
         
-        switch (opcode) {
+        switch (frame.opcode) {
             case Opcode::Text:
+                // RFC 6455 §8.1: texto deve ser UTF-8 válido. Sem remontagem, a
+                // validação segue pelos fragmentos (caractere pode cruzar um)
+                if (config.validateUtf8) {
+                    utf8Text.reset();
+                    if (!utf8Text.feed(payload.data(), payload.size(), frame.fin)) {
+                        failConnection(CloseCode::InvalidPayload, ErrorCode::InvalidFrame, "UTF-8 inválido em frame de texto");
+                        return FrameStatus::Stop;
+                    }
+                }
+                handleMessage(payload, false);
+                break;
+                
+            case Opcode::Continuation:
+                // Não entregue, mas a de uma mensagem de texto também é validada
+                if (config.validateUtf8 && utf8Text.active() &&
+                    !utf8Text.feed(payload.data(), payload.size(), frame.fin)) {
+                    failConnection(CloseCode::InvalidPayload, ErrorCode::InvalidFrame, "UTF-8 inválido em frame de texto");
+                    return FrameStatus::Stop;
+                }
+                break;
+                
             case Opcode::Binary:
-                handleMessage(payload);
+                handleMessage(payload, true);
                 break;
                 
             case Opcode::Close:
+                if constexpr (P::threaded) {
+                    // Fechamento programado no meio da rotação: segue no novo link
+                    if (rotating.load(std::memory_order_acquire) && takeOverStandby()) {
+                        return FrameStatus::Dispatched;
+                    }
+                }
                 handleClose(payload);
-                return false;
+                return FrameStatus::Stop;
                 
             case Opcode::Ping:
                 handlePing(payload);
@@ -574,75 +2074,110 @@ private:
                 break;
         }
         
-        return true;
+        return FrameStatus::Dispatched;
     }
     
     // ============================================
     // Frame Sending
     // ============================================
+    // OwnThread: threads de usuário, heartbeat e auto-pong publicam o frame
+    // e um só escritor envia o lote; ExternalDriven escreve direto
     bool sendFrame(uint8_t opcode, std::string_view payload) {
-        std::lock_guard<std::mutex> lock(sendMutex);
-        
-        std::vector<uint8_t> frame;
-        frame.reserve(14 + payload.size());
-        
-        // Header
-        frame.push_back(0x80 | opcode);  // FIN + opcode
-        
-        // Payload length + mask bit (client sempre mascara)
-        if (payload.size() < 126) {
-            frame.push_back(0x80 | static_cast<uint8_t>(payload.size()));
-        } else if (payload.size() <= 65535) {
-            frame.push_back(0x80 | 126);
-            frame.push_back(static_cast<uint8_t>((payload.size() >> 8) & 0xFF));
-            frame.push_back(static_cast<uint8_t>(payload.size() & 0xFF));
+        if constexpr (P::threaded) {
+            internal::SendRequest request;
+            request.opcode = opcode;
+            request.payload = payload;
+            return sendCombiner.submit(request, [this](internal::SendRequest* batch) {
+                return flushRequests(batch);
+            });
         } else {
-            frame.push_back(0x80 | 127);
-            for (int i = 7; i >= 0; --i) {
-                frame.push_back(static_cast<uint8_t>((payload.size() >> (i * 8)) & 0xFF));
-            }
+            std::lock_guard<SendMutex> lock(sendMutex);
+            return writeFrame(opcode, payload);
         }
-        
-        // Mask key
-        std::random_device rd;
-        std::mt19937 gen(rd());
-        std::uniform_int_distribution<> dis(0, 255);
-        uint8_t maskKey[4];
-        for (auto& b : maskKey) {
-            b = static_cast<uint8_t>(dis(gen));
-            frame.push_back(b);
+    }
+    
+    // Escritor da vez: todos os pedidos pendentes numa única escrita
+    bool flushRequests(internal::SendRequest* batch) {
+        combineBuffer.clear();
+        size_t total = 0;
+        for (internal::SendRequest* request = batch; request; request = request->next) {
+            total += MaxFrameHeader + request->payload.size();
         }
-        
-        // Masked payload
-        for (size_t i = 0; i < payload.size(); ++i) {
-            frame.push_back(static_cast<uint8_t>(payload[i]) ^ maskKey[i % 4]);
+        combineBuffer.reserve(total);
+        for (internal::SendRequest* request = batch; request; request = request->next) {
+            appendFrame(request->opcode, request->payload, combineBuffer);
+            countSent(request->opcode, request->payload.size());
         }
         
+        // sendMutex só disputado com Close e troca de link (rotação)
+        std::lock_guard<SendMutex> lock(sendMutex);
+        return rawSend(reinterpret_cast<const char*>(combineBuffer.data()), combineBuffer.size());
+    }
+    
+    // Exige sendMutex
+    bool writeFrame(uint8_t opcode, std::string_view payload) {
+        std::vector<uint8_t> frame;
+        encodeFrame(opcode, payload, frame);
+        countSent(opcode, payload.size());
         return rawSend(reinterpret_cast<const char*>(frame.data()), frame.size());
     }
     
+    void countSent(uint8_t opcode, size_t bytes) {
+        if constexpr (P::metrics) {
+            if (opcode == Opcode::Text || opcode == Opcode::Binary) {
+                bump(counters.messagesSent);
+                bump(counters.bytesSent, bytes);
+            }
+        }
+    }
+    
     void sendCloseFrame(int code) {
+        std::lock_guard<SendMutex> lock(sendMutex);
+        writeCloseFrame(code);
+    }
+    
+    // Exige sendMutex
+    void writeCloseFrame(int code) {
         uint8_t payload[2] = {
             static_cast<uint8_t>((code >> 8) & 0xFF),
             static_cast<uint8_t>(code & 0xFF)
         };
-        sendFrame(Opcode::Close, std::string_view(reinterpret_cast<char*>(payload), 2));
+        writeFrame(Opcode::Close, std::string_view(reinterpret_cast<char*>(payload), 2));
     }
     
     // ============================================
     // Raw I/O
     // ============================================
     bool rawSend(const char* data, size_t len) {
+        if constexpr (P::metrics) {
+            bump(counters.sendWrites);
+        }
+        if constexpr (P::memory) {
+            return pipe && pipe->send(data, len) == static_cast<std::ptrdiff_t>(len);
+        }
+        if (socket == SOCKET_ERROR_VALUE) {
+            return false;   // Link já fechado por cleanup()
+        }
         size_t totalSent = 0;
         while (totalSent < len) {
             ssize_t sent;
-            if (ssl) {
+            if constexpr (P::transport == TransportKind::Tcp) {
+                sent = ::send(socket, data + totalSent, len - totalSent, SEND_FLAGS);
+            } else if constexpr (P::transport == TransportKind::Tls) {
+                sent = SSL_write(ssl, data + totalSent, static_cast<int>(len - totalSent));
+            } else if (ssl) {
                 sent = SSL_write(ssl, data + totalSent, static_cast<int>(len - totalSent));
             } else {
-                sent = ::send(socket, data + totalSent, len - totalSent, 0);
+                sent = ::send(socket, data + totalSent, len - totalSent, SEND_FLAGS);
             }
             
             if (sent <= 0) {
+                // Socket não bloqueante (ExternalDriven): envio termina inline
+                if constexpr (P::externalDriven) {
+                    if (sent < 0 && wouldBlock(sent) && waitForWritable(1000)) {
+                        continue;
+                    }
+                }
                 return false;
             }
             totalSent += sent;
@@ -651,33 +2186,126 @@ private:
     }
     
     ssize_t rawRecv(char* buffer, size_t len) {
-        if (ssl) {
+        if constexpr (P::memory) {
+            return pipe->read(buffer, len);
+        } else if constexpr (P::transport == TransportKind::Tcp) {
+            return ::recv(socket, buffer, len, 0);
+        } else if constexpr (P::transport == TransportKind::Tls) {
+            return SSL_read(ssl, buffer, static_cast<int>(len));
+        } else if (ssl) {
             return SSL_read(ssl, buffer, static_cast<int>(len));
         } else {
             return ::recv(socket, buffer, len, 0);
         }
     }
     
+    // Retorno negativo de rawSend/rawRecv que só indica "tente de novo"
+    bool wouldBlock(ssize_t result) const {
+        if constexpr (P::memory) {
+            return result == MemoryPipe::WouldBlock;
+        }
+        if constexpr (P::tlsPossible) {
+            if (ssl) {
+                int err = SSL_get_error(ssl, static_cast<int>(result));
+                return err == SSL_ERROR_WANT_READ || err == SSL_ERROR_WANT_WRITE;
+            }
+        }
+        (void)result;
+#ifdef _WIN32
+        return WSAGetLastError() == WSAEWOULDBLOCK;
+#else
+        return errno == EAGAIN || errno == EWOULDBLOCK;
+#endif
+    }
+    
+    bool waitForWritable(int timeoutMs) {
+#ifdef _WIN32
+        fd_set writeSet;
+        FD_ZERO(&writeSet);
+        FD_SET(socket, &writeSet);
+        
+        timeval timeout;
+        timeout.tv_sec = timeoutMs / 1000;
+        timeout.tv_usec = (timeoutMs % 1000) * 1000;
+        
+        return select(static_cast<int>(socket) + 1, nullptr, &writeSet, nullptr, &timeout) > 0;
+#else
+        // TLS pode precisar ler (renegociação) para concluir a escrita
+        pollfd pfd;
+        pfd.fd = socket;
+        pfd.events = POLLIN | POLLOUT;
+        return ::poll(&pfd, 1, timeoutMs) > 0 && !(pfd.revents & (POLLERR | POLLHUP | POLLNVAL));
+#endif
+    }
+    
+    void setNonBlocking() {
+        if constexpr (P::memory) {
+            return;     // MemoryPipe::read() nunca bloqueia
+        }
+#ifdef _WIN32
+        u_long mode = 1;
+        ioctlsocket(socket, FIONBIO, &mode);
+#else
+        int flags = fcntl(socket, F_GETFL, 0);
+        fcntl(socket, F_SETFL, flags | O_NONBLOCK);
+#endif
+    }
+    
     // ============================================
     // Handlers
     // ============================================
-    void handleMessage(std::string_view data) {
+    void handleMessage(std::string_view data, bool binary) {
+        if constexpr (P::threaded) {
+            // Fora da rotação a chave nem é calculada
+            if (rotating.load(std::memory_order_acquire)) {
+                if (!admitDuringRotation(data)) return;
+            }
+        }
+        
+#ifndef _WIN32
+        // Publica para outros processos antes de qualquer callback
+        if (shmPublisher) {
+            shmPublisher->publish(data, binary);
+        }
+#endif
+        
+        if constexpr (P::metrics) {
+            bump(counters.messagesReceived);
+            bump(counters.bytesReceived, data.size());
+        }
+        
+        const CallbackSet& cbs = dispatchCallbacks();
+        
         // Callback raw
-        {
-            std::lock_guard<std::mutex> lock(callbackMutex);
-            if (onRawMessageCb) {
-                onRawMessageCb(data);
+        if (cbs.raw) {
+            cbs.raw(data);
+        }
+        
+        // Roteamento por conteúdo (varredura dos bytes crus)
+        if (cbs.router) {
+            cbs.router->dispatch(data);
+        }
+        
+        // Parse JSON só se alguém consome o resultado
+        if constexpr (P::json) {
+            if (cbs.message) {
+                auto json = Json::parse(data);
+                if (json) {
+                    cbs.message(*json);
+                } else if constexpr (P::metrics) {
+                    bump(counters.jsonParseFailures);
+                }
             }
         }
         
-        // Tenta parsear como JSON
-        auto json = Json::parse(data);
-        if (json) {
-            std::lock_guard<std::mutex> lock(callbackMutex);
-            if (onMessageCb) {
-                onMessageCb(*json);
+        // Lote da leitura atual (entregue em flushBatch)
+        if (cbs.batch) {
+            if (batchViews.empty()) {
+                batchStart = Clock::now();
             }
+            batchViews.push_back({data, binary});
         }
+        batchCount++;
     }
     
     void handlePing(std::string_view payload) {
@@ -687,9 +2315,9 @@ private:
         }
         
         // Callback
-        std::lock_guard<std::mutex> lock(callbackMutex);
-        if (onPingCb) {
-            onPingCb(payload);
+        const CallbackSet& cbs = dispatchCallbacks();
+        if (cbs.ping) {
+            cbs.ping(payload);
         }
     }
     
@@ -700,9 +2328,9 @@ private:
         }
         
         // Callback
-        std::lock_guard<std::mutex> lock(callbackMutex);
-        if (onPongCb) {
-            onPongCb(payload);
+        const CallbackSet& cbs = dispatchCallbacks();
+        if (cbs.pong) {
+            cbs.pong(payload);
         }
     }
     
@@ -711,72 +2339,350 @@ private:
         if (payload.size() >= 2) {
             code = (static_cast<uint8_t>(payload[0]) << 8) | static_cast<uint8_t>(payload[1]);
         }
+        linkCloseCode = code;
         
-        connected.store(false, std::memory_order_release);
+        // Responde o Close (RFC 6455 §5.5.1); a queda segue para handleDisconnect
+        sendCloseFrame(code == CloseCode::NoStatusReceived ? CloseCode::Normal : code);
+    }
+    
+    void failConnection(int closeCode, int errorCode, std::string_view reason) {
+        triggerError(errorCode, reason);
+        
+        if (connected.exchange(false, std::memory_order_acq_rel)) {
+            sendCloseFrame(closeCode);
+            triggerDisconnect(closeCode);
+        }
         running.store(false, std::memory_order_release);
+        notifyStopped();
     }
     
-    void handleDisconnect() {
-        connected.store(false, std::memory_order_release);
+    // ============================================
+    // Rotação (detalhes)
+    // ============================================
+    
+    // Exige rotation.mutex. O filtro (rotating) é desligado pela thread de I/O.
+    void resetRotation() {
+        rotation.active = false;
+        rotation.aligned = false;
+        rotation.takeover = false;
+        rotation.switched = false;
+        rotation.standby.reset();
+        rotation.delivered.clear();
+        rotation.deliveredOrder.clear();
+        rotation.pending.clear();
+        rotation.pendingIndex.clear();
+        rotation.matchEnd = 0;
+        rotation.topics.clear();
+    }
+    
+    // Assina todos os tópicos no novo link, no ritmo configurado. A thread de
+    // I/O adota o registro na troca e envia só o que mudou desde então.
+    void subscribeStandbyTopics(EndpointDialer& link) {
+        std::vector<std::string> topics;
+        std::vector<std::string> messages;
+        {
+            std::lock_guard<CallbackMutex> lock(subscriptionMutex);
+            topics = topicBook.active();
+            messages = topicBook.encodeAll(topics);
+        }
+        
+        internal::SendPacer pacer = topicBook.newPacer();
+        pacer.reset(Clock::now());
+        for (const auto& message : messages) {
+            for (auto now = Clock::now(); !pacer.tryAcquire(now); now = Clock::now()) {
+                std::this_thread::sleep_for(pacer.untilNext(now));
+            }
+            link.sendFrame(Opcode::Text, message);
+        }
         
-        // Tenta reconectar se configurado
-        if (config.autoReconnect && reconnectAttempts < config.maxReconnectAttempts) {
-            reconnectAttempts++;
-            std::this_thread::sleep_for(std::chrono::seconds(1) * reconnectAttempts);
+        std::lock_guard<std::mutex> lock(rotation.mutex);
+        rotation.topics = std::move(topics);
+        rotation.topicPacer = pacer;
+    }
+    
+    // Lê o novo link até ele alinhar com o atual
+    // @return nullptr se pronto para a troca, senão o motivo da falha
+    const char* alignStandby(EndpointDialer& link) {
+        const auto deadline = Clock::now() + config.rotation.overlapTimeout;
+        for (;;) {
+            bool takeover;
+            {
+                std::lock_guard<std::mutex> lock(rotation.mutex);
+                if (rotation.aligned) return nullptr;
+                // Link antigo caiu antes de entregar a âncora: não há com o
+                // que alinhar, o novo segue de onde está
+                if (rotation.takeover && rotation.delivered.empty()) return nullptr;
+                takeover = rotation.takeover;
+            }
+            if (!running.load(std::memory_order_acquire)) {
+                return "Conexão encerrada durante a rotação";
+            }
+            if (Clock::now() >= deadline) {
+                // Link antigo já caiu: melhor o novo sem alinhamento que nenhum
+                return takeover ? nullptr : "Nenhuma mensagem em comum entre os links";
+            }
+            if (!link.waitReadable(10)) {
+                continue;
+            }
+            if (link.readSome() <= 0) {
+                return "Novo link caiu durante a rotação";
+            }
+            if (const char* failure = drainStandby(link)) {
+                return failure;
+            }
+        }
+    }
+    
+    // Decodifica os frames completos do novo link para rotation.pending
+    const char* drainStandby(EndpointDialer& link) {
+        for (;;) {
+            FrameView frame;
+            auto status = parseFrame(link.rx.data() + link.rxHead, link.rxTail - link.rxHead,
+                                     config.maxMessageSize, frame);
+            if (status == ParseStatus::Incomplete) return nullptr;
+            if (status == ParseStatus::TooLarge) return "Mensagem muito grande no novo link";
+            link.rxHead += frame.length;
             
-            cleanup();
-            if (connect()) {
-                return;
+            switch (frame.opcode) {
+                case Opcode::Text:
+                    if (config.validateUtf8) {
+                        link.utf8.reset();
+                        if (!link.utf8.feed(frame.payload.data(), frame.payload.size(), frame.fin)) {
+                            return "UTF-8 inválido no novo link";
+                        }
+                    }
+                    [[fallthrough]];
+                case Opcode::Binary:
+                    if (!queueStandbyMessage(frame.payload, frame.opcode == Opcode::Binary)) {
+                        return "Novo link excedeu RotationConfig::maxBuffered";
+                    }
+                    break;
+                case Opcode::Ping:
+                    if (config.ping.autoPong) link.sendFrame(Opcode::Pong, frame.payload);
+                    break;
+                case Opcode::Close:
+                    return "Novo link fechado pelo servidor";
+                case Opcode::Continuation:
+                    if (config.validateUtf8 && link.utf8.active() &&
+                        !link.utf8.feed(frame.payload.data(), frame.payload.size(), frame.fin)) {
+                        return "UTF-8 inválido no novo link";
+                    }
+                    break;
+                default:
+                    break;
             }
         }
+    }
+    
+    bool queueStandbyMessage(std::string_view payload, bool binary) {
+        std::string key(config.rotation.key(payload));
+        std::lock_guard<std::mutex> lock(rotation.mutex);
+        if (rotation.pending.size() >= config.rotation.maxBuffered) {
+            return false;
+        }
+        if (!key.empty()) {
+            // Link antigo já entregou esta: tudo até aqui é repetido
+            if (rotation.delivered.count(key) > 0) {
+                rotation.matchEnd = rotation.pending.size() + 1;
+                rotation.aligned = true;
+            }
+            rotation.pendingIndex[std::move(key)] = rotation.pending.size();
+        }
+        rotation.pending.push_back({std::string(payload), binary});
+        return true;
+    }
+    
+    // Thread de I/O, antes de entregar: registra (antes da troca) ou
+    // descarta o que o link antigo já entregou (depois da troca)
+    bool admitDuringRotation(std::string_view data) {
+        std::string_view key = config.rotation.key ? config.rotation.key(data) : std::string_view{};
+        if (deduplicating) {
+            if (key.empty()) return true;
+            if (dedupKeys.count(std::string(key)) > 0) return false;
+            // Primeira mensagem nova: os links estão alinhados
+            deduplicating = false;
+            dedupKeys.clear();
+        }
         
-        running.store(false, std::memory_order_release);
-        triggerDisconnect(CloseCode::AbnormalClosure);
+        std::lock_guard<std::mutex> lock(rotation.mutex);
+        if (!rotation.active) {
+            rotating.store(false, std::memory_order_relaxed);
+            return true;
+        }
+        if (key.empty()) {
+            return true;
+        }
+        
+        markDelivered(std::string(key));
+        return true;
+    }
+    
+    // Exige rotation.mutex
+    void markDelivered(std::string key) {
+        auto it = rotation.pendingIndex.find(key);
+        if (it != rotation.pendingIndex.end()) {
+            rotation.matchEnd = std::max(rotation.matchEnd, it->second + 1);
+            rotation.aligned = true;
+        }
+        rotation.delivered[key]++;
+        rotation.deliveredOrder.push_back(std::move(key));
+        if (rotation.deliveredOrder.size() == 1) {
+            rotation.cv.notify_all();   // Âncora para rotateConnection()
+        }
+        while (rotation.deliveredOrder.size() > config.rotation.keyWindow) {
+            auto old = rotation.delivered.find(rotation.deliveredOrder.front());
+            if (old != rotation.delivered.end() && --old->second == 0) {
+                rotation.delivered.erase(old);
+            }
+            rotation.deliveredOrder.pop_front();
+        }
+    }
+    
+    // Thread de I/O: adota rotation.standby entre duas leituras
+    void switchToStandby() {
+        // Lote pendente aponta para o buffer do link que vai fechar
+        flushBatch();
+        
+        std::unique_ptr<EndpointDialer> next;
+        std::vector<PendingMessage> replay;
+        std::vector<std::string> standbyTopics;
+        internal::SendPacer standbyPacer;
+        {
+            std::lock_guard<std::mutex> lock(rotation.mutex);
+            handoffReady.store(false, std::memory_order_relaxed);
+            next = std::move(rotation.standby);
+            if (!next) return;
+            
+            replay.assign(std::make_move_iterator(rotation.pending.begin() + static_cast<std::ptrdiff_t>(rotation.matchEnd)),
+                          std::make_move_iterator(rotation.pending.end()));
+            dedupKeys = std::move(rotation.delivered);
+            standbyTopics = std::move(rotation.topics);
+            standbyPacer = rotation.topicPacer;
+            deduplicating = true;
+            rotation.active = false;    // Replay abaixo não registra chaves
+        }
+        
+        // Close no antigo e troca sob sendMutex: nenhum envio cai no link velho.
+        // subscriptionMutex antes: o registro de tópicos troca junto com o link
+        {
+            std::lock_guard<CallbackMutex> subscriptions(subscriptionMutex);
+            {
+                std::lock_guard<SendMutex> lock(sendMutex);
+                writeCloseFrame(CloseCode::Normal);
+                adoptConnection(*next);
+            }
+            topicBook.adoptLink(standbyTopics, standbyPacer);
+            pumpTopicsLocked();
+        }
+        next.reset();  // Fecha o link antigo
+        
+        if constexpr (P::metrics) {
+            bump(counters.rotations);
+        }
+        if (heartbeat) {
+            heartbeat->onPongReceived();  // Pong pendente era do link antigo
+        }
+        
+        // Mensagens que só o novo link viu, sem as já entregues
+        for (const auto& message : replay) {
+            handleMessage(message.payload, message.binary);
+        }
+        flushBatch();
+        
+        std::lock_guard<std::mutex> lock(rotation.mutex);
+        resetRotation();
+        rotation.switched = true;
+        rotation.cv.notify_all();
+    }
+    
+    // Link antigo caiu no meio da rotação: adota o novo quando ele alinhar
+    // (a entrega pausa até lá, no máximo overlapTimeout)
+    bool takeOverStandby() {
+        {
+            std::unique_lock<std::mutex> lock(rotation.mutex);
+            if (!rotation.active) return false;
+            rotation.takeover = true;
+            rotation.cv.notify_all();
+            rotation.cv.wait(lock, [this] {
+                return rotation.standby || !rotation.active || !running.load(std::memory_order_acquire);
+            });
+            if (!rotation.standby) return false;
+        }
+        switchToStandby();
+        return true;
+    }
+    
+    void rotationScheduler() {
+        std::unique_lock<std::mutex> lock(schedulerMutex);
+        while (!schedulerStop) {
+            if (schedulerCv.wait_for(lock, config.rotation.interval, [this] { return schedulerStop; })) {
+                break;
+            }
+            lock.unlock();
+            if (connected.load(std::memory_order_acquire)) {
+                rotateConnection();
+            }
+            lock.lock();
+        }
     }
     
     // ============================================
     // Callbacks
     // ============================================
     void triggerError(int code, std::string_view msg) {
-        std::lock_guard<std::mutex> lock(callbackMutex);
-        if (onErrorCb) {
-            onErrorCb(code, msg);
+        CallbackReader reader(*this);
+        const CallbackSet& cbs = *reader;
+        if (cbs.error) {
+            cbs.error(code, msg);
         }
     }
     
     void triggerConnect() {
-        std::lock_guard<std::mutex> lock(callbackMutex);
-        if (onConnectCb) {
-            onConnectCb();
+        CallbackReader reader(*this);
+        const CallbackSet& cbs = *reader;
+        if (cbs.connect) {
+            cbs.connect();
         }
     }
     
     void triggerDisconnect(int code) {
-        std::lock_guard<std::mutex> lock(callbackMutex);
-        if (onDisconnectCb) {
-            onDisconnectCb(code);
+        CallbackReader reader(*this);
+        const CallbackSet& cbs = *reader;
+        if (cbs.disconnect) {
+            cbs.disconnect(code);
         }
     }
     
     // ============================================
     // Cleanup
     // ============================================
+    // Sob sendMutex: um envio que já passou do teste de connected termina
+    // antes do SSL_free/close (e não escreve num fd reaproveitado)
     void cleanup() {
-        if (ssl) {
-            SSL_shutdown(ssl);
-            SSL_free(ssl);
-            ssl = nullptr;
+        std::lock_guard<SendMutex> lock(sendMutex);
+        if constexpr (P::memory) {
+            if (pipe) {
+                pipe->detach();
+                pipe.reset();
+            }
+            rxHead = rxTail = 0;
+            utf8Text.reset();
+            return;
         }
-        
-        if (sslCtx) {
-            SSL_CTX_free(sslCtx);
-            sslCtx = nullptr;
+        if constexpr (P::tlsPossible) {
+            if (ssl) {
+                SSL_shutdown(ssl);
+                SSL_free(ssl);
+                ssl = nullptr;
+            }
         }
         
         if (socket != SOCKET_ERROR_VALUE) {
             CLOSE_SOCKET(socket);
             socket = SOCKET_ERROR_VALUE;
         }
+        rxHead = rxTail = 0;
+        utf8Text.reset();
         
 #ifdef _WIN32
         WSACleanup();
@@ -787,15 +2693,21 @@ private:
 // ============================================
 // WebSocket Public API
 // ============================================
-WebSocket::WebSocket(WebSocketConfig config)
+template<typename P>
+WebSocketClient<P>::WebSocketClient(WebSocketConfig config)
     : impl_(std::make_unique<Impl>(std::move(config))) {}
 
-WebSocket::~WebSocket() = default;
+template<typename P>
+WebSocketClient<P>::~WebSocketClient() = default;
 
-WebSocket::WebSocket(WebSocket&& other) noexcept = default;
-WebSocket& WebSocket::operator=(WebSocket&& other) noexcept = default;
+template<typename P>
+WebSocketClient<P>::WebSocketClient(WebSocketClient&& other) noexcept = default;
 
-bool WebSocket::pinThread(int core) {
+template<typename P>
+WebSocketClient<P>& WebSocketClient<P>::operator=(WebSocketClient&& other) noexcept = default;
+
+template<typename P>
+bool WebSocketClient<P>::setPinnedCore(int core) {
     if (!internal::isValidCore(core)) {
         return false;
     }
@@ -803,113 +2715,290 @@ bool WebSocket::pinThread(int core) {
     return true;
 }
 
-int WebSocket::getCoreCount() noexcept {
+template<typename P>
+int WebSocketClient<P>::getCoreCount() noexcept {
     return internal::getCoreCount();
 }
 
-bool WebSocket::connect() {
+template<typename P>
+bool WebSocketClient<P>::connect() {
     return impl_->connect();
 }
 
-void WebSocket::disconnect(int code) {
+template<typename P>
+void WebSocketClient<P>::disconnect(int code) {
     impl_->disconnect(code);
 }
 
-bool WebSocket::isConnected() const noexcept {
+template<typename P>
+bool WebSocketClient<P>::isConnected() const noexcept {
     return impl_->connected.load(std::memory_order_acquire);
 }
 
-void WebSocket::wait() {
-    if (impl_->ioThread.joinable()) {
-        impl_->ioThread.join();
+template<typename P>
+void WebSocketClient<P>::waitStopped() {
+    impl_->waitStopped();
+}
+
+template<typename P>
+bool WebSocketClient<P>::rotateConnection() {
+    if constexpr (P::threaded && !P::memory) {
+        return impl_->rotateConnection();
+    } else {
+        return false;
+    }
+}
+
+template<typename P>
+size_t WebSocketClient<P>::pollFrames(size_t budget, int timeoutMs) {
+    if constexpr (P::externalDriven) {
+        return impl_->pollFrames(budget, timeoutMs);
+    } else {
+        (void)budget;
+        (void)timeoutMs;
+        return 0;
     }
 }
 
-bool WebSocket::send(std::string_view message) {
+template<typename P>
+int WebSocketClient<P>::nativeHandle() const noexcept {
+    return impl_->socket == SOCKET_ERROR_VALUE ? -1 : static_cast<int>(impl_->socket);
+}
+
+template<typename P>
+bool WebSocketClient<P>::bufferedData() const noexcept {
+    return impl_->hasBufferedData();
+}
+
+template<typename P>
+bool WebSocketClient<P>::send(std::string_view message) {
+    return impl_->send(message);
+}
+
+template<typename P>
+bool WebSocketClient<P>::send(const char* message) {
     return impl_->send(message);
 }
 
-bool WebSocket::send(const Json& message) {
-    return impl_->send(message.stringify());
+template<typename P>
+bool WebSocketClient<P>::send(const std::string& message) {
+    return impl_->send(message);
 }
 
-bool WebSocket::sendBinary(const void* data, size_t size) {
+template<typename P>
+bool WebSocketClient<P>::sendBinary(const void* data, size_t size) {
     return impl_->sendBinary(data, size);
 }
 
-void WebSocket::sendAsync(std::string_view message) {
+template<typename P>
+void WebSocketClient<P>::sendAsync(std::string_view message) {
     impl_->sendAsync(message);
 }
 
-bool WebSocket::sendPing() {
+template<typename P>
+bool WebSocketClient<P>::subscribe(std::string_view message) {
+    return impl_->subscribe(message);
+}
+
+template<typename P>
+bool WebSocketClient<P>::unsubscribe(std::string_view message, std::string_view unsubscribeMessage) {
+    return impl_->unsubscribe(message, unsubscribeMessage);
+}
+
+template<typename P>
+bool WebSocketClient<P>::subscribeTopics(const std::vector<std::string>& topics) {
+    return impl_->subscribeTopics(topics);
+}
+
+template<typename P>
+bool WebSocketClient<P>::unsubscribeTopics(const std::vector<std::string>& topics) {
+    return impl_->unsubscribeTopics(topics);
+}
+
+template<typename P>
+std::vector<std::string> WebSocketClient<P>::topics() const {
+    return impl_->topics();
+}
+
+template<typename P>
+std::vector<std::string> WebSocketClient<P>::subscriptions() const {
+    return impl_->subscriptions();
+}
+
+template<typename P>
+bool WebSocketClient<P>::sendPing() {
     return impl_->sendPingFrame("");
 }
 
-bool WebSocket::sendPing(std::string_view payload) {
+template<typename P>
+bool WebSocketClient<P>::sendPing(std::string_view payload) {
     return impl_->sendPingFrame(payload);
 }
 
-bool WebSocket::sendPong(std::string_view payload) {
+template<typename P>
+bool WebSocketClient<P>::sendPong(std::string_view payload) {
     return impl_->sendPongFrame(payload);
 }
 
-void WebSocket::setPingMode(PingMode mode) {
-    impl_->heartbeat->setMode(mode);
+template<typename P>
+void WebSocketClient<P>::configureHeartbeat(const PingMode* mode,
+                                            const std::chrono::milliseconds* interval,
+                                            const std::chrono::milliseconds* timeout) {
+    if constexpr (P::heartbeat) {
+        if (mode) impl_->heartbeat->setMode(*mode);
+        if (interval) impl_->heartbeat->setInterval(*interval);
+        if (timeout) impl_->heartbeat->setTimeout(*timeout);
+    } else {
+        (void)mode;
+        (void)interval;
+        (void)timeout;
+    }
+}
+
+template<typename P>
+void WebSocketClient<P>::setAutoPong(bool enabled) {
+    impl_->config.ping.autoPong = enabled;
 }
 
-void WebSocket::setPingInterval(std::chrono::milliseconds interval) {
-    impl_->heartbeat->setInterval(interval);
+template<typename P>
+void WebSocketClient<P>::setJsonCallback(OnMessage callback) {
+    impl_->updateCallbacks([&](auto& cbs) { cbs.message = std::move(callback); });
 }
 
-void WebSocket::setPingTimeout(std::chrono::milliseconds timeout) {
-    impl_->heartbeat->setTimeout(timeout);
+template<typename P>
+void WebSocketClient<P>::onRawMessage(OnRawMessage callback) {
+    impl_->updateCallbacks([&](auto& cbs) { cbs.raw = std::move(callback); });
 }
 
-void WebSocket::setAutoPong(bool enabled) {
-    impl_->config.ping.autoPong = enabled;
+template<typename P>
+void WebSocketClient<P>::onError(OnError callback) {
+    impl_->updateCallbacks([&](auto& cbs) { cbs.error = std::move(callback); });
+}
+
+template<typename P>
+void WebSocketClient<P>::onConnect(OnConnect callback) {
+    impl_->updateCallbacks([&](auto& cbs) { cbs.connect = std::move(callback); });
+}
+
+template<typename P>
+void WebSocketClient<P>::onDisconnect(OnDisconnect callback) {
+    impl_->updateCallbacks([&](auto& cbs) { cbs.disconnect = std::move(callback); });
+}
+
+template<typename P>
+void WebSocketClient<P>::onMessageBatch(OnMessageBatch callback) {
+    impl_->updateCallbacks([&](auto& cbs) { cbs.batch = std::move(callback); });
 }
 
-void WebSocket::onMessage(OnMessage callback) {
-    std::lock_guard<std::mutex> lock(impl_->callbackMutex);
-    impl_->onMessageCb = std::move(callback);
+template<typename P>
+void WebSocketClient<P>::onReconnect(OnReconnect callback) {
+    impl_->updateCallbacks([&](auto& cbs) { cbs.reconnect = std::move(callback); });
 }
 
-void WebSocket::onRawMessage(OnRawMessage callback) {
-    std::lock_guard<std::mutex> lock(impl_->callbackMutex);
-    impl_->onRawMessageCb = std::move(callback);
+template<typename P>
+void WebSocketClient<P>::onPing(OnPing callback) {
+    impl_->updateCallbacks([&](auto& cbs) { cbs.ping = std::move(callback); });
 }
 
-void WebSocket::onError(OnError callback) {
-    std::lock_guard<std::mutex> lock(impl_->callbackMutex);
-    impl_->onErrorCb = std::move(callback);
+template<typename P>
+void WebSocketClient<P>::onPong(OnPong callback) {
+    impl_->updateCallbacks([&](auto& cbs) { cbs.pong = std::move(callback); });
 }
 
-void WebSocket::onConnect(OnConnect callback) {
-    std::lock_guard<std::mutex> lock(impl_->callbackMutex);
-    impl_->onConnectCb = std::move(callback);
+template<typename P>
+void WebSocketClient<P>::route(MessageRouter router) {
+    if (!router.built()) {
+        router.build();
+    }
+    auto shared = std::make_shared<const MessageRouter>(std::move(router));
+    impl_->updateCallbacks([&](auto& cbs) { cbs.router = std::move(shared); });
 }
 
-void WebSocket::onDisconnect(OnDisconnect callback) {
-    std::lock_guard<std::mutex> lock(impl_->callbackMutex);
-    impl_->onDisconnectCb = std::move(callback);
+template<typename P>
+bool WebSocketClient<P>::publishToSharedMemory(std::string_view name, size_t capacity) {
+#ifndef _WIN32
+    auto publisher = std::make_unique<ShmPublisher>();
+    if (!publisher->open(name, capacity)) {
+        return false;
+    }
+    impl_->shmPublisher = std::move(publisher);
+    return true;
+#else
+    (void)name;
+    (void)capacity;
+    return false;
+#endif
 }
 
-void WebSocket::onPing(OnPing callback) {
-    std::lock_guard<std::mutex> lock(impl_->callbackMutex);
-    impl_->onPingCb = std::move(callback);
+template<typename P>
+std::string_view WebSocketClient<P>::url() const noexcept {
+    return *impl_->currentUrl.load(std::memory_order_acquire);
 }
 
-void WebSocket::onPong(OnPong callback) {
-    std::lock_guard<std::mutex> lock(impl_->callbackMutex);
-    impl_->onPongCb = std::move(callback);
+template<typename P>
+std::vector<EndpointTiming> WebSocketClient<P>::endpointTimings() const {
+    std::shared_lock lock(impl_->stateMutex);
+    return impl_->lastRace;
 }
 
-std::string_view WebSocket::url() const noexcept {
-    return impl_->config.url;
+template<typename P>
+void WebSocketClient<P>::onEndpointRace(OnEndpointRace callback) {
+    impl_->updateCallbacks([&](auto& cbs) { cbs.race = std::move(callback); });
 }
 
-void WebSocket::setAutoReconnect(bool enabled) {
+template<typename P>
+void WebSocketClient<P>::setAutoReconnect(bool enabled) {
     impl_->config.autoReconnect = enabled;
 }
 
+template<typename P>
+WebSocketStats WebSocketClient<P>::readStats() const noexcept {
+    WebSocketStats out;
+    if constexpr (P::metrics) {
+        const auto& c = impl_->counters;
+        out.messagesReceived = c.messagesReceived.load(std::memory_order_relaxed);
+        out.bytesReceived = c.bytesReceived.load(std::memory_order_relaxed);
+        out.framesReceived = c.framesReceived.load(std::memory_order_relaxed);
+        out.messagesSent = c.messagesSent.load(std::memory_order_relaxed);
+        out.bytesSent = c.bytesSent.load(std::memory_order_relaxed);
+        out.sendWrites = c.sendWrites.load(std::memory_order_relaxed);
+        out.jsonParseFailures = c.jsonParseFailures.load(std::memory_order_relaxed);
+        out.reconnects = c.reconnects.load(std::memory_order_relaxed);
+        out.reconnectAttempts = c.reconnectAttempts.load(std::memory_order_relaxed);
+        out.lastRecoveryUs = c.lastRecoveryUs.load(std::memory_order_relaxed);
+        out.maxRecoveryUs = c.maxRecoveryUs.load(std::memory_order_relaxed);
+        out.totalRecoveryUs = c.totalRecoveryUs.load(std::memory_order_relaxed);
+        out.rotations = c.rotations.load(std::memory_order_relaxed);
+        for (size_t i = 0; i < BatchSizeBuckets; ++i) {
+            out.batchSizes[i] = c.batchSizes[i].load(std::memory_order_relaxed);
+        }
+    }
+    return out;
+}
+
+// ============================================
+// Instanciações explícitas (todas as combinações de políticas)
+// ============================================
+#define GG_WS_INSTANTIATE(T, TH, J, H, M) \
+    template class WebSocketClient<PolicySet<policy::T, policy::TH, policy::J, policy::H, policy::M>>;
+#define GG_WS_INSTANTIATE_M(T, TH, J, H) \
+    GG_WS_INSTANTIATE(T, TH, J, H, MetricsOn) GG_WS_INSTANTIATE(T, TH, J, H, MetricsOff)
+#define GG_WS_INSTANTIATE_H(T, TH, J) \
+    GG_WS_INSTANTIATE_M(T, TH, J, HeartbeatOn) GG_WS_INSTANTIATE_M(T, TH, J, HeartbeatOff)
+#define GG_WS_INSTANTIATE_J(T, TH) \
+    GG_WS_INSTANTIATE_H(T, TH, JsonOn) GG_WS_INSTANTIATE_H(T, TH, JsonOff)
+#define GG_WS_INSTANTIATE_TH(T) \
+    GG_WS_INSTANTIATE_J(T, OwnThread) GG_WS_INSTANTIATE_J(T, ExternalDriven)
+
+GG_WS_INSTANTIATE_TH(AutoTransport)
+GG_WS_INSTANTIATE_TH(TcpTransport)
+GG_WS_INSTANTIATE_TH(TlsTransport)
+GG_WS_INSTANTIATE_TH(MemoryTransport)
+
+#undef GG_WS_INSTANTIATE_TH
+#undef GG_WS_INSTANTIATE_J
+#undef GG_WS_INSTANTIATE_H
+#undef GG_WS_INSTANTIATE_M
+#undef GG_WS_INSTANTIATE
+
 } // namespace gg
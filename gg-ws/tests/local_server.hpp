@@ -0,0 +1,551 @@
+#pragma once
+
+/**
+ * @file local_server.hpp
+ * @brief Servidor WebSocket mínimo em loopback para testes e benchmarks.
+ *
+ * Cada conexão aceita roda a sessão do teste em sua própria thread,
+ * depois do handshake HTTP Upgrade. Com um TlsIdentity, o servidor fala
+ * wss:// com um certificado autoassinado gerado na hora.
+ *
+ * Exemplo:
+ * @code
+ *   gg::test::LocalServer server([](gg::test::Connection& conn) {
+ *       conn.sendText("hello");
+ *       conn.waitClose();
+ *   });
+ *   gg::WebSocket ws({.url = server.url()});
+ * @endcode
+ */
+
+#include <openssl/evp.h>
+#include <openssl/pem.h>
+#include <openssl/sha.h>
+#include <openssl/ssl.h>
+#include <openssl/x509v3.h>
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace gg::test {
+
+/**
+ * @brief Lado servidor de uma conexão WebSocket já negociada.
+ */
+class Connection {
+public:
+    explicit Connection(int fd, SSL* ssl = nullptr) : fd_(fd), ssl_(ssl) {}
+
+    int fd() const noexcept { return fd_; }
+
+    /**
+     * @brief Envia frame não mascarado (servidor nunca mascara).
+     */
+    bool sendFrame(uint8_t opcode, std::string_view payload, bool fin = true) {
+        return sendRaw(encodeFrame(opcode, payload, fin));
+    }
+
+    bool sendText(std::string_view payload) { return sendFrame(0x1, payload); }
+
+    bool sendClose(uint16_t code) {
+        char payload[2] = {static_cast<char>(code >> 8), static_cast<char>(code & 0xFF)};
+        return sendFrame(0x8, std::string_view(payload, 2));
+    }
+
+    /**
+     * @brief Envia bytes já codificados (vários frames num único write).
+     */
+    bool sendRaw(std::string_view data) {
+        size_t sent = 0;
+        while (sent < data.size()) {
+            ssize_t n = ssl_ ? SSL_write(ssl_, data.data() + sent, static_cast<int>(data.size() - sent))
+                             : ::send(fd_, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+            if (n <= 0) return false;
+            sent += static_cast<size_t>(n);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Uma leitura (recv ou SSL_read).
+     */
+    ssize_t recvSome(void* out, size_t len) {
+        return ssl_ ? SSL_read(ssl_, out, static_cast<int>(len)) : ::recv(fd_, out, len, 0);
+    }
+
+    bool waitReadable(int timeoutMs) {
+        if (ssl_ && SSL_pending(ssl_) > 0) return true;
+        pollfd pfd{fd_, POLLIN, 0};
+        return ::poll(&pfd, 1, timeoutMs) > 0;
+    }
+
+    /**
+     * @brief Lê um frame do cliente, removendo a máscara.
+     * @param timeoutMs Tempo máximo de espera pelo primeiro byte
+     * @return false em timeout, EOF ou erro
+     */
+    bool readFrame(uint8_t& opcode, std::string& payload, int timeoutMs = 5000) {
+        if (!waitReadable(timeoutMs)) return false;
+
+        uint8_t header[2];
+        if (!readExact(header, 2)) return false;
+        opcode = header[0] & 0x0F;
+        bool masked = (header[1] & 0x80) != 0;
+        uint64_t len = header[1] & 0x7F;
+        if (len == 126) {
+            uint8_t ext[2];
+            if (!readExact(ext, 2)) return false;
+            len = (static_cast<uint64_t>(ext[0]) << 8) | ext[1];
+        } else if (len == 127) {
+            uint8_t ext[8];
+            if (!readExact(ext, 8)) return false;
+            len = 0;
+            for (uint8_t b : ext) len = (len << 8) | b;
+        }
+        uint8_t mask[4] = {0, 0, 0, 0};
+        if (masked && !readExact(mask, 4)) return false;
+
+        payload.resize(len);
+        if (len > 0 && !readExact(payload.data(), len)) return false;
+        for (size_t i = 0; i < len; ++i) {
+            payload[i] = static_cast<char>(payload[i] ^ mask[i % 4]);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Consome frames até receber Close (ou o socket fechar).
+     * @return Código de fechamento recebido, ou -1
+     */
+    int waitClose(int timeoutMs = 5000) {
+        uint8_t opcode;
+        std::string payload;
+        while (readFrame(opcode, payload, timeoutMs)) {
+            if (opcode == 0x8) {
+                if (payload.size() >= 2) {
+                    return (static_cast<uint8_t>(payload[0]) << 8) | static_cast<uint8_t>(payload[1]);
+                }
+                return 1005;
+            }
+        }
+        return -1;
+    }
+
+    static std::string encodeFrame(uint8_t opcode, std::string_view payload, bool fin = true) {
+        std::string frame;
+        frame.reserve(payload.size() + 10);
+        frame += static_cast<char>((fin ? 0x80 : 0x00) | opcode);
+        if (payload.size() < 126) {
+            frame += static_cast<char>(payload.size());
+        } else if (payload.size() <= 0xFFFF) {
+            frame += static_cast<char>(126);
+            frame += static_cast<char>((payload.size() >> 8) & 0xFF);
+            frame += static_cast<char>(payload.size() & 0xFF);
+        } else {
+            frame += static_cast<char>(127);
+            for (int i = 7; i >= 0; --i) {
+                frame += static_cast<char>((payload.size() >> (i * 8)) & 0xFF);
+            }
+        }
+        frame.append(payload.data(), payload.size());
+        return frame;
+    }
+
+private:
+    int fd_;
+    SSL* ssl_;
+
+    bool readExact(void* out, size_t len) {
+        auto* p = static_cast<char*>(out);
+        size_t got = 0;
+        while (got < len) {
+            ssize_t n = recvSome(p + got, len - got);
+            if (n <= 0) return false;
+            got += static_cast<size_t>(n);
+        }
+        return true;
+    }
+};
+
+/**
+ * @brief Certificado autoassinado (EC P-256) e SSL_CTX de servidor.
+ *
+ * O certificado também é gravado em caFile() para o cliente confiar nele
+ * (TlsConfig::caFile).
+ */
+class TlsIdentity {
+public:
+    /**
+     * @param maxVersion Versão máxima do servidor (ex: TLS1_2_VERSION; 0 = sem limite)
+     */
+    explicit TlsIdentity(int maxVersion = 0) {
+        EVP_PKEY_CTX* keyCtx = EVP_PKEY_CTX_new_id(EVP_PKEY_EC, nullptr);
+        EVP_PKEY_keygen_init(keyCtx);
+        EVP_PKEY_CTX_set_ec_paramgen_curve_nid(keyCtx, NID_X9_62_prime256v1);
+        EVP_PKEY_keygen(keyCtx, &key_);
+        EVP_PKEY_CTX_free(keyCtx);
+
+        X509* cert = X509_new();
+        X509_set_version(cert, 2);
+        ASN1_INTEGER_set(X509_get_serialNumber(cert), 1);
+        X509_gmtime_adj(X509_getm_notBefore(cert), -60);
+        X509_gmtime_adj(X509_getm_notAfter(cert), 24 * 3600);
+        X509_set_pubkey(cert, key_);
+        X509_NAME* name = X509_get_subject_name(cert);
+        X509_NAME_add_entry_by_txt(name, "CN", MBSTRING_ASC,
+                                   reinterpret_cast<const unsigned char*>("localhost"), -1, -1, 0);
+        X509_set_issuer_name(cert, name);
+        X509_EXTENSION* ext = X509V3_EXT_conf_nid(nullptr, nullptr, NID_basic_constraints,
+                                                  const_cast<char*>("critical,CA:TRUE"));
+        X509_add_ext(cert, ext, -1);
+        X509_EXTENSION_free(ext);
+        X509_sign(cert, key_, EVP_sha256());
+
+        ctx_ = SSL_CTX_new(TLS_server_method());
+        SSL_CTX_use_certificate(ctx_, cert);
+        SSL_CTX_use_PrivateKey(ctx_, key_);
+        if (maxVersion != 0) {
+            SSL_CTX_set_max_proto_version(ctx_, maxVersion);
+        }
+
+        static std::atomic<int> counter{0};
+        caFile_ = "/tmp/gg_ws_test_ca_" + std::to_string(::getpid()) + "_" +
+                  std::to_string(counter++) + ".pem";
+        FILE* file = std::fopen(caFile_.c_str(), "w");
+        if (file) {
+            PEM_write_X509(file, cert);
+            std::fclose(file);
+        }
+        X509_free(cert);
+    }
+
+    ~TlsIdentity() {
+        SSL_CTX_free(ctx_);
+        EVP_PKEY_free(key_);
+        ::unlink(caFile_.c_str());
+    }
+
+    TlsIdentity(const TlsIdentity&) = delete;
+    TlsIdentity& operator=(const TlsIdentity&) = delete;
+
+    SSL_CTX* serverContext() const noexcept { return ctx_; }
+    const std::string& caFile() const noexcept { return caFile_; }
+
+private:
+    EVP_PKEY* key_ = nullptr;
+    SSL_CTX* ctx_ = nullptr;
+    std::string caFile_;
+};
+
+/**
+ * @brief Servidor de teste: aceita conexões em 127.0.0.1 (porta efêmera).
+ */
+class LocalServer {
+public:
+    using Session = std::function<void(Connection&)>;
+
+    /**
+     * @param handshakeDelay Atraso antes de responder o upgrade (simula RTT)
+     */
+    explicit LocalServer(Session session,
+                         std::chrono::milliseconds handshakeDelay = std::chrono::milliseconds(0))
+        : session_(std::move(session)), handshakeDelay_(handshakeDelay) {
+        listenLoopback();
+        acceptThread_ = std::thread(&LocalServer::acceptLoop, this);
+    }
+
+    /**
+     * @brief Servidor wss:// com o certificado de tls (que precisa sobreviver ao servidor).
+     */
+    LocalServer(const TlsIdentity& tls, Session session)
+        : session_(std::move(session)), handshakeDelay_(0), tlsCtx_(tls.serverContext()) {
+        listenLoopback();
+        acceptThread_ = std::thread(&LocalServer::acceptLoop, this);
+    }
+
+    /**
+     * @brief Escuta num Unix domain socket (URLs ws+unix://).
+     */
+    LocalServer(std::string unixPath, Session session)
+        : session_(std::move(session)), handshakeDelay_(0), unixPath_(std::move(unixPath)) {
+        ::unlink(unixPath_.c_str());
+        listenFd_ = ::socket(AF_UNIX, SOCK_STREAM, 0);
+
+        sockaddr_un addr{};
+        addr.sun_family = AF_UNIX;
+        std::strncpy(addr.sun_path, unixPath_.c_str(), sizeof(addr.sun_path) - 1);
+        ::bind(listenFd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+        ::listen(listenFd_, 64);
+
+        acceptThread_ = std::thread(&LocalServer::acceptLoop, this);
+    }
+
+    ~LocalServer() {
+        stop();
+    }
+
+    LocalServer(const LocalServer&) = delete;
+    LocalServer& operator=(const LocalServer&) = delete;
+
+    uint16_t port() const noexcept { return port_; }
+
+    std::string url(std::string_view path = "/") const {
+        if (!unixPath_.empty()) {
+            return "ws+unix://" + unixPath_ + ":" + std::string(path);
+        }
+        return std::string(tlsCtx_ ? "wss://127.0.0.1:" : "ws://127.0.0.1:") + std::to_string(port_) + std::string(path);
+    }
+
+    /**
+     * @brief Número de conexões aceitas até agora.
+     */
+    int connections() const noexcept { return accepted_.load(); }
+
+    /**
+     * @brief Handshakes TLS que retomaram uma sessão anterior.
+     */
+    int resumedSessions() const noexcept { return resumed_.load(); }
+
+    void stop() {
+        if (stopping_.exchange(true)) return;
+        if (acceptThread_.joinable()) acceptThread_.join();
+        ::close(listenFd_);
+        if (!unixPath_.empty()) ::unlink(unixPath_.c_str());
+
+        std::vector<std::thread> sessions;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            sessions.swap(sessions_);
+        }
+        for (auto& t : sessions) {
+            if (t.joinable()) t.join();
+        }
+    }
+
+    /**
+     * @brief Calcula Sec-WebSocket-Accept (RFC 6455 §4.2.2).
+     */
+    static std::string acceptKey(std::string_view key) {
+        std::string input(key);
+        input += "258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
+        unsigned char digest[SHA_DIGEST_LENGTH];
+        SHA1(reinterpret_cast<const unsigned char*>(input.data()), input.size(), digest);
+
+        static const char table[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+        std::string out;
+        for (size_t i = 0; i < SHA_DIGEST_LENGTH; i += 3) {
+            uint32_t n = static_cast<uint32_t>(digest[i]) << 16;
+            if (i + 1 < SHA_DIGEST_LENGTH) n |= static_cast<uint32_t>(digest[i + 1]) << 8;
+            if (i + 2 < SHA_DIGEST_LENGTH) n |= digest[i + 2];
+            out += table[(n >> 18) & 0x3F];
+            out += table[(n >> 12) & 0x3F];
+            out += (i + 1 < SHA_DIGEST_LENGTH) ? table[(n >> 6) & 0x3F] : '=';
+            out += (i + 2 < SHA_DIGEST_LENGTH) ? table[n & 0x3F] : '=';
+        }
+        return out;
+    }
+
+private:
+    Session session_;
+    std::chrono::milliseconds handshakeDelay_;
+    int listenFd_ = -1;
+    uint16_t port_ = 0;
+    std::string unixPath_;
+    std::atomic<bool> stopping_{false};
+    std::atomic<int> accepted_{0};
+    std::thread acceptThread_;
+    std::mutex mutex_;
+    std::vector<std::thread> sessions_;
+    SSL_CTX* tlsCtx_ = nullptr;
+    std::atomic<int> resumed_{0};
+
+    void listenLoopback() {
+        listenFd_ = ::socket(AF_INET, SOCK_STREAM, 0);
+        int one = 1;
+        setsockopt(listenFd_, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        addr.sin_port = 0;
+        ::bind(listenFd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+        ::listen(listenFd_, 64);
+
+        socklen_t len = sizeof(addr);
+        getsockname(listenFd_, reinterpret_cast<sockaddr*>(&addr), &len);
+        port_ = ntohs(addr.sin_port);
+    }
+
+    void acceptLoop() {
+        while (!stopping_.load()) {
+            pollfd pfd{listenFd_, POLLIN, 0};
+            if (::poll(&pfd, 1, 50) <= 0) continue;
+
+            int fd = ::accept(listenFd_, nullptr, nullptr);
+            if (fd < 0) continue;
+            int one = 1;
+            setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+            accepted_++;
+
+            std::lock_guard<std::mutex> lock(mutex_);
+            sessions_.emplace_back([this, fd]() {
+                SSL* ssl = tlsCtx_ ? acceptTls(fd) : nullptr;
+                Connection conn(fd, ssl);
+                if ((!tlsCtx_ || ssl) && handshake(conn, handshakeDelay_)) {
+                    session_(conn);
+                }
+                if (ssl) {
+                    SSL_shutdown(ssl);
+                    SSL_free(ssl);
+                }
+                ::close(fd);
+            });
+        }
+    }
+
+    SSL* acceptTls(int fd) {
+        timeval timeout{5, 0};
+        setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+        SSL* ssl = SSL_new(tlsCtx_);
+        SSL_set_fd(ssl, fd);
+        if (SSL_accept(ssl) != 1) {
+            SSL_free(ssl);
+            return nullptr;
+        }
+        if (SSL_session_reused(ssl)) {
+            resumed_++;
+        }
+        return ssl;
+    }
+
+    static bool handshake(Connection& conn, std::chrono::milliseconds delay) {
+        std::string request;
+        char buf[1024];
+        while (request.find("\r\n\r\n") == std::string::npos) {
+            if (!conn.waitReadable(5000)) return false;
+            ssize_t n = conn.recvSome(buf, sizeof(buf));
+            if (n <= 0) return false;
+            request.append(buf, static_cast<size_t>(n));
+        }
+
+        std::string key;
+        size_t pos = request.find("Sec-WebSocket-Key: ");
+        if (pos != std::string::npos) {
+            pos += 19;
+            key = request.substr(pos, request.find("\r\n", pos) - pos);
+        }
+
+        if (delay.count() > 0) {
+            std::this_thread::sleep_for(delay);
+        }
+        
+        std::string response =
+            "HTTP/1.1 101 Switching Protocols\r\n"
+            "Upgrade: websocket\r\n"
+            "Connection: Upgrade\r\n"
+            "Sec-WebSocket-Accept: " + acceptKey(key) + "\r\n\r\n";
+        return conn.sendRaw(response);
+    }
+};
+
+/**
+ * @brief Listener que nunca completa o 3-way handshake.
+ *
+ * Usa backlog 0 e ocupa a fila de accept com conexões próprias: novos SYNs
+ * são descartados pelo kernel e o connect() do cliente fica pendente, como
+ * num host inalcançável.
+ */
+class Blackhole {
+public:
+    /**
+     * @param ipv6 Escuta em ::1 em vez de 127.0.0.1
+     * @param port Porta (0 = efêmera)
+     */
+    explicit Blackhole(bool ipv6 = false, uint16_t port = 0) {
+        sockaddr_storage addr{};
+        socklen_t len;
+        if (ipv6) {
+            auto* a6 = reinterpret_cast<sockaddr_in6*>(&addr);
+            a6->sin6_family = AF_INET6;
+            a6->sin6_addr = in6addr_loopback;
+            a6->sin6_port = htons(port);
+            len = sizeof(sockaddr_in6);
+        } else {
+            auto* a4 = reinterpret_cast<sockaddr_in*>(&addr);
+            a4->sin_family = AF_INET;
+            a4->sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            a4->sin_port = htons(port);
+            len = sizeof(sockaddr_in);
+        }
+
+        listenFd_ = ::socket(addr.ss_family, SOCK_STREAM, 0);
+        if (ipv6) {
+            int one = 1;
+            setsockopt(listenFd_, IPPROTO_IPV6, IPV6_V6ONLY, &one, sizeof(one));
+        }
+        if (::bind(listenFd_, reinterpret_cast<sockaddr*>(&addr), len) != 0 ||
+            ::listen(listenFd_, 0) != 0) {
+            return;
+        }
+        getsockname(listenFd_, reinterpret_cast<sockaddr*>(&addr), &len);
+        port_ = ntohs(ipv6 ? reinterpret_cast<sockaddr_in6*>(&addr)->sin6_port
+                           : reinterpret_cast<sockaddr_in*>(&addr)->sin_port);
+        addr_ = addr;
+        addrLen_ = len;
+
+        // Enche a fila até um connect ficar pendente
+        for (int i = 0; i < 16; ++i) {
+            int fd = ::socket(addr.ss_family, SOCK_STREAM, 0);
+            fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+            ::connect(fd, reinterpret_cast<sockaddr*>(&addr), len);
+            fillers_.push_back(fd);
+            pollfd pfd{fd, POLLOUT, 0};
+            if (::poll(&pfd, 1, 100) == 0) break;
+        }
+    }
+
+    ~Blackhole() {
+        for (int fd : fillers_) ::close(fd);
+        if (listenFd_ >= 0) ::close(listenFd_);
+    }
+
+    Blackhole(const Blackhole&) = delete;
+    Blackhole& operator=(const Blackhole&) = delete;
+
+    bool valid() const noexcept { return port_ != 0; }
+    uint16_t port() const noexcept { return port_; }
+    const sockaddr_storage& address() const noexcept { return addr_; }
+    socklen_t addressLength() const noexcept { return addrLen_; }
+
+    std::string url() const {
+        return addr_.ss_family == AF_INET6 ? "ws://[::1]:" + std::to_string(port_) + "/"
+                                           : "ws://127.0.0.1:" + std::to_string(port_) + "/";
+    }
+
+private:
+    int listenFd_ = -1;
+    uint16_t port_ = 0;
+    sockaddr_storage addr_{};
+    socklen_t addrLen_ = 0;
+    std::vector<int> fillers_;
+};
+
+} // namespace gg::test
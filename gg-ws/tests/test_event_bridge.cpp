@@ -0,0 +1,183 @@
+#include "gg_ws/event_bridge.hpp"
+#include "gg_ws/websocket.hpp"
+#include "local_server.hpp"
+
+#include "GG_Observer.h"
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace gg;
+
+// ============================================
+// Macros de Teste
+// ============================================
+#define TEST(name) void test_##name()
+#define RUN_TEST(name) \
+    std::cout << "  " << #name << "... "; \
+    test_##name(); \
+    std::cout << "OK\n"
+
+#define ASSERT(expr) \
+    if (!(expr)) { \
+        std::cerr << "\nFALHA: " << #expr << " em " << __FILE__ << ":" << __LINE__ << "\n"; \
+        std::exit(1); \
+    }
+
+// ============================================
+// MessagePool / MessageHandle
+// ============================================
+TEST(handle_refcount_and_recycle) {
+    MessagePool pool(2, 8);
+    ASSERT(pool.idle() == 2);
+
+    const char* buffer = nullptr;
+    {
+        MessageHandle a = pool.acquire(R"({"p":1})", false, true);
+        ASSERT(pool.idle() == 1);
+        ASSERT(a.data() == R"({"p":1})");
+        ASSERT(a.json() && (*a.json())["p"].getInt() == 1);
+        buffer = a.data().data();
+
+        MessageHandle b = a;
+        MessageHandle c = b;
+        ASSERT(a.useCount() == 3);
+        ASSERT(c.data().data() == buffer);     // Mesmo buffer, sem cópia
+
+        MessageHandle moved = std::move(c);
+        ASSERT(!c);
+        ASSERT(moved.useCount() == 3);
+    }
+    ASSERT(pool.idle() == 2);
+
+    // Bloco devolvido é reaproveitado (LIFO)
+    MessageHandle again = pool.acquire("x", true);
+    ASSERT(again.binary());
+    ASSERT(again.json() == nullptr);
+    ASSERT(again.data() == "x");
+}
+
+TEST(handle_outlives_pool) {
+    MessageHandle survivor;
+    {
+        MessagePool pool(0);
+        survivor = pool.acquire("still here", false);
+    }
+    ASSERT(survivor.data() == "still here");
+    survivor.reset();
+    ASSERT(!survivor);
+}
+
+TEST(blocks_released_on_other_threads) {
+    MessagePool pool(0, 1024);
+    std::vector<MessageHandle> handles;
+    for (int i = 0; i < 1000; ++i) {
+        handles.push_back(pool.acquire(std::to_string(i), false));
+    }
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&handles, t]() {
+            for (size_t i = static_cast<size_t>(t); i < handles.size(); i += 4) {
+                handles[i].reset();
+            }
+        });
+    }
+    for (auto& t : threads) t.join();
+    ASSERT(pool.idle() == 1000);
+}
+
+// ============================================
+// EventBus
+// ============================================
+TEST(bridge_fans_out_same_buffer) {
+    constexpr int Messages = 200;
+    test::LocalServer server([&](test::Connection& conn) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        for (int i = 0; i < Messages; ++i) {
+            conn.sendText("{\"i\":" + std::to_string(i) + "}");
+        }
+        conn.waitClose();
+    });
+
+    EventBus bus;
+    EventBusBridge bridge(bus, {.parseJson = true});
+
+    // Cada assinante guarda o endereço do payload que recebeu
+    struct Seen {
+        std::vector<const char*> buffers;
+        int ordered = 0;
+    };
+    Seen seen[2];
+    std::atomic<int> ready{0};
+    std::atomic<bool> stop{false};
+    std::vector<std::thread> subscribers;
+    for (int s = 0; s < 2; ++s) {
+        subscribers.emplace_back([&, s]() {
+            auto sub = bus.subscribe<MessageHandle>([&, s](const MessageHandle& msg) {
+                const Json* json = msg.json();
+                if (json && (*json)["i"].getInt() == seen[s].ordered) seen[s].ordered++;
+                seen[s].buffers.push_back(msg.data().data());
+            });
+            ready++;
+            while (!stop.load()) {
+                bus.poll();
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            bus.poll();
+        });
+    }
+    while (ready.load() < 2) {
+        std::this_thread::yield();
+    }
+
+    WebSocketConfig config{.url = server.url()};
+    config.autoReconnect = false;
+    config.ping.mode = PingMode::Disabled;
+    WebSocket ws(config);
+    bridge.attach(ws);
+
+    ASSERT(ws.connect());
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (bridge.published() < Messages && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    ws.disconnect();
+
+    // Handles ainda na fila mantêm os blocos vivos até o poll()
+    stop = true;
+    for (auto& t : subscribers) t.join();
+
+    ASSERT(bridge.published() == Messages);
+    for (const Seen& s : seen) {
+        ASSERT(s.ordered == Messages);
+        ASSERT(s.buffers.size() == static_cast<size_t>(Messages));
+    }
+    ASSERT(seen[0].buffers == seen[1].buffers);
+
+    // Todos os blocos voltaram (nenhum além dos pré-alocados foi preciso)
+    ASSERT(bridge.pool().idle() == BridgeOptions{}.preallocate);
+}
+
+// ============================================
+// Main
+// ============================================
+int main() {
+    std::cout << "=== Testes do EventBusBridge ===\n\n";
+
+    std::cout << "Pool:\n";
+    RUN_TEST(handle_refcount_and_recycle);
+    RUN_TEST(handle_outlives_pool);
+    RUN_TEST(blocks_released_on_other_threads);
+
+    std::cout << "\nEventBus:\n";
+    RUN_TEST(bridge_fans_out_same_buffer);
+
+    std::cout << "\n=== TODOS OS TESTES PASSARAM ===\n";
+    return 0;
+}
@@ -1,9 +1,40 @@
 #include "gg_ws/json.hpp"
-#include <iostream>
+#include "gg_ws/json_bind.hpp"
+#include "gg_ws/json_document.hpp"
+#include "gg_ws/json_query.hpp"
+#include "gg_ws/json_writer.hpp"
+#include "../src/internal/json_structural.hpp"
+#include <array>
+#include <atomic>
 #include <cassert>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <new>
+#include <optional>
+#include <string>
+#include <vector>
 
 using namespace gg;
 
+// ============================================
+// Contador de alocações (operator new global)
+// ============================================
+static std::atomic<size_t> allocations{0};
+
+void* operator new(size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"    // new acima usa malloc
+#endif
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+
 // ============================================
 // Macros de Teste
 // ============================================
@@ -320,6 +351,905 @@ TEST(roundtrip) {
     ASSERT(*parsed == *reparsed);
 }
 
+// ============================================
+// Testes de JsonDocument
+// ============================================
+static const char* const TradeMessage =
+    R"({"e":"trade","E":1700000000123,"s":"BTCUSDT","t":12345,"p":"67234.50","q":"0.00012",)"
+    R"("b":88,"a":50,"T":1700000000120,"m":true,"M":true,"x":null,"l":[1,2.5,-3e2]})";
+
+TEST(document_parse_types) {
+    std::string input = TradeMessage;
+    JsonDocument doc;
+    ASSERT(doc.parse(input));
+    ASSERT(doc.root().isObject());
+    ASSERT_EQ(doc.root().size(), 13u);
+    ASSERT_EQ(doc["e"].getString(), "trade");
+    ASSERT_EQ(doc["E"].getInt(), 1700000000123);
+    ASSERT_EQ(doc["p"].getString(), "67234.50");
+    ASSERT(doc["m"].getBool());
+    ASSERT(doc["x"].isNull());
+    ASSERT_EQ(doc["l"].size(), 3u);
+    ASSERT_EQ(doc["l"][1].getNumber(), 2.5);
+    ASSERT_EQ(doc["l"][2].getNumber(), -300.0);
+    
+    // Strings sem escape apontam para a entrada
+    std::string_view symbol = doc["s"].getString();
+    ASSERT(symbol.data() > input.data() && symbol.data() < input.data() + input.size());
+    
+    // Ordem do documento
+    std::string order;
+    doc.root().forEachPair([&](std::string_view key, JsonValue) { order += key; });
+    ASSERT_EQ(order, "eEstpqbaTmMxl");
+}
+
+TEST(document_escapes_and_lookup) {
+    JsonDocument doc;
+    ASSERT(doc.parse(R"({"a\nb":"x\"y\u00e9\ud83d\ude80","k":1,"k":2,"n":null})"));
+    ASSERT_EQ(doc["a\nb"].getString(), "x\"y\xc3\xa9\xf0\x9f\x9a\x80");
+    ASSERT_EQ(doc["k"].getInt(), 2);            // Chave repetida: vale a última
+    ASSERT(doc.root().contains("n"));
+    ASSERT(!doc.root().contains("missing"));
+    ASSERT(doc["missing"]["deep"][3].isNull());  // Acesso seguro encadeado
+    ASSERT_EQ(doc["k"].getString("def"), "def");
+}
+
+TEST(document_invalid) {
+    JsonDocument doc;
+    const char* invalid[] = {"", "{", "[1,2", R"({"a":})", R"({"a" 1})", "[1,]", "01",
+                             "\"abc", "\"\\x\"", "nul", "{} x", "[\"\x01\"]"};
+    for (const char* input : invalid) {
+        ASSERT(!doc.parse(input));
+        ASSERT(doc.root().isNull());
+    }
+    std::string deep(1000, '[');
+    ASSERT(!doc.parse(deep + std::string(1000, ']')));
+    
+    // Documento continua utilizável depois de erro
+    ASSERT(doc.parse(R"([{"a":[1]}])"));
+    ASSERT_EQ(doc[0]["a"][0].getInt(), 1);
+}
+
+TEST(document_matches_dom) {
+    JsonDocument doc;
+    ASSERT(doc.parse(TradeMessage));
+    auto dom = Json::parse(TradeMessage);
+    ASSERT(dom.has_value());
+    ASSERT(doc.root().toJson() == *dom);
+}
+
+TEST(document_reuse_no_allocations) {
+    std::string input = TradeMessage;
+    std::string escaped = R"({"stream":"btcusdt@depth","data":{"b":[["67234.50","1.2"],["67234.40","0.5"]],)"
+                          R"("a":[["67234.60","3.0"]],"note":"tab\there"}})";
+    JsonDocument doc;
+    for (int i = 0; i < 3; ++i) {
+        ASSERT(doc.parse(input));
+        ASSERT(doc.parse(escaped));
+    }
+    const size_t capacity = doc.arenaCapacity();
+    
+    size_t before = allocations.load();
+    for (int i = 0; i < 1000; ++i) {
+        ASSERT(doc.parse(i % 2 ? escaped : input));
+    }
+    ASSERT_EQ(allocations.load() - before, 0u);
+    ASSERT_EQ(doc.arenaCapacity(), capacity);
+    ASSERT_EQ(doc["data"]["b"][1][0].getString(), "67234.40");
+    ASSERT_EQ(doc["data"]["note"].getString(), "tab\there");
+    
+    // Mensagem maior que a arena: cresce e volta a um bloco só
+    std::string big = "[";
+    for (int i = 0; i < 5000; ++i) big += (i ? ",\"x\\n\"" : "\"x\\n\"");
+    big += "]";
+    ASSERT(doc.parse(big));
+    ASSERT_EQ(doc.root().size(), 5000u);
+    ASSERT(doc.parse(big));
+    before = allocations.load();
+    ASSERT(doc.parse(big));
+    ASSERT_EQ(allocations.load() - before, 0u);
+}
+
+// ============================================
+// Testes de Números
+// ============================================
+TEST(number_exact_integers) {
+    std::string input = R"({"max":9223372036854775807,"min":-9223372036854775808,)"
+                        R"("u":18446744073709551615,"big":18446744073709551616,)"
+                        R"("ns":1700000000123456789,"f":2.5,"neg":-7})";
+    auto json = Json::parse(input);
+    ASSERT(json.has_value());
+    const Json& j = *json;
+    ASSERT_EQ(j["max"].getInt(), INT64_MAX);
+    ASSERT_EQ(j["min"].getInt(), INT64_MIN);
+    ASSERT_EQ(j["u"].getUInt(), UINT64_MAX);
+    ASSERT_EQ(j["u"].getInt(-1), -1);                   // Não cabe em int64
+    ASSERT_EQ(j["ns"].getInt(), 1700000000123456789);  // Double perderia os últimos dígitos
+    ASSERT(j["ns"].isInteger());
+    ASSERT(!j["big"].isInteger());                      // Acima de 64 bits: double
+    ASSERT_EQ(j["big"].getNumber(), 18446744073709551616.0);
+    ASSERT_EQ(j["f"].getInt(), 2);
+    ASSERT(!j["f"].isInteger());
+    ASSERT_EQ(j["neg"].getUInt(99), 99u);
+    
+    // Serialização sem passar por double
+    auto again = Json::parse(j.stringify());
+    ASSERT(again.has_value());
+    ASSERT_EQ((*again)["ns"].getInt(), 1700000000123456789);
+    ASSERT_EQ((*again)["u"].getUInt(), UINT64_MAX);
+    ASSERT_EQ(Json(uint64_t{18446744073709551615u}).stringify(), "18446744073709551615");
+    ASSERT_EQ(Json(int64_t{-9007199254740993}).stringify(), "-9007199254740993");
+    
+    // Mesma leitura no JsonDocument
+    JsonDocument doc;
+    ASSERT(doc.parse(input));
+    ASSERT_EQ(doc["ns"].getInt(), 1700000000123456789);
+    ASSERT_EQ(doc["u"].getUInt(), UINT64_MAX);
+    ASSERT_EQ(doc["min"].getInt(), INT64_MIN);
+    ASSERT(doc.root().toJson() == j);
+    
+    // Igualdade numérica entre representações
+    ASSERT(Json(1) == *Json::parse("1.0"));
+    ASSERT(Json(uint64_t{1}) == Json(1));
+    ASSERT(Json(int64_t{9007199254740993}) != Json(9007199254740992.0));
+    ASSERT(Json(2) != Json(2.5));
+}
+
+TEST(number_matches_strtod) {
+    auto same = [](const std::string& text) {
+        auto json = Json::parse(text);
+        if (!json || !json->isNumber()) return false;
+        double expected = std::strtod(text.c_str(), nullptr);
+        double got = json->getNumber();
+        return std::memcmp(&expected, &got, sizeof(double)) == 0;
+    };
+    
+    for (const char* text : {
+             "0.1", "-0.0", "1e23", "9007199254740993.0", "2.2250738585072011e-308",
+             "2.2250738585072014e-308", "4.9406564584124654e-324", "2.4703282292062328e-324",
+             "2.4703282292062327e-324", "1.7976931348623157e308", "1.7976931348623158e308",
+             "1e400", "-1e-400", "0.000000000000000000000000000000123456789",
+             "123456789012345678901234567890", "7.2057594037927933e16",
+             "9.999999999999999999999999e-5", "1448997445238699e-322"}) {
+        ASSERT(same(text));
+    }
+    
+    // Mantissas de 1 a 25 dígitos (truncamento acima de 19) e expoentes em toda a faixa
+    uint32_t seed = 777;
+    auto next = [&seed]() { seed = seed * 1103515245 + 12345; return seed >> 8; };
+    for (int i = 0; i < 20000; ++i) {
+        std::string text = next() % 2 ? "-" : "";
+        const int digits = 1 + static_cast<int>(next() % 25);
+        text += static_cast<char>('1' + next() % 9);
+        for (int d = 1; d < digits; ++d) {
+            if (d == digits / 2 && next() % 2) text += '.';
+            text += static_cast<char>('0' + next() % 10);
+        }
+        if (next() % 2) text += "e" + std::to_string(static_cast<int>(next() % 660) - 330);
+        ASSERT(same(text));
+    }
+}
+
+TEST(decimal_exact) {
+    // Texto, números JSON e strings numéricas: mesma mantissa, sem double
+    auto price = Decimal::parse("67234.50");
+    ASSERT(price.has_value());
+    ASSERT_EQ(price->mantissa, 6723450);
+    ASSERT_EQ(static_cast<int>(price->scale), 2);
+    ASSERT_EQ(price->toTicks(2).value_or(0), 6723450);
+    ASSERT_EQ(price->toTicks(4).value_or(0), 672345000);
+    ASSERT_EQ(price->toTicks(1).value_or(0), 672345);      // Só descarta zeros
+    ASSERT(!price->toTicks(0).has_value());
+    ASSERT_EQ(price->toString(), "67234.50");
+    ASSERT_EQ(Decimal::parse("-1.5e-3")->toString(), "-0.0015");
+    ASSERT_EQ(Decimal::parse("0.000123")->toString(), "0.000123");
+    ASSERT_EQ(Decimal::parse("12e2")->toString(), "1200");
+    ASSERT_EQ(Decimal::parse("0.1")->toDouble(), 0.1);
+    ASSERT(Decimal::parse("1.50") == Decimal(15, 1));
+    ASSERT(Decimal::parse("1.5") != Decimal(15, 0));
+    for (const char* bad : {"", "1.", ".5", "01", "1e", "+1", "1 ", "9223372036854775808", "0.1234567890123456789"}) {
+        ASSERT(!Decimal::parse(bad).has_value());
+    }
+    ASSERT(!Decimal::fromDouble(std::numeric_limits<double>::infinity()).has_value());
+    ASSERT_EQ(Decimal::fromDouble(0.1)->toString(), "0.1");
+    
+    std::string input = R"({"p":67234.50,"q":"0.00012300","t":0.30000000000000004,"n":3,"x":1e2,"s":"abc"})";
+    auto json = Json::parse(input);
+    ASSERT(json.has_value());
+    const Json& j = *json;
+    ASSERT(j["p"].isDecimal());
+    ASSERT(!j["p"].isInteger());
+    ASSERT(j["p"].getDecimal() == Decimal(6723450, 2));
+    ASSERT_EQ(j["q"].getDecimal().toTicks(8).value_or(0), 12300);
+    ASSERT_EQ(j["t"].getDecimal().toString(), "0.30000000000000004");
+    ASSERT(j["n"].getDecimal() == Decimal(3, 0));
+    ASSERT(j["x"].getDecimal() == Decimal(100, 0));       // Expoente: double, ainda exato
+    ASSERT(j["s"].getDecimal(Decimal(-1, 0)) == Decimal(-1, 0));
+    ASSERT_EQ(j["p"].getNumber(), 67234.5);
+    ASSERT_EQ(j["p"].getInt(), 67234);
+    ASSERT_EQ(Json(Decimal(-25, 1)).getInt(), -2);
+    ASSERT_EQ(Json(Decimal(-25, 1)).getUInt(7), 7u);
+    ASSERT(j["p"] == Json(67234.5));
+    ASSERT(j["n"] == Json(Decimal(300, 2)));
+    
+    // Serialização sem perda: as casas lidas voltam iguais
+    ASSERT_EQ(j["p"].stringify(), "67234.50");
+    ASSERT_EQ(j["t"].stringify(), "0.30000000000000004");
+    ASSERT_EQ(j["n"].stringify(), "3");
+    ASSERT_EQ(Json(Decimal(-5, 3)).stringify(), "-0.005");
+    ASSERT_EQ(Json(2.5).stringify(), "2.5");
+    
+    JsonDocument doc;
+    ASSERT(doc.parse(input));
+    ASSERT(doc["p"].isDecimal());
+    ASSERT(doc["p"].getDecimal() == Decimal(6723450, 2));
+    ASSERT_EQ(doc["q"].getDecimal().toTicks(8).value_or(0), 12300);
+    ASSERT_EQ(doc["p"].getNumber(), 67234.5);
+    ASSERT_EQ(doc["p"].getInt(), 67234);
+    ASSERT_EQ(doc.root().toJson().stringify(), j.stringify());
+}
+
+// ============================================
+// Testes de Parse por Eventos
+// ============================================
+
+// Registra cada evento como texto (todos os callbacks)
+struct EventTrace {
+    std::string out;
+    void onStartObject() { out += "{"; }
+    void onEndObject() { out += "}"; }
+    void onStartArray() { out += "["; }
+    void onEndArray() { out += "]"; }
+    void onKey(std::string_view key) { out += "k:" + std::string(key) + " "; }
+    void onString(std::string_view text) { out += "s:" + std::string(text) + " "; }
+    void onNumber(const JsonNumber& number) { out += "n:" + std::string(number.text()) + " "; }
+    void onBool(bool value) { out += value ? "true " : "false "; }
+    void onNull() { out += "null "; }
+};
+
+TEST(decimal_scale_bounded) {
+    // Escala acima de MaxScale (construtor aceita até 255): expoente, até MaxChars
+    ASSERT_EQ(Decimal(1, 60).toString(), "1e-60");
+    ASSERT_EQ(Decimal(-15, 19).toString(), "-15e-19");
+    const Decimal widest(std::numeric_limits<int64_t>::min(), 255);
+    ASSERT_EQ(widest.toString(), "-9223372036854775808e-255");
+    ASSERT_EQ(widest.toString().size(), Decimal::MaxChars);
+    
+    // JsonWriter em buffer do caller: não escreve além da capacidade
+    char buffer[64];
+    std::memset(buffer, '#', sizeof(buffer));
+    JsonWriter fits(buffer, Decimal::MaxChars + 1);
+    fits.value(widest);
+    ASSERT(!fits.overflow());
+    ASSERT_EQ(fits.view(), widest.toString());
+    ASSERT_EQ(buffer[Decimal::MaxChars + 1], '#');
+    JsonWriter small(buffer, 8);
+    small.value(Decimal(1, 60));
+    ASSERT(small.overflow());
+    ASSERT_EQ(small.size(), 0u);
+}
+
+TEST(events_sequence) {
+    EventTrace trace;
+    auto result = Json::parseEvents(R"( {"a":[1,-2.50,"x\ty"],"b":{"c":null,"d":true},"e":[],"f":{}} )", trace);
+    ASSERT(result);
+    ASSERT_EQ(result.offset, 62u);             // Ok: a entrada inteira
+    ASSERT_EQ(trace.out, "{k:a [n:1 n:-2.50 s:x\ty ]k:b {k:c null k:d true }k:e []k:f {}}");
+    
+    // Valores escalares na raiz
+    for (const char* root : {"42", "\"abc\"", "false", "null"}) {
+        EventTrace single;
+        ASSERT(Json::parseEvents(root, single));
+    }
+    
+    // Números com a mesma representação de Json
+    struct Numbers {
+        std::vector<JsonNumber> values;
+        void onNumber(const JsonNumber& number) { values.push_back(number); }
+    } numbers;
+    ASSERT(Json::parseEvents("[1700000000123456789, 67234.50, 1e2, 18446744073709551615, -3]", numbers));
+    ASSERT_EQ(numbers.values.size(), 5u);
+    ASSERT_EQ(numbers.values[0].getInt(), 1700000000123456789);
+    ASSERT(numbers.values[0].isInteger());
+    ASSERT(numbers.values[1].getDecimal() == Decimal(6723450, 2));
+    ASSERT_EQ(numbers.values[1].getNumber(), 67234.5);
+    ASSERT_EQ(numbers.values[1].getInt(), 67234);
+    ASSERT_EQ(numbers.values[2].getInt(), 100);
+    ASSERT_EQ(numbers.values[3].getUInt(), UINT64_MAX);
+    ASSERT_EQ(numbers.values[4].getUInt(7), 7u);
+}
+
+TEST(events_stop_and_invalid) {
+    // Handler só com os callbacks que usa; false interrompe
+    struct FirstKey {
+        std::string_view key;
+        bool onKey(std::string_view k) { key = k; return false; }
+    } first;
+    std::string input = R"({"stream":"btcusdt@trade","data":{}})";
+    auto stopped = Json::parseEvents(input, first);
+    ASSERT(!stopped);
+    ASSERT(stopped.status == Json::EventResult::Status::Stopped);
+    ASSERT_EQ(first.key, "stream");
+    
+    const char* invalid[] = {"", "{", "[1,2", R"({"a":})", R"({"a" 1})", "[1,]", "01",
+                             "\"abc", "\"\\x\"", "nul", "{} x", "[\"\x01\"]", "[1 2]", "{\"a\":1,}"};
+    for (const char* text : invalid) {
+        EventTrace trace;
+        auto result = Json::parseEvents(text, trace);
+        ASSERT(result.status == Json::EventResult::Status::Invalid);
+        ASSERT(!Json::isValid(text));
+    }
+    EventTrace partial;
+    auto bad = Json::parseEvents(R"({"a":[1,2 x]})", partial);
+    ASSERT(bad.status == Json::EventResult::Status::Invalid);
+    ASSERT_EQ(partial.out, "{k:a [n:1 n:2 ");       // Eventos até o erro já foram entregues
+    std::string deep(1000, '[');
+    ASSERT(!Json::isValid(deep + std::string(1000, ']')));
+    ASSERT(Json::isValid(std::string(500, '[') + std::string(500, ']')));
+}
+
+TEST(events_no_allocations) {
+    struct Sum {
+        double total = 0;
+        size_t strings = 0;
+        void onNumber(const JsonNumber& number) { total += number.getNumber(); }
+        void onString(std::string_view text) { strings += text.size(); }
+    } sum;
+    std::string escaped = R"({"stream":"btcusdt@depth","data":{"b":[["67234.50","1.2"],["67234.40","0.5"]],)"
+                          R"("a":[["67234.60","3.0"]],"note":"tab\there","E":1700000000123}})";
+    std::string input = TradeMessage;
+    for (int i = 0; i < 3; ++i) {
+        ASSERT(Json::parseEvents(input, sum));
+        ASSERT(Json::parseEvents(escaped, sum));
+    }
+    size_t before = allocations.load();
+    for (int i = 0; i < 1000; ++i) {
+        ASSERT(Json::parseEvents(input, sum));
+        ASSERT(Json::parseEvents(escaped, sum));
+    }
+    ASSERT_EQ(allocations.load() - before, 0u);
+}
+
+// ============================================
+// Testes de Consulta por Caminho
+// ============================================
+TEST(query_extract_fields) {
+    JsonQuery query({"/p", "/q", "/T", "/m", "/l/1", "/x", "/missing", "/l"});
+    ASSERT(query.valid());
+    ASSERT_EQ(query.size(), 8u);
+    
+    std::array<JsonField, 8> fields;
+    ASSERT_EQ(query.extract(TradeMessage, fields), 7u);
+    ASSERT_EQ(fields[0].getString(), "67234.50");
+    ASSERT(fields[0].getDecimal() == Decimal(6723450, 2));
+    ASSERT_EQ(fields[1].getDecimal().toTicks(8).value_or(0), 12000);
+    ASSERT_EQ(fields[2].getInt(), 1700000000120);
+    ASSERT(fields[3].getBool());
+    ASSERT_EQ(fields[4].getNumber(), 2.5);
+    ASSERT(fields[5].isNull());
+    ASSERT(!fields[6].found());
+    ASSERT_EQ(fields[6].getInt(-1), -1);
+    ASSERT(fields[7].type() == Json::Type::Array);
+    ASSERT_EQ(fields[7].raw(), "[1,2.5,-3e2]");
+    
+    // Caminhos aninhados, chaves com escape (RFC 6901) e strings com escape
+    std::string nested = R"({"stream":"btcusdt@depth","data":{"b":[["67234.50","1.2"],["67234.40","0.5"]],)"
+                         R"("a/b":{"~k":7},"note":"tab\there","E":1700000000123}})";
+    JsonQuery paths({"/data/b/1/0", "/data/a~1b/~0k", "/data/note", "/data/E", "/data/b/2", ""});
+    JsonField out[6];
+    ASSERT_EQ(paths.extract(nested, out), 5u);
+    ASSERT_EQ(out[0].getString(), "67234.40");
+    ASSERT_EQ(out[1].getInt(), 7);
+    ASSERT(out[2].isEscaped());
+    ASSERT_EQ(out[2].getString("?"), "?");
+    ASSERT_EQ(out[2].getStringCopy(), "tab\there");
+    ASSERT_EQ(out[3].getInt(), 1700000000123);
+    ASSERT(!out[4].found());
+    ASSERT_EQ(out[5].raw(), nested);                // "" é o documento inteiro
+    
+    // Caminhos inválidos não são buscados
+    JsonQuery bad({"p", "/a~2", "/ok"});
+    ASSERT(!bad.valid());
+    std::vector<JsonField> some(3);
+    ASSERT_EQ(bad.extract(R"({"ok":1,"p":2})", some), 1u);
+    ASSERT_EQ(some[2].getInt(), 1);
+}
+
+TEST(query_stops_early) {
+    // Para assim que acha tudo: o resto (mesmo inválido) não é lido
+    JsonQuery query({"/e", "/s"});
+    JsonField fields[2];
+    ASSERT_EQ(query.extract(R"({"e":"trade","s":"BTCUSDT",garbage)", fields), 2u);
+    ASSERT_EQ(fields[1].getString(), "BTCUSDT");
+    
+    // Erro no trecho percorrido encerra a busca
+    ASSERT_EQ(query.extract(R"({"e":"trade" "s":"BTCUSDT"})", fields), 1u);
+    ASSERT(!fields[1].found());
+    ASSERT_EQ(query.extract(R"({"x":[1,{"s":"no"}],"s":"yes","e":tru})", fields), 1u);
+    ASSERT_EQ(fields[1].getString(), "yes");
+    
+    // Menos campos que caminhos: só os primeiros são buscados
+    ASSERT_EQ(query.extract(R"({"s":"BTCUSDT","e":"trade"})", fields, 1), 1u);
+    ASSERT_EQ(fields[0].getString(), "trade");
+    
+    // Sem alocação por mensagem
+    size_t before = allocations.load();
+    for (int i = 0; i < 1000; ++i) {
+        ASSERT_EQ(query.extract(TradeMessage, fields), 2u);
+    }
+    ASSERT_EQ(allocations.load() - before, 0u);
+}
+
+// ============================================
+// Testes de Escrita (JsonWriter)
+// ============================================
+TEST(writer_streaming) {
+    std::string out = "prefix:";
+    JsonWriter writer(out);
+    writer.beginObject()
+          .field("symbol", "BTCUSDT")
+          .field("price", Decimal(6723450, 2))
+          .field("qty", 0.001)
+          .field("ts", int64_t{1700000000123})
+          .field("id", std::numeric_limits<uint64_t>::max())
+          .field("small", static_cast<unsigned short>(7))
+          .field("reduce", false)
+          .field("tag", nullptr);
+    writer.key("legs").beginArray().value(1).value(-2.5).beginObject().endObject().beginArray().endArray().endArray();
+    ASSERT(!writer.complete());
+    writer.endObject();
+    ASSERT(writer.complete());
+    ASSERT_EQ(writer.view(), R"({"symbol":"BTCUSDT","price":67234.50,"qty":0.001,"ts":1700000000123,)"
+                             R"("id":18446744073709551615,"small":7,"reduce":false,"tag":null,"legs":[1,-2.5,{},[]]})");
+    ASSERT_EQ(out.substr(0, 7), "prefix:");
+    ASSERT(Json::parse(writer.view()));
+    
+    // Doubles: menor representação que volta ao mesmo valor
+    auto number = [](double value) {
+        std::string text;
+        JsonWriter(text).value(value);
+        return text;
+    };
+    ASSERT_EQ(number(0.1), "0.1");
+    ASSERT_EQ(number(3.0), "3");
+    ASSERT_EQ(number(-1e300), "-1e+300");
+    ASSERT_EQ(number(67234.5), "67234.5");
+    ASSERT_EQ(number(std::numeric_limits<double>::quiet_NaN()), "null");
+    for (double value : {0.1 + 0.2, 1.0 / 3.0, 5e-324, 1.7976931348623157e308, 123456789.123456789}) {
+        ASSERT_EQ(std::strtod(number(value).c_str(), nullptr), value);
+    }
+    
+    // Escapes em qualquer posição dos blocos de 16 bytes
+    for (size_t length = 0; length < 40; ++length) {
+        for (char special : {'"', '\\', '\n', '\x01', '\x1f'}) {
+            std::string text(length, 'a');
+            if (length) text[length / 3] = special;
+            if (length > 20) text[length - 1] = special;
+            std::string encoded;
+            JsonWriter(encoded).value(text);
+            auto parsed = Json::parse(encoded);
+            ASSERT(parsed && parsed->getString() == text);
+        }
+    }
+    ASSERT_EQ(Json(std::string("\x01\x7f\xc3\xa9")).stringify(), "\"\\u0001\x7f\xc3\xa9\"");
+}
+
+TEST(writer_pretty_and_buffer) {
+    Json json = Json::object();
+    json["a"] = Json::Array{Json(1), Json::object(), Json::array()};
+    ASSERT_EQ(json.stringify(true), "{\n  \"a\": [\n    1,\n    {},\n    []\n  ]\n}");
+    
+    // Buffer do chamador: 0 se não coube
+    char buffer[64];
+    size_t size = json.stringify(buffer, sizeof(buffer));
+    ASSERT_EQ(std::string_view(buffer, size), R"({"a":[1,{},[]]})");
+    ASSERT_EQ(json.stringify(buffer, 10), 0u);
+    JsonWriter small(buffer, 4);
+    small.value("abcdef");
+    ASSERT(small.overflow());
+    ASSERT(!small.complete());
+    
+    // String reutilizada e buffer: sem alocação por mensagem
+    auto trade = Json::parse(TradeMessage);
+    ASSERT(trade);
+    std::string out;
+    trade->stringify(out);
+    const std::string expected = out;
+    char large[512];
+    size_t before = allocations.load();
+    for (int i = 0; i < 1000; ++i) {
+        out.clear();
+        trade->stringify(out);
+        ASSERT_EQ(trade->stringify(large, sizeof(large)), expected.size());
+    }
+    ASSERT_EQ(allocations.load() - before, 0u);
+    ASSERT_EQ(out, expected);
+    ASSERT(Json::parse(out) == trade);
+}
+
+// ============================================
+// Testes de Binding (GG_JSON_BIND)
+// ============================================
+struct BoundLevel {
+    Decimal price;
+    Decimal qty;
+};
+GG_JSON_BIND(BoundLevel, price, qty)
+
+struct BoundTrade {
+    std::string_view e;
+    std::string_view s;
+    uint64_t t = 0;
+    Decimal p;
+    Decimal q;
+    int64_t T = 0;
+    bool m = false;
+};
+GG_JSON_BIND(BoundTrade, e, s, t, p, q, T, m)
+
+struct BoundBook {
+    std::string symbol;
+    double weight = 0.0;
+    uint8_t depth = 0;
+    std::optional<int32_t> seq;
+    std::vector<BoundLevel> bids;
+    std::vector<std::string> tags;
+};
+GG_JSON_BIND(BoundBook, symbol, weight, depth, seq, bids, tags)
+
+TEST(bind_decode_encode) {
+    // Campos fora da struct ("E", "b", "a", "M") são pulados
+    BoundTrade trade;
+    ASSERT(decodeJson(TradeMessage, trade));
+    ASSERT_EQ(trade.e, "trade");
+    ASSERT_EQ(trade.s, "BTCUSDT");
+    ASSERT_EQ(trade.t, 12345u);
+    ASSERT(trade.p == Decimal(6723450, 2));
+    ASSERT_EQ(trade.q.toString(), "0.00012");
+    ASSERT_EQ(trade.T, 1700000000120);
+    ASSERT(trade.m);
+    
+    // Encode na ordem do GG_JSON_BIND; volta igual
+    std::string text = encodeJson(trade);
+    ASSERT_EQ(text, R"({"e":"trade","s":"BTCUSDT","t":12345,"p":67234.50,"q":0.00012,"T":1700000000120,"m":true})");
+    char buffer[128];
+    ASSERT_EQ(std::string_view(buffer, encodeJson(trade, buffer, sizeof(buffer))), text);
+    ASSERT_EQ(encodeJson(trade, buffer, 16), 0u);
+    BoundTrade again;
+    ASSERT(decodeJson(text, again));
+    ASSERT(again.p == trade.p && again.q == trade.q && again.T == trade.T && again.s == trade.s);
+    
+    // Aninhados, vector, optional e strings com escape
+    BoundBook book;
+    ASSERT(decodeJson(R"({"symbol":"BTC\/USDT","seq":7,"bids":[{"price":"1.5","qty":2},{"qty":"0.1","price":3}],)"
+                      R"("extra":{"x":[1,{"y":null}]},"tags":["a\"b"],"weight":0.25,"depth":20})", book));
+    ASSERT_EQ(book.symbol, "BTC/USDT");
+    ASSERT(book.seq && *book.seq == 7);
+    ASSERT_EQ(book.bids.size(), 2u);
+    ASSERT(book.bids[1].price == Decimal(3, 0));
+    ASSERT_EQ(book.tags[0], "a\"b");
+    ASSERT_EQ(book.weight, 0.25);
+    ASSERT_EQ(book.depth, 20);
+    ASSERT(decodeJson(R"({"seq":null,"bids":[]})", book));
+    ASSERT(!book.seq);
+    ASSERT(book.bids.empty());
+    ASSERT_EQ(encodeJson(book), R"({"symbol":"BTC/USDT","weight":0.25,"depth":20,"seq":null,"bids":[],"tags":["a\"b"]})");
+    
+    // O encode é JSON que o parse aceita
+    auto parsed = Json::parse(encodeJson(book));
+    ASSERT(parsed && parsed->get("tags")[0].getString() == "a\"b");
+}
+
+TEST(bind_rejects_mismatches) {
+    BoundBook book;
+    ASSERT(!decodeJson(R"({"depth":256})", book));          // Não cabe em uint8
+    ASSERT(!decodeJson(R"({"depth":-1})", book));
+    ASSERT(!decodeJson(R"({"depth":1.5})", book));          // Inteiro exige valor inteiro
+    ASSERT(!decodeJson(R"({"depth":"20x"})", book));        // String numérica inteira
+    ASSERT(!decodeJson(R"({"symbol":1})", book));
+    ASSERT(!decodeJson(R"({"bids":{}})", book));
+    ASSERT(!decodeJson(R"({"symbol":"a"} x)", book));
+    ASSERT(!decodeJson(R"({"extra":[1,}],"symbol":"a"})", book));   // Chave pulada também é validada
+    ASSERT(!decodeJson(R"([1])", book));
+    
+    // string_view não aceita escape (não há onde guardar o texto decodificado)
+    BoundTrade trade;
+    ASSERT(!decodeJson(R"({"s":"BTC\nUSDT"})", trade));
+    ASSERT(decodeJson(R"({"p":"-0.5","T":-3})", trade));
+    ASSERT(trade.p == Decimal(-5, 1));
+    ASSERT_EQ(trade.T, -3);
+}
+
+TEST(bind_no_allocations) {
+    // Só campos de tamanho fixo e views: nenhuma alocação por mensagem
+    BoundTrade trade;
+    std::string out;
+    out.reserve(256);
+    size_t before = allocations.load();
+    for (int i = 0; i < 1000; ++i) {
+        ASSERT(decodeJson(TradeMessage, trade));
+        out.clear();
+        encodeJson(trade, out);
+    }
+    ASSERT_EQ(allocations.load() - before, 0u);
+    ASSERT_EQ(trade.T, 1700000000120);
+}
+
+// ============================================
+// Testes de Json::Object
+// ============================================
+TEST(object_insertion_order) {
+    auto json = Json::parse(R"({"z":1,"a":2,"m":3,"a":4})");
+    ASSERT(json.has_value());
+    // Ordem do documento; chave repetida: vale a última, na primeira posição
+    ASSERT_EQ(json->stringify(), R"({"z":1,"a":4,"m":3})");
+    std::vector<std::string> keys = json->keys();
+    ASSERT_EQ(keys.size(), 3u);
+    ASSERT_EQ(keys[0], "z");
+    ASSERT_EQ(keys[2], "m");
+
+    Json built;
+    built["second"] = 2;
+    built["first"] = 1;
+    built["second"] = 20;
+    ASSERT_EQ(built.stringify(), R"({"second":20,"first":1})");
+    built.erase("second");
+    built["third"] = 3;
+    ASSERT_EQ(built.stringify(), R"({"first":1,"third":3})");
+
+    // Igualdade não depende da ordem
+    ASSERT_EQ(*Json::parse(R"({"a":1,"b":2})"), *Json::parse(R"({"b":2,"a":1})"));
+    ASSERT_NE(*Json::parse(R"({"a":1,"b":2})"), *Json::parse(R"({"a":1,"c":2})"));
+}
+
+TEST(object_for_each_pair) {
+    auto json = Json::parse(R"({"b":1,"a":2})");
+    ASSERT(json.has_value());
+    std::string order;
+    json->forEachPair([&](std::string_view key, const Json&) { order += key; });
+    ASSERT_EQ(order, "ba");
+
+    // Assinaturas anteriores à chave como string_view
+    int64_t sum = 0;
+    json->forEachPair([&](const std::string& key, const Json& value) { order += key; sum += value.getInt(); });
+    json->forEachPair([&](auto& key, auto& value) { order += key; sum += value.getInt(); });
+    ASSERT_EQ(order, "bababa");
+    ASSERT_EQ(sum, 6);
+
+    // Handle movido: cópia e atribuição não tocam na chave que não existe mais
+    detail::KeyHandle key("b");
+    detail::KeyHandle moved(std::move(key));
+    detail::KeyHandle copy(key);
+    copy = moved;
+    ASSERT_EQ(copy.view(), "b");
+}
+
+TEST(object_large_and_long_keys) {
+    // Acima de IndexThreshold: busca pelo índice, inclusive depois de erase e cópia
+    Json json = Json::object();
+    const size_t count = JsonObject::IndexThreshold * 8;
+    for (size_t i = 0; i < count; ++i) json["key" + std::to_string(i)] = static_cast<int64_t>(i);
+    ASSERT_EQ(json.size(), count);
+    for (size_t i = 0; i < count; ++i) ASSERT_EQ(json["key" + std::to_string(i)].getInt(), static_cast<int64_t>(i));
+    ASSERT(!json.contains("key" + std::to_string(count)));
+
+    for (size_t i = 0; i < count; i += 2) json.erase("key" + std::to_string(i));
+    ASSERT_EQ(json.size(), count / 2);
+    Json copy = json;
+    for (size_t i = 0; i < count; ++i) {
+        ASSERT_EQ(copy.contains("key" + std::to_string(i)), i % 2 == 1);
+    }
+    ASSERT_EQ(copy, json);
+    ASSERT_EQ(json.keys().front(), "key1");
+
+    // Chaves acima de MaxInternedSize são cópias do membro
+    const std::string longKey(detail::KeyHandle::MaxInternedSize + 10, 'k');
+    const std::string escaped = R"({")" + longKey + R"(":1,"tab\tkey":2,"short":3})";
+    auto parsed = Json::parse(escaped);
+    ASSERT(parsed.has_value());
+    ASSERT_EQ(parsed->get(longKey).getInt(), 1);
+    ASSERT_EQ(parsed->get("tab\tkey").getInt(), 2);
+    Json other = *parsed;
+    ASSERT_EQ(other.keys()[0], longKey);
+    ASSERT_EQ(other, *parsed);
+}
+
+TEST(object_parse_allocations) {
+    // Chaves internadas: o object custa só o bloco de membros
+    constexpr std::string_view message = R"({"e":"trade","E":1700000000123,"p":67234.5,"q":0.001,"m":true})";
+    ASSERT(Json::parse(message).has_value());
+    size_t before = allocations.load();
+    for (int i = 0; i < 100; ++i) {
+        auto json = Json::parse(message);
+        ASSERT(json.has_value());
+        ASSERT_EQ(json->get("E").getInt(), 1700000000123);
+    }
+    // Uma alocação por mensagem: o bloco de membros ("trade" cabe no SSO)
+    ASSERT_EQ(allocations.load() - before, 100u);
+}
+
+TEST(object_references_stable) {
+    // Rodado também com -fsanitize=address: nenhuma inserção move valores
+    Json object = Json::object();
+    object["a"] = 1;
+    object["b"] = object["a"];
+    ASSERT_EQ(object["b"].getInt(), 1);
+    object["c"] = Json::parse(R"({"x":[1,2,3]})").value();
+    object["d"] = object["c"]["x"];
+    ASSERT_EQ(object["d"].stringify(), "[1,2,3]");
+
+    // Referência guardada sobrevive a blocos novos e à montagem do índice
+    Json& a = object["a"];
+    const Json* c = &object["c"];
+    for (int i = 0; i < 100; ++i) object["k" + std::to_string(i)] = i;
+    ASSERT_EQ(a.getInt(), 1);
+    ASSERT_EQ(&object["c"], c);
+    a = 2;
+    ASSERT_EQ(object["a"].getInt(), 2);
+
+    // Parse (um bloco exato) seguido de inserções
+    auto parsed = Json::parse(R"({"p":"1.5","q":"2"})");
+    ASSERT(parsed.has_value());
+    Json& p = (*parsed)["p"];
+    (*parsed)["r"] = (*parsed)["q"];
+    (*parsed)["s"] = p;
+    ASSERT_EQ(p.getString(), "1.5");
+    ASSERT_EQ(parsed->stringify(), R"({"p":"1.5","q":"2","r":"2","s":"1.5"})");
+
+    // erase anda com os seguintes, atravessando blocos, e mantém a ordem
+    parsed->erase("q");
+    ASSERT_EQ(parsed->stringify(), R"({"p":"1.5","r":"2","s":"1.5"})");
+    (*parsed)["t"] = 4;
+    ASSERT_EQ(parsed->stringify(), R"({"p":"1.5","r":"2","s":"1.5","t":4})");
+}
+
+TEST(object_key_lookup) {
+    static constexpr Json::Key Price{"p"};
+    static constexpr Json::Key Missing{"x"};
+    static_assert(Price.hash() == detail::objectKeyHash("p"));
+
+    auto json = Json::parse(R"({"e":"trade","p":"67234.50","q":"0.001"})");
+    ASSERT(json.has_value());
+    ASSERT_EQ((*json)[Price].getString(), "67234.50");
+    ASSERT_EQ(json->get(Price).getDecimal(), Decimal(6723450, 2));
+    ASSERT(json->contains(Price));
+    ASSERT(!json->contains(Missing));
+    ASSERT((*json)[Missing].isNull());
+    ASSERT(Json(1)[Price].isNull());
+
+    // Object grande (índice) e inserção pela Key
+    Json large = Json::object();
+    for (int i = 0; i < 40; ++i) large["k" + std::to_string(i)] = i;
+    static constexpr Json::Key K39{"k39"};
+    ASSERT_EQ(large[K39].getInt(), 39);
+    large[Missing] = "novo";
+    ASSERT_EQ(large.get(Missing).getString(), "novo");
+    ASSERT_EQ(large.keys().back(), "x");
+
+    // Nenhuma busca aloca, por Key ou por string_view
+    const Json& message = *json;
+    const std::string key = "q";
+    size_t before = allocations.load();
+    for (int i = 0; i < 1000; ++i) {
+        ASSERT(!message[Price].isNull());
+        ASSERT(!message[key].isNull());
+        ASSERT(large.contains(K39));
+    }
+    ASSERT_EQ(allocations.load() - before, 0u);
+}
+
+// ============================================
+// Testes do Índice Estrutural
+// ============================================
+using internal::json::StructuralIndex;
+
+// Referência byte a byte: mesmas regras do estágio 1, sem bits
+static bool referenceTokens(std::string_view input, std::vector<uint32_t>& tokens) {
+    tokens.clear();
+    bool inString = false, escaped = false, boundary = true;
+    for (uint32_t i = 0; i < input.size(); ++i) {
+        const char c = input[i];
+        const bool isEscaped = escaped;
+        escaped = c == '\\' && !isEscaped;
+        const bool quote = c == '"' && !isEscaped;
+        if (inString) {
+            if (quote) {
+                tokens.push_back(i);
+                inString = false;
+                boundary = true;
+            } else if (static_cast<unsigned char>(c) < 0x20) {
+                return false;
+            }
+            continue;
+        }
+        if (quote) {
+            tokens.push_back(i);
+            inString = true;
+        } else if (c == '{' || c == '}' || c == '[' || c == ']' || c == ':' || c == ',') {
+            tokens.push_back(i);
+            boundary = true;
+        } else if (c == ' ' || c == '\t' || c == '\n' || c == '\r') {
+            boundary = true;
+        } else {
+            if (boundary && c != '"') tokens.push_back(i);
+            boundary = false;
+        }
+    }
+    return !inString;
+}
+
+TEST(structural_index_tokens) {
+    std::string input = R"( {"a\"b":[1, tru e],"c":"\\"})";
+    StructuralIndex index;
+    ASSERT(index.build(input));
+    std::vector<uint32_t> tokens(index.begin(), index.end());
+    std::vector<uint32_t> expected = {1, 2, 7, 8, 9, 10, 11, 13, 17, 18, 19, 20, 22, 23, 24, 27, 28};
+    ASSERT(tokens == expected);
+    
+    ASSERT(!index.build(R"(["abc)"));                  // String não terminada
+    ASSERT(!index.build("[\"a\nb\"]"));                // Controle dentro de string
+    ASSERT(index.build("[\"a\"]\n"));                  // Fora de string é espaço
+    ASSERT(index.build(""));
+    ASSERT_EQ(index.size(), 0u);
+}
+
+TEST(structural_index_kernels_agree) {
+    // Entradas pseudo-aleatórias cruzando fronteiras de bloco (64 bytes),
+    // com sequências de barras invertidas e aspas escapadas
+    const char alphabet[] = "{}[]:,\"\"\\\\\\ ab1\n\x01";
+    const StructuralIndex::Kernel kernels[] = {
+        StructuralIndex::Kernel::Scalar, StructuralIndex::Kernel::Sse2, StructuralIndex::Kernel::Avx2
+    };
+    uint32_t seed = 12345;
+    StructuralIndex index;
+    std::vector<uint32_t> expected;
+    for (int round = 0; round < 3000; ++round) {
+        std::string input;
+        const size_t length = round % 300;
+        for (size_t i = 0; i < length; ++i) {
+            seed = seed * 1103515245 + 12345;
+            // Controle é raro: senão quase toda entrada falharia cedo
+            size_t pick = (seed >> 16) % (sizeof(alphabet) - 1);
+            if (alphabet[pick] == '\x01' && (seed >> 8) % 8) pick = 0;
+            input += alphabet[pick];
+        }
+        const bool ok = referenceTokens(input, expected);
+        for (auto kernel : kernels) {
+            ASSERT_EQ(index.build(input, kernel), ok);
+            if (ok) ASSERT(std::vector<uint32_t>(index.begin(), index.end()) == expected);
+        }
+    }
+}
+
+TEST(parse_token_boundaries) {
+    // Lixo colado em escalares e strings
+    ASSERT(!Json::parse("12x").has_value());
+    ASSERT(!Json::parse("[1 2]").has_value());
+    ASSERT(!Json::parse(R"(["a"b])").has_value());
+    ASSERT(!Json::parse(R"({"a":1}x)").has_value());
+    ASSERT(!Json::parse("nullx").has_value());
+    ASSERT(!Json::parse("tru e").has_value());
+    ASSERT(!Json::parse("[1,]").has_value());
+    ASSERT(!Json::parse(R"({"a" 1})").has_value());
+    ASSERT(!Json::parse("").has_value());
+    ASSERT(!Json::parse("   ").has_value());
+    ASSERT(Json::parse(" \n[ 1 ,\t2 ] \r\n").has_value());
+    
+    // Aspa escapada e barras na fronteira de bloco (64 bytes)
+    for (size_t pad = 55; pad < 70; ++pad) {
+        std::string text = std::string(pad, 'x') + "\\\"q\\\\";
+        std::string input = R"({"k":")" + text + R"(","n":-1.5e3})";
+        auto json = Json::parse(input);
+        ASSERT(json.has_value());
+        ASSERT_EQ((*json)["k"].getString(), std::string(pad, 'x') + "\"q\\");
+        ASSERT_EQ((*json)["n"].getNumber(), -1500.0);
+        
+        JsonDocument doc;
+        ASSERT(doc.parse(input));
+        ASSERT_EQ(doc["k"].getString(), (*json)["k"].getString());
+    }
+}
+
 // ============================================
 // Main
 // ============================================
@@ -380,6 +1310,50 @@ int main() {
     std::cout << "\nRoundtrip:\n";
     RUN_TEST(roundtrip);
     
+    std::cout << "\nJsonDocument:\n";
+    RUN_TEST(document_parse_types);
+    RUN_TEST(document_escapes_and_lookup);
+    RUN_TEST(document_invalid);
+    RUN_TEST(document_matches_dom);
+    RUN_TEST(document_reuse_no_allocations);
+    
+    std::cout << "\nNúmeros:\n";
+    RUN_TEST(number_exact_integers);
+    RUN_TEST(number_matches_strtod);
+    RUN_TEST(decimal_exact);
+    RUN_TEST(decimal_scale_bounded);
+    
+    std::cout << "\nEventos (SAX):\n";
+    RUN_TEST(events_sequence);
+    RUN_TEST(events_stop_and_invalid);
+    RUN_TEST(events_no_allocations);
+    
+    std::cout << "\nConsulta (JsonQuery):\n";
+    RUN_TEST(query_extract_fields);
+    RUN_TEST(query_stops_early);
+    
+    std::cout << "\nEscrita (JsonWriter):\n";
+    RUN_TEST(writer_streaming);
+    RUN_TEST(writer_pretty_and_buffer);
+    
+    std::cout << "\nBinding (GG_JSON_BIND):\n";
+    RUN_TEST(bind_decode_encode);
+    RUN_TEST(bind_rejects_mismatches);
+    RUN_TEST(bind_no_allocations);
+    
+    std::cout << "\nObject (ordem e chaves internadas):\n";
+    RUN_TEST(object_insertion_order);
+    RUN_TEST(object_for_each_pair);
+    RUN_TEST(object_large_and_long_keys);
+    RUN_TEST(object_parse_allocations);
+    RUN_TEST(object_key_lookup);
+    RUN_TEST(object_references_stable);
+    
+    std::cout << "\nÍndice estrutural:\n";
+    RUN_TEST(structural_index_tokens);
+    RUN_TEST(structural_index_kernels_agree);
+    RUN_TEST(parse_token_boundaries);
+    
     std::cout << "\n=== TODOS OS TESTES PASSARAM ===\n";
     return 0;
 }
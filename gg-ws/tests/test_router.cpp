@@ -0,0 +1,155 @@
+#include "gg_ws/router.hpp"
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace gg;
+
+// ============================================
+// Macros de Teste
+// ============================================
+#define TEST(name) void test_##name()
+#define RUN_TEST(name) \
+    std::cout << "  " << #name << "... "; \
+    test_##name(); \
+    std::cout << "OK\n"
+
+#define ASSERT(expr) \
+    if (!(expr)) { \
+        std::cerr << "\nFALHA: " << #expr << " em " << __FILE__ << ":" << __LINE__ << "\n"; \
+        std::exit(1); \
+    }
+
+#define ASSERT_EQ(a, b) ASSERT((a) == (b))
+
+// ============================================
+// Varredura da chave
+// ============================================
+TEST(find_string_value) {
+    MessageRouter router("e");
+    ASSERT_EQ(router.key(), "e");
+    ASSERT_EQ(router.findValue(R"({"e":"trade","s":"BTCUSDT"})"), "trade");
+    ASSERT_EQ(router.findValue(R"({"s":"BTCUSDT", "e" :  "depthUpdate" })"), "depthUpdate");
+    ASSERT_EQ(router.findValue("{\n  \"e\":\n\t\"kline\"\n}"), "kline");
+    ASSERT_EQ(router.findValue(R"({"e":""})"), "");
+    ASSERT(router.findValue(R"({"e":""})").data() != nullptr);
+}
+
+TEST(find_scalar_value) {
+    MessageRouter router("id");
+    ASSERT_EQ(router.findValue(R"({"id":42,"x":1})"), "42");
+    ASSERT_EQ(router.findValue(R"({"id":-7})"), "-7");
+    ASSERT_EQ(router.findValue(R"({"id": true ,"x":1})"), "true");
+    ASSERT_EQ(router.findValue(R"({"id":null})"), "null");
+}
+
+TEST(find_skips_false_matches) {
+    MessageRouter router("e");
+    // "e" como valor, não como chave
+    ASSERT_EQ(router.findValue(R"({"x":"e","e":"trade"})"), "trade");
+    // "e" escapado dentro de string
+    ASSERT_EQ(router.findValue(R"({"msg":"a \"e\": b","e":"book"})"), "book");
+    // Chaves que só contêm "e" como sufixo/prefixo
+    ASSERT_EQ(router.findValue(R"({"type":"x","ee":"y","e":"z"})"), "z");
+    // Escape dentro do valor não termina a string
+    ASSERT_EQ(router.findValue(R"({"e":"a\"b"})"), R"(a\"b)");
+}
+
+TEST(find_missing_key) {
+    MessageRouter router("channel");
+    ASSERT(router.findValue(R"({"e":"trade"})").data() == nullptr);
+    ASSERT(router.findValue("").data() == nullptr);
+    ASSERT(router.findValue(R"({"channel")").data() == nullptr);
+    ASSERT(router.findValue(R"({"channel":)").data() == nullptr);
+    ASSERT(router.findValue(R"({"channel":"unterminated)").data() == nullptr);
+}
+
+// ============================================
+// Dispatch
+// ============================================
+TEST(dispatch_routes_and_fallback) {
+    int trades = 0, depth = 0, other = 0;
+    MessageRouter router("e");
+    router.on("trade", [&](std::string_view msg) {
+              ASSERT(msg.find("BTCUSDT") != std::string_view::npos);
+              trades++;
+          })
+          .on("depthUpdate", [&](std::string_view) { depth++; })
+          .otherwise([&](std::string_view) { other++; });
+    router.build();
+    ASSERT(router.built());
+
+    ASSERT(router.dispatch(R"({"e":"trade","s":"BTCUSDT"})"));
+    ASSERT(router.dispatch(R"({"e":"depthUpdate","s":"BTCUSDT"})"));
+    ASSERT(!router.dispatch(R"({"e":"kline"})"));
+    ASSERT(!router.dispatch(R"({"result":null,"id":1})"));
+    ASSERT(!router.dispatch(R"({"e":"trades"})"));
+
+    ASSERT_EQ(trades, 1);
+    ASSERT_EQ(depth, 1);
+    ASSERT_EQ(other, 3);
+}
+
+TEST(dispatch_without_build_and_replace) {
+    int first = 0, second = 0;
+    MessageRouter router("topic");
+    router.on("a", [&](std::string_view) { first++; });
+    ASSERT(!router.built());
+    ASSERT(router.dispatch(R"({"topic":"a"})"));
+
+    // Mesmo valor substitui o handler
+    router.on("a", [&](std::string_view) { second++; });
+    router.build();
+    ASSERT(router.dispatch(R"({"topic":"a"})"));
+    ASSERT_EQ(router.size(), 1u);
+    ASSERT_EQ(first, 1);
+    ASSERT_EQ(second, 1);
+}
+
+TEST(perfect_hash_many_values) {
+    std::vector<std::string> values;
+    for (int i = 0; i < 500; ++i) {
+        values.push_back("btcusdt@depth" + std::to_string(i));
+    }
+
+    std::vector<int> hits(values.size(), 0);
+    MessageRouter router("stream");
+    for (size_t i = 0; i < values.size(); ++i) {
+        router.on(values[i], [&hits, i](std::string_view) { hits[i]++; });
+    }
+    router.build();
+    ASSERT(router.tableSize() >= values.size());
+    ASSERT((router.tableSize() & (router.tableSize() - 1)) == 0);
+
+    for (size_t i = 0; i < values.size(); ++i) {
+        ASSERT(router.dispatch("{\"stream\":\"" + values[i] + "\",\"data\":{}}"));
+    }
+    for (int h : hits) ASSERT_EQ(h, 1);
+
+    // Valores não registrados nunca caem em handler alheio
+    for (int i = 500; i < 2000; ++i) {
+        ASSERT(!router.dispatch("{\"stream\":\"btcusdt@depth" + std::to_string(i) + "\"}"));
+    }
+}
+
+// ============================================
+// Main
+// ============================================
+int main() {
+    std::cout << "=== Testes do MessageRouter ===\n\n";
+
+    std::cout << "Varredura:\n";
+    RUN_TEST(find_string_value);
+    RUN_TEST(find_scalar_value);
+    RUN_TEST(find_skips_false_matches);
+    RUN_TEST(find_missing_key);
+
+    std::cout << "\nDispatch:\n";
+    RUN_TEST(dispatch_routes_and_fallback);
+    RUN_TEST(dispatch_without_build_and_replace);
+    RUN_TEST(perfect_hash_many_values);
+
+    std::cout << "\n=== TODOS OS TESTES PASSARAM ===\n";
+    return 0;
+}
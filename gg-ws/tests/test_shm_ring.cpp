@@ -0,0 +1,302 @@
+#include "gg_ws/gg_ws.hpp"
+#include "gg_ws/shm_ring.hpp"
+#include "local_server.hpp"
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace gg;
+
+// ============================================
+// Macros de Teste
+// ============================================
+#define TEST(name) void test_##name()
+#define RUN_TEST(name) \
+    std::cout << "  " << #name << "... " << std::flush; \
+    test_##name(); \
+    std::cout << "OK\n"
+
+#define ASSERT(expr) \
+    if (!(expr)) { \
+        std::cerr << "\nFALHA: " << #expr << " em " << __FILE__ << ":" << __LINE__ << "\n"; \
+        std::exit(1); \
+    }
+
+#define ASSERT_EQ(a, b) ASSERT((a) == (b))
+
+static std::string ringName(const char* tag) {
+    return "/gg_ws_test_" + std::string(tag) + "_" + std::to_string(getpid());
+}
+
+// Payload determinístico derivado do número de sequência
+static std::string payloadFor(uint64_t seq) {
+    std::string s = "{\"seq\":" + std::to_string(seq) + ",\"pad\":\"";
+    s.append(seq % 97, 'x');
+    s += "\"}";
+    return s;
+}
+
+// ============================================
+// Testes
+// ============================================
+TEST(publish_subscribe_order) {
+    std::string name = ringName("order");
+    ShmPublisher pub;
+    ASSERT(pub.open(name, 4096));
+
+    ShmSubscriber sub;
+    ASSERT(sub.open(name));
+
+    for (int i = 0; i < 10; ++i) {
+        ASSERT(pub.publish(payloadFor(i + 1), i == 9) != 0);
+    }
+
+    std::vector<uint64_t> seqs;
+    bool lastBinary = false;
+    size_t n = sub.poll([&](const ShmMessage& msg) {
+        ASSERT(msg.data == payloadFor(msg.seq));
+        seqs.push_back(msg.seq);
+        lastBinary = msg.binary;
+    });
+
+    ASSERT_EQ(n, 10u);
+    for (size_t i = 0; i < seqs.size(); ++i) {
+        ASSERT_EQ(seqs[i], i + 1);
+    }
+    ASSERT(lastBinary);
+    ASSERT_EQ(sub.dropped(), 0u);
+    ASSERT_EQ(sub.poll([](const ShmMessage&) {}), 0u);
+
+    ShmPublisher::unlink(name);
+}
+
+TEST(wrap_around) {
+    std::string name = ringName("wrap");
+    ShmPublisher pub;
+    ASSERT(pub.open(name, 4096));
+    ShmSubscriber sub;
+    ASSERT(sub.open(name));
+
+    // Leitor acompanha o writer: 100 voltas no ring sem perda
+    uint64_t expected = 1;
+    for (uint64_t i = 1; i <= 5000; ++i) {
+        ASSERT(pub.publish(payloadFor(i)) == i);
+        if (i % 7 == 0) {
+            sub.poll([&](const ShmMessage& msg) {
+                ASSERT_EQ(msg.seq, expected);
+                ASSERT(msg.data == payloadFor(msg.seq));
+                expected++;
+            });
+        }
+    }
+    sub.poll([&](const ShmMessage& msg) {
+        ASSERT_EQ(msg.seq, expected);
+        expected++;
+    });
+
+    ASSERT_EQ(expected, 5001u);
+    ASSERT_EQ(sub.dropped(), 0u);
+    ASSERT_EQ(sub.laps(), 0u);
+
+    ShmPublisher::unlink(name);
+}
+
+TEST(message_too_large_rejected) {
+    std::string name = ringName("large");
+    ShmPublisher pub;
+    ASSERT(pub.open(name, 4096));
+    ASSERT_EQ(pub.publish(std::string(4000, 'x')), 0u);
+    ASSERT(pub.publish("ok") != 0);
+    ShmPublisher::unlink(name);
+}
+
+TEST(slow_consumer_is_lapped) {
+    std::string name = ringName("lap");
+    ShmPublisher pub;
+    ASSERT(pub.open(name, 4096));
+    ShmSubscriber sub;
+    ASSERT(sub.open(name));
+
+    // Writer dá várias voltas sem o leitor consumir: não pode bloquear
+    const uint64_t total = 2000;
+    for (uint64_t i = 1; i <= total; ++i) {
+        ASSERT(pub.publish(payloadFor(i)) == i);
+    }
+
+    // Ultrapassado: salta para a posição atual do writer
+    ASSERT_EQ(sub.poll([](const ShmMessage&) {}), 0u);
+    ASSERT(sub.laps() > 0);
+
+    // Volta a receber em ordem; o salto aparece como perda
+    ASSERT(pub.publish(payloadFor(total + 1)) == total + 1);
+    uint64_t last = 0;
+    ASSERT_EQ(sub.poll([&](const ShmMessage& msg) {
+        ASSERT(msg.data == payloadFor(msg.seq));
+        last = msg.seq;
+    }), 1u);
+    ASSERT_EQ(last, total + 1);
+    ASSERT_EQ(sub.dropped(), total);
+
+    ShmPublisher::unlink(name);
+}
+
+TEST(cross_process_fanout) {
+    std::string name = ringName("xproc");
+    const int consumers = 3;
+    const uint64_t total = 1000000;
+
+    ShmPublisher pub;
+    ASSERT(pub.open(name, 64 * 1024 * 1024));
+
+    int readyPipe[2], resultPipe[2];
+    ASSERT(pipe(readyPipe) == 0 && pipe(resultPipe) == 0);
+
+    std::vector<pid_t> children;
+    for (int c = 0; c < consumers; ++c) {
+        pid_t pid = fork();
+        ASSERT(pid >= 0);
+        if (pid == 0) {
+            ShmSubscriber sub;
+            if (!sub.open(name)) _exit(2);
+            char one = 1;
+            if (write(readyPipe[1], &one, 1) != 1) _exit(3);
+
+            uint64_t last = 0, received = 0;
+            bool ordered = true;
+            auto start = std::chrono::steady_clock::now();
+            auto deadline = start + std::chrono::seconds(30);
+            while (last < total && std::chrono::steady_clock::now() < deadline) {
+                sub.poll([&](const ShmMessage& msg) {
+                    bool payloadOk = msg.seq > total ? msg.data == "end" : msg.data == payloadFor(msg.seq);
+                    if (msg.seq <= last || !payloadOk) ordered = false;
+                    last = msg.seq;
+                    received++;
+                });
+            }
+            double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+            char line[128];
+            int len = std::snprintf(line, sizeof(line), "%llu %llu %.0f\n",
+                static_cast<unsigned long long>(received),
+                static_cast<unsigned long long>(sub.dropped()),
+                received / secs);
+            if (write(resultPipe[1], line, len) != len) _exit(4);
+            _exit(ordered && last >= total && received + sub.dropped() == last ? 0 : 1);
+        }
+        children.push_back(pid);
+    }
+
+    for (int c = 0; c < consumers; ++c) {
+        char b;
+        ASSERT(read(readyPipe[0], &b, 1) == 1);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    for (uint64_t i = 1; i <= total; ++i) {
+        pub.publish(payloadFor(i));
+    }
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    // Consumidores ultrapassados no fim só terminam ao ver algo além de `total`
+    size_t finished = 0;
+    while (finished < children.size()) {
+        pub.publish("end");
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        for (pid_t& pid : children) {
+            int status = 0;
+            if (pid > 0 && waitpid(pid, &status, WNOHANG) == pid) {
+                ASSERT(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+                pid = -1;
+                finished++;
+            }
+        }
+    }
+    close(resultPipe[1]);
+
+    char buf[512] = {};
+    ssize_t n = read(resultPipe[0], buf, sizeof(buf) - 1);
+    ASSERT(n > 0);
+
+    std::cout << "\n    publisher: " << static_cast<uint64_t>(total / secs) << " msg/s\n";
+    std::string results(buf, static_cast<size_t>(n));
+    size_t pos = 0;
+    while (pos < results.size()) {
+        size_t end = results.find('\n', pos);
+        std::cout << "    consumidor (recebidas perdidas msg/s): " << results.substr(pos, end - pos) << "\n";
+        pos = end + 1;
+    }
+    std::cout << "    ";
+
+    close(readyPipe[0]);
+    close(readyPipe[1]);
+    close(resultPipe[0]);
+    ShmPublisher::unlink(name);
+}
+
+TEST(websocket_publishes_received_messages) {
+    std::string name = ringName("ws");
+    const int total = 500;
+
+    test::LocalServer server([&](test::Connection& conn) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        for (int i = 1; i <= total; ++i) {
+            conn.sendText(payloadFor(i));
+        }
+        conn.waitClose();
+    });
+
+    WebSocketConfig config{.url = server.url()};
+    config.autoReconnect = false;
+    config.ping.mode = PingMode::Disabled;
+    WebSocket ws(config);
+    ASSERT(ws.publishToSharedMemory(name, 1024 * 1024));
+
+    ShmSubscriber sub;
+    ASSERT(sub.open(name));
+    ASSERT(ws.connect());
+
+    uint64_t expected = 1;
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (expected <= total && std::chrono::steady_clock::now() < deadline) {
+        sub.poll([&](const ShmMessage& msg) {
+            ASSERT_EQ(msg.seq, expected);
+            ASSERT(msg.data == payloadFor(expected));
+            ASSERT(!msg.binary);
+            expected++;
+        });
+    }
+    ws.disconnect();
+
+    ASSERT_EQ(expected, static_cast<uint64_t>(total + 1));
+    ShmPublisher::unlink(name);
+}
+
+// ============================================
+// Main
+// ============================================
+int main() {
+    std::cout << "=== Testes do Ring em Memória Compartilhada ===\n\n";
+
+    std::cout << "Ring:\n";
+    RUN_TEST(publish_subscribe_order);
+    RUN_TEST(wrap_around);
+    RUN_TEST(message_too_large_rejected);
+    RUN_TEST(slow_consumer_is_lapped);
+
+    std::cout << "\nMultiprocesso:\n";
+    RUN_TEST(cross_process_fanout);
+
+    std::cout << "\nWebSocket:\n";
+    RUN_TEST(websocket_publishes_received_messages);
+
+    std::cout << "\n=== TODOS OS TESTES PASSARAM ===\n";
+    return 0;
+}
@@ -1,12 +1,14 @@
 #include "gg_ws/gg_ws.hpp"
 #include "../src/internal/message_queue.hpp"
 #include "../src/internal/memory_pool.hpp"
+#include "../src/internal/send_combiner.hpp"
 
 #include <iostream>
 #include <thread>
 #include <vector>
 #include <atomic>
 #include <chrono>
+#include <string>
 
 using namespace gg;
 
@@ -269,6 +271,119 @@ TEST(json_concurrent_modify) {
     ASSERT_EQ(completed.load(), numThreads * operationsPerThread);
 }
 
+// ============================================
+// Testes do SendCombiner
+// ============================================
+TEST(combiner_keeps_order_per_thread) {
+    internal::SendCombiner combiner;
+    std::vector<std::string> written;     // Só o escritor da vez mexe aqui
+    std::atomic<int> flushes{0};
+    
+    const int numThreads = 8;
+    const int sendsPerThread = 5000;
+    
+    std::vector<std::thread> threads;
+    for (int t = 0; t < numThreads; ++t) {
+        threads.emplace_back([&, t]() {
+            for (int i = 0; i < sendsPerThread; ++i) {
+                std::string payload = std::to_string(t) + ":" + std::to_string(i);
+                internal::SendRequest request;
+                request.payload = payload;
+                bool ok = combiner.submit(request, [&](internal::SendRequest* batch) {
+                    for (auto* r = batch; r; r = r->next) written.emplace_back(r->payload);
+                    flushes++;
+                    return true;
+                });
+                ASSERT(ok);
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    
+    ASSERT_EQ(written.size(), static_cast<size_t>(numThreads * sendsPerThread));
+    ASSERT(flushes.load() <= numThreads * sendsPerThread);
+    std::vector<int> next(numThreads, 0);
+    for (const auto& entry : written) {
+        size_t colon = entry.find(':');
+        int thread = std::stoi(entry.substr(0, colon));
+        ASSERT_EQ(std::stoi(entry.substr(colon + 1)), next[thread]);
+        next[thread]++;
+    }
+}
+
+TEST(combiner_reports_failure) {
+    internal::SendCombiner combiner;
+    internal::SendRequest request;
+    request.payload = "x";
+    ASSERT(!combiner.submit(request, [](internal::SendRequest*) { return false; }));
+    
+    internal::SendRequest again;
+    ASSERT(combiner.submit(again, [](internal::SendRequest*) { return true; }));
+}
+
+// Decodifica frames mascarados (cliente → servidor) capturados no pipe
+std::vector<std::string> unmaskFrames(const std::string& data) {
+    std::vector<std::string> out;
+    size_t pos = 0;
+    while (pos + 2 <= data.size()) {
+        uint64_t len = static_cast<uint8_t>(data[pos + 1]) & 0x7F;
+        pos += 2;
+        if (len == 126) {
+            len = (static_cast<uint64_t>(static_cast<uint8_t>(data[pos])) << 8) |
+                  static_cast<uint8_t>(data[pos + 1]);
+            pos += 2;
+        }
+        const char* mask = data.data() + pos;
+        pos += 4;
+        std::string payload = data.substr(pos, len);
+        for (size_t i = 0; i < payload.size(); ++i) payload[i] ^= mask[i % 4];
+        out.push_back(std::move(payload));
+        pos += len;
+    }
+    return out;
+}
+
+TEST(concurrent_send_combined) {
+    auto pipe = MemoryPipe::create("thread_safety_send");
+    WebSocketConfig config{.url = "memory://thread_safety_send"};
+    config.autoReconnect = false;
+    BasicWebSocket<policy::MemoryTransport, policy::HeartbeatOff> ws(config);
+    ASSERT(ws.connect());
+    
+    const int numThreads = 8;
+    const int sendsPerThread = 2000;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < numThreads; ++t) {
+        threads.emplace_back([&, t]() {
+            for (int i = 0; i < sendsPerThread; ++i) {
+                ASSERT(ws.send(std::to_string(t) + ":" + std::to_string(i)));
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    
+    WebSocketStats stats = ws.stats();
+    ws.disconnect();
+    
+    std::vector<std::string> frames = unmaskFrames(pipe->drainOutbound());
+    frames.pop_back();      // Close
+    ASSERT_EQ(frames.size(), static_cast<size_t>(numThreads * sendsPerThread));
+    ASSERT_EQ(stats.messagesSent, static_cast<uint64_t>(numThreads * sendsPerThread));
+    ASSERT(stats.sendWrites <= stats.messagesSent);
+    
+    std::vector<int> next(numThreads, 0);
+    for (const auto& frame : frames) {
+        size_t colon = frame.find(':');
+        int thread = std::stoi(frame.substr(0, colon));
+        ASSERT_EQ(std::stoi(frame.substr(colon + 1)), next[thread]);
+        next[thread]++;
+    }
+}
+
 // ============================================
 // Main
 // ============================================
@@ -289,6 +404,11 @@ int main() {
     RUN_TEST(json_concurrent_parse);
     RUN_TEST(json_concurrent_modify);
     
+    std::cout << "\nSendCombiner:\n";
+    RUN_TEST(combiner_keeps_order_per_thread);
+    RUN_TEST(combiner_reports_failure);
+    RUN_TEST(concurrent_send_combined);
+    
     std::cout << "\n=== TODOS OS TESTES PASSARAM ===\n";
     return 0;
 }
@@ -0,0 +1,175 @@
+#include "../src/internal/utf8_validator.hpp"
+
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace gg;
+
+// ============================================
+// Macros de Teste
+// ============================================
+#define TEST(name) void test_##name()
+#define RUN_TEST(name) \
+    std::cout << "  " << #name << "... "; \
+    test_##name(); \
+    std::cout << "OK\n"
+
+#define ASSERT(expr) \
+    if (!(expr)) { \
+        std::cerr << "\nFALHA: " << #expr << " em " << __FILE__ << ":" << __LINE__ << "\n"; \
+        std::exit(1); \
+    }
+
+#define ASSERT_EQ(a, b) ASSERT((a) == (b))
+
+// Roda todas as implementações disponíveis e exige o mesmo resultado
+static bool validateAll(const std::string& s) {
+    bool scalar = internal::utf8ValidateScalar(s.data(), s.size());
+#ifdef GG_WS_UTF8_X86
+    if (__builtin_cpu_supports("ssse3")) {
+        ASSERT_EQ(internal::utf8ValidateSse(s.data(), s.size()), scalar);
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        ASSERT_EQ(internal::utf8ValidateAvx2(s.data(), s.size()), scalar);
+    }
+#endif
+    ASSERT_EQ(internal::utf8Validate(s.data(), s.size()), scalar);
+    return scalar;
+}
+
+// Insere a sequência em várias posições para cruzar fronteiras de bloco
+static bool validateAtOffsets(const std::string& seq) {
+    bool expected = validateAll(seq);
+    for (size_t pad = 0; pad < 70; ++pad) {
+        std::string s(pad, 'a');
+        s += seq;
+        s += std::string(pad % 7, 'b');
+        ASSERT_EQ(validateAll(s), expected);
+    }
+    return expected;
+}
+
+// ============================================
+// Testes
+// ============================================
+TEST(empty_and_ascii) {
+    ASSERT(validateAll(""));
+    ASSERT(validateAll("hello"));
+    ASSERT(validateAll(R"({"e":"trade","s":"BTCUSDT","p":"67234.50","q":"0.00012"})"));
+}
+
+TEST(valid_multibyte) {
+    ASSERT(validateAtOffsets("\xC3\xA9"));              // é
+    ASSERT(validateAtOffsets("\xE2\x82\xAC"));          // €
+    ASSERT(validateAtOffsets("\xF0\x9F\x9A\x80"));      // 🚀
+    ASSERT(validateAtOffsets("\xED\x9F\xBF"));          // U+D7FF
+    ASSERT(validateAtOffsets("\xEE\x80\x80"));          // U+E000
+    ASSERT(validateAtOffsets("\xF4\x8F\xBF\xBF"));      // U+10FFFF
+    ASSERT(validateAtOffsets("ação çedilha ünïcödé 日本語"));
+}
+
+TEST(invalid_sequences) {
+    ASSERT(!validateAtOffsets("\x80"));                 // Continuação solta
+    ASSERT(!validateAtOffsets("\xBF"));
+    ASSERT(!validateAtOffsets("\xC3"));                 // Truncado
+    ASSERT(!validateAtOffsets("\xE2\x82"));
+    ASSERT(!validateAtOffsets("\xF0\x9F\x9A"));
+    ASSERT(!validateAtOffsets("\xC0\xAF"));             // Overlong 2
+    ASSERT(!validateAtOffsets("\xC1\xBF"));
+    ASSERT(!validateAtOffsets("\xE0\x80\xAF"));         // Overlong 3
+    ASSERT(!validateAtOffsets("\xF0\x80\x80\xAF"));     // Overlong 4
+    ASSERT(!validateAtOffsets("\xED\xA0\x80"));         // Surrogate
+    ASSERT(!validateAtOffsets("\xF4\x90\x80\x80"));     // > U+10FFFF
+    ASSERT(!validateAtOffsets("\xF5\x80\x80\x80"));
+    ASSERT(!validateAtOffsets("\xFF"));
+    ASSERT(!validateAtOffsets("\xC3\xA9\xA9"));         // Continuação extra
+    ASSERT(!validateAtOffsets("\xE2\x82\xAC\x80"));
+    ASSERT(!validateAtOffsets("\xC3" "a"));             // Lead seguido de ASCII
+}
+
+TEST(random_fuzz) {
+    std::mt19937 gen(12345);
+    const char* pieces[] = {
+        "a", "{\"p\":", "\xC3\xA9", "\xE2\x82\xAC", "\xF0\x9F\x9A\x80",
+        "\x80", "\xC3", "\xED\xA0\x80", "\xF4\x90\x80\x80", "\xE0\xA0\x80"
+    };
+    std::uniform_int_distribution<> pick(0, 9);
+    std::uniform_int_distribution<> bytes(0, 255);
+
+    int valid = 0, invalid = 0;
+    for (int iter = 0; iter < 20000; ++iter) {
+        std::string s;
+        int n = iter % 80;
+        for (int k = 0; k < n; ++k) {
+            s += (iter % 3 == 0) ? std::string(1, static_cast<char>(bytes(gen)))
+                                 : std::string(pieces[pick(gen) % 5]);
+        }
+        // Em 1/3 das strings "boas" injeta uma peça qualquer
+        if (iter % 3 == 1 && !s.empty()) {
+            s.insert(s.size() / 2, pieces[pick(gen)]);
+        }
+        validateAll(s) ? valid++ : invalid++;
+    }
+    ASSERT(valid > 0 && invalid > 0);
+}
+
+// Valida em fragmentos cortados em cada posição (e em três, nos pares de cortes)
+static bool streamAgrees(const std::string& s) {
+    const bool expected = validateAll(s);
+    for (size_t cut = 0; cut <= s.size(); ++cut) {
+        internal::Utf8Stream stream;
+        bool ok = stream.feed(s.data(), cut, false) && stream.feed(s.data() + cut, s.size() - cut, true);
+        ASSERT_EQ(ok, expected);
+        ASSERT(!ok || !stream.active());
+        for (size_t cut2 = cut; cut2 <= s.size(); ++cut2) {
+            internal::Utf8Stream three;
+            ok = three.feed(s.data(), cut, false) && three.feed(s.data() + cut, cut2 - cut, false) &&
+                 three.feed(s.data() + cut2, s.size() - cut2, true);
+            ASSERT_EQ(ok, expected);
+        }
+    }
+    return expected;
+}
+
+TEST(stream_fragments) {
+    // Caractere dividido entre fragmentos continua válido
+    ASSERT(streamAgrees("preço \xE2\x82\xAC \xF0\x9F\x9A\x80 日本"));
+    ASSERT(streamAgrees(std::string(40, 'a') + "\xF4\x8F\xBF\xBF" + std::string(40, 'b')));
+
+    // Inválido em qualquer fragmento (inclusive depois do primeiro)
+    ASSERT(!streamAgrees("ok \xC3\x28 depois"));
+    ASSERT(!streamAgrees("ok \xE0\x80\xAF"));
+    ASSERT(!streamAgrees("ok \xED\xA0\x80"));
+    ASSERT(!streamAgrees("fim aberto \xF0\x9F\x9A"));
+
+    // Sequência aberta só falha no FIN
+    internal::Utf8Stream stream;
+    ASSERT(stream.feed("a\xE2", 2, false));
+    ASSERT(stream.active());
+    ASSERT(stream.feed("\x82", 1, false));
+    ASSERT(!stream.feed("", 0, true));
+
+    // reset() descarta a sequência aberta da mensagem anterior
+    stream.reset();
+    ASSERT(stream.feed("\xC3", 1, false));
+    stream.reset();
+    ASSERT(stream.feed("a", 1, true));
+}
+
+// ============================================
+// Main
+// ============================================
+int main() {
+    std::cout << "=== Testes do Validador UTF-8 ===\n\n";
+
+    RUN_TEST(empty_and_ascii);
+    RUN_TEST(valid_multibyte);
+    RUN_TEST(invalid_sequences);
+    RUN_TEST(random_fuzz);
+    RUN_TEST(stream_fragments);
+
+    std::cout << "\n=== TODOS OS TESTES PASSARAM ===\n";
+    return 0;
+}
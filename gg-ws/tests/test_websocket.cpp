@@ -1,9 +1,22 @@
 #include "gg_ws/websocket.hpp"
+#include "gg_ws/memory_transport.hpp"
+#include "local_server.hpp"
+#include "../src/internal/tcp_connector.hpp"
+
+#include <algorithm>
+#include <cstring>
 #include <iostream>
+#include <memory>
+#include <string>
 #include <thread>
 #include <vector>
 #include <atomic>
 #include <chrono>
+#include <mutex>
+#include <type_traits>
+
+#include <dirent.h>
+#include <sys/socket.h>
 
 using namespace gg;
 
@@ -210,6 +223,1603 @@ TEST(send_async) {
     }
 }
 
+// ============================================
+// Testes locais (servidor em loopback)
+// ============================================
+TEST(utf8_invalid_closes_1007) {
+    std::atomic<int> closeCode{0};
+    test::LocalServer server([&](test::Connection& conn) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        conn.sendText("{\"p\":\"ok\"}");
+        conn.sendText("bad \xC3\x28 utf8");
+        closeCode = conn.waitClose();
+    });
+    
+    WebSocketConfig config{.url = server.url()};
+    config.validateUtf8 = true;
+    config.autoReconnect = false;
+    config.ping.mode = PingMode::Disabled;
+    WebSocket ws(config);
+    
+    std::atomic<int> messages{0};
+    std::atomic<int> errorCode{0};
+    std::atomic<int> disconnectCode{0};
+    ws.onRawMessage([&](std::string_view) { messages++; });
+    ws.onError([&](int code, std::string_view) { errorCode = code; });
+    ws.onDisconnect([&](int code) { disconnectCode = code; });
+    
+    ASSERT(ws.connect());
+    ws.wait();
+    server.stop();
+    
+    ASSERT(messages.load() == 1);
+    ASSERT(errorCode.load() == ErrorCode::InvalidFrame);
+    ASSERT(disconnectCode.load() == CloseCode::InvalidPayload);
+    ASSERT(closeCode.load() == CloseCode::InvalidPayload);
+    ASSERT(!ws.isConnected());
+}
+
+TEST(utf8_invalid_fragment_closes_1007) {
+    // FIN=0 não escapa da validação: o frame seria entregue do mesmo jeito
+    std::atomic<int> closeCode{0};
+    test::LocalServer server([&](test::Connection& conn) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        conn.sendFrame(0x1, "bad \xC3\x28 utf8", false);
+        closeCode = conn.waitClose();
+    });
+    
+    WebSocketConfig config{.url = server.url()};
+    config.validateUtf8 = true;
+    config.autoReconnect = false;
+    config.ping.mode = PingMode::Disabled;
+    WebSocket ws(config);
+    
+    std::atomic<int> messages{0};
+    ws.onRawMessage([&](std::string_view) { messages++; });
+    
+    ASSERT(ws.connect());
+    ws.wait();
+    server.stop();
+    
+    ASSERT(messages.load() == 0);
+    ASSERT(closeCode.load() == CloseCode::InvalidPayload);
+}
+
+TEST(utf8_split_across_fragments_passes) {
+    // "€" dividido entre o frame de texto (FIN=0) e a continuação
+    test::LocalServer server([&](test::Connection& conn) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        conn.sendFrame(0x1, "preço \xE2\x82", false);
+        conn.sendFrame(0x0, "\xAC fim", true);
+        conn.sendText("depois");
+        conn.waitClose();
+    });
+    
+    WebSocketConfig config{.url = server.url()};
+    config.validateUtf8 = true;
+    config.autoReconnect = false;
+    config.ping.mode = PingMode::Disabled;
+    WebSocket ws(config);
+    
+    std::atomic<int> messages{0};
+    ws.onRawMessage([&](std::string_view) { messages++; });
+    
+    ASSERT(ws.connect());
+    for (int i = 0; i < 100 && messages < 2; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    ASSERT(ws.isConnected());
+    ws.disconnect();
+    
+    // Sem remontagem: o primeiro fragmento e a mensagem seguinte
+    ASSERT(messages.load() == 2);
+}
+
+TEST(utf8_invalid_continuation_closes_1007) {
+    std::atomic<int> closeCode{0};
+    test::LocalServer server([&](test::Connection& conn) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        conn.sendFrame(0x1, "ok ", false);
+        conn.sendFrame(0x0, "bad \xC3\x28 utf8", true);
+        closeCode = conn.waitClose();
+    });
+    
+    WebSocketConfig config{.url = server.url()};
+    config.validateUtf8 = true;
+    config.autoReconnect = false;
+    config.ping.mode = PingMode::Disabled;
+    WebSocket ws(config);
+    
+    std::atomic<int> messages{0};
+    ws.onRawMessage([&](std::string_view) { messages++; });
+    
+    ASSERT(ws.connect());
+    ws.wait();
+    server.stop();
+    
+    ASSERT(messages.load() == 1);
+    ASSERT(closeCode.load() == CloseCode::InvalidPayload);
+}
+
+TEST(utf8_valid_multibyte_passes) {
+    test::LocalServer server([&](test::Connection& conn) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        conn.sendText("preço \xE2\x82\xAC \xF0\x9F\x9A\x80");
+        conn.waitClose();
+    });
+    
+    WebSocketConfig config{.url = server.url()};
+    config.validateUtf8 = true;
+    config.autoReconnect = false;
+    config.ping.mode = PingMode::Disabled;
+    WebSocket ws(config);
+    
+    std::atomic<int> messages{0};
+    ws.onRawMessage([&](std::string_view) { messages++; });
+    
+    ASSERT(ws.connect());
+    for (int i = 0; i < 100 && messages == 0; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    ASSERT(ws.isConnected());
+    ws.disconnect();
+    
+    ASSERT(messages.load() == 1);
+}
+
+// ============================================
+// Políticas de compilação
+// ============================================
+static_assert(std::is_same_v<WebSocket, BasicWebSocket<policy::AutoTransport, policy::MetricsOn>>);
+static_assert(std::is_same_v<BasicWebSocket<policy::JsonOff, policy::TcpTransport>,
+                             BasicWebSocket<policy::TcpTransport, policy::JsonOff>>);
+
+using RawTcpFeed = BasicWebSocket<policy::TcpTransport, policy::JsonOff,
+                                  policy::HeartbeatOff, policy::MetricsOff>;
+using PolledFeed = BasicWebSocket<policy::TcpTransport, policy::ExternalDriven, policy::HeartbeatOff>;
+
+TEST(policy_raw_tcp_receive) {
+    test::LocalServer server([&](test::Connection& conn) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        for (int i = 0; i < 100; ++i) {
+            conn.sendText("{\"i\":" + std::to_string(i) + "}");
+        }
+        conn.waitClose();
+    });
+    
+    WebSocketConfig config{.url = server.url()};
+    config.autoReconnect = false;
+    RawTcpFeed ws(config);
+    
+    std::atomic<int> messages{0};
+    ws.onRawMessage([&](std::string_view) { messages++; });
+    
+    ASSERT(ws.connect());
+    for (int i = 0; i < 200 && messages < 100; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    ws.disconnect();
+    ASSERT(messages.load() == 100);
+}
+
+TEST(policy_rejects_mismatched_scheme) {
+    RawTcpFeed ws({.url = "wss://127.0.0.1:1/"});
+    std::atomic<int> errorCode{0};
+    ws.onError([&](int code, std::string_view) { errorCode = code; });
+    ASSERT(!ws.connect());
+    ASSERT(errorCode.load() == ErrorCode::InvalidUrl);
+}
+
+TEST(policy_external_poll_and_stats) {
+    test::LocalServer server([&](test::Connection& conn) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        for (int i = 0; i < 50; ++i) {
+            conn.sendText("{\"i\":" + std::to_string(i) + "}");
+        }
+        conn.sendText("not json");
+        conn.waitClose();
+    });
+    
+    WebSocketConfig config{.url = server.url()};
+    config.autoReconnect = false;
+    PolledFeed ws(config);
+    
+    const auto caller = std::this_thread::get_id();
+    int jsonMessages = 0;
+    bool sameThread = true;
+    ws.onMessage([&](const Json& msg) {
+        sameThread = sameThread && std::this_thread::get_id() == caller;
+        if (msg["i"].getInt() == jsonMessages) jsonMessages++;
+    });
+    
+    ASSERT(ws.connect());
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (ws.stats().messagesReceived < 51 && std::chrono::steady_clock::now() < deadline) {
+        ws.poll(64, 10);
+    }
+    
+    auto stats = ws.stats();
+    ws.disconnect();
+    
+    ASSERT(sameThread);
+    ASSERT(jsonMessages == 50);
+    ASSERT(stats.messagesReceived == 51);
+    ASSERT(stats.jsonParseFailures == 1);
+    ASSERT(stats.bytesReceived > 0);
+}
+
+TEST(frames_sent_with_handshake) {
+    // Servidor envia frames logo após o 101: chegam no mesmo segmento do handshake
+    test::LocalServer server([&](test::Connection& conn) {
+        for (int i = 0; i < 20; ++i) {
+            conn.sendText("m" + std::to_string(i));
+        }
+        conn.waitClose();
+    });
+    
+    WebSocketConfig config{.url = server.url()};
+    config.autoReconnect = false;
+    RawTcpFeed ws(config);
+    
+    std::atomic<int> messages{0};
+    ws.onRawMessage([&](std::string_view) { messages++; });
+    
+    ASSERT(ws.connect());
+    for (int i = 0; i < 200 && messages < 20; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    ws.disconnect();
+    ASSERT(messages.load() == 20);
+}
+
+TEST(external_poll_budget_fd_and_inline_send) {
+    std::atomic<bool> replyReceived{false};
+    test::LocalServer server([&](test::Connection& conn) {
+        std::string burst;
+        for (int i = 0; i < 10; ++i) {
+            burst += test::Connection::encodeFrame(0x1, "m" + std::to_string(i));
+        }
+        conn.sendRaw(burst);
+        
+        uint8_t opcode;
+        std::string payload;
+        if (conn.readFrame(opcode, payload) && opcode == 0x1 && payload == "reply") {
+            replyReceived = true;
+        }
+        conn.waitClose();
+    });
+    
+    WebSocketConfig config{.url = server.url()};
+    config.autoReconnect = false;
+    PolledFeed ws(config);
+    
+    int messages = 0;
+    ws.onRawMessage([&](std::string_view msg) {
+        // Envio dentro do callback sai inline, sem thread de I/O
+        if (msg == "m9") ws.send("reply");
+        messages++;
+    });
+    
+    ASSERT(ws.fd() == -1);
+    ASSERT(ws.connect());
+    ASSERT(ws.fd() >= 0);
+    
+    // Loop do caller: espera no fd, processa no máximo 3 frames por vez
+    bool budgetRespected = true;
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (messages < 10 && std::chrono::steady_clock::now() < deadline) {
+        if (!ws.hasBufferedData()) {
+            pollfd pfd{ws.fd(), POLLIN, 0};
+            ::poll(&pfd, 1, 100);
+        }
+        budgetRespected = budgetRespected && ws.poll(3) <= 3;
+    }
+    
+    // Nada disponível: poll(budget, 0) retorna sem bloquear
+    auto start = std::chrono::steady_clock::now();
+    ws.poll(3);
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    
+    for (int i = 0; i < 200 && !replyReceived; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    ws.disconnect();
+    
+    ASSERT(messages == 10);
+    ASSERT(budgetRespected);
+    ASSERT(elapsed < std::chrono::milliseconds(50));
+    ASSERT(replyReceived.load());
+}
+
+// ============================================
+// Dispatch de callbacks
+// ============================================
+TEST(route_by_event_type) {
+    test::LocalServer server([&](test::Connection& conn) {
+        for (int i = 0; i < 30; ++i) {
+            conn.sendText(i % 3 == 0 ? R"({"e":"trade","p":"1.0"})"
+                        : i % 3 == 1 ? R"({"e":"depthUpdate","b":[]})"
+                                     : R"({"result":null,"id":1})");
+        }
+        conn.waitClose();
+    });
+    
+    WebSocketConfig config{.url = server.url()};
+    config.autoReconnect = false;
+    PolledFeed ws(config);
+    
+    int trades = 0, depth = 0, other = 0, raw = 0;
+    ws.onRawMessage([&](std::string_view) { raw++; });
+    
+    MessageRouter router("e");
+    router.on("trade", [&](std::string_view) { trades++; })
+          .on("depthUpdate", [&](std::string_view) { depth++; })
+          .otherwise([&](std::string_view) { other++; });
+    ws.route(std::move(router));
+    
+    ASSERT(ws.connect());
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (raw < 30 && std::chrono::steady_clock::now() < deadline) {
+        ws.poll(64, 10);
+    }
+    ws.disconnect();
+    
+    ASSERT(raw == 30);
+    ASSERT(trades == 10);
+    ASSERT(depth == 10);
+    ASSERT(other == 10);
+}
+
+TEST(batch_per_read) {
+    // 40 frames num único write chegam numa leitura; o último vem sozinho
+    test::LocalServer server([&](test::Connection& conn) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        std::string burst;
+        for (int i = 0; i < 40; ++i) {
+            burst += i == 20 ? test::Connection::encodeFrame(0x2, "bin")
+                             : test::Connection::encodeFrame(0x1, "m" + std::to_string(i));
+        }
+        conn.sendRaw(burst);
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        conn.sendText("last");
+        conn.waitClose();
+    });
+    
+    WebSocketConfig config{.url = server.url()};
+    config.autoReconnect = false;
+    PolledFeed ws(config);
+    
+    int raw = 0;
+    std::vector<std::vector<std::string>> batches;
+    bool binaryFlagged = false;
+    ws.onRawMessage([&](std::string_view) { raw++; });
+    ws.onMessageBatch([&](const MessageBatch& batch) {
+        ASSERT(!batch.empty());
+        std::vector<std::string> copy;
+        for (const MessageView& msg : batch) {
+            copy.emplace_back(msg.data);
+            if (msg.binary) binaryFlagged = msg.data == "bin";
+        }
+        batches.push_back(std::move(copy));
+    });
+    
+    ASSERT(ws.connect());
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (raw < 41 && std::chrono::steady_clock::now() < deadline) {
+        ws.poll(64, 10);
+    }
+    auto stats = ws.stats();
+    ws.disconnect();
+    
+    // Callbacks por mensagem continuam; o lote vem depois, com a leitura inteira
+    ASSERT(raw == 41);
+    ASSERT(batches.size() == 2);
+    ASSERT(batches[0].size() == 40);
+    ASSERT(batches[0][0] == "m0" && batches[0][39] == "m39");
+    ASSERT(batches[1].size() == 1 && batches[1][0] == "last");
+    ASSERT(binaryFlagged);
+    
+    // Histograma: uma leitura de 40 (bucket 32-63) e uma de 1
+    ASSERT(stats.batchSizes[5] == 1);
+    ASSERT(stats.batchSizes[0] == 1);
+    uint64_t reads = 0;
+    for (uint64_t count : stats.batchSizes) reads += count;
+    ASSERT(reads == 2);
+}
+
+TEST(batch_survives_buffer_growth) {
+    // Frames curtos e o header de um frame maior que o buffer na mesma
+    // leitura: o buffer cresce antes do fim do lote
+    const std::string big(200 * 1024, 'x');
+    test::LocalServer server([&](test::Connection& conn) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        std::string burst;
+        for (int i = 0; i < 10; ++i) {
+            burst += test::Connection::encodeFrame(0x1, "m" + std::to_string(i));
+        }
+        const std::string frame = test::Connection::encodeFrame(0x2, big);
+        conn.sendRaw(burst + frame.substr(0, 16));
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        conn.sendRaw(std::string_view(frame).substr(16));
+        conn.waitClose();
+    });
+    
+    WebSocketConfig config{.url = server.url()};
+    config.autoReconnect = false;
+    PolledFeed ws(config);
+    
+    int raw = 0;
+    std::vector<std::vector<std::string>> batches;
+    ws.onRawMessage([&](std::string_view) { raw++; });
+    ws.onMessageBatch([&](const MessageBatch& batch) {
+        std::vector<std::string> copy;
+        for (const MessageView& msg : batch) {
+            copy.emplace_back(msg.data);
+        }
+        batches.push_back(std::move(copy));
+    });
+    
+    ASSERT(ws.connect());
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (raw < 11 && std::chrono::steady_clock::now() < deadline) {
+        ws.poll(64, 10);
+    }
+    ws.disconnect();
+    
+    ASSERT(raw == 11);
+    ASSERT(batches.size() >= 2);
+    ASSERT(batches[0].size() == 10);
+    for (int i = 0; i < 10; ++i) {
+        ASSERT(batches[0][static_cast<size_t>(i)] == "m" + std::to_string(i));
+    }
+    ASSERT(batches.back().size() == 1 && batches.back()[0] == big);
+}
+
+TEST(swap_callbacks_while_receiving) {
+    test::LocalServer server([&](test::Connection& conn) {
+        for (int i = 0; i < 20000; ++i) {
+            if (!conn.sendText("x")) break;
+        }
+        conn.waitClose();
+    });
+    
+    WebSocketConfig config{.url = server.url()};
+    config.autoReconnect = false;
+    RawTcpFeed ws(config);
+    
+    std::atomic<int> a{0}, b{0};
+    ws.onRawMessage([&](std::string_view) { a++; });
+    ASSERT(ws.connect());
+    
+    // Troca o callback enquanto a thread de I/O despacha; nenhuma mensagem se perde
+    for (int i = 0; i < 500 && a + b < 20000; ++i) {
+        if (i % 2 == 0) {
+            ws.onRawMessage([&](std::string_view) { b++; });
+        } else {
+            ws.onRawMessage([&](std::string_view) { a++; });
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+    }
+    for (int i = 0; i < 500 && a + b < 20000; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    ws.disconnect();
+    ASSERT(a + b == 20000);
+}
+
+TEST(replaced_callbacks_are_released) {
+    test::LocalServer server([&](test::Connection& conn) {
+        conn.waitClose();
+    });
+    
+    WebSocketConfig config{.url = server.url()};
+    config.autoReconnect = false;
+    RawTcpFeed ws(config);
+    
+    // Captures de callbacks e routers substituídos são liberadas com a conexão viva
+    auto token = std::make_shared<int>(0);
+    std::weak_ptr<int> weak = token;
+    ws.onRawMessage([token](std::string_view) {});
+    ws.route(MessageRouter("e").on("trade", [token](std::string_view) {}));
+    token.reset();
+    ASSERT(ws.connect());
+    
+    ws.onRawMessage([](std::string_view) {});
+    ws.route(MessageRouter("e"));
+    for (int i = 0; i < 100 && !weak.expired(); ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    ASSERT(weak.expired());
+    ASSERT(ws.isConnected());
+    ws.disconnect();
+}
+
+// ============================================
+// Connect não bloqueante / Happy Eyeballs
+// ============================================
+static internal::ResolvedAddress loopbackAddress(bool ipv6, uint16_t port) {
+    internal::ResolvedAddress out;
+    if (ipv6) {
+        auto* a6 = reinterpret_cast<sockaddr_in6*>(&out.addr);
+        a6->sin6_family = AF_INET6;
+        a6->sin6_addr = in6addr_loopback;
+        a6->sin6_port = htons(port);
+        out.len = sizeof(sockaddr_in6);
+    } else {
+        auto* a4 = reinterpret_cast<sockaddr_in*>(&out.addr);
+        a4->sin_family = AF_INET;
+        a4->sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        a4->sin_port = htons(port);
+        out.len = sizeof(sockaddr_in);
+    }
+    out.family = ipv6 ? AF_INET6 : AF_INET;
+    return out;
+}
+
+static long long elapsedMs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start).count();
+}
+
+TEST(happy_eyeballs_races_past_unreachable) {
+    test::LocalServer fast([](test::Connection& conn) { conn.waitClose(1000); });
+    test::Blackhole slow4(false);
+    test::Blackhole slow6(true);
+    ASSERT(slow4.valid());
+    
+    // Vários registros A: o primeiro não responde, o segundo vence após o atraso
+    {
+        std::vector<internal::ResolvedAddress> addresses = {
+            loopbackAddress(false, slow4.port()), loopbackAddress(false, fast.port())};
+        auto start = std::chrono::steady_clock::now();
+        auto result = internal::connectHappyEyeballs(
+            addresses, start + std::chrono::seconds(5), std::chrono::milliseconds(100));
+        auto ms = elapsedMs(start);
+        ASSERT(result.socket != internal::InvalidNativeSocket);
+        ASSERT(result.winner == 1);
+        ASSERT(ms >= 90 && ms < 1000);
+        ::close(result.socket);
+    }
+    
+    // IPv6 inalcançável + IPv4 rápido: intercalados, o IPv4 vence
+    if (slow6.valid()) {
+        auto ordered = internal::interleaveFamilies({
+            loopbackAddress(true, slow6.port()), loopbackAddress(true, slow6.port()),
+            loopbackAddress(false, fast.port())});
+        ASSERT(ordered[0].family == AF_INET6);
+        ASSERT(ordered[1].family == AF_INET);
+        
+        auto start = std::chrono::steady_clock::now();
+        auto result = internal::connectHappyEyeballs(
+            ordered, start + std::chrono::seconds(5), std::chrono::milliseconds(100));
+        ASSERT(result.socket != internal::InvalidNativeSocket);
+        ASSERT(result.winner == 1);
+        ASSERT(elapsedMs(start) < 1000);
+        ::close(result.socket);
+    }
+}
+
+TEST(connect_timeout_is_enforced) {
+    test::Blackhole hole(false);
+    ASSERT(hole.valid());
+    
+    WebSocketConfig config{.url = hole.url()};
+    config.autoReconnect = false;
+    config.connectTimeout = std::chrono::milliseconds(300);
+    RawTcpFeed ws(config);
+    
+    std::atomic<int> errorCode{0};
+    ws.onError([&](int code, std::string_view) { errorCode = code; });
+    
+    auto start = std::chrono::steady_clock::now();
+    ASSERT(!ws.connect());
+    auto ms = elapsedMs(start);
+    ASSERT(errorCode.load() == ErrorCode::Timeout);
+    ASSERT(ms >= 290 && ms < 1000);
+}
+
+TEST(connect_refused_fails_fast) {
+    // Porta fechada: RST imediato, sem esperar o timeout
+    uint16_t port;
+    {
+        test::Blackhole closed(false);
+        port = closed.port();
+    }
+    WebSocketConfig config{.url = "ws://127.0.0.1:" + std::to_string(port) + "/"};
+    config.autoReconnect = false;
+    config.connectTimeout = std::chrono::seconds(5);
+    RawTcpFeed ws(config);
+    
+    std::atomic<int> errorCode{0};
+    ws.onError([&](int code, std::string_view) { errorCode = code; });
+    
+    auto start = std::chrono::steady_clock::now();
+    ASSERT(!ws.connect());
+    ASSERT(errorCode.load() == ErrorCode::ConnectionFailed);
+    ASSERT(elapsedMs(start) < 1000);
+}
+
+// Threads vivas do processo (supervisor, I/O e heartbeat incluídos)
+size_t liveThreads() {
+    size_t count = 0;
+    if (DIR* dir = opendir("/proc/self/task")) {
+        while (dirent* entry = readdir(dir)) {
+            if (entry->d_name[0] != '.') count++;
+        }
+        closedir(dir);
+    }
+    return count;
+}
+
+TEST(dns_cache_feeds_happy_eyeballs) {
+    test::LocalServer fast([](test::Connection& conn) {
+        conn.sendText("hi");
+        conn.waitClose();
+    });
+    test::Blackhole slow6(true, fast.port());
+    
+    // Nome fictício: só existe no cache (IPv6 inalcançável + IPv4 do servidor)
+    std::vector<internal::ResolvedAddress> addresses;
+    if (slow6.valid()) addresses.push_back(loopbackAddress(true, fast.port()));
+    addresses.push_back(loopbackAddress(false, fast.port()));
+    internal::DnsCache::instance().insert("race.gg-ws.test", fast.port(), addresses,
+                                          std::chrono::seconds(60));
+    
+    WebSocketConfig config{.url = "ws://race.gg-ws.test:" + std::to_string(fast.port()) + "/"};
+    config.autoReconnect = false;
+    config.connectTimeout = std::chrono::seconds(3);
+    config.connectAttemptDelay = std::chrono::milliseconds(100);
+    RawTcpFeed ws(config);
+    
+    std::atomic<int> messages{0};
+    ws.onRawMessage([&](std::string_view) { messages++; });
+    
+    auto hitsBefore = internal::DnsCache::instance().hits();
+    auto start = std::chrono::steady_clock::now();
+    ASSERT(ws.connect());
+    ASSERT(elapsedMs(start) < 1000);
+    ASSERT(internal::DnsCache::instance().hits() == hitsBefore + 1);
+    
+    for (int i = 0; i < 200 && messages == 0; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    ws.disconnect();
+    internal::DnsCache::instance().invalidate("race.gg-ws.test", fast.port());
+    ASSERT(messages.load() == 1);
+}
+
+TEST(dns_cache_shares_lookups) {
+    // Misses simultâneos do mesmo nome esperam uma consulta só; as threads
+    // do resolver saem quando a fila esvazia
+    auto& cache = internal::DnsCache::instance();
+    cache.invalidate("localhost", 9);
+    const size_t baseline = liveThreads();
+    
+    std::atomic<int> resolved{0};
+    std::vector<std::thread> callers;
+    for (int i = 0; i < 8; ++i) {
+        callers.emplace_back([&] {
+            std::vector<internal::ResolvedAddress> out;
+            auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+            if (cache.resolve("localhost", 9, std::chrono::seconds(60), deadline, out) ==
+                internal::DnsCache::Status::Ok && !out.empty()) {
+                resolved++;
+            }
+        });
+    }
+    for (auto& caller : callers) caller.join();
+    ASSERT(resolved.load() == 8);
+    
+    // Agora do cache, sem resolver
+    auto hitsBefore = cache.hits();
+    std::vector<internal::ResolvedAddress> out;
+    ASSERT(cache.resolve("localhost", 9, std::chrono::seconds(60),
+                         std::chrono::steady_clock::now() + std::chrono::seconds(1), out) ==
+           internal::DnsCache::Status::Ok);
+    ASSERT(cache.hits() == hitsBefore + 1);
+    cache.invalidate("localhost", 9);
+    
+    for (int i = 0; i < 100 && liveThreads() > baseline; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    ASSERT(liveThreads() == baseline);
+}
+
+// ============================================
+// Corrida de endpoints
+// ============================================
+TEST(endpoint_race_keeps_fastest) {
+    auto session = [](test::Connection& conn) {
+        conn.sendText("hello");
+        conn.waitClose(2000);
+    };
+    test::LocalServer slow(session, std::chrono::milliseconds(400));
+    test::LocalServer fast(session, std::chrono::milliseconds(20));
+    test::Blackhole unreachable(false);
+    
+    WebSocketConfig config{.url = slow.url()};
+    config.endpoints = {unreachable.url(), fast.url(), "ws://:0/"};
+    config.autoReconnect = false;
+    config.connectTimeout = std::chrono::seconds(3);
+    RawTcpFeed ws(config);
+    
+    std::atomic<int> races{0};
+    ws.onEndpointRace([&](const std::vector<EndpointTiming>& timings) {
+        ASSERT(timings.size() == 4);
+        races++;
+    });
+    std::atomic<int> messages{0};
+    ws.onRawMessage([&](std::string_view msg) {
+        if (msg == "hello") messages++;
+    });
+    
+    auto start = std::chrono::steady_clock::now();
+    ASSERT(ws.connect());
+    auto ms = elapsedMs(start);
+    ASSERT(ms < 350);
+    ASSERT(ws.url() == fast.url());
+    
+    auto timings = ws.endpointTimings();
+    ASSERT(timings.size() == 4);
+    ASSERT(timings[0].url == slow.url());
+    ASSERT(timings[0].outcome == EndpointOutcome::Cancelled);
+    ASSERT(timings[0].tcp.count() > 0);
+    ASSERT(timings[1].outcome == EndpointOutcome::Cancelled);
+    ASSERT(timings[2].outcome == EndpointOutcome::Winner);
+    ASSERT(timings[2].upgrade >= std::chrono::milliseconds(20));
+    ASSERT(timings[2].total >= timings[2].tcp + timings[2].upgrade);
+    ASSERT(timings[3].outcome == EndpointOutcome::Failed);
+    ASSERT(timings[3].errorCode == ErrorCode::InvalidUrl);
+    
+    for (int i = 0; i < 200 && messages == 0; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    ASSERT(messages.load() == 1);
+    ws.disconnect();
+    
+    // Nova conexão corre de novo
+    ASSERT(ws.connect());
+    ASSERT(ws.url() == fast.url());
+    ws.disconnect();
+    ASSERT(races.load() == 2);
+}
+
+TEST(endpoint_race_all_fail) {
+    test::Blackhole a(false), b(false);
+    WebSocketConfig config{.url = a.url()};
+    config.endpoints = {b.url()};
+    config.autoReconnect = false;
+    config.connectTimeout = std::chrono::milliseconds(300);
+    RawTcpFeed ws(config);
+    
+    std::atomic<int> errorCode{0};
+    ws.onError([&](int code, std::string_view) { errorCode = code; });
+    
+    auto start = std::chrono::steady_clock::now();
+    ASSERT(!ws.connect());
+    ASSERT(elapsedMs(start) < 1000);
+    ASSERT(errorCode.load() == ErrorCode::Timeout);
+    for (const auto& timing : ws.endpointTimings()) {
+        ASSERT(timing.outcome == EndpointOutcome::Failed);
+        ASSERT(timing.errorCode == ErrorCode::Timeout);
+    }
+}
+
+// ============================================
+// Rotação make-before-break
+// ============================================
+
+// Feed com sequência global (1 msg/ms). Cada conexão começa após "sub",
+// `startBehind` mensagens atrás do ao vivo, e entrega sempre `trailing`
+// mensagens atrás (simula um link mais lento).
+struct SequenceFeed {
+    struct Link {
+        long startBehind = 0;
+        long trailing = 0;
+        bool closeWhenNextSubscribes = false;
+    };
+    
+    std::vector<Link> links;
+    std::atomic<long> live{1000};
+    std::atomic<int> subscribed{0};
+    std::atomic<bool> stop{false};
+    std::thread ticker;
+    std::unique_ptr<test::LocalServer> server;
+    
+    explicit SequenceFeed(std::vector<Link> config) : links(std::move(config)) {
+        ticker = std::thread([this] {
+            while (!stop) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                live++;
+            }
+        });
+        server = std::make_unique<test::LocalServer>([this](test::Connection& conn) { session(conn); });
+    }
+    
+    ~SequenceFeed() {
+        stop = true;
+        server->stop();
+        ticker.join();
+    }
+    
+    void session(test::Connection& conn) {
+        uint8_t opcode = 0;
+        std::string payload;
+        if (!conn.readFrame(opcode, payload, 2000) || payload != "sub") return;
+        
+        const int index = subscribed++;
+        const Link link = index < static_cast<int>(links.size()) ? links[index] : Link{};
+        long cursor = live - link.startBehind;
+        
+        while (!stop) {
+            if (link.closeWhenNextSubscribes && subscribed > index + 1) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(5));
+                conn.sendClose(1001);
+                conn.waitClose(500);
+                return;
+            }
+            
+            std::string batch;
+            for (long target = live - link.trailing; cursor <= target; ++cursor) {
+                batch += test::Connection::encodeFrame(0x1, "{\"seq\":" + std::to_string(cursor) + "}");
+            }
+            if (!batch.empty() && !conn.sendRaw(batch)) return;
+            
+            // Cliente fechou este link?
+            pollfd pfd{conn.fd(), POLLIN, 0};
+            if (::poll(&pfd, 1, 1) > 0) {
+                if (!conn.readFrame(opcode, payload, 0) || opcode == 0x8) return;
+            }
+        }
+    }
+};
+
+using RotatingFeed = BasicWebSocket<policy::TcpTransport, policy::JsonOff, policy::HeartbeatOff>;
+
+struct SequenceLog {
+    std::mutex mutex;
+    std::vector<long> seqs;
+    
+    void add(std::string_view msg) {
+        auto value = MessageRouter("seq").findValue(msg);
+        std::lock_guard<std::mutex> lock(mutex);
+        seqs.push_back(std::stol(std::string(value)));
+    }
+    
+    size_t size() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return seqs.size();
+    }
+    
+    // Sem buraco nem duplicata
+    bool contiguous() {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (size_t i = 1; i < seqs.size(); ++i) {
+            if (seqs[i] != seqs[i - 1] + 1) {
+                std::cerr << "\n  quebra: " << seqs[i - 1] << " -> " << seqs[i] << "\n";
+                return false;
+            }
+        }
+        return !seqs.empty();
+    }
+};
+
+static WebSocketConfig rotationConfig(const SequenceFeed& feed) {
+    WebSocketConfig config{.url = feed.server->url()};
+    config.autoReconnect = false;
+    config.rotation.key = [router = MessageRouter("seq")](std::string_view msg) {
+        return router.findValue(msg);
+    };
+    config.rotation.subscribe = [](const RotationSend& send) { send("sub"); };
+    config.rotation.overlapTimeout = std::chrono::seconds(2);
+    return config;
+}
+
+static void waitForMessages(SequenceLog& log, size_t count) {
+    for (int i = 0; i < 300 && log.size() < count; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+}
+
+TEST(rotation_new_link_behind) {
+    // Novo link repete 40 mensagens que o antigo já entregou
+    SequenceFeed feed({{0, 0, false}, {40, 0, false}});
+    RotatingFeed ws(rotationConfig(feed));
+    SequenceLog log;
+    std::atomic<int> disconnects{0};
+    ws.onRawMessage([&](std::string_view msg) { log.add(msg); });
+    ws.onDisconnect([&](int) { disconnects++; });
+    
+    ASSERT(ws.connect());
+    ASSERT(ws.send("sub"));
+    waitForMessages(log, 50);
+    
+    ASSERT(ws.rotate());
+    ASSERT(feed.server->connections() == 2);
+    size_t atSwitch = log.size();
+    waitForMessages(log, atSwitch + 100);
+    ws.disconnect();
+    
+    ASSERT(log.contiguous());
+    ASSERT(ws.stats().rotations == 1);
+    ASSERT(disconnects.load() == 1);  // Só o disconnect() explícito
+}
+
+TEST(rotation_new_link_ahead) {
+    // Link antigo entrega 40 mensagens atrasado: o novo chega antes
+    SequenceFeed feed({{0, 40, false}, {0, 0, false}});
+    RotatingFeed ws(rotationConfig(feed));
+    SequenceLog log;
+    ws.onRawMessage([&](std::string_view msg) { log.add(msg); });
+    
+    ASSERT(ws.connect());
+    ASSERT(ws.send("sub"));
+    waitForMessages(log, 50);
+    
+    ASSERT(ws.rotate());
+    size_t atSwitch = log.size();
+    waitForMessages(log, atSwitch + 100);
+    ws.disconnect();
+    
+    ASSERT(log.contiguous());
+    ASSERT(ws.stats().rotations == 1);
+}
+
+TEST(rotation_fails_without_overlap) {
+    // Novo link começa 5000 à frente: nenhuma mensagem em comum
+    SequenceFeed feed({{0, 0, false}, {-5000, 0, false}});
+    auto config = rotationConfig(feed);
+    config.rotation.overlapTimeout = std::chrono::milliseconds(200);
+    RotatingFeed ws(config);
+    SequenceLog log;
+    std::atomic<int> rotationErrors{0};
+    ws.onRawMessage([&](std::string_view msg) { log.add(msg); });
+    ws.onError([&](int code, std::string_view) {
+        if (code == ErrorCode::RotationFailed) rotationErrors++;
+    });
+    
+    ASSERT(ws.connect());
+    ASSERT(ws.send("sub"));
+    waitForMessages(log, 20);
+    
+    ASSERT(!ws.rotate());
+    ASSERT(rotationErrors.load() == 1);
+    ASSERT(ws.isConnected());
+    size_t after = log.size();
+    waitForMessages(log, after + 50);
+    ws.disconnect();
+    
+    // Link antigo seguiu entregando
+    ASSERT(log.contiguous());
+    ASSERT(ws.stats().rotations == 0);
+}
+
+TEST(scheduled_rotation_survives_server_close) {
+    // Servidor derruba o link antigo assim que o novo assina
+    SequenceFeed feed({{0, 0, true}, {20, 0, false}});
+    auto config = rotationConfig(feed);
+    config.rotation.interval = std::chrono::milliseconds(100);
+    RotatingFeed ws(config);
+    SequenceLog log;
+    std::atomic<int> disconnects{0};
+    ws.onRawMessage([&](std::string_view msg) { log.add(msg); });
+    ws.onDisconnect([&](int) { disconnects++; });
+    
+    ASSERT(ws.connect());
+    ASSERT(ws.send("sub"));
+    for (int i = 0; i < 200 && ws.stats().rotations == 0; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    
+    ASSERT(ws.stats().rotations >= 1);
+    size_t atSwitch = log.size();
+    waitForMessages(log, atSwitch + 50);
+    ASSERT(ws.isConnected());
+    ws.disconnect();
+    
+    ASSERT(log.contiguous());
+    ASSERT(disconnects.load() == 1);
+}
+
+// ============================================
+// Reconexão
+// ============================================
+
+// Lê as `count` assinaturas do início da sessão ("a;b;")
+std::string readSubscriptions(test::Connection& conn, int count) {
+    std::string subs;
+    uint8_t opcode;
+    std::string payload;
+    for (int i = 0; i < count && conn.readFrame(opcode, payload, 2000); ++i) {
+        subs += payload + ";";
+    }
+    return subs;
+}
+
+TEST(reconnect_replays_subscriptions) {
+    // Sessões 0 e 2 caem sem Close, a 1 fecha com 1001; a 3 fica
+    const size_t baseline = liveThreads();
+    std::mutex mutex;
+    std::vector<std::string> replayed;
+    std::atomic<int> sessions{0};
+    test::LocalServer server([&](test::Connection& conn) {
+        int index = sessions++;
+        std::string subs = readSubscriptions(conn, 2);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            replayed.push_back(subs);
+        }
+        conn.sendText("tick");
+        if (index == 1) {
+            conn.sendClose(CloseCode::GoingAway);
+            conn.waitClose(1000);
+        } else if (index < 3) {
+            ::shutdown(conn.fd(), SHUT_RDWR);
+        } else {
+            conn.waitClose();
+        }
+    });
+    
+    {
+        WebSocketConfig config{.url = server.url()};
+        config.reconnectBaseDelay = std::chrono::milliseconds(20);
+        config.reconnectMaxDelay = std::chrono::milliseconds(50);
+        WebSocket ws(config);
+        
+        std::atomic<int> ticks{0};
+        std::atomic<int> reconnects{0};
+        std::atomic<int> disconnects{0};
+        ws.onRawMessage([&](std::string_view) { ticks++; });
+        ws.onReconnect([&](int attempts, std::chrono::microseconds) {
+            ASSERT(attempts == 1);
+            reconnects++;
+        });
+        ws.onDisconnect([&](int) { disconnects++; });
+        
+        ASSERT(!ws.subscribe("sub:a"));     // Desconectado: só registra
+        ASSERT(ws.connect());
+        ASSERT(ws.subscribe("sub:b"));
+        ASSERT(ws.subscriptions().size() == 2);
+        
+        // onReconnect sai depois que o link já entrega: espera por ele também
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while ((ticks.load() < 4 || reconnects.load() < 3 || !ws.isConnected()) &&
+               std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        
+        auto stats = ws.stats();
+        ASSERT(ticks.load() == 4);
+        ASSERT(ws.isConnected());
+        ASSERT(reconnects.load() == 3);
+        ASSERT(stats.reconnects == 3);
+        ASSERT(stats.reconnectAttempts == 3);
+        // Primeira tentativa sem backoff: volta em bem menos que 1s
+        ASSERT(stats.maxRecoveryUs < 200000);
+        ASSERT(stats.totalRecoveryUs >= stats.maxRecoveryUs);
+        
+        ws.disconnect();
+        ASSERT(disconnects.load() == 1);
+    }
+    server.stop();
+    
+    ASSERT(replayed.size() == 4);
+    for (const auto& subs : replayed) {
+        ASSERT(subs == "sub:a;sub:b;");
+    }
+    
+    // Supervisor, I/O e heartbeat de todos os links terminaram
+    for (int i = 0; i < 100 && liveThreads() > baseline; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    ASSERT(liveThreads() == baseline);
+}
+
+TEST(send_during_reconnect) {
+    // Envios de outras threads enquanto o link cai e é trocado: cleanup() e a
+    // adoção do novo link esperam o envio em andamento (nada de escrever num
+    // fd fechado/reaproveitado ou num SSL* liberado)
+    std::atomic<int> sessions{0};
+    test::LocalServer server([&](test::Connection& conn) {
+        if (sessions++ < 3) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(30));
+            ::shutdown(conn.fd(), SHUT_RDWR);
+        } else {
+            conn.waitClose();
+        }
+    });
+    
+    WebSocketConfig config{.url = server.url()};
+    config.reconnectBaseDelay = std::chrono::milliseconds(5);
+    config.reconnectMaxDelay = std::chrono::milliseconds(10);
+    RawTcpFeed ws(config);
+    std::atomic<int> reconnects{0};
+    ws.onReconnect([&](int, std::chrono::microseconds) { reconnects++; });
+    ASSERT(ws.connect());
+    
+    std::atomic<bool> stop{false};
+    std::vector<std::thread> senders;
+    for (int i = 0; i < 2; ++i) {
+        senders.emplace_back([&] {
+            while (!stop.load()) {
+                ws.send("x");
+            }
+        });
+    }
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (reconnects.load() < 3 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    stop = true;
+    for (auto& sender : senders) sender.join();
+    ASSERT(reconnects.load() == 3);
+    ASSERT(ws.isConnected());
+    ws.disconnect();
+}
+
+TEST(reconnect_gives_up_after_max_attempts) {
+    std::atomic<bool> drop{false};
+    test::LocalServer server([&](test::Connection& conn) {
+        while (!drop.load()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        ::shutdown(conn.fd(), SHUT_RDWR);
+    });
+    
+    WebSocketConfig config{.url = server.url()};
+    config.connectTimeout = std::chrono::milliseconds(200);
+    config.maxReconnectAttempts = 3;
+    config.reconnectBaseDelay = std::chrono::milliseconds(20);
+    config.reconnectMaxDelay = std::chrono::milliseconds(40);
+    RotatingFeed ws(config);
+    
+    std::atomic<int> disconnects{0};
+    std::atomic<int> disconnectCode{0};
+    ws.onDisconnect([&](int code) {
+        disconnects++;
+        disconnectCode = code;
+    });
+    
+    ASSERT(ws.connect());
+    
+    // Servidor para de aceitar e só então derruba o link: todas as tentativas falham
+    std::thread stopper([&]() { server.stop(); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(150));
+    auto start = std::chrono::steady_clock::now();
+    drop = true;
+    ws.wait();
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    stopper.join();
+    
+    ASSERT(server.connections() == 1);
+    
+    ASSERT(elapsed < std::chrono::seconds(3));
+    ASSERT(!ws.isConnected());
+    ASSERT(disconnects.load() == 1);
+    ASSERT(disconnectCode.load() == CloseCode::AbnormalClosure);
+    ASSERT(ws.stats().reconnectAttempts == 3);
+    ASSERT(ws.stats().reconnects == 0);
+    ws.disconnect();
+}
+
+TEST(external_poll_reconnects) {
+    std::mutex mutex;
+    std::vector<std::string> replayed;
+    std::atomic<int> sessions{0};
+    test::LocalServer server([&](test::Connection& conn) {
+        int index = sessions++;
+        std::string subs = readSubscriptions(conn, 1);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            replayed.push_back(subs);
+        }
+        conn.sendText("tick");
+        if (index == 0) {
+            ::shutdown(conn.fd(), SHUT_RDWR);
+        } else {
+            conn.waitClose();
+        }
+    });
+    
+    WebSocketConfig config{.url = server.url()};
+    PolledFeed ws(config);
+    int ticks = 0;
+    int reconnects = 0;
+    const auto caller = std::this_thread::get_id();
+    ws.onRawMessage([&](std::string_view) { ticks++; });
+    ws.onReconnect([&](int, std::chrono::microseconds) {
+        ASSERT(std::this_thread::get_id() == caller);
+        reconnects++;
+    });
+    
+    ws.subscribe("sub");
+    ASSERT(ws.connect());
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while ((ticks < 2 || !ws.isConnected()) && std::chrono::steady_clock::now() < deadline) {
+        ws.poll(64, 10);
+    }
+    
+    ASSERT(ticks == 2);
+    ASSERT(reconnects == 1);
+    ASSERT(ws.isConnected());
+    ASSERT(ws.fd() >= 0);
+    ASSERT(ws.stats().reconnects == 1);
+    ws.disconnect();
+    server.stop();
+    
+    ASSERT(replayed.size() == 2);
+    ASSERT(replayed[0] == "sub;" && replayed[1] == "sub;");
+}
+
+TEST(external_poll_does_not_block_on_redial) {
+    // Depois da queda só sobra o endpoint que aceita o TCP e nunca
+    // responde ao upgrade: a discagem leva connectTimeout inteiro
+    test::Blackhole hole(false);
+    ASSERT(hole.valid());
+    std::atomic<int> sessions{0};
+    test::LocalServer server([&](test::Connection& conn) {
+        sessions++;
+        ::shutdown(conn.fd(), SHUT_RDWR);
+    });
+    
+    WebSocketConfig config{.url = server.url(), .endpoints = {hole.url()}};
+    config.connectTimeout = std::chrono::milliseconds(400);
+    config.reconnectFirstDelay = std::chrono::milliseconds(0);
+    PolledFeed ws(config);
+    const size_t baseline = liveThreads();
+    ASSERT(ws.connect());
+    server.stop();
+    
+    // poll(0) volta na hora durante toda a tentativa (e a seguinte)
+    int64_t slowest = 0;
+    auto until = std::chrono::steady_clock::now() + std::chrono::milliseconds(600);
+    while (std::chrono::steady_clock::now() < until) {
+        auto start = std::chrono::steady_clock::now();
+        ws.poll(64, 0);
+        slowest = std::max<int64_t>(slowest, elapsedMs(start));
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    ASSERT(sessions.load() == 1);
+    ASSERT(!ws.isConnected());
+    ASSERT(ws.stats().reconnectAttempts >= 1);
+    ASSERT(slowest < 50);
+    
+    // disconnect() no meio da discagem: interrompe e junta a thread auxiliar
+    auto start = std::chrono::steady_clock::now();
+    ws.disconnect();
+    ASSERT(elapsedMs(start) < 200);
+    for (int i = 0; i < 100 && liveThreads() > baseline; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    ASSERT(liveThreads() <= baseline);
+}
+
+// ============================================
+// Transportes
+// ============================================
+using MemoryFeed = BasicWebSocket<policy::MemoryTransport, policy::ExternalDriven, policy::HeartbeatOff>;
+
+TEST(unix_socket_receive_and_send) {
+    const std::string path = "/tmp/gg_ws_test_" + std::to_string(::getpid()) + ".sock";
+    std::string received;
+    test::LocalServer server(path, [&](test::Connection& conn) {
+        uint8_t opcode = 0;
+        conn.readFrame(opcode, received);
+        conn.sendText("pong");
+        conn.waitClose();
+    });
+    
+    WebSocketConfig config{.url = server.url("/feed")};
+    config.autoReconnect = false;
+    RawTcpFeed ws(config);
+    std::atomic<int> pongs{0};
+    ws.onRawMessage([&](std::string_view msg) {
+        if (msg == "pong") pongs++;
+    });
+    
+    ASSERT(ws.connect());
+    ASSERT(ws.send("ping"));
+    for (int i = 0; i < 200 && pongs.load() == 0; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    ws.disconnect();
+    server.stop();
+    ASSERT(pongs.load() == 1);
+    ASSERT(received == "ping");
+}
+
+TEST(memory_pipe_full_stack) {
+    auto pipe = MemoryPipe::create("test_full_stack");
+    WebSocketConfig config{.url = "memory://test_full_stack"};
+    config.autoReconnect = false;
+    MemoryFeed ws(config);
+    std::vector<int> values;
+    int closeCode = 0;
+    ws.onMessage([&](const Json& msg) { values.push_back(msg["v"].getInt()); });
+    ws.onDisconnect([&](int code) { closeCode = code; });
+    
+    ASSERT(ws.connect());
+    ASSERT(pipe->attached());
+    ASSERT(ws.fd() == -1);
+    ASSERT(ws.poll() == 0);     // Sem dados: não bloqueia
+    
+    for (int i = 0; i < 1000; ++i) {
+        pipe->writeText("{\"v\":" + std::to_string(i) + "}");
+    }
+    ASSERT(ws.poll(600) == 600);
+    ASSERT(ws.poll() == 400);
+    ASSERT(values.size() == 1000 && values.back() == 999);
+    ASSERT(ws.stats().messagesReceived == 1000);
+    
+    // Envio do cliente: frame mascarado capturado no pipe
+    ASSERT(ws.send("hello"));
+    std::string out = pipe->drainOutbound();
+    ASSERT(out.size() == 2 + 4 + 5);
+    ASSERT(static_cast<uint8_t>(out[0]) == 0x81 && static_cast<uint8_t>(out[1]) == (0x80 | 5));
+    for (size_t i = 0; i < 5; ++i) {
+        out[6 + i] = static_cast<char>(out[6 + i] ^ out[2 + i % 4]);
+    }
+    ASSERT(out.substr(6) == "hello");
+    
+    // Close do "servidor": resposta capturada, link liberado
+    pipe->writeFrame(0x8, std::string("\x03\xe8", 2));
+    ws.poll(64, 100);
+    ASSERT(!ws.isConnected());
+    ASSERT(closeCode == CloseCode::Normal);
+    ASSERT(static_cast<uint8_t>(pipe->drainOutbound()[0]) == 0x88);
+    ws.disconnect();
+    ASSERT(!pipe->attached());
+}
+
+TEST(memory_pipe_own_thread_source) {
+    // Source gera o mesmo frame indefinidamente, direto no buffer de recepção
+    const std::string frame = test::Connection::encodeFrame(0x1, "tick");
+    auto pipe = MemoryPipe::create("test_source");
+    size_t offset = 0;
+    pipe->setSource([&](char* out, size_t capacity) {
+        size_t n = 0;
+        while (n < capacity) {
+            size_t chunk = std::min(capacity - n, frame.size() - offset);
+            std::memcpy(out + n, frame.data() + offset, chunk);
+            n += chunk;
+            offset = (offset + chunk) % frame.size();
+        }
+        return n;
+    });
+    
+    WebSocketConfig config{.url = "memory://test_source"};
+    config.autoReconnect = false;
+    BasicWebSocket<policy::MemoryTransport, policy::JsonOff, policy::HeartbeatOff> ws(config);
+    std::atomic<int> ticks{0};
+    ws.onRawMessage([&](std::string_view msg) {
+        if (msg == "tick") ticks++;
+    });
+    std::atomic<int> disconnects{0};
+    ws.onDisconnect([&](int) { disconnects++; });
+    
+    ASSERT(ws.connect());
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (ticks.load() < 100000 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    ASSERT(ticks.load() >= 100000);
+    
+    // Segundo cliente no mesmo pipe é recusado
+    MemoryFeed other({.url = "memory://test_source"});
+    ASSERT(!other.connect());
+    
+    // Pipe fechado: EOF derruba o link
+    pipe->close();
+    ws.wait();
+    ASSERT(disconnects.load() == 1);
+    ws.disconnect();
+    ASSERT(!pipe->attached());
+}
+
+// ============================================
+// Assinaturas por tópico
+// ============================================
+
+// "S:a,b" / "U:a,b"
+static std::string encodeTopics(SubscriptionAction action, const std::vector<std::string_view>& topics) {
+    std::string out = action == SubscriptionAction::Subscribe ? "S:" : "U:";
+    for (size_t i = 0; i < topics.size(); ++i) {
+        if (i > 0) out += ',';
+        out.append(topics[i].data(), topics[i].size());
+    }
+    return out;
+}
+
+// Payloads de texto dos frames (mascarados) que o cliente escreveu no pipe
+static std::vector<std::string> clientTexts(MemoryPipe& pipe) {
+    std::string wire = pipe.drainOutbound();
+    std::vector<std::string> texts;
+    size_t pos = 0;
+    while (pos + 6 <= wire.size()) {
+        uint8_t opcode = static_cast<uint8_t>(wire[pos]) & 0x0F;
+        size_t len = static_cast<uint8_t>(wire[pos + 1]) & 0x7F;
+        size_t header = 2;
+        if (len == 126) {
+            len = (static_cast<size_t>(static_cast<uint8_t>(wire[pos + 2])) << 8) | static_cast<uint8_t>(wire[pos + 3]);
+            header = 4;
+        }
+        const char* mask = wire.data() + pos + header;
+        std::string payload = wire.substr(pos + header + 4, len);
+        for (size_t i = 0; i < payload.size(); ++i) {
+            payload[i] = static_cast<char>(payload[i] ^ mask[i % 4]);
+        }
+        if (opcode == Opcode::Text) texts.push_back(std::move(payload));
+        pos += header + 4 + len;
+    }
+    return texts;
+}
+
+static size_t topicCount(const std::string& message) {
+    return static_cast<size_t>(std::count(message.begin(), message.end(), ',')) + 1;
+}
+
+TEST(topics_batched_and_paced) {
+    auto pipe = MemoryPipe::create("test_topics");
+    WebSocketConfig config{.url = "memory://test_topics"};
+    config.autoReconnect = false;
+    config.subscriptions.encode = encodeTopics;
+    config.subscriptions.maxTopicsPerMessage = 100;
+    config.subscriptions.messagesPerSecond = 10;
+    config.subscriptions.burst = 2;
+    MemoryFeed ws(config);
+    
+    std::vector<std::string> topics;
+    for (int i = 0; i < 250; ++i) topics.push_back("t" + std::to_string(i));
+    ASSERT(ws.subscribeTopics(topics));
+    ASSERT(ws.subscribeTopics({"t0", "t1"}));   // Repetidos: ignorados
+    
+    // Burst sai no connect; o terceiro lote espera o ritmo
+    ASSERT(ws.connect());
+    auto sent = clientTexts(*pipe);
+    ASSERT(sent.size() == 2);
+    ASSERT(sent[0].rfind("S:t0,t1,", 0) == 0 && topicCount(sent[0]) == 100);
+    ASSERT(sent[1].rfind("S:t100,", 0) == 0 && topicCount(sent[1]) == 100);
+    ws.poll(64, 0);
+    ASSERT(clientTexts(*pipe).empty());
+    
+    auto start = std::chrono::steady_clock::now();
+    while (sent.size() < 3 && elapsedMs(start) < 1000) {
+        ws.poll(64, 10);
+        for (auto& message : clientTexts(*pipe)) sent.push_back(std::move(message));
+    }
+    ASSERT(sent.size() == 3);
+    ASSERT(elapsedMs(start) >= 80);
+    ASSERT(sent[2].rfind("S:t200,", 0) == 0 && topicCount(sent[2]) == 50);
+    
+    // Ritmo esgotado: assinar e cancelar antes do envio se anulam
+    ASSERT(ws.subscribeTopics({"x"}));
+    ASSERT(ws.unsubscribeTopics({"x", "t0", "t1", "missing"}));
+    ASSERT(ws.subscribeTopics({"y"}));
+    while (sent.size() < 5 && elapsedMs(start) < 2000) {
+        ws.poll(64, 10);
+        for (auto& message : clientTexts(*pipe)) sent.push_back(std::move(message));
+    }
+    ASSERT(sent.size() == 5);
+    ASSERT(sent[3] == "U:t0,t1");
+    ASSERT(sent[4] == "S:y");
+    
+    auto active = ws.topics();
+    ASSERT(active.size() == 249);
+    ASSERT(active.front() == "t2" && active.back() == "y");
+    ws.disconnect();
+}
+
+TEST(topics_replayed_after_reconnect) {
+    auto pipe = MemoryPipe::create("test_topics_replay");
+    WebSocketConfig config{.url = "memory://test_topics_replay"};
+    config.subscriptions.encode = encodeTopics;
+    config.subscriptions.maxTopicsPerMessage = 200;
+    config.subscriptions.burst = 3;
+    MemoryFeed ws(config);
+    ASSERT(!MemoryFeed({.url = config.url}).subscribeTopics({"a"}));   // Sem encoder
+    
+    std::vector<std::string> topics;
+    for (int i = 0; i < 450; ++i) topics.push_back("t" + std::to_string(i));
+    ws.subscribe("legacy");
+    ASSERT(ws.subscribeTopics(topics));
+    ASSERT(ws.connect());
+    ASSERT(clientTexts(*pipe).size() == 4);
+    ASSERT(ws.unsubscribeTopics({"t5"}));
+    ASSERT(clientTexts(*pipe).empty());     // Burst já gasto neste link
+    
+    // Queda: o link novo recebe o conjunto ativo, sem o cancelamento pendente
+    pipe->close();
+    ws.poll(64, 100);
+    ASSERT(!ws.isConnected());
+    pipe->reopen();
+    auto start = std::chrono::steady_clock::now();
+    while (!ws.isConnected() && elapsedMs(start) < 2000) {
+        ws.poll(64, 10);
+    }
+    ASSERT(ws.isConnected());
+    
+    auto sent = clientTexts(*pipe);
+    ASSERT(sent.size() == 4);
+    ASSERT(sent[0] == "legacy");
+    ASSERT(topicCount(sent[1]) == 200 && topicCount(sent[2]) == 200 && topicCount(sent[3]) == 49);
+    ASSERT(sent[1].find(",t5,") == std::string::npos);
+    ws.poll(64, 0);
+    ASSERT(clientTexts(*pipe).empty());
+    ws.disconnect();
+}
+
+// ============================================
+// TLS
+// ============================================
+using RawTlsFeed = BasicWebSocket<policy::TlsTransport, policy::JsonOff, policy::HeartbeatOff>;
+
+// Conecta e desconecta `rounds` vezes; retorna quantos handshakes o cliente viu retomados
+static int tlsReconnects(const test::TlsIdentity& identity, bool resume, int rounds, int& serverResumed) {
+    test::LocalServer server(identity, [](test::Connection& conn) {
+        conn.sendText("hello");
+        conn.waitClose(2000);
+    });
+    
+    WebSocketConfig config{.url = server.url()};
+    config.autoReconnect = false;
+    config.tls.caFile = identity.caFile();
+    config.tls.resumeSessions = resume;
+    RawTlsFeed ws(config);
+    std::atomic<int> resumed{0};
+    ws.onEndpointRace([&](const std::vector<EndpointTiming>& timings) {
+        for (const auto& timing : timings) {
+            if (timing.outcome == EndpointOutcome::Winner && timing.tlsResumed) resumed++;
+        }
+    });
+    std::atomic<int> messages{0};
+    ws.onRawMessage([&](std::string_view msg) {
+        if (msg == "hello") messages++;
+    });
+    
+    for (int i = 0; i < rounds; ++i) {
+        ASSERT(ws.connect());
+        for (int j = 0; j < 200 && messages.load() <= i; ++j) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        ws.disconnect();
+    }
+    server.stop();
+    ASSERT(messages.load() == rounds);
+    serverResumed = server.resumedSessions();
+    return resumed.load();
+}
+
+TEST(tls_session_resumed_on_reconnect) {
+    // TLS 1.3 (NewSessionTicket) e TLS 1.2 (ticket no handshake)
+    for (int version : {0, TLS1_2_VERSION}) {
+        test::TlsIdentity identity(version);
+        int serverResumed = 0;
+        ASSERT(tlsReconnects(identity, true, 3, serverResumed) == 2);
+        ASSERT(serverResumed == 2);
+    }
+}
+
+TEST(tls_resumption_disabled) {
+    test::TlsIdentity identity;
+    int serverResumed = 0;
+    ASSERT(tlsReconnects(identity, false, 3, serverResumed) == 0);
+    ASSERT(serverResumed == 0);
+}
+
+TEST(tls_untrusted_certificate_fails) {
+    test::TlsIdentity identity, other;
+    test::LocalServer server(identity, [](test::Connection& conn) { conn.waitClose(2000); });
+    
+    WebSocketConfig config{.url = server.url()};
+    config.autoReconnect = false;
+    config.tls.caFile = other.caFile();
+    RawTlsFeed ws(config);
+    std::atomic<int> errorCode{0};
+    ws.onError([&](int code, std::string_view) { errorCode = code; });
+    ASSERT(!ws.connect());
+    ASSERT(errorCode.load() == ErrorCode::TlsError);
+}
+
 // ============================================
 // Main
 // ============================================
@@ -219,6 +1829,67 @@ int main() {
     std::cout << "Básicos:\n";
     RUN_TEST(cpu_affinity);
     
+    std::cout << "\nLocal (loopback):\n";
+    RUN_TEST(utf8_invalid_closes_1007);
+    RUN_TEST(utf8_invalid_fragment_closes_1007);
+    RUN_TEST(utf8_valid_multibyte_passes);
+    RUN_TEST(utf8_split_across_fragments_passes);
+    RUN_TEST(utf8_invalid_continuation_closes_1007);
+    
+    std::cout << "\nPolíticas:\n";
+    RUN_TEST(policy_raw_tcp_receive);
+    RUN_TEST(policy_rejects_mismatched_scheme);
+    RUN_TEST(policy_external_poll_and_stats);
+    
+    std::cout << "\nLoop externo:\n";
+    RUN_TEST(frames_sent_with_handshake);
+    RUN_TEST(external_poll_budget_fd_and_inline_send);
+    
+    std::cout << "\nConnect:\n";
+    RUN_TEST(happy_eyeballs_races_past_unreachable);
+    RUN_TEST(connect_timeout_is_enforced);
+    RUN_TEST(connect_refused_fails_fast);
+    RUN_TEST(dns_cache_feeds_happy_eyeballs);
+    RUN_TEST(dns_cache_shares_lookups);
+    
+    std::cout << "\nCorrida de endpoints:\n";
+    RUN_TEST(endpoint_race_keeps_fastest);
+    RUN_TEST(endpoint_race_all_fail);
+    
+    std::cout << "\nRotação:\n";
+    RUN_TEST(rotation_new_link_behind);
+    RUN_TEST(rotation_new_link_ahead);
+    RUN_TEST(rotation_fails_without_overlap);
+    RUN_TEST(scheduled_rotation_survives_server_close);
+    
+    std::cout << "\nReconexão:\n";
+    RUN_TEST(reconnect_replays_subscriptions);
+    RUN_TEST(reconnect_gives_up_after_max_attempts);
+    RUN_TEST(send_during_reconnect);
+    RUN_TEST(external_poll_reconnects);
+    RUN_TEST(external_poll_does_not_block_on_redial);
+    
+    std::cout << "\nTransportes:\n";
+    RUN_TEST(unix_socket_receive_and_send);
+    RUN_TEST(memory_pipe_full_stack);
+    RUN_TEST(memory_pipe_own_thread_source);
+    
+    std::cout << "\nAssinaturas por tópico:\n";
+    RUN_TEST(topics_batched_and_paced);
+    RUN_TEST(topics_replayed_after_reconnect);
+    
+    std::cout << "\nTLS:\n";
+    RUN_TEST(tls_session_resumed_on_reconnect);
+    RUN_TEST(tls_resumption_disabled);
+    RUN_TEST(tls_untrusted_certificate_fails);
+    
+    std::cout << "\nDispatch:\n";
+    RUN_TEST(route_by_event_type);
+    RUN_TEST(batch_per_read);
+    RUN_TEST(batch_survives_buffer_growth);
+    RUN_TEST(swap_callbacks_while_receiving);
+    RUN_TEST(replaced_callbacks_are_released);
+    
     std::cout << "\nConexão (requer internet):\n";
     RUN_TEST(basic_connection);
     RUN_TEST(send_receive);
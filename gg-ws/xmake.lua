@@ -39,7 +39,7 @@ target("gg_ws")
     
     -- Flags específicas por plataforma
     if is_plat("linux") then
-        add_syslinks("pthread")
+        add_syslinks("pthread", "rt")
     elseif is_plat("windows") then
         add_syslinks("ws2_32", "crypt32")
     end
@@ -68,6 +68,81 @@ target("test_thread_safety")
     add_deps("gg_ws")
     add_packages("openssl")
 
+target("test_utf8")
+    set_kind("binary")
+    set_default(false)
+    add_files("tests/test_utf8.cpp")
+    add_deps("gg_ws")
+    add_packages("openssl")
+
+target("test_router")
+    set_kind("binary")
+    set_default(false)
+    add_files("tests/test_router.cpp")
+    add_deps("gg_ws")
+    add_packages("openssl")
+
+target("test_shm_ring")
+    set_kind("binary")
+    set_default(false)
+    add_files("tests/test_shm_ring.cpp")
+    add_deps("gg_ws")
+    add_packages("openssl")
+
+target("test_event_bridge")
+    set_kind("binary")
+    set_default(false)
+    add_files("tests/test_event_bridge.cpp")
+    add_deps("gg_ws")
+    add_packages("openssl")
+    add_includedirs("../observer/src")     -- GG_Observer (header-only)
+    add_cxxflags("-frtti", {force = true})  -- EventBus usa typeid
+
+-- ============================================
+-- Benchmarks
+-- ============================================
+target("bench_utf8")
+    set_kind("binary")
+    set_default(false)
+    add_files("benchmarks/bench_utf8.cpp")
+    add_deps("gg_ws")
+    add_packages("openssl")
+
+target("bench_policies")
+    set_kind("binary")
+    set_default(false)
+    add_files("benchmarks/bench_policies.cpp")
+    add_deps("gg_ws")
+    add_packages("openssl")
+
+target("bench_transport")
+    set_kind("binary")
+    set_default(false)
+    add_files("benchmarks/bench_transport.cpp")
+    add_deps("gg_ws")
+    add_packages("openssl")
+
+target("bench_send")
+    set_kind("binary")
+    set_default(false)
+    add_files("benchmarks/bench_send.cpp")
+    add_deps("gg_ws")
+    add_packages("openssl")
+
+target("bench_tls_reconnect")
+    set_kind("binary")
+    set_default(false)
+    add_files("benchmarks/bench_tls_reconnect.cpp")
+    add_deps("gg_ws")
+    add_packages("openssl")
+
+target("bench_json")
+    set_kind("binary")
+    set_default(false)
+    add_files("benchmarks/bench_json.cpp")
+    add_deps("gg_ws")
+    add_packages("openssl")
+
 -- ============================================
 -- Exemplo
 -- ============================================